@@ -7,15 +7,28 @@
 #include "protocol/ntp/ntp.hpp"
 #include "chatbot/message/message.hpp"
 #include "media/audio/capture/capture.hpp"
+#include "media/audio/level/level.hpp"
+#include "media/clock/clock.hpp"
 #include "media/audio/wakeword/wakeword.hpp"
 #include "media/camera/camera.hpp"
 #include "media/camera/process/jpeg/encode/jpeg_enc.hpp"
 #include "assets/assets.hpp"
 #include "logic/logic.h"
+#include "move/move.hpp"
+#include "move/clip/clip.hpp"
+#include "move/engine/engine.hpp"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "nvs_flash.h"
+#include "system/event/event.hpp"
+#include "system/event/bus/bus.hpp"
 #include "system/task/task.hpp"
+#include "system/task/profiler/profiler.hpp"
+#include "system/task/stack/stack.hpp"
+#include "tool/recorder/recorder.hpp"
+#include "tool/trace/trace.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <vector>
 
@@ -51,55 +64,56 @@ namespace app
             return false;
         }
 
-        return true;
-    }
-
-    void App::run()
-    {
-        while (true)
+        if (!initEventLoop())
         {
-            switch (current_state_)
-            {
-            case DeviceState::INIT:
-                handleInitState();
-                break;
-
-            case DeviceState::PROVISIONING:
-                handleProvisioningState();
-                break;
+            ESP_LOGE(TAG, "主循环事件队列初始化失败");
+            return false;
+        }
 
-            case DeviceState::NTP_SYNC:
-                handleNtpSyncState();
-                break;
+        // 飞行记录器不影响正常运行，失败时只告警
+        if (!tool::recorder::Recorder::getInstance().init())
+        {
+            ESP_LOGW(TAG, "飞行记录器初始化失败");
+        }
 
-            case DeviceState::CONNECTING:
-                handleConnectingState();
-                break;
+#ifdef CONFIG_STACK_TUNER_ENABLE
+        // 浸泡测试：采样各任务的栈水位，定期输出建议栈大小
+        sys::task::stack::StackTuner::getInstance().start(CONFIG_STACK_TUNER_PERIOD_MS,
+                                                          CONFIG_STACK_TUNER_REPORT_S * 1000);
+#endif
 
-            case DeviceState::WAKEWORD_WAIT:
-                handleWakewordWaitState();
-                break;
+#ifdef CONFIG_CPU_PROFILER_ENABLE
+        // 统计各任务和各核心的 CPU 占用，定期输出日志并在运行状态下上报服务器
+        sys::task::profiler::CpuProfiler::getInstance().start(CONFIG_CPU_PROFILER_PERIOD_MS,
+                                                              CONFIG_CPU_PROFILER_REPORT_S * 1000);
+#endif
 
-            case DeviceState::RUNNING:
-                handleRunningState();
-                break;
+#ifdef CONFIG_TRACE_ENABLE
+        // 跨任务时延跟踪，由服务器的 trace_dump 请求导出
+        if (!tool::trace::Tracer::getInstance().init(CONFIG_TRACE_RECORDS_PER_CORE))
+        {
+            ESP_LOGW(TAG, "跟踪初始化失败");
+        }
+#endif
 
-            case DeviceState::ERROR:
-                handleErrorState();
-                break;
+        return true;
+    }
 
-            case DeviceState::RECOVERY:
-                handleRecoveryState();
-                break;
+    void App::run()
+    {
+        // 初始化各子系统，完成后进入 PROVISIONING
+        handleInitState();
 
-            default:
-                ESP_LOGE(TAG, "未知状态: %d", static_cast<int>(current_state_));
-                setState(DeviceState::ERROR);
-                break;
+        AppEvent event;
+        while (true)
+        {
+            // 没有事件时一直睡眠，事件到达后立即按当前状态处理
+            if (xQueueReceive(event_queue_, &event, portMAX_DELAY) == pdTRUE)
+            {
+                TRACE_COUNTER("app.queue", uxQueueMessagesWaiting(event_queue_));
+                TRACE_SCOPE("app.dispatch");
+                dispatchEvent(event);
             }
-
-            // 防止忙等，给其他任务运行机会
-            sys::task::TaskManager::delayMs(100);
         }
     }
 
@@ -113,6 +127,8 @@ namespace app
 
     namespace
     {
+        constexpr uint32_t INIT_RETRY_MS = 1000; // 子系统初始化失败后的重试间隔（毫秒）
+
         /**
          * @brief 获取状态名称字符串
          * @param state 设备状态
@@ -142,6 +158,68 @@ namespace app
                 return "UNKNOWN";
             }
         }
+
+        /**
+         * @brief 获取事件名称字符串
+         * @param type 事件类型
+         * @return 事件名称字符串
+         */
+        const char* getEventName(AppEventType type)
+        {
+            switch (type)
+            {
+            case AppEventType::STATE_TIMEOUT:
+                return "STATE_TIMEOUT";
+            case AppEventType::RETRY:
+                return "RETRY";
+            case AppEventType::SENSOR_TICK:
+                return "SENSOR_TICK";
+            case AppEventType::IMAGE_TICK:
+                return "IMAGE_TICK";
+            case AppEventType::LOG_TICK:
+                return "LOG_TICK";
+            case AppEventType::PRESENCE_TICK:
+                return "PRESENCE_TICK";
+            case AppEventType::PRESENCE_DETECTED:
+                return "PRESENCE_DETECTED";
+            case AppEventType::PROVISION_DONE:
+                return "PROVISION_DONE";
+            case AppEventType::NTP_DONE:
+                return "NTP_DONE";
+            case AppEventType::WS_CONNECTED:
+                return "WS_CONNECTED";
+            case AppEventType::WS_DISCONNECTED:
+                return "WS_DISCONNECTED";
+            case AppEventType::WAKEWORD:
+                return "WAKEWORD";
+            case AppEventType::RECORDER_DUMP:
+                return "RECORDER_DUMP";
+            case AppEventType::CPU_TICK:
+                return "CPU_TICK";
+            case AppEventType::TRACE_DUMP:
+                return "TRACE_DUMP";
+            default:
+                return "UNKNOWN";
+            }
+        }
+
+        /**
+         * @brief 获取状态的超时时间
+         * @param state 设备状态
+         * @return 超时时间（毫秒），0 表示不超时
+         */
+        uint32_t getStateTimeoutMs(DeviceState state)
+        {
+            switch (state)
+            {
+            case DeviceState::PROVISIONING:
+                return 30000; // 配网
+            case DeviceState::CONNECTING:
+                return 10000; // 等待连接确认
+            default:
+                return 0;
+            }
+        }
     } // namespace
 
     void App::setState(DeviceState new_state)
@@ -151,12 +229,30 @@ namespace app
             return; // 状态未改变
         }
 
-        // 记录状态转换
-        ESP_LOGI(TAG, "状态转换: %s -> %s", getStateName(current_state_), getStateName(new_state));
+        DeviceState old_state = current_state_;
+        int64_t     now_us    = esp_timer_get_time();
+        exitState(old_state);
+
+        // 记录状态转换：在上一状态停留的时间，以及触发事件从投递到转换的延迟
+        long long stay_ms = (now_us - state_start_time_) / 1000;
+        if (current_event_ != nullptr)
+        {
+            ESP_LOGI(TAG, "状态转换: %s -> %s (停留 %lld ms, 事件 %s 延迟 %lld us)",
+                     getStateName(old_state), getStateName(new_state), stay_ms,
+                     getEventName(current_event_->type),
+                     (long long)(now_us - current_event_->time_us));
+        }
+        else
+        {
+            ESP_LOGI(TAG, "状态转换: %s -> %s (停留 %lld ms)", getStateName(old_state),
+                     getStateName(new_state), stay_ms);
+        }
+        tool::recorder::Recorder::getInstance().recordState(static_cast<uint8_t>(old_state),
+                                                            static_cast<uint8_t>(new_state));
 
         // 更新状态
-        current_state_    = new_state;
-        state_start_time_ = esp_timer_get_time();
+        current_state_ = new_state;
+        restartStateTimer();
 
         // 某些状态转换时重置重试计数
         if (new_state == DeviceState::PROVISIONING || new_state == DeviceState::CONNECTING ||
@@ -164,13 +260,198 @@ namespace app
         {
             resetRetryCount();
         }
+
+        enterState(new_state);
+    }
+
+    void App::enterState(DeviceState state)
+    {
+        switch (state)
+        {
+        case DeviceState::NTP_SYNC:
+        {
+            // NTP 在 INIT 中已启动，NTP_DONE 可能在配网状态就已到达并被丢弃，
+            // 这里向 NTPManager 查询一次（带锁）
+            auto status = app::protocol::ntp::NTPManager::getInstance().getSyncStatus();
+            if (status == app::protocol::ntp::SyncStatus::COMPLETED ||
+                status == app::protocol::ntp::SyncStatus::FAILED)
+            {
+                checkNtpSyncResult(status == app::protocol::ntp::SyncStatus::COMPLETED);
+            }
+            break;
+        }
+
+        case DeviceState::CONNECTING:
+            tryConnect();
+            break;
+
+        case DeviceState::WAKEWORD_WAIT:
+            checkWakeword();
+            break;
+
+        case DeviceState::RUNNING:
+            // 已唤醒，停止唤醒词检测
+            if (wakeword_ && wakeword_->isRunning())
+            {
+                stopWakeWord();
+            }
+
+            timers_.start(sensor_timer_, 1000, 1000);
+            timers_.start(image_timer_, 5000, 5000);
+            timers_.start(log_timer_, 5000, 5000);
+#if defined(CONFIG_CPU_PROFILER_ENABLE) && CONFIG_CPU_PROFILER_UPLOAD_S > 0
+            timers_.start(cpu_timer_, CONFIG_CPU_PROFILER_UPLOAD_S * 1000,
+                          CONFIG_CPU_PROFILER_UPLOAD_S * 1000);
+#endif
+
+            // 进入时立即上传一次
+            postEvent(AppEventType::SENSOR_TICK);
+            postEvent(AppEventType::IMAGE_TICK);
+            postEvent(AppEventType::LOG_TICK);
+
+            if (!chatbot_.isConnected())
+            {
+                reconnect();
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void App::exitState(DeviceState state)
+    {
+        // 退避只属于当前状态，新状态重新计数
+        timers_.stop(retry_timer_);
+
+        if (state == DeviceState::RUNNING)
+        {
+            timers_.stop(sensor_timer_);
+            timers_.stop(image_timer_);
+            timers_.stop(log_timer_);
+            timers_.stop(cpu_timer_);
+        }
+    }
+
+    bool App::isStateTimedOut() const
+    {
+        // 重新计时前已投递的超时事件作废
+        uint32_t timeout_ms   = getStateTimeoutMs(current_state_);
+        int64_t  elapsed_time = (esp_timer_get_time() - state_start_time_) / 1000; // 转换为毫秒
+        return timeout_ms > 0 && elapsed_time >= timeout_ms;
+    }
+
+    void App::restartStateTimer()
+    {
+        state_start_time_   = esp_timer_get_time();
+        uint32_t timeout_ms = getStateTimeoutMs(current_state_);
+        if (timeout_ms > 0)
+        {
+            timers_.start(state_timer_, timeout_ms);
+        }
+        else
+        {
+            timers_.stop(state_timer_);
+        }
+    }
+
+    void App::startRetryTimer()
+    {
+        // 第1次：1秒，第2次：2秒，第3次：4秒，第4次：8秒，第5次：16秒
+        timers_.start(retry_timer_, 1000u << retry_count_);
+    }
+
+    // ==================== 事件处理 ====================
+
+    bool App::initEventLoop()
+    {
+        event_queue_ = xQueueCreate(APP_EVENT_QUEUE_LEN, sizeof(AppEvent));
+        if (event_queue_ == nullptr)
+        {
+            ESP_LOGE(TAG, "创建事件队列失败");
+            return false;
+        }
+
+        if (!timers_.init("app_loop"))
+        {
+            return false;
+        }
+
+        // 定时器回调在 esp_timer 任务中执行，只投递事件
+        state_timer_.setCallback([this] { postEvent(AppEventType::STATE_TIMEOUT); });
+        retry_timer_.setCallback([this] { postEvent(AppEventType::RETRY); });
+        sensor_timer_.setCallback([this] { postEvent(AppEventType::SENSOR_TICK); });
+        image_timer_.setCallback([this] { postEvent(AppEventType::IMAGE_TICK); });
+        log_timer_.setCallback([this] { postEvent(AppEventType::LOG_TICK); });
+        cpu_timer_.setCallback([this] { postEvent(AppEventType::CPU_TICK); });
+        presence_timer_.setCallback([this] { postEvent(AppEventType::PRESENCE_TICK); });
+
+        // 在场保持时间到期后需要冷却，每秒检查一次
+        timers_.start(presence_timer_, 1000, 1000);
+        return true;
+    }
+
+    bool App::postEvent(AppEventType type, bool success)
+    {
+        if (event_queue_ == nullptr)
+        {
+            return false;
+        }
+
+        AppEvent event;
+        event.type    = type;
+        event.success = success;
+        event.time_us = esp_timer_get_time();
+
+        // 不阻塞投递方（定时器、WebSocket、音频等任务），队列满时丢弃并计数
+        if (xQueueSend(event_queue_, &event, 0) != pdTRUE)
+        {
+            dropped_events_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
     }
 
-    bool App::isStateTimeout(int timeout_ms) const
+    void App::dispatchEvent(const AppEvent& event)
     {
-        int64_t current_time = esp_timer_get_time();
-        int64_t elapsed_time = (current_time - state_start_time_) / 1000; // 转换为毫秒
-        return elapsed_time >= timeout_ms;
+        current_event_ = &event;
+
+        switch (current_state_)
+        {
+        case DeviceState::PROVISIONING:
+            handleProvisioningEvent(event);
+            break;
+
+        case DeviceState::NTP_SYNC:
+            handleNtpSyncEvent(event);
+            break;
+
+        case DeviceState::CONNECTING:
+            handleConnectingEvent(event);
+            break;
+
+        case DeviceState::WAKEWORD_WAIT:
+            handleWakewordWaitEvent(event);
+            break;
+
+        case DeviceState::RUNNING:
+            handleRunningEvent(event);
+            break;
+
+        default:
+            // INIT 在 run() 开始时同步执行，ERROR 和 RECOVERY 不处理事件
+            break;
+        }
+
+        // 按在场状态预热或冷却耗时子系统（与状态无关）
+        if (event.type == AppEventType::PRESENCE_TICK ||
+            event.type == AppEventType::PRESENCE_DETECTED)
+        {
+            updatePrewarm();
+        }
+
+        current_event_ = nullptr;
     }
 
     // ==================== 状态处理函数 ====================
@@ -193,6 +474,14 @@ namespace app
         {
             ESP_LOGW(TAG, "QMI8658A 初始化失败");
         }
+        else
+        {
+            // 启动后台数据采集任务（运动检测用于上传规则和在场预热）
+            if (!qmi8658a_.startDataCollection(200))
+            {
+                ESP_LOGW(TAG, "QMI8658A 数据采集任务启动失败");
+            }
+        }
 
         if (!initAPDS9930(getI2CBusHandle()))
         {
@@ -200,10 +489,10 @@ namespace app
         }
         else
         {
-            // 启动 APDS-9930 传感器数据获取
-            if (apds9930_.start())
+            // 启动 APDS-9930 传感器数据获取（中断模式下同时打开光和接近阈值中断）
+            if (apds9930_.start(apds9930_.isIrqMode(), apds9930_.isIrqMode()))
             {
-                // 启动后台数据采集任务
+                // 启动后台数据采集任务（中断模式下 5000ms 为兜底检查周期）
                 if (!apds9930_.startDataCollection(5000))
                 {
                     ESP_LOGW(TAG, "APDS-9930 数据采集任务启动失败");
@@ -217,7 +506,7 @@ namespace app
         }
         else
         {
-            // 启动后台数据采集任务
+            // 启动后台数据采集任务（中断模式下 100ms 为兜底检查周期）
             if (!mpr121_.startDataCollection(100))
             {
                 ESP_LOGW(TAG, "MPR121 触摸传感器数据采集任务启动失败");
@@ -237,6 +526,11 @@ namespace app
             }
         }
 
+        if (!initMove(getI2CBusHandle()))
+        {
+            ESP_LOGW(TAG, "舵机驱动初始化失败，运动控制将不可用");
+        }
+
         // 初始化摄像头
         if (!initCamera(getI2CBusHandle()))
         {
@@ -258,50 +552,22 @@ namespace app
         setState(DeviceState::PROVISIONING);
     }
 
-    void App::handleProvisioningState()
+    void App::handleProvisioningEvent(const AppEvent& event)
     {
-        // 检查配网是否已完成
-        if (provision_completed_)
+        switch (event.type)
         {
-            if (provision_success_)
-            {
-                ESP_LOGI(TAG, "配网成功，进入NTP同步状态");
-                setState(DeviceState::NTP_SYNC);
-            }
-            else
-            {
-                // 配网失败，检查重试次数
-                retry_count_++;
-                if (retry_count_ >= max_retries_)
-                {
-                    ESP_LOGE(TAG, "配网重试次数超过上限 (%d 次)，进入错误状态", max_retries_);
-                    setState(DeviceState::ERROR);
-                }
-                else
-                {
-                    ESP_LOGW(TAG, "配网失败，第 %d 次重试...", retry_count_);
-                    provision_completed_ = false;
+        case AppEventType::PROVISION_DONE:
+            // 配网结果在 INIT 中就可能投递，事件循环先于 INIT 创建，会在进入本状态后处理
+            checkProvisionResult(event.success);
+            break;
 
-                    // 重新启动配网
-                    auto& provision = app::network::ProvisionManager::getInstance();
-                    if (provision.start())
-                    {
-                        // 重置状态开始时间
-                        state_start_time_ = esp_timer_get_time();
-                    }
-                    else
-                    {
-                        ESP_LOGE(TAG, "重新启动配网失败");
-                        setState(DeviceState::ERROR);
-                    }
-                }
+        case AppEventType::STATE_TIMEOUT:
+            // 检查超时（30秒）
+            if (!isStateTimedOut())
+            {
+                break;
             }
-            return;
-        }
 
-        // 检查超时（30秒）
-        if (isStateTimeout(30000))
-        {
             ESP_LOGW(TAG, "配网超时");
             retry_count_++;
             if (retry_count_ >= max_retries_)
@@ -317,7 +583,7 @@ namespace app
                 if (provision.start())
                 {
                     // 重置状态开始时间
-                    state_start_time_ = esp_timer_get_time();
+                    restartStateTimer();
                 }
                 else
                 {
@@ -325,29 +591,92 @@ namespace app
                     setState(DeviceState::ERROR);
                 }
             }
+            break;
+
+        default:
+            break;
         }
     }
 
-    void App::handleNtpSyncState()
+    void App::checkProvisionResult(bool success)
     {
-        // 检查NTP同步是否已完成
-        if (ntp_sync_completed_)
+        if (success)
+        {
+            ESP_LOGI(TAG, "配网成功，进入NTP同步状态");
+            setState(DeviceState::NTP_SYNC);
+            return;
+        }
+
+        // 配网失败，检查重试次数
+        retry_count_++;
+        if (retry_count_ >= max_retries_)
         {
-            if (ntp_sync_success_)
+            ESP_LOGE(TAG, "配网重试次数超过上限 (%d 次)，进入错误状态", max_retries_);
+            setState(DeviceState::ERROR);
+        }
+        else
+        {
+            ESP_LOGW(TAG, "配网失败，第 %d 次重试...", retry_count_);
+
+            // 重新启动配网
+            auto& provision = app::network::ProvisionManager::getInstance();
+            if (provision.start())
             {
-                ESP_LOGI(TAG, "NTP时间同步成功，进入WebSocket连接状态");
-                setState(DeviceState::CONNECTING);
+                // 重置状态开始时间
+                restartStateTimer();
             }
             else
             {
-                ESP_LOGW(TAG, "NTP时间同步失败，将在后台继续尝试");
-                setState(DeviceState::CONNECTING);
+                ESP_LOGE(TAG, "重新启动配网失败");
+                setState(DeviceState::ERROR);
             }
-            return;
         }
     }
 
-    void App::handleConnectingState()
+    void App::handleNtpSyncEvent(const AppEvent& event)
+    {
+        if (event.type == AppEventType::NTP_DONE)
+        {
+            checkNtpSyncResult(event.success);
+        }
+    }
+
+    void App::checkNtpSyncResult(bool success)
+    {
+        if (success)
+        {
+            ESP_LOGI(TAG, "NTP时间同步成功，进入WebSocket连接状态");
+        }
+        else
+        {
+            ESP_LOGW(TAG, "NTP时间同步失败，将在后台继续尝试");
+        }
+        setState(DeviceState::CONNECTING);
+    }
+
+    void App::handleConnectingEvent(const AppEvent& event)
+    {
+        switch (event.type)
+        {
+        case AppEventType::WS_CONNECTED:
+        case AppEventType::RETRY:
+            tryConnect();
+            break;
+
+        case AppEventType::STATE_TIMEOUT:
+            // 检查连接超时（10秒）
+            if (isStateTimedOut() && !chatbot_.isConnected())
+            {
+                onConnectTimeout();
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void App::tryConnect()
     {
         // 初始化Chatbot（如果还未初始化）
         if (!chatbot_initialized_)
@@ -373,14 +702,14 @@ namespace app
                 else
                 {
                     // 重置状态开始时间，等待指数退避后重试
-                    state_start_time_          = esp_timer_get_time();
-                    last_connect_attempt_time_ = esp_timer_get_time();
+                    restartStateTimer();
+                    startRetryTimer();
                 }
                 return;
             }
             chatbot_initialized_ = true;
             // 初始化后立即尝试连接
-            last_connect_attempt_time_ = 0; // 设置为0，表示立即尝试
+            timers_.stop(retry_timer_);
         }
 
         // 检查是否已连接
@@ -392,36 +721,20 @@ namespace app
             return;
         }
 
-        int64_t current_time = esp_timer_get_time();
-
-        // 如果是第一次尝试（last_connect_attempt_time_ == 0），立即连接
-        // 否则检查是否到了重试时间
-        if (last_connect_attempt_time_ != 0)
+        // 退避等待中，retry_timer_ 到期后投递 RETRY 再尝试
+        if (retry_timer_.isActive())
         {
-            // 计算指数退避延迟（毫秒）
-            // 第1次：1秒，第2次：2秒，第3次：4秒，第4次：8秒，第5次：16秒
-            const int base_delay_ms = 1000;                                // 基础延迟1秒
-            const int delay_ms      = base_delay_ms * (1 << retry_count_); // 2^retry_count
-            int64_t   delay_us      = delay_ms * 1000;                     // 转换为微秒
-
-            // 检查是否到了重试时间
-            int64_t elapsed_time = current_time - last_connect_attempt_time_;
-
-            if (elapsed_time < delay_us)
-            {
-                // 还没到重试时间，继续等待
-                return;
-            }
+            return;
         }
 
         // 尝试连接
         ESP_LOGI(TAG, "尝试连接WebSocket服务器（第 %d 次）...", retry_count_ + 1);
-        last_connect_attempt_time_ = current_time;
 
         if (chatbot_.connect())
         {
             ESP_LOGI(TAG, "WebSocket连接请求已发送，等待连接确认...");
-            state_start_time_ = current_time;
+            restartStateTimer();
+            startRetryTimer();
         }
         else
         {
@@ -437,31 +750,62 @@ namespace app
             else
             {
                 // 重置状态开始时间，等待指数退避后重试
-                state_start_time_ = current_time;
+                restartStateTimer();
+                startRetryTimer();
             }
         }
+    }
 
-        // 检查连接超时（10秒）
-        if (isStateTimeout(10000))
+    void App::onConnectTimeout()
+    {
+        ESP_LOGW(TAG, "WebSocket连接超时");
+        retry_count_++;
+        if (retry_count_ >= max_retries_)
         {
-            ESP_LOGW(TAG, "WebSocket连接超时");
-            retry_count_++;
-            if (retry_count_ >= max_retries_)
-            {
-                ESP_LOGE(TAG, "WebSocket连接重试次数超过上限 (%d 次），回退到配网状态",
-                         max_retries_);
-                chatbot_initialized_ = false; // 重置初始化状态，下次重新初始化
-                setState(DeviceState::PROVISIONING);
-            }
-            else
-            {
-                // 重置状态开始时间，等待指数退避后重试
-                state_start_time_ = current_time;
-            }
+            ESP_LOGE(TAG, "WebSocket连接重试次数超过上限 (%d 次），回退到配网状态", max_retries_);
+            chatbot_initialized_ = false; // 重置初始化状态，下次重新初始化
+            setState(DeviceState::PROVISIONING);
+        }
+        else
+        {
+            // 重置状态开始时间，等待指数退避后重试
+            restartStateTimer();
+            startRetryTimer();
         }
     }
 
-    void App::handleWakewordWaitState()
+    void App::handleWakewordWaitEvent(const AppEvent& event)
+    {
+        switch (event.type)
+        {
+        case AppEventType::WAKEWORD:
+            ESP_LOGI(TAG, "检测到唤醒词，进入正常运行状态");
+            resetRetryCount();
+            setState(DeviceState::RUNNING);
+            break;
+
+        case AppEventType::RETRY:
+            checkWakeword();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void App::checkWakeword()
+    {
+        if (!prepareWakeword())
+        {
+            // 初始化失败，稍后重试
+            timers_.start(retry_timer_, INIT_RETRY_MS);
+            return;
+        }
+
+        // 唤醒词检测通过事件回调异步触发，检测到后投递 WAKEWORD 事件
+    }
+
+    bool App::prepareWakeword()
     {
         // 初始化音频（如果还未初始化）
         if (!audio_.isInitialized())
@@ -469,8 +813,7 @@ namespace app
             if (!initAudio(getI2CBusHandle(), 16000))
             {
                 ESP_LOGE(TAG, "音频初始化失败");
-                // 音频初始化失败，等待重试
-                return;
+                return false;
             }
         }
 
@@ -480,8 +823,7 @@ namespace app
             if (!initAfe())
             {
                 ESP_LOGW(TAG, "AFE初始化失败，将在后台继续尝试");
-                // AFE初始化失败，等待重试
-                return;
+                return false;
             }
         }
 
@@ -492,7 +834,7 @@ namespace app
             if (!startAudioCapture())
             {
                 ESP_LOGE(TAG, "启动音频采集失败");
-                return;
+                return false;
             }
         }
 
@@ -502,8 +844,7 @@ namespace app
             if (!initWakeWord())
             {
                 ESP_LOGW(TAG, "唤醒词初始化失败，将在后台继续尝试");
-                // 唤醒词初始化失败，等待重试
-                return;
+                return false;
             }
         }
 
@@ -513,100 +854,54 @@ namespace app
             if (!startWakeWord())
             {
                 ESP_LOGW(TAG, "启动唤醒词检测失败，将在后台继续尝试");
-                return;
+                return false;
             }
         }
 
-        // 检查是否检测到唤醒词
-        if (wakeword_detected_)
-        {
-            ESP_LOGI(TAG, "检测到唤醒词，进入正常运行状态");
-            wakeword_detected_ = false; // 重置标志
-            resetRetryCount();
-            setState(DeviceState::RUNNING);
-            return;
-        }
-
-        // 等待唤醒词（阻塞式，但不阻塞主循环）
-        // 唤醒词检测通过事件回调异步触发，这里只需要等待标志被设置
+        return true;
     }
 
-    void App::handleRunningState()
+    void App::handleRunningEvent(const AppEvent& event)
     {
-        // 停止唤醒词检测（仅在首次进入时执行一次）
-        static bool wakeword_stopped = false;
-        if (!wakeword_stopped && wakeword_ && wakeword_->isRunning())
+        switch (event.type)
         {
-            stopWakeWord();
-            wakeword_stopped = true;
-        }
+        case AppEventType::WS_CONNECTED:
+            // 重连成功，重置重试计数
+            ESP_LOGI(TAG, "WebSocket重连成功");
+            resetRetryCount();
+            timers_.stop(retry_timer_);
 
-        // 检查WebSocket连接状态
-        if (!chatbot_.isConnected())
-        {
-            ESP_LOGW(TAG, "WebSocket连接断开，尝试重连...");
-            retry_count_++;
-            if (retry_count_ >= max_retries_)
+            // 断线期间到达的导出请求
+            if (recorder_dump_pending_.load(std::memory_order_acquire))
             {
-                ESP_LOGE(TAG, "WebSocket重连次数超过上限 (%d 次），回退到配网状态", max_retries_);
-                chatbot_initialized_ = false;
-                wakeword_stopped     = false; // 重置标志
-                setState(DeviceState::PROVISIONING);
-                return;
+                postEvent(AppEventType::RECORDER_DUMP);
             }
-            else
+            if (trace_dump_pending_.load(std::memory_order_acquire))
             {
-                // 尝试重连
-                if (chatbot_.connect())
-                {
-                    ESP_LOGI(TAG, "WebSocket重连成功");
-                    resetRetryCount();
-                }
-                else
-                {
-                    ESP_LOGW(TAG, "WebSocket重连失败，等待下次重试");
-                    // 使用指数退避延迟
-                    sys::task::TaskManager::delayMs(1000 *
-                                                    (1 << retry_count_)); // 1s, 2s, 4s, 8s, 16s
-                }
-                return;
+                postEvent(AppEventType::TRACE_DUMP);
             }
-        }
-
-        // 如果连接正常，重置重试计数
-        if (retry_count_ > 0)
-        {
-            resetRetryCount();
-        }
-
-        // 初始化逻辑配置（仅一次）
-        static const logic_config_t config      = initLogicConfig();
-        static int                  zero_streak = 0;
-
-        // 定期采集并发送传感器数据（每1秒）
-        static int64_t last_sensor_time = 0;
-        int64_t        current_time     = esp_timer_get_time();
-        if (current_time - last_sensor_time >= 1000000) // 1秒
-        {
-            // 计算控制位并转换为二进制字符串
-            std::string command_str = calculateAndConvertControl(config, zero_streak);
-
-            // 采集并发送传感器数据
-            collectAndSendSensorData(command_str);
+            break;
 
-            last_sensor_time = current_time;
-        }
+        case AppEventType::WS_DISCONNECTED:
+        case AppEventType::RETRY:
+            if (!chatbot_.isConnected())
+            {
+                reconnect();
+            }
+            break;
 
-        // 摄像头图片上传（当 command[4] == '1' 时，每5秒上传一张）
-        static int64_t last_image_time = 0;
-        if (current_time - last_image_time >= 5000000) // 5秒
-        {
-            // 检查 command[4] 是否为 '1'（摄像头使能）
-            static std::string last_command_str;
-            std::string        command_str = calculateAndConvertControl(config, zero_streak);
+        case AppEventType::SENSOR_TICK:
+            // 定期采集并发送传感器数据（sensor_timer_，每1秒）
+            // 上传控制位由规则引擎在传感器状态变化时更新，这里只读取
+            if (chatbot_.isConnected())
+            {
+                collectAndSendSensorData(control_rules_.getOutputs());
+            }
+            break;
 
-            // 如果 command[4] == '1'，上传图片
-            if (command_str.length() == 5 && command_str[4] == '1')
+        case AppEventType::IMAGE_TICK:
+            // 摄像头图片上传（摄像头输出位有效时，image_timer_ 每5秒上传一张）
+            if (chatbot_.isConnected() && (control_rules_.getOutputs() & LOGIC_OUTPUT_CAMERA))
             {
                 if (captureAndSendImage())
                 {
@@ -617,22 +912,79 @@ namespace app
                     ESP_LOGW(TAG, "图片上传失败");
                 }
             }
+            break;
 
-            last_image_time = current_time;
-        }
+        case AppEventType::RECORDER_DUMP:
+            // 服务器请求的飞行记录器导出（与图片上传同在主循环中发送，避免二进制帧交错）
+            if (chatbot_.isConnected() &&
+                recorder_dump_pending_.load(std::memory_order_acquire))
+            {
+                sendRecorderDump();
+                recorder_dump_pending_.store(false, std::memory_order_release);
+            }
+            break;
 
-        // 定期打印系统信息（每5秒）
-        static int64_t last_log_time = 0;
-        if (current_time - last_log_time >= 5000000) // 5秒
-        {
+        case AppEventType::TRACE_DUMP:
+            // 服务器请求的跟踪记录导出（同上，在主循环中发送）
+            if (chatbot_.isConnected() && trace_dump_pending_.load(std::memory_order_acquire))
+            {
+                sendTraceDump();
+                trace_dump_pending_.store(false, std::memory_order_release);
+            }
+            break;
+
+        case AppEventType::CPU_TICK:
+            // CPU 占用上报（cpu_timer_，周期见 CONFIG_CPU_PROFILER_UPLOAD_S）
+            if (chatbot_.isConnected())
+            {
+                sendCpuInfo();
+            }
+            break;
+
+        case AppEventType::LOG_TICK:
+            // 定期打印系统信息（log_timer_，每5秒）
             logSystemInfo();
-            last_log_time = current_time;
+            if (uint32_t dropped = dropped_events_.exchange(0, std::memory_order_relaxed))
+            {
+                ESP_LOGW(TAG, "事件队列已满，丢弃 %lu 个事件", (unsigned long)dropped);
+            }
+            break;
+
+        default:
+            break;
         }
     }
 
-    void App::handleErrorState() {}
+    void App::reconnect()
+    {
+        // 退避等待中，retry_timer_ 到期后投递 RETRY 再重连
+        if (retry_timer_.isActive())
+        {
+            return;
+        }
+
+        ESP_LOGW(TAG, "WebSocket连接断开，尝试重连...");
+        retry_count_++;
+        if (retry_count_ >= max_retries_)
+        {
+            ESP_LOGE(TAG, "WebSocket重连次数超过上限 (%d 次），回退到配网状态", max_retries_);
+            chatbot_initialized_ = false;
+            setState(DeviceState::PROVISIONING);
+            return;
+        }
 
-    void App::handleRecoveryState() {}
+        if (chatbot_.connect())
+        {
+            ESP_LOGI(TAG, "WebSocket重连请求已发送，等待连接确认");
+        }
+        else
+        {
+            ESP_LOGW(TAG, "WebSocket重连失败，等待下次重试");
+        }
+
+        // 使用指数退避延迟，连接成功时由 WS_CONNECTED 停止
+        startRetryTimer();
+    }
 
     // ==================== 初始化方法 ====================
     // 初始化NVS
@@ -665,6 +1017,12 @@ namespace app
         {
             i2c_.scan(200);
         }
+
+        // 启动 I2C 事务调度器（失败时各设备退化为直接访问总线）
+        if (!i2c::scheduler::Scheduler::getInstance().start())
+        {
+            ESP_LOGW(TAG, "I2C 事务调度器启动失败");
+        }
         return true;
     }
 
@@ -703,12 +1061,31 @@ namespace app
     // 初始化事件系统
     bool App::initEvent()
     {
+        // Wi-Fi/IP 等系统事件仍走 esp_event
         auto& event_mgr = app::sys::event::EventManager::getInstance();
         if (!event_mgr.init())
         {
             ESP_LOGE(TAG, "事件系统初始化失败");
             return false;
         }
+
+        // 应用事件走事件总线，传感器事件使用共用分发任务
+        namespace bus = app::sys::event::bus;
+        auto& event_bus = bus::EventBus::getInstance();
+        if (!event_bus.init())
+        {
+            ESP_LOGE(TAG, "事件总线初始化失败");
+            return false;
+        }
+
+        // 唤醒词事件单独分发，不会被慢的传感器订阅者拖延
+        bus::EventBus::DomainConfig audio_config;
+        audio_config.priority = app::sys::task::Priority::HIGH;
+        if (!event_bus.startDomain(bus::Domain::AUDIO, audio_config))
+        {
+            ESP_LOGE(TAG, "音频事件分发任务启动失败");
+            return false;
+        }
         return true;
     }
 
@@ -725,6 +1102,14 @@ namespace app
             ESP_LOGE(TAG, "QMI8658A 初始化失败");
             return false;
         }
+
+        // 运动状态变化时更新上传规则输入
+        qmi8658a_.setMotionStatusCallback(
+            [this](int status)
+            {
+                control_rules_.setInput(LOGIC_INPUT_GYRO, status == 1);
+                reportPresence(logic::presence::Source::MOTION, status == 1);
+            });
         return true;
     }
 
@@ -736,11 +1121,26 @@ namespace app
             ESP_LOGE(TAG, "I2C 句柄无效");
             return false;
         }
-        if (!apds9930_.init(i2c_handle, device::apds9930::APDS9930_I2C_ADDR))
+        if (!apds9930_.init(i2c_handle, device::apds9930::APDS9930_I2C_ADDR,
+                            app::config::APDS9930_INT))
         {
             ESP_LOGE(TAG, "APDS-9930 初始化失败");
             return false;
         }
+
+        // 环境光状态变化时更新上传规则输入
+        apds9930_.setLightStatusCallback(
+            [this](int status) { control_rules_.setInput(LOGIC_INPUT_LIGHT, status == 1); });
+
+        // 订阅接近事件
+        namespace bus = app::sys::event::bus;
+        bus::EventBus::getInstance().subscribe<bus::Topic::PROXIMITY_CHANGED>(
+            [this](const device::apds9930::LightData& data)
+            {
+                ESP_LOGI(TAG, "接近状态: %s (接近值: %u)", data.near ? "靠近" : "离开",
+                         data.proximity);
+                reportPresence(logic::presence::Source::PROXIMITY, data.near);
+            });
         return true;
     }
 
@@ -753,11 +1153,19 @@ namespace app
             return false;
         }
 
-        if (!mpr121_.init(i2c_handle, device::mpr121::MPR121_I2C_ADDR, GPIO_NUM_NC))
+        if (!mpr121_.init(i2c_handle, device::mpr121::MPR121_I2C_ADDR, app::config::MPR121_IRQ))
         {
             ESP_LOGE(TAG, "MPR121 初始化失败");
             return false;
         }
+
+        // 触摸状态变化时更新上传规则输入
+        mpr121_.setTouchStatusCallback(
+            [this](int status)
+            {
+                control_rules_.setInput(LOGIC_INPUT_TOUCH, status == 1);
+                reportPresence(logic::presence::Source::TOUCH, status == 1);
+            });
         return true;
     }
 
@@ -769,6 +1177,58 @@ namespace app
             ESP_LOGE(TAG, "M0404 初始化失败");
             return false;
         }
+
+        // 压力状态变化时更新上传规则输入
+        m0404_.setPressureStatusCallback(
+            [this](int status)
+            {
+                control_rules_.setInput(LOGIC_INPUT_PRESSURE, status == 1);
+                reportPresence(logic::presence::Source::PRESSURE, status == 1);
+            });
+
+        // 订阅压力阵列手势事件
+        namespace bus = app::sys::event::bus;
+        bus::EventBus::getInstance().subscribe<bus::Topic::GESTURE>(
+            [](const device::m0404::gesture::GestureEvent& gesture)
+            {
+                ESP_LOGI(TAG, "压力手势: %s, 方向: %s, 持续: %lu ms, 激活点数: %u",
+                         device::m0404::gesture::getGestureName(gesture.type),
+                         device::m0404::gesture::getDirectionName(gesture.direction),
+                         (unsigned long)gesture.duration_ms, gesture.peak_contacts);
+            });
+        return true;
+    }
+
+    // 初始化舵机驱动和运动引擎
+    bool App::initMove(i2c_master_bus_handle_t i2c_handle)
+    {
+        if (i2c_handle == nullptr)
+        {
+            ESP_LOGE(TAG, "I2C 总线句柄为空");
+            return false;
+        }
+
+        if (!move::PCA9685::init(i2c_handle))
+        {
+            ESP_LOGE(TAG, "PCA9685 初始化失败");
+            return false;
+        }
+
+        if (!move::engine::MotionEngine::getInstance().start(move::engine::DEFAULT_TICK_MS))
+        {
+            ESP_LOGE(TAG, "运动引擎启动失败");
+            return false;
+        }
+
+        // 预置动作片段直接使用 assets 分区的映射内存，缺失时只是不能按 id 播放
+        void*  clips_data = nullptr;
+        size_t clips_size = 0;
+        if (!app::assets::Assets::getInstance().getAssetData(move::clip::ASSET_NAME, clips_data,
+                                                             clips_size) ||
+            !motion_clips_.load(clips_data, clips_size))
+        {
+            ESP_LOGW(TAG, "未加载预置动作片段");
+        }
         return true;
     }
 
@@ -862,13 +1322,11 @@ namespace app
                 {
                 case app::protocol::ntp::SyncStatus::COMPLETED:
                     ESP_LOGI(TAG, "NTP时间同步完成");
-                    ntp_sync_completed_ = true;
-                    ntp_sync_success_   = true;
+                    postEvent(AppEventType::NTP_DONE, true);
                     break;
                 case app::protocol::ntp::SyncStatus::FAILED:
                     ESP_LOGE(TAG, "NTP时间同步失败");
-                    ntp_sync_completed_ = true;
-                    ntp_sync_success_   = false;
+                    postEvent(AppEventType::NTP_DONE, false);
                     break;
                 case app::protocol::ntp::SyncStatus::IN_PROGRESS:
                     ESP_LOGI(TAG, "NTP时间同步进行中...");
@@ -955,6 +1413,14 @@ namespace app
         chatbot_.setReceiveCallback([this](const std::string& json_str) -> bool
                                     { return message_receiver_.handleMessage(json_str); });
 
+        // 连接状态变化投递给主循环，不再等轮询发现
+        chatbot_.setConnectionCallback(
+            [this](bool connected)
+            {
+                postEvent(connected ? AppEventType::WS_CONNECTED
+                                    : AppEventType::WS_DISCONNECTED);
+            });
+
         // 设置消息处理函数
         setupMessageHandlers();
 
@@ -1008,6 +1474,18 @@ namespace app
         ESP_LOGI(TAG, "  - 采样率: %d Hz", capture.getSampleRate());
         ESP_LOGI(TAG, "  - 通道数: %d", capture.getChannels());
 
+        // LED 随用户说话（AFE 输出）和设备播放的声音起伏，渲染任务每帧读取一次电平
+        led_.setAudioLevelSource(
+            []()
+            {
+                // 低于约 -45dBFS（电平 64）的底噪不点亮，其余拉伸到 0-255
+                using media::audio::level::LevelMeter;
+                int level =
+                    std::max(LevelMeter::input().getLevel(), LevelMeter::output().getLevel());
+                return static_cast<uint8_t>(level > 64 ? (level - 64) * 255 / 191 : 0);
+            });
+        led_.enableAudioLevel(app::config::LED_GPIO, device::led::Color(0, 120, 255));
+
         return true;
     }
 
@@ -1052,6 +1530,9 @@ namespace app
             return false;
         }
 
+        // init() 会启动视频流，先停下等有人靠近时再预热（capture() 也会按需启动）
+        camera_.stopStreaming();
+
         ESP_LOGI(TAG, "摄像头初始化成功");
         return true;
     }
@@ -1113,6 +1594,9 @@ namespace app
             {
                 // 更新 VAD 状态
                 is_speaking_.store(is_speaking, std::memory_order_release);
+                tool::recorder::Recorder::getInstance().recordVad(is_speaking);
+                control_rules_.setInput(LOGIC_INPUT_VOICE, is_speaking);
+                reportPresence(logic::presence::Source::VOICE, is_speaking);
 
                 // VAD 状态变化时的处理
                 if (is_speaking)
@@ -1136,14 +1620,25 @@ namespace app
             {
                 // 只有在检测到语音、已连接且处于 RUNNING 状态时才上传音频
                 // 注意：这里可以根据需要放宽状态限制，比如在 WAKEWORD_WAIT 也可以上传用于云端校验
+                // 记录器导出期间暂停上传，避免音频帧混入导出数据
                 if (isSpeaking() && chatbot_.isConnected() &&
-                    current_state_ == DeviceState::RUNNING)
+                    current_state_ == DeviceState::RUNNING &&
+                    !recorder_dump_pending_.load(std::memory_order_acquire) &&
+                    !trace_dump_pending_.load(std::memory_order_acquire))
                 {
                     // 1. 如果是本次语音的首帧，先发送 listen 消息
                     if (!listen_message_sent_)
                     {
                         sendListenMessage();
                         listen_message_sent_ = true;
+
+                        // 唤醒后的第一段语音：统计唤醒到开始上传音频的延迟
+                        int64_t wake_us = wake_time_us_.exchange(0, std::memory_order_acq_rel);
+                        if (wake_us != 0)
+                        {
+                            ESP_LOGI(TAG, "唤醒到开始上传音频: %lld ms",
+                                     (long long)((esp_timer_get_time() - wake_us) / 1000));
+                        }
                     }
 
                     // 2. 将 PCM 数据喂给 Opus 编码器进行编码
@@ -1382,33 +1877,23 @@ namespace app
         ESP_LOGI(TAG, "  - 通道数: %d", channels);
         ESP_LOGI(TAG, "  - 输入帧大小: %u 样本", (unsigned int)wakeword_->getFeedSize());
 
-        // 注册唤醒词事件处理器
-        auto& event_mgr = app::sys::event::EventManager::getInstance();
-        event_mgr.registerHandler(
-            media::audio::wakeword::WAKEWORD_EVENT_BASE,
-            media::audio::wakeword::WAKEWORD_EVENT_DETECTED,
-            [this](esp_event_base_t event_base, app::sys::event::EventId event_id,
-                   const app::sys::event::EventData& event_data)
+        // 订阅唤醒词事件（在音频域的分发任务中执行）
+        namespace bus = app::sys::event::bus;
+        bus::EventBus::getInstance().subscribe<bus::Topic::WAKEWORD_DETECTED>(
+            [this](const media::audio::wakeword::WakeWordEventData& wake_data)
             {
-                (void)event_base;
-                (void)event_id;
-
-                if (event_data.data != nullptr)
-                {
-                    const media::audio::wakeword::WakeWordEventData* wake_data =
-                        static_cast<const media::audio::wakeword::WakeWordEventData*>(
-                            event_data.data);
-
-                    ESP_LOGI(TAG, "========== 检测到唤醒词 ==========");
-                    ESP_LOGI(TAG, "  文本: %s", wake_data->text);
-                    ESP_LOGI(TAG, "  命令: %s", wake_data->command);
-                    ESP_LOGI(TAG, "  动作: %s", wake_data->action);
-                    ESP_LOGI(TAG, "  概率: %.2f", wake_data->probability);
-                    ESP_LOGI(TAG, "====================================");
-
-                    // 设置唤醒词检测标志
-                    wakeword_detected_ = true;
-                }
+                ESP_LOGI(TAG, "========== 检测到唤醒词 ==========");
+                ESP_LOGI(TAG, "  文本: %s", wake_data.text);
+                ESP_LOGI(TAG, "  命令: %s", wake_data.command);
+                ESP_LOGI(TAG, "  动作: %s", wake_data.action);
+                ESP_LOGI(TAG, "  概率: %.2f", wake_data.probability);
+                ESP_LOGI(TAG, "====================================");
+
+                tool::recorder::Recorder::getInstance().recordWakeword(wake_data.probability);
+
+                // 记录唤醒时间用于统计唤醒到上传的延迟，状态切换由 App 任务处理事件完成
+                wake_time_us_.store(esp_timer_get_time(), std::memory_order_release);
+                postEvent(AppEventType::WAKEWORD);
             });
 
         return true;
@@ -1558,10 +2043,14 @@ namespace app
     {
         ESP_LOGI(TAG, "================= 系统信息 ===================");
         logMemoryInfo();
+        logCpuInfo();
         logWiFiInfo();
+        logI2CInfo();
+        logRecorderInfo();
         logQMI8658AInfo();
         logMPR121Info();
         logM0404Info();
+        logMoveInfo();
         logAPDS9930Info();
         ESP_LOGI(TAG, "==============================================");
     }
@@ -1580,6 +2069,23 @@ namespace app
                  (unsigned int)(mem_info.getPsramTotal() / 1024));
     }
 
+    void App::logCpuInfo()
+    {
+        auto& profiler = sys::task::profiler::CpuProfiler::getInstance();
+        if (!profiler.isRunning())
+        {
+            return;
+        }
+
+        for (const auto& core : profiler.getCoreLoads())
+        {
+            ESP_LOGI(TAG, "CPU%d 占用: %.1f%% (短) / %.1f%% (中) / %.1f%% (长), 峰值 %.1f%%",
+                     core.core, core.load(sys::task::profiler::Window::SHORT),
+                     core.load(sys::task::profiler::Window::MEDIUM),
+                     core.load(sys::task::profiler::Window::LONG), core.peak);
+        }
+    }
+
     void App::logWiFiInfo()
     {
         auto& provision = app::network::ProvisionManager::getInstance();
@@ -1608,16 +2114,42 @@ namespace app
         }
     }
 
+    void App::logI2CInfo()
+    {
+        i2c::scheduler::Scheduler::getInstance().logStats();
+    }
+
+    void App::logRecorderInfo()
+    {
+        tool::recorder::Recorder::getInstance().logStats();
+    }
+
     void App::logAPDS9930Info()
     {
-        float lux_value = 0.0f;
-        if (apds9930_.readAmbientLightLux(lux_value))
+        // 优先使用采集任务缓存的数据，避免额外的 I2C 访问
+        device::apds9930::LightData data;
+        float                       lux_value = 0.0f;
+        bool                        read_ok   = apds9930_.getLatestData(data);
+        if (read_ok)
+        {
+            lux_value = data.lux;
+        }
+        else
+        {
+            read_ok = apds9930_.readAmbientLightLux(lux_value);
+        }
+
+        if (read_ok)
         {
             // 根据阈值判断状态（<1000 lux 为暗，>=1000 lux 为亮）
             int light_status = (lux_value >= 1000.0f) ? 1 : 0;
             ESP_LOGI(TAG, "APDS-9930 环境光传感器:");
             ESP_LOGI(TAG, "  状态: %d (%s)", light_status, light_status ? "亮" : "暗");
             ESP_LOGI(TAG, "  照度: %.2f lux", lux_value);
+            if (data.valid)
+            {
+                ESP_LOGI(TAG, "  接近: %s (%u)", data.near ? "靠近" : "离开", data.proximity);
+            }
         }
         else
         {
@@ -1627,6 +2159,16 @@ namespace app
 
     void App::logMPR121Info()
     {
+        // 中断模式下不主动读取寄存器，避免额外的 I2C 访问
+        if (mpr121_.isIrqMode())
+        {
+            auto stats = mpr121_.getIrqLatencyStats();
+            ESP_LOGI(TAG, "MPR121 触摸传感器状态: %d (中断模式，响应延迟 平均/最大: %lu/%lu us)",
+                     mpr121_.getCurrentTouchStatus(), (unsigned long)stats.avg_us,
+                     (unsigned long)stats.max_us);
+            return;
+        }
+
         device::mpr121::TouchData data;
         if (mpr121_.readTouch(data))
         {
@@ -1651,31 +2193,147 @@ namespace app
                 ESP_LOGI(TAG, "  传感器[%2lu]: %5u", (unsigned long)i, raw_value);
             }
         }
+
+        auto cal_stats = m0404_.getOnlineCalibrationStats();
+        ESP_LOGI(TAG, "M0404 零点置信度: %u%%, 采纳窗口: %lu, 噪声窗口: %lu, 中断窗口: %lu",
+                 m0404_.getZeroPointConfidence(), (unsigned long)cal_stats.windows_accepted,
+                 (unsigned long)cal_stats.windows_noisy, (unsigned long)cal_stats.windows_aborted);
+    }
+
+    void App::logMoveInfo()
+    {
+        auto& engine = move::engine::MotionEngine::getInstance();
+        if (engine.isRunning())
+        {
+            engine.logStats();
+        }
+        ESP_LOGI(TAG, "预置动作片段: %u 个", (unsigned int)motion_clips_.getClipCount());
+        auto& media_clock = media::clock::MediaClock::getInstance();
+        if (media_clock.isStarted())
+        {
+            media_clock.logStats();
+        }
     }
 
-    // ==================== 数据上传 ====================
+    // ==================== 在场预热 ====================
 
-    void App::collectAndSendSensorData(const std::string& command_str)
+    void App::reportPresence(logic::presence::Source source, bool active)
     {
-        // 验证 command 长度
-        if (command_str.length() != 5)
+        uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+        if (presence_.report(source, active, now_ms) && active)
+        {
+            ESP_LOGI(TAG, "检测到有人 (来源: %s)", logic::presence::getSourceName(source));
+
+            // 立即预热，不等在场检查定时器
+            postEvent(AppEventType::PRESENCE_DETECTED);
+        }
+    }
+
+    void App::updatePrewarm()
+    {
+        // 初始化完成前各子系统还不存在
+        if (current_state_ == DeviceState::INIT)
+        {
+            return;
+        }
+
+        presence_.tick(static_cast<uint32_t>(esp_timer_get_time() / 1000));
+        bool present = presence_.isPresent();
+        if (present == prewarmed_)
+        {
+            return;
+        }
+
+        // 对话进行中（用户在说话或回复正在播放）不冷却，下一次在场检查再判断
+        if (!present && isConversationActive())
         {
-            ESP_LOGE(TAG, "command 长度错误: %u，应为5位", (unsigned int)command_str.length());
             return;
         }
 
+        prewarmed_ = present;
+        if (present)
+        {
+            prewarm();
+        }
+        else
+        {
+            cooldown();
+        }
+    }
+
+    void App::prewarm()
+    {
+        ESP_LOGI(TAG, "预热音频输出、摄像头和网络连接");
+
+        // 打开编解码器输出和功放，回复到来时可以直接播放
+        if (audio_.isInitialized() && !audio_.enableOutput(true))
+        {
+            ESP_LOGW(TAG, "预热音频输出失败");
+        }
+
+        // 启动摄像头流，让自动曝光提前收敛
+        if (camera_.isInitialized() && !camera_.startStreaming())
+        {
+            ESP_LOGW(TAG, "预热摄像头失败");
+        }
+
+        // 连接或运行中断线重连处于退避等待时立即重试，而不是等用户开口后才连上
+        bool backoff = (current_state_ == DeviceState::CONNECTING && chatbot_initialized_ &&
+                        retry_count_ > 0) ||
+                       (current_state_ == DeviceState::RUNNING && retry_timer_.isActive());
+        if (backoff && !chatbot_.isConnected())
+        {
+            ESP_LOGI(TAG, "有人靠近，跳过重连退避");
+            timers_.stop(retry_timer_);
+            postEvent(AppEventType::RETRY);
+        }
+    }
+
+    void App::cooldown()
+    {
+        auto stats = presence_.getStats();
+        ESP_LOGI(TAG, "无人，关闭预热的子系统 (累计在场: %lu s, 进入次数: %lu)",
+                 (unsigned long)(stats.present_ms / 1000), (unsigned long)stats.activations);
+
+        if (audio_.isInitialized())
+        {
+            audio_.enableOutput(false);
+        }
+
+        // 服务器要求上传图片时保持视频流，避免每次拍照都冷启动
+        if (!(control_rules_.getOutputs() & LOGIC_OUTPUT_CAMERA))
+        {
+            camera_.stopStreaming();
+        }
+    }
+
+    bool App::isConversationActive() const
+    {
+        if (current_state_ != DeviceState::RUNNING)
+        {
+            return false;
+        }
+
+        return isSpeaking() ||
+               media::clock::MediaClock::getInstance().isPlaying(esp_timer_get_time());
+    }
+
+    // ==================== 数据上传 ====================
+
+    void App::collectAndSendSensorData(uint8_t outputs)
+    {
         // 构造传感器数据
         chatbot::message::SensorData sensor_data;
 
-        // 根据 command 控制哪些传感器数据需要上传
-        // command[0]: 触摸传感器 (touch)
-        // command[1]: 压力传感器 (pressure)
-        // command[2]: 陀螺仪 (gyroscope)
-        // command[3]: 光敏传感器 (photosensitive)
-        // command[4]: 摄像头 (camera) - 暂不在此处理
+        // 根据输出位控制哪些传感器数据需要上传
+        // LOGIC_OUTPUT_TOUCH:    触摸传感器 (touch)
+        // LOGIC_OUTPUT_PRESSURE: 压力传感器 (pressure)
+        // LOGIC_OUTPUT_GYRO:     陀螺仪 (gyroscope)
+        // LOGIC_OUTPUT_LIGHT:    光敏传感器 (photosensitive)
+        // LOGIC_OUTPUT_CAMERA:   摄像头 (camera) - 暂不在此处理
 
-        // 触摸传感器 (command[0])
-        if (command_str[0] == '1')
+        // 触摸传感器
+        if (outputs & LOGIC_OUTPUT_TOUCH)
         {
             sensor_data.touch = mpr121_.getCurrentTouchStatus();
         }
@@ -1684,8 +2342,8 @@ namespace app
             sensor_data.touch = 0; // 不上传，使用默认值
         }
 
-        // 压力传感器 (command[1]) - 16个点位
-        if (command_str[1] == '1')
+        // 压力传感器 - 16个点位
+        if (outputs & LOGIC_OUTPUT_PRESSURE)
         {
             app::device::m0404::PressureData pressure_data;
             if (m0404_.getLatestPressureData(pressure_data) && pressure_data.valid)
@@ -1707,8 +2365,8 @@ namespace app
             sensor_data.pressure.fill(0);
         }
 
-        // 陀螺仪 (command[2])
-        if (command_str[2] == '1')
+        // 陀螺仪
+        if (outputs & LOGIC_OUTPUT_GYRO)
         {
             device::qmi8658a::SensorData gyro_data;
             if (qmi8658a_.read(gyro_data, device::qmi8658a::READ_ALL))
@@ -1732,11 +2390,20 @@ namespace app
             sensor_data.gyroscope.z = 0.0f;
         }
 
-        // 光敏传感器 (command[3])
-        if (command_str[3] == '1')
+        // 光敏传感器
+        if (outputs & LOGIC_OUTPUT_LIGHT)
         {
-            float photosensitive = 0.0f;
-            apds9930_.readAmbientLightLux(photosensitive);
+            // 使用采集任务缓存的照度，采集任务未运行时才同步读取
+            device::apds9930::LightData light_data;
+            float                       photosensitive = 0.0f;
+            if (apds9930_.getLatestData(light_data))
+            {
+                photosensitive = light_data.lux;
+            }
+            else
+            {
+                apds9930_.readAmbientLightLux(photosensitive);
+            }
             sensor_data.photosensitive = photosensitive;
         }
         else
@@ -1749,12 +2416,12 @@ namespace app
         chatbot::message::TransportInfoMessage msg;
         msg.base.type = chatbot::message::MessageType::TRANSPORT_INFO;
         msg.base.to   = "server";
-        msg.command   = command_str;
+        msg.command   = logic::rule::toCommandString(outputs);
         msg.data      = sensor_data;
 
         if (chatbot_.sendMessage(msg))
         {
-            ESP_LOGI(TAG, "传感器数据发送成功 (command: %s)", command_str.c_str());
+            ESP_LOGI(TAG, "传感器数据发送成功 (command: %s)", msg.command.c_str());
         }
         else
         {
@@ -1762,27 +2429,6 @@ namespace app
         }
     }
 
-    std::string App::calculateAndConvertControl(const logic_config_t& config, int& zero_streak)
-    {
-        // 计算控制位
-        int control_value =
-            calculateControl(mpr121_.getCurrentTouchStatus(), m0404_.getCurrentPressureStatus(),
-                             qmi8658a_.getCurrentMotionStatus(), apds9930_.getCurrentLightStatus(),
-                             isSpeaking() ? 1 : 0, config, zero_streak, TAG);
-
-        // 转换为5位二进制字符串
-        std::string command_str(5, '0');
-        for (int i = 0; i < 5; i++)
-        {
-            if (control_value & (1 << (4 - i)))
-            {
-                command_str[i] = '1';
-            }
-        }
-
-        return command_str;
-    }
-
     bool App::captureAndSendImage()
     {
         if (!camera_.isInitialized())
@@ -1881,9 +2527,8 @@ namespace app
 
     void App::onProvisionComplete(bool success, const char* ssid)
     {
-        // 标记配网完成
-        provision_completed_ = true;
-        provision_success_   = success;
+        // 结果随事件带到 App 任务
+        postEvent(AppEventType::PROVISION_DONE, success);
 
         if (success)
         {
@@ -1909,9 +2554,16 @@ namespace app
                      msg.command[0], msg.command[1], msg.command[2], msg.command[3],
                      msg.command[4]);
 
-            // TODO: 根据控制位动态调整传感器数据上传
-            // 例如：如果摄像头控制位为'1'，则启用摄像头数据上传
-            // 如果为'0'，则停止摄像头数据上传
+            // 服务器下发的控制位编译进上传规则，对应数据始终上传（"00000" 恢复为仅按本地规则）
+            uint8_t server_outputs = 0;
+            if (logic::rule::fromCommandString(msg.command, server_outputs))
+            {
+                control_rules_.setServerOutputs(server_outputs);
+            }
+            else
+            {
+                ESP_LOGW(TAG, "控制位格式错误: %s", msg.command.c_str());
+            }
         }
         else
         {
@@ -1929,6 +2581,10 @@ namespace app
         message_receiver_.setMovInfoHandler([this](const chatbot::message::MovInfoMessage& msg)
                                             { handleMovInfoMessage(msg); });
 
+        // 设置动作片段播放消息处理
+        message_receiver_.setMovClipHandler([this](const chatbot::message::MovClipMessage& msg)
+                                            { handleMovClipMessage(msg); });
+
         // 设置音频播放消息处理
         message_receiver_.setPlayHandler([this](const chatbot::message::PlayMessage& msg)
                                          { handlePlayMessage(msg); });
@@ -1941,6 +2597,16 @@ namespace app
         message_receiver_.setErrorHandler([this](const chatbot::message::ErrorMessage& msg)
                                           { handleErrorMessage(msg); });
 
+        // 设置飞行记录器导出请求处理
+        message_receiver_.setRecorderDumpHandler(
+            [this](const chatbot::message::RecorderDumpMessage& msg)
+            { handleRecorderDumpMessage(msg); });
+
+        // 设置跟踪记录导出请求处理
+        message_receiver_.setTraceDumpHandler(
+            [this](const chatbot::message::TraceDumpMessage& msg)
+            { handleTraceDumpMessage(msg); });
+
         ESP_LOGI(TAG, "消息处理函数已设置");
     }
 
@@ -1962,19 +2628,89 @@ namespace app
 
     void App::handleMovInfoMessage(const chatbot::message::MovInfoMessage& msg)
     {
-        ESP_LOGI(TAG, "收到运动控制消息，舵机数量: %u", (unsigned int)msg.data.size());
-
-        // TODO: 实现舵机控制逻辑
-        // 这里需要：
-        // 1. 解析每个舵机的控制参数 (move_part, start_time, angle, duration)
-        // 2. 根据时间轴协调多个舵机运动
-        // 3. 调用舵机驱动API执行动作
+        TRACE_INSTANT("msg.mov_info");
+        ESP_LOGI(TAG, "收到运动控制消息，舵机数量: %u, 媒体时间: %d", (unsigned int)msg.data.size(),
+                 msg.media_time);
 
+        std::vector<move::ServoMotion> motions;
+        motions.reserve(msg.data.size());
         for (const auto& [servo_name, servo_ctrl] : msg.data)
         {
             ESP_LOGI(TAG, "  舵机: %s, 部位: %s, 起始时间: %s, 角度: %d°, 持续时间: %dms",
                      servo_name.c_str(), servo_ctrl.move_part.c_str(),
                      servo_ctrl.start_time.c_str(), servo_ctrl.angle, servo_ctrl.duration);
+
+            move::ServoMotion motion;
+            motion.move_part = servo_ctrl.move_part;
+            motion.channel   = move::mapMovePartToChannel(motion.move_part);
+            if (motion.channel == 255)
+            {
+                continue;
+            }
+            motion.start_time =
+                static_cast<uint32_t>(strtoul(servo_ctrl.start_time.c_str(), nullptr, 10));
+            motion.angle    = static_cast<uint8_t>(std::clamp(servo_ctrl.angle, 0, 180));
+            motion.duration = static_cast<uint32_t>(std::max(servo_ctrl.duration, 0));
+            motions.push_back(motion);
+        }
+
+        if (motions.empty())
+        {
+            ESP_LOGW(TAG, "运动控制消息中没有有效的动作");
+            return;
+        }
+
+        std::sort(motions.begin(), motions.end(),
+                  [](const move::ServoMotion& a, const move::ServoMotion& b)
+                  { return a.start_time < b.start_time; });
+
+        // 提交给运动引擎后立即返回，不阻塞消息处理；新片段从当前位置交叉淡化切入。
+        // 带 media_time 的片段按音频播放进度推进，与 TTS 对齐
+        auto& engine = move::engine::MotionEngine::getInstance();
+        bool  ok     = msg.media_time >= 0
+                           ? engine.submitSynced(std::move(motions),
+                                                 static_cast<uint32_t>(msg.media_time))
+                           : engine.submit(std::move(motions), move::engine::Policy::BLEND);
+        if (!ok)
+        {
+            ESP_LOGW(TAG, "提交运动序列失败");
+        }
+    }
+
+    void App::handleMovClipMessage(const chatbot::message::MovClipMessage& msg)
+    {
+        TRACE_INSTANT("msg.mov_clip");
+        ESP_LOGI(TAG, "收到动作片段消息 - id: %d, 速度: %.2f, 幅度: %.2f, 衔接: %s", msg.data.id,
+                 msg.data.speed, msg.data.scale, msg.data.policy.c_str());
+
+        move::clip::Clip clip;
+        if (msg.data.id < 0 || msg.data.id > UINT16_MAX ||
+            !motion_clips_.find(static_cast<uint16_t>(msg.data.id), clip))
+        {
+            ESP_LOGW(TAG, "未找到动作片段: %d", msg.data.id);
+            return;
+        }
+
+        move::engine::Policy policy = move::engine::Policy::MIX;
+        if (msg.data.policy == "blend")
+        {
+            policy = move::engine::Policy::BLEND;
+        }
+        else if (msg.data.policy == "queue")
+        {
+            policy = move::engine::Policy::QUEUE;
+        }
+
+        // 速度和幅度转换为 Q8，超出范围由 expand() 限制
+        auto toQ8 = [](double value)
+        { return static_cast<int32_t>(std::clamp(value, 0.0, 16.0) * move::timeline::Q8_ONE); };
+
+        std::vector<move::ServoMotion> motions;
+        move::clip::ClipLibrary::expand(clip, toQ8(msg.data.speed), toQ8(msg.data.scale),
+                                        motions);
+        if (!move::engine::MotionEngine::getInstance().submit(std::move(motions), policy))
+        {
+            ESP_LOGW(TAG, "提交动作片段失败: %s", clip.name);
         }
     }
 
@@ -1982,6 +2718,10 @@ namespace app
     {
         ESP_LOGI(TAG, "收到音频播放请求消息");
 
+        // 新的音频流：媒体时间从流的第一个采样开始计，mov_info 的 media_time 以此为零点
+        media::clock::MediaClock::getInstance().start(audio_.getOutputSampleRate(),
+                                                      audio_.getOutputLatencySamples());
+
         // TODO: 实现音频播放逻辑
         // 这里需要：
         // 1. 准备接收音频数据流
@@ -2005,8 +2745,24 @@ namespace app
 
         ESP_LOGI(TAG, "机器人情绪反馈: %s", emotion_desc.c_str());
 
+        // LED 淡入对应的情绪颜色；平淡和未知的情绪淡出，恢复原来的颜色
+        const std::map<std::string, device::led::Color> emotion_colors = {
+            {"0", device::led::Color(255, 160, 0)}, {"1", device::led::Color(0, 60, 255)},
+            {"2", device::led::Color(255, 0, 0)},   {"4", device::led::Color(120, 0, 255)},
+            {"5", device::led::Color(0, 220, 255)}};
+
+        auto color_it = emotion_colors.find(msg.data.code);
+        if (color_it != emotion_colors.end())
+        {
+            led_.setEmotionColor(app::config::LED_GPIO, color_it->second);
+        }
+        else
+        {
+            led_.clearEmotionColor();
+        }
+
         // TODO: 根据情绪反馈调整机器人的行为或表情
-        // 例如：开心时播放欢快音乐，生气时改变LED颜色等
+        // 例如：开心时播放欢快音乐等
     }
 
     void App::handleErrorMessage(const chatbot::message::ErrorMessage& msg)
@@ -2025,4 +2781,123 @@ namespace app
         }
     }
 
+    void App::handleRecorderDumpMessage(const chatbot::message::RecorderDumpMessage& msg)
+    {
+        (void)msg;
+        ESP_LOGI(TAG, "收到飞行记录器导出请求");
+
+        // 接收回调运行在 WebSocket 任务中，导出交给主循环执行
+        recorder_dump_pending_.store(true, std::memory_order_release);
+        postEvent(AppEventType::RECORDER_DUMP);
+    }
+
+    namespace
+    {
+        /**
+         * @brief 上传导出数据：先发送导出消息告知记录数和数据长度，再以二进制帧发送导出数据
+         * @param client WebSocket 客户端
+         * @param source 导出来源（提供 dump(writer, on_begin)）
+         * @param type 导出消息类型
+         * @param name 日志中的数据名称
+         * @return true 全部发送成功
+         */
+        template <typename DumpMessage, typename Source>
+        bool sendDump(chatbot::Chatbot& client, Source& source,
+                      chatbot::message::MessageType type, const char* name)
+        {
+            return source.dump(
+                [&client](const uint8_t* data, size_t len) { return client.sendBinary(data, len); },
+                [&client, type, name](uint32_t records, size_t length)
+                {
+                    DumpMessage reply;
+                    reply.base.type    = type;
+                    reply.base.to      = "server";
+                    reply.data.records = records;
+                    reply.data.length  = static_cast<uint32_t>(length);
+
+                    ESP_LOGI(TAG, "开始发送%s数据: %lu 条记录, %u 字节", name,
+                             (unsigned long)records, (unsigned int)length);
+                    return client.sendMessage(reply);
+                });
+        }
+    } // namespace
+
+    bool App::sendRecorderDump()
+    {
+        auto& recorder = tool::recorder::Recorder::getInstance();
+        if (!recorder.isInitialized())
+        {
+            ESP_LOGW(TAG, "飞行记录器未初始化，无法导出");
+            return false;
+        }
+
+        return sendDump<chatbot::message::RecorderDumpMessage>(
+            chatbot_, recorder, chatbot::message::MessageType::RECORDER_DUMP, "飞行记录器");
+    }
+
+    void App::handleTraceDumpMessage(const chatbot::message::TraceDumpMessage& msg)
+    {
+        (void)msg;
+        ESP_LOGI(TAG, "收到跟踪记录导出请求");
+
+        trace_dump_pending_.store(true, std::memory_order_release);
+        postEvent(AppEventType::TRACE_DUMP);
+    }
+
+    bool App::sendTraceDump()
+    {
+        auto& tracer = tool::trace::Tracer::getInstance();
+        if (!tracer.isInitialized())
+        {
+            ESP_LOGW(TAG, "跟踪未启用（CONFIG_TRACE_ENABLE），无法导出");
+            return false;
+        }
+
+        return sendDump<chatbot::message::TraceDumpMessage>(
+            chatbot_, tracer, chatbot::message::MessageType::TRACE_DUMP, "跟踪");
+    }
+
+    bool App::sendCpuInfo()
+    {
+        namespace profiler = sys::task::profiler;
+
+        auto& cpu = profiler::CpuProfiler::getInstance();
+        if (!cpu.isRunning())
+        {
+            return false;
+        }
+
+        chatbot::message::CpuInfoMessage msg;
+        msg.base.type      = chatbot::message::MessageType::CPU_INFO;
+        msg.base.to        = "server";
+        msg.data.period_ms = cpu.getPeriodMs();
+        for (size_t w = 0; w < profiler::WINDOW_COUNT; w++)
+        {
+            msg.data.windows[w] = static_cast<int>(profiler::WINDOW_SAMPLES[w]);
+        }
+
+        for (const auto& load : cpu.getCoreLoads())
+        {
+            chatbot::message::CpuCoreLoad core;
+            core.core = load.core;
+            core.peak = load.peak;
+            std::copy(std::begin(load.percent), std::end(load.percent), core.load.begin());
+            msg.data.cores.push_back(core);
+        }
+
+        // 按中窗口排序，只上报占用最高的几个任务
+        for (const auto& load :
+             cpu.getTaskLoads(profiler::Window::MEDIUM, profiler::REPORT_TOP_TASKS))
+        {
+            chatbot::message::CpuTaskLoad task;
+            task.name     = load.name;
+            task.core     = load.core == tskNO_AFFINITY ? -1 : static_cast<int>(load.core);
+            task.priority = static_cast<int>(load.priority);
+            std::copy(std::begin(load.percent), std::end(load.percent), task.load.begin());
+            msg.data.tasks.push_back(task);
+        }
+
+        return chatbot_.sendMessage(msg);
+    }
+
 } // namespace app
@@ -5,6 +5,7 @@
 #include "chatbot/handle/sender.hpp"
 #include "chatbot/handle/receiver.hpp"
 #include "i2c/i2c.hpp"
+#include "i2c/scheduler/scheduler.hpp"
 #include "device/qmi8658a/qmi8658a.hpp"
 #include "device/apds9930/apds9930.hpp"
 #include "device/mpr121/mpr121.hpp"
@@ -17,6 +18,12 @@
 #include "media/camera/camera.hpp"
 #include "network/network.hpp"
 #include "logic/logic.h"
+#include "logic/rule/rule.hpp"
+#include "logic/presence/presence.hpp"
+#include "move/clip/clip.hpp"
+#include "system/timer/timer.hpp"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include <atomic>
 #include <memory>
 #include <string>
@@ -38,6 +45,40 @@ namespace app
         RECOVERY       // 恢复中
     };
 
+    /**
+     * @brief 主循环事件类型
+     */
+    enum class AppEventType : uint8_t
+    {
+        STATE_TIMEOUT,     // 状态超时定时器到期
+        RETRY,             // 重试定时器到期（连接退避、初始化重试）
+        SENSOR_TICK,       // 传感器数据上传周期
+        IMAGE_TICK,        // 图片上传周期
+        LOG_TICK,          // 系统信息打印周期
+        PRESENCE_TICK,     // 在场保持时间检查周期
+        PRESENCE_DETECTED, // 检测到有人
+        PROVISION_DONE,    // 配网结束（success 为结果）
+        NTP_DONE,          // NTP同步结束（success 为结果）
+        WS_CONNECTED,      // WebSocket 已连接
+        WS_DISCONNECTED,   // WebSocket 已断开
+        WAKEWORD,          // 检测到唤醒词
+        RECORDER_DUMP,     // 服务器请求导出飞行记录器
+        CPU_TICK,          // CPU 占用上报周期
+        TRACE_DUMP         // 服务器请求导出跟踪记录
+    };
+
+    /**
+     * @brief 主循环事件（按值拷贝进队列）
+     */
+    struct AppEvent
+    {
+        AppEventType type;
+        bool         success; // PROVISION_DONE / NTP_DONE 的结果
+        int64_t      time_us; // 投递时间，用于统计投递到处理的延迟
+    };
+
+    constexpr size_t APP_EVENT_QUEUE_LEN = 32; // 主循环事件队列长度
+
     class App
     {
     public:
@@ -56,7 +97,7 @@ namespace app
         bool setup();
 
         /**
-         * @brief 主运行循环（状态机驱动）
+         * @brief 主运行循环（事件驱动的状态机）
          */
         void run();
 
@@ -88,11 +129,15 @@ namespace app
         }
 
         /**
-         * @brief 检查当前状态是否超时
-         * @param timeout_ms 超时时间（毫秒）
-         * @return true=超时, false=未超时
+         * @brief 检查当前状态是否超时（收到 STATE_TIMEOUT 事件时调用）
+         * @return true=超时, false=未超时（重新计时前投递的事件）
          */
-        bool isStateTimeout(int timeout_ms) const;
+        bool isStateTimedOut() const;
+
+        /**
+         * @brief 重新开始当前状态的计时（重试时调用）
+         */
+        void restartStateTimer();
 
         /**
          * @brief 重置重试计数
@@ -102,15 +147,40 @@ namespace app
             retry_count_ = 0;
         }
 
+        /**
+         * @brief 进入状态时的动作（启动该状态的定时器、检查进入前已满足的条件）
+         * @param state 新状态
+         */
+        void enterState(DeviceState state);
+
+        /**
+         * @brief 离开状态时的动作（停止只属于该状态的定时器）
+         * @param state 旧状态
+         */
+        void exitState(DeviceState state);
+
+        void startRetryTimer(); // 按重试次数开始指数退避（1s, 2s, 4s...）
+
+        // ==================== 事件处理 ====================
+        bool initEventLoop();                                   // 创建事件队列和主循环定时器
+        bool postEvent(AppEventType type, bool success = true); // 投递事件（任意任务可调用）
+        void dispatchEvent(const AppEvent& event);              // 按当前状态处理事件
+
         // ==================== 状态处理函数 ====================
-        void handleInitState();         // 处理初始化状态
-        void handleProvisioningState(); // 处理配网状态
-        void handleNtpSyncState();      // 处理NTP同步状态
-        void handleConnectingState();   // 处理WebSocket连接状态
-        void handleWakewordWaitState(); // 处理唤醒词等待状态
-        void handleRunningState();      // 处理正常运行状态
-        void handleErrorState();        // 处理错误状态
-        void handleRecoveryState();     // 处理恢复状态
+        void handleInitState();                              // 初始化（run() 开始时执行）
+        void handleProvisioningEvent(const AppEvent& event); // 处理配网状态的事件
+        void handleNtpSyncEvent(const AppEvent& event);      // 处理NTP同步状态的事件
+        void handleConnectingEvent(const AppEvent& event);   // 处理WebSocket连接状态的事件
+        void handleWakewordWaitEvent(const AppEvent& event); // 处理唤醒词等待状态的事件
+        void handleRunningEvent(const AppEvent& event);      // 处理正常运行状态的事件
+
+        void checkProvisionResult(bool success); // 按配网结果进入NTP同步或重试
+        void checkNtpSyncResult(bool success);   // NTP同步结束后进入连接状态
+        void tryConnect();                       // 初始化Chatbot并尝试连接（退避期间不尝试）
+        void onConnectTimeout();                 // 连接确认超时，退避后重试
+        void checkWakeword();                    // 准备唤醒词检测，失败时稍后重试
+        bool prepareWakeword();                  // 初始化音频、AFE 和唤醒词检测
+        void reconnect();                        // 运行中断线重连（指数退避）
 
         // ==================== 初始化方法 ====================
         bool initNVS();                                                // 初始化NVS
@@ -120,6 +190,7 @@ namespace app
         bool initQMI8658A(i2c_master_bus_handle_t i2c_handle);         // 初始化QMI8658A
         bool initAPDS9930(i2c_master_bus_handle_t i2c_handle);         // 初始化 APDS-9930
         bool initMPR121(i2c_master_bus_handle_t i2c_handle);           // 初始化 MPR121 触摸传感器
+        bool initMove(i2c_master_bus_handle_t i2c_handle);             // 初始化舵机驱动和运动引擎
         bool initM0404(uart_port_t uart_num, gpio_num_t tx_pin, gpio_num_t rx_pin,
                        int baud_rate = 115200); // 初始化 M0404 压力传感器
         bool initProvision();                   // 初始化配网管理器
@@ -140,11 +211,22 @@ namespace app
         bool startWakeWord();                                // 启动唤醒词检测
         void stopWakeWord();                                 // 停止唤醒词检测
 
+        // ==================== 在场预热 ====================
+        /**
+         * @brief 报告在场证据（可在各传感器任务中调用）
+         * @param source 来源
+         * @param active 是否有效
+         */
+        void reportPresence(logic::presence::Source source, bool active);
+
+        void updatePrewarm();              // 按在场状态预热或冷却（主循环调用）
+        void prewarm();                    // 预热：打开音频输出、启动摄像头流、跳过重连退避
+        void cooldown();                   // 冷却：关闭音频输出、停止摄像头流
+        bool isConversationActive() const; // 运行中用户正在说话或回复正在播放
+
         // ==================== 数据上传 ====================
-        void collectAndSendSensorData(const std::string& command_str); // 采集并发送传感器数据
-        std::string calculateAndConvertControl(const logic_config_t& config,
-                                               int& zero_streak); // 计算控制位并转换
-        bool        captureAndSendImage();                        // 捕获并发送图片
+        void collectAndSendSensorData(uint8_t outputs); // 采集并发送传感器数据（输出位见 logic.h）
+        bool captureAndSendImage();                     // 捕获并发送图片
 
         // ==================== 消息处理 ====================
         void setupMessageHandlers(); // 设置消息处理函数
@@ -153,9 +235,15 @@ namespace app
         // 消息处理函数
         void handleRecvInfoMessage(const chatbot::message::RecvInfoMessage& msg);
         void handleMovInfoMessage(const chatbot::message::MovInfoMessage& msg);
+        void handleMovClipMessage(const chatbot::message::MovClipMessage& msg);
         void handlePlayMessage(const chatbot::message::PlayMessage& msg);
         void handleEmotionMessage(const chatbot::message::EmotionMessage& msg);
         void handleErrorMessage(const chatbot::message::ErrorMessage& msg);
+        void handleRecorderDumpMessage(const chatbot::message::RecorderDumpMessage& msg);
+        void handleTraceDumpMessage(const chatbot::message::TraceDumpMessage& msg);
+        bool sendRecorderDump(); // 发送飞行记录器导出数据
+        bool sendTraceDump();    // 发送跟踪记录导出数据
+        bool sendCpuInfo();      // 发送 CPU 占用统计
 
         /**
          * @brief 检查当前是否检测到语音
@@ -173,11 +261,15 @@ namespace app
         void logSystemInfo();
 
         void logMemoryInfo();   // 打印内存信息
+        void logCpuInfo();      // 打印各核心 CPU 占用
         void logWiFiInfo();     // 打印 WiFi 信息
+        void logI2CInfo();      // 打印 I2C 总线统计
+        void logRecorderInfo(); // 打印飞行记录器统计
         void logQMI8658AInfo(); // 打印 QMI8658A 信息
         void logAPDS9930Info(); // 打印 APDS-9930 信息
         void logMPR121Info();   // 打印 MPR121 信息
         void logM0404Info();    // 打印 M0404 信息
+        void logMoveInfo();     // 打印运动引擎统计
 
         // ==================== 回调方法 ====================
         void onProvisionStatus(app::network::ProvisionStatus status); // 配网状态回调
@@ -206,26 +298,48 @@ namespace app
         // VAD 状态
         std::atomic<bool> is_speaking_{false};
 
-        // 唤醒词检测
-        std::unique_ptr<media::audio::wakeword::WakeWord> wakeword_;
+        // 上传控制规则（传感器状态变化时更新）
+        logic::rule::RuleEngine control_rules_;
 
-        // 配网状态
-        bool provision_completed_{false}; // 配网是否完成
-        bool provision_success_{false};   // 配网是否成功
+        // 预置动作片段（数据在 assets 分区中，initMove 时加载）
+        move::clip::ClipLibrary motion_clips_;
 
-        // NTP同步状态
-        bool ntp_sync_completed_{false}; // NTP同步是否完成
-        bool ntp_sync_success_{false};   // NTP同步是否成功
+        // 在场检测（传感器状态变化时更新，主循环据此预热或冷却）
+        logic::presence::PresenceDetector presence_;
 
-        // WebSocket连接状态
-        bool    chatbot_initialized_{false};   // Chatbot是否已初始化
-        int64_t last_connect_attempt_time_{0}; // 上次连接尝试时间（微秒）
+        // 是否处于预热状态（初始化后各子系统处于冷状态，有人靠近时才预热）
+        bool prewarmed_{false};
 
-        // 唤醒词检测状态
-        bool wakeword_detected_{false}; // 是否检测到唤醒词
+        // 唤醒词检测
+        std::unique_ptr<media::audio::wakeword::WakeWord> wakeword_;
+
+        // WebSocket连接状态
+        bool chatbot_initialized_{false}; // Chatbot是否已初始化
 
         // 音频上传状态
         bool listen_message_sent_{false}; // 是否已发送过 listen 消息
+
+        // 飞行记录器和跟踪记录导出请求（置位期间暂停音频上传）
+        std::atomic<bool> recorder_dump_pending_{false};
+        std::atomic<bool> trace_dump_pending_{false};
+
+        // 唤醒词检测时间（微秒），开始上传音频时输出延迟并清零
+        std::atomic<int64_t> wake_time_us_{0};
+
+        // 主循环事件队列（回调只投递事件，状态转换都在主循环中执行）
+        QueueHandle_t         event_queue_{nullptr};
+        std::atomic<uint32_t> dropped_events_{0};      // 队列满时丢弃的事件数
+        const AppEvent*       current_event_{nullptr}; // 正在处理的事件（记录转换延迟）
+
+        // 主循环定时器（到期时投递对应事件）
+        sys::timer::TimerWheel timers_;
+        sys::timer::Timer      state_timer_;    // 状态超时
+        sys::timer::Timer      sensor_timer_;   // 传感器数据上传（RUNNING，1 秒）
+        sys::timer::Timer      image_timer_;    // 图片上传（RUNNING，5 秒）
+        sys::timer::Timer      log_timer_;      // 系统信息打印（RUNNING，5 秒）
+        sys::timer::Timer      cpu_timer_;      // CPU 占用上报（RUNNING，见 Kconfig）
+        sys::timer::Timer      presence_timer_; // 在场保持时间检查（1 秒）
+        sys::timer::Timer      retry_timer_;    // 重试退避，运行期间不尝试
     };
 
 } // namespace app
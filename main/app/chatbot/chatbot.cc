@@ -179,6 +179,36 @@ namespace app
                 msg_ptr          = msg_copy.get();
                 break;
             }
+            case message::MessageType::RECORDER_DUMP:
+            {
+                const auto& src  = static_cast<const message::RecorderDumpMessage&>(msg);
+                auto        copy = std::make_unique<message::RecorderDumpMessage>();
+                copy->base       = src.base;
+                copy->data       = src.data;
+                msg_copy         = std::move(copy);
+                msg_ptr          = msg_copy.get();
+                break;
+            }
+            case message::MessageType::CPU_INFO:
+            {
+                const auto& src  = static_cast<const message::CpuInfoMessage&>(msg);
+                auto        copy = std::make_unique<message::CpuInfoMessage>();
+                copy->base       = src.base;
+                copy->data       = src.data;
+                msg_copy         = std::move(copy);
+                msg_ptr          = msg_copy.get();
+                break;
+            }
+            case message::MessageType::TRACE_DUMP:
+            {
+                const auto& src  = static_cast<const message::TraceDumpMessage&>(msg);
+                auto        copy = std::make_unique<message::TraceDumpMessage>();
+                copy->base       = src.base;
+                copy->data       = src.data;
+                msg_copy         = std::move(copy);
+                msg_ptr          = msg_copy.get();
+                break;
+            }
             default:
                 ESP_LOGE(TAG, "设备不支持发送此消息类型: %d", static_cast<int>(type));
                 return false;
@@ -277,6 +307,11 @@ namespace app
             receive_callback_ = std::move(callback);
         }
 
+        void Chatbot::setConnectionCallback(ConnectionCallback&& callback)
+        {
+            connection_callback_ = std::move(callback);
+        }
+
         std::string Chatbot::getDeviceMacAddress() const
         {
             return app::chatbot::message::getDeviceMacAddress();
@@ -285,13 +320,19 @@ namespace app
         void Chatbot::onWebSocketConnected()
         {
             ESP_LOGI(TAG, "WebSocket 已连接到服务器");
-            // 可以在这里发送初始消息，如设备信息等
+            if (connection_callback_)
+            {
+                connection_callback_(true);
+            }
         }
 
         void Chatbot::onWebSocketDisconnected()
         {
             ESP_LOGW(TAG, "WebSocket 已断开连接");
-            // 可以在这里实现重连逻辑（如果WebSocket客户端未自动重连）
+            if (connection_callback_)
+            {
+                connection_callback_(false);
+            }
         }
 
         void Chatbot::onWebSocketData(const protocol::websocket::DataEvent& event)
@@ -136,6 +136,15 @@ namespace app
              */
             using ReceiveCallback = std::function<bool(const std::string& json_str)>;
 
+            /**
+             * @brief 连接状态回调函数类型
+             *
+             * 在 WebSocket 事件任务中调用，应尽快返回（例如只投递事件）。
+             *
+             * @param connected true 已连接, false 已断开
+             */
+            using ConnectionCallback = std::function<void(bool connected)>;
+
             /**
              * @brief 设置发送回调
              * @param callback 发送回调函数
@@ -148,6 +157,12 @@ namespace app
              */
             void setReceiveCallback(ReceiveCallback&& callback);
 
+            /**
+             * @brief 设置连接状态回调
+             * @param callback 连接状态回调函数
+             */
+            void setConnectionCallback(ConnectionCallback&& callback);
+
         private:
             /**
              * @brief WebSocket连接成功回调
@@ -171,11 +186,12 @@ namespace app
              */
             void onWebSocketError(const protocol::websocket::ErrorEvent& event);
 
-            SendCallback                          send_callback_;    // 发送回调
-            ReceiveCallback                       receive_callback_; // 接收回调
-            protocol::websocket::WebSocketClient* ws_client_;        // WebSocket客户端指针
-            Config                                config_;           // 配置信息
-            bool                                  initialized_;      // 是否已初始化
+            SendCallback                          send_callback_;       // 发送回调
+            ReceiveCallback                       receive_callback_;    // 接收回调
+            ConnectionCallback                    connection_callback_; // 连接状态回调
+            protocol::websocket::WebSocketClient* ws_client_;           // WebSocket客户端指针
+            Config                                config_;              // 配置信息
+            bool                                  initialized_;         // 是否已初始化
         };
 
     } // namespace chatbot
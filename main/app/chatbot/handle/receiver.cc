@@ -59,6 +59,20 @@ namespace app
                     break;
                 }
 
+                case MessageType::MOV_CLIP:
+                {
+                    auto* clip_msg = dynamic_cast<MovClipMessage*>(msg.get());
+                    if (clip_msg && mov_clip_handler_)
+                    {
+                        mov_clip_handler_(*clip_msg);
+                    }
+                    else if (!mov_clip_handler_)
+                    {
+                        ESP_LOGW(TAG, "mov_clip 处理函数未设置");
+                    }
+                    break;
+                }
+
                 case MessageType::PLAY:
                 {
                     auto* play_msg = dynamic_cast<PlayMessage*>(msg.get());
@@ -101,6 +115,34 @@ namespace app
                     break;
                 }
 
+                case MessageType::RECORDER_DUMP:
+                {
+                    auto* dump_msg = dynamic_cast<RecorderDumpMessage*>(msg.get());
+                    if (dump_msg && recorder_dump_handler_)
+                    {
+                        recorder_dump_handler_(*dump_msg);
+                    }
+                    else if (!recorder_dump_handler_)
+                    {
+                        ESP_LOGW(TAG, "recorder_dump 处理函数未设置");
+                    }
+                    break;
+                }
+
+                case MessageType::TRACE_DUMP:
+                {
+                    auto* dump_msg = dynamic_cast<TraceDumpMessage*>(msg.get());
+                    if (dump_msg && trace_dump_handler_)
+                    {
+                        trace_dump_handler_(*dump_msg);
+                    }
+                    else if (!trace_dump_handler_)
+                    {
+                        ESP_LOGW(TAG, "trace_dump 处理函数未设置");
+                    }
+                    break;
+                }
+
                 default:
                     ESP_LOGW(TAG, "未知的消息类型: %d", static_cast<int>(type));
                     return false;
@@ -23,11 +23,15 @@ namespace app
                 /**
                  * @brief 各类型消息的处理函数类型
                  */
-                using RecvInfoHandler = std::function<void(const message::RecvInfoMessage&)>;
-                using MovInfoHandler  = std::function<void(const message::MovInfoMessage&)>;
-                using PlayHandler     = std::function<void(const message::PlayMessage&)>;
-                using EmotionHandler  = std::function<void(const message::EmotionMessage&)>;
-                using ErrorHandler    = std::function<void(const message::ErrorMessage&)>;
+                using RecvInfoHandler     = std::function<void(const message::RecvInfoMessage&)>;
+                using MovInfoHandler      = std::function<void(const message::MovInfoMessage&)>;
+                using MovClipHandler      = std::function<void(const message::MovClipMessage&)>;
+                using PlayHandler         = std::function<void(const message::PlayMessage&)>;
+                using EmotionHandler      = std::function<void(const message::EmotionMessage&)>;
+                using ErrorHandler        = std::function<void(const message::ErrorMessage&)>;
+                using RecorderDumpHandler =
+                    std::function<void(const message::RecorderDumpMessage&)>;
+                using TraceDumpHandler    = std::function<void(const message::TraceDumpMessage&)>;
 
                 /**
                  * @brief 构造函数
@@ -47,6 +51,11 @@ namespace app
                     mov_info_handler_ = std::move(handler);
                 }
 
+                void setMovClipHandler(MovClipHandler&& handler)
+                {
+                    mov_clip_handler_ = std::move(handler);
+                }
+
                 void setPlayHandler(PlayHandler&& handler)
                 {
                     play_handler_ = std::move(handler);
@@ -62,6 +71,16 @@ namespace app
                     error_handler_ = std::move(handler);
                 }
 
+                void setRecorderDumpHandler(RecorderDumpHandler&& handler)
+                {
+                    recorder_dump_handler_ = std::move(handler);
+                }
+
+                void setTraceDumpHandler(TraceDumpHandler&& handler)
+                {
+                    trace_dump_handler_ = std::move(handler);
+                }
+
                 /**
                  * @brief 处理接收到的JSON消息
                  *
@@ -73,11 +92,14 @@ namespace app
                 bool handleMessage(const std::string& json_str);
 
             private:
-                RecvInfoHandler recv_info_handler_;
-                MovInfoHandler  mov_info_handler_;
-                PlayHandler     play_handler_;
-                EmotionHandler  emotion_handler_;
-                ErrorHandler    error_handler_;
+                RecvInfoHandler     recv_info_handler_;
+                MovInfoHandler      mov_info_handler_;
+                MovClipHandler      mov_clip_handler_;
+                PlayHandler         play_handler_;
+                EmotionHandler      emotion_handler_;
+                ErrorHandler        error_handler_;
+                RecorderDumpHandler recorder_dump_handler_;
+                TraceDumpHandler    trace_dump_handler_;
             };
 
         } // namespace handle
@@ -1,5 +1,6 @@
 #include "message.hpp"
 
+#include <cmath>
 #include <cstring>
 
 #include "esp_log.h"
@@ -317,6 +318,10 @@ namespace app
                     cJSON_AddItemToObject(data_obj, servo_name.c_str(), servo_obj);
                 }
                 cJSON_AddItemToObject(json.get(), "data", data_obj);
+                if (media_time >= 0)
+                {
+                    cJSON_AddNumberToObject(json.get(), "media_time", media_time);
+                }
 
                 JsonStringRAII json_str(cJSON_Print(json.get()));
                 if (!json_str.get())
@@ -420,6 +425,105 @@ namespace app
                     return false;
                 }
 
+                // 可选：与音频同步
+                media_time             = -1;
+                cJSON* media_time_item = cJSON_GetObjectItem(root.get(), "media_time");
+                if (media_time_item && cJSON_IsNumber(media_time_item))
+                {
+                    media_time = (int)cJSON_GetNumberValue(media_time_item);
+                }
+
+                return true;
+            }
+
+            // ========== MovClipMessage 实现 ==========
+
+            std::string MovClipMessage::toJson() const
+            {
+                using namespace app::tool::ota;
+                JsonRAII json;
+
+                // 基础字段
+                cJSON_AddStringToObject(json.get(), "type", messageTypeToString(base.type));
+                cJSON_AddStringToObject(json.get(), "from", base.from.c_str());
+                cJSON_AddStringToObject(json.get(), "to", base.to.c_str());
+                cJSON_AddStringToObject(json.get(), "timestamp", base.timestamp.c_str());
+
+                // data 对象
+                cJSON* data_obj = cJSON_CreateObject();
+                cJSON_AddNumberToObject(data_obj, "id", data.id);
+                cJSON_AddNumberToObject(data_obj, "speed", data.speed);
+                cJSON_AddNumberToObject(data_obj, "scale", data.scale);
+                cJSON_AddStringToObject(data_obj, "policy", data.policy.c_str());
+                cJSON_AddItemToObject(json.get(), "data", data_obj);
+
+                JsonStringRAII json_str(cJSON_Print(json.get()));
+                if (!json_str.get())
+                {
+                    ESP_LOGE(TAG, "构建 mov_clip 消息失败");
+                    return "";
+                }
+
+                return std::string(json_str.get());
+            }
+
+            bool MovClipMessage::fromJson(const std::string& json_str)
+            {
+                using namespace app::tool::ota;
+                JsonRAII root(json_str.c_str());
+                if (!root.get())
+                {
+                    ESP_LOGE(TAG, "JSON 解析失败: %s", cJSON_GetErrorPtr());
+                    return false;
+                }
+
+                // 解析基础字段
+                if (!MessageFactory::parseBase(root.get(), base))
+                {
+                    return false;
+                }
+
+                // 验证类型
+                if (base.type != MessageType::MOV_CLIP)
+                {
+                    ESP_LOGE(TAG, "消息类型不匹配");
+                    return false;
+                }
+
+                // 解析 data 对象（只有 id 是必需的）
+                cJSON* data_obj = cJSON_GetObjectItem(root.get(), "data");
+                if (!data_obj || !cJSON_IsObject(data_obj))
+                {
+                    ESP_LOGE(TAG, "缺少 data 字段或类型错误");
+                    return false;
+                }
+
+                cJSON* id_item = cJSON_GetObjectItem(data_obj, "id");
+                if (!id_item || !cJSON_IsNumber(id_item))
+                {
+                    ESP_LOGE(TAG, "缺少 id 字段或类型错误");
+                    return false;
+                }
+                data.id = (int)cJSON_GetNumberValue(id_item);
+
+                cJSON* speed_item = cJSON_GetObjectItem(data_obj, "speed");
+                if (speed_item && cJSON_IsNumber(speed_item))
+                {
+                    data.speed = cJSON_GetNumberValue(speed_item);
+                }
+
+                cJSON* scale_item = cJSON_GetObjectItem(data_obj, "scale");
+                if (scale_item && cJSON_IsNumber(scale_item))
+                {
+                    data.scale = cJSON_GetNumberValue(scale_item);
+                }
+
+                cJSON* policy_item = cJSON_GetObjectItem(data_obj, "policy");
+                if (policy_item && cJSON_IsString(policy_item))
+                {
+                    data.policy = cJSON_GetStringValue(policy_item);
+                }
+
                 return true;
             }
 
@@ -662,6 +766,337 @@ namespace app
                 return true;
             }
 
+            // ========== RecorderDumpMessage 实现 ==========
+
+            std::string RecorderDumpMessage::toJson() const
+            {
+                using namespace app::tool::ota;
+                JsonRAII json;
+
+                // 基础字段
+                cJSON_AddStringToObject(json.get(), "type", messageTypeToString(base.type));
+                cJSON_AddStringToObject(json.get(), "from", base.from.c_str());
+                cJSON_AddStringToObject(json.get(), "to", base.to.c_str());
+                cJSON_AddStringToObject(json.get(), "timestamp", base.timestamp.c_str());
+
+                // data 对象
+                cJSON* data_obj = cJSON_CreateObject();
+                cJSON_AddNumberToObject(data_obj, "records", data.records);
+                cJSON_AddNumberToObject(data_obj, "length", data.length);
+                cJSON_AddItemToObject(json.get(), "data", data_obj);
+
+                JsonStringRAII json_str(cJSON_Print(json.get()));
+                if (!json_str.get())
+                {
+                    ESP_LOGE(TAG, "构建 recorder_dump 消息失败");
+                    return "";
+                }
+
+                return std::string(json_str.get());
+            }
+
+            bool RecorderDumpMessage::fromJson(const std::string& json_str)
+            {
+                using namespace app::tool::ota;
+                JsonRAII root(json_str.c_str());
+                if (!root.get())
+                {
+                    ESP_LOGE(TAG, "JSON 解析失败: %s", cJSON_GetErrorPtr());
+                    return false;
+                }
+
+                // 解析基础字段
+                if (!MessageFactory::parseBase(root.get(), base))
+                {
+                    return false;
+                }
+
+                // 验证类型
+                if (base.type != MessageType::RECORDER_DUMP)
+                {
+                    ESP_LOGE(TAG, "消息类型不匹配");
+                    return false;
+                }
+
+                // 解析 data 对象（请求中可省略）
+                cJSON* data_obj = cJSON_GetObjectItem(root.get(), "data");
+                if (data_obj && cJSON_IsObject(data_obj))
+                {
+                    cJSON* records_item = cJSON_GetObjectItem(data_obj, "records");
+                    if (records_item && cJSON_IsNumber(records_item))
+                    {
+                        data.records = static_cast<uint32_t>(cJSON_GetNumberValue(records_item));
+                    }
+
+                    cJSON* length_item = cJSON_GetObjectItem(data_obj, "length");
+                    if (length_item && cJSON_IsNumber(length_item))
+                    {
+                        data.length = static_cast<uint32_t>(cJSON_GetNumberValue(length_item));
+                    }
+                }
+
+                return true;
+            }
+
+            // ========== CpuInfoMessage 实现 ==========
+
+            namespace
+            {
+                // 占用保留一位小数，避免 float 转 double 后输出多余的位数
+                double roundLoad(float value)
+                {
+                    return std::round(static_cast<double>(value) * 10.0) / 10.0;
+                }
+
+                cJSON* createLoadArray(const std::array<float, 3>& load)
+                {
+                    cJSON* array = cJSON_CreateArray();
+                    for (float value : load)
+                    {
+                        cJSON_AddItemToArray(array, cJSON_CreateNumber(roundLoad(value)));
+                    }
+                    return array;
+                }
+
+                void parseLoadArray(cJSON* array, std::array<float, 3>& load)
+                {
+                    if (!array || !cJSON_IsArray(array))
+                    {
+                        return;
+                    }
+                    int size = cJSON_GetArraySize(array);
+                    for (int i = 0; i < size && i < 3; i++)
+                    {
+                        cJSON* elem = cJSON_GetArrayItem(array, i);
+                        if (elem && cJSON_IsNumber(elem))
+                        {
+                            load[i] = static_cast<float>(cJSON_GetNumberValue(elem));
+                        }
+                    }
+                }
+            } // namespace
+
+            std::string CpuInfoMessage::toJson() const
+            {
+                using namespace app::tool::ota;
+                JsonRAII json;
+
+                // 基础字段
+                cJSON_AddStringToObject(json.get(), "type", messageTypeToString(base.type));
+                cJSON_AddStringToObject(json.get(), "from", base.from.c_str());
+                cJSON_AddStringToObject(json.get(), "to", base.to.c_str());
+                cJSON_AddStringToObject(json.get(), "timestamp", base.timestamp.c_str());
+
+                // data 对象
+                cJSON* data_obj = cJSON_CreateObject();
+                cJSON_AddNumberToObject(data_obj, "period_ms", data.period_ms);
+                cJSON_AddItemToObject(data_obj, "windows",
+                                      cJSON_CreateIntArray(data.windows.data(), 3));
+
+                cJSON* cores_array = cJSON_CreateArray();
+                for (const CpuCoreLoad& core : data.cores)
+                {
+                    cJSON* core_obj = cJSON_CreateObject();
+                    cJSON_AddNumberToObject(core_obj, "core", core.core);
+                    cJSON_AddItemToObject(core_obj, "load", createLoadArray(core.load));
+                    cJSON_AddNumberToObject(core_obj, "peak", roundLoad(core.peak));
+                    cJSON_AddItemToArray(cores_array, core_obj);
+                }
+                cJSON_AddItemToObject(data_obj, "cores", cores_array);
+
+                cJSON* tasks_array = cJSON_CreateArray();
+                for (const CpuTaskLoad& task : data.tasks)
+                {
+                    cJSON* task_obj = cJSON_CreateObject();
+                    cJSON_AddStringToObject(task_obj, "name", task.name.c_str());
+                    cJSON_AddNumberToObject(task_obj, "core", task.core);
+                    cJSON_AddNumberToObject(task_obj, "priority", task.priority);
+                    cJSON_AddItemToObject(task_obj, "load", createLoadArray(task.load));
+                    cJSON_AddItemToArray(tasks_array, task_obj);
+                }
+                cJSON_AddItemToObject(data_obj, "tasks", tasks_array);
+                cJSON_AddItemToObject(json.get(), "data", data_obj);
+
+                JsonStringRAII json_str(cJSON_Print(json.get()));
+                if (!json_str.get())
+                {
+                    ESP_LOGE(TAG, "构建 cpu_info 消息失败");
+                    return "";
+                }
+
+                return std::string(json_str.get());
+            }
+
+            bool CpuInfoMessage::fromJson(const std::string& json_str)
+            {
+                using namespace app::tool::ota;
+                JsonRAII root(json_str.c_str());
+                if (!root.get())
+                {
+                    ESP_LOGE(TAG, "JSON 解析失败: %s", cJSON_GetErrorPtr());
+                    return false;
+                }
+
+                // 解析基础字段
+                if (!MessageFactory::parseBase(root.get(), base))
+                {
+                    return false;
+                }
+
+                // 验证类型
+                if (base.type != MessageType::CPU_INFO)
+                {
+                    ESP_LOGE(TAG, "消息类型不匹配");
+                    return false;
+                }
+
+                cJSON* data_obj = cJSON_GetObjectItem(root.get(), "data");
+                if (!data_obj || !cJSON_IsObject(data_obj))
+                {
+                    ESP_LOGE(TAG, "缺少 data 字段或类型错误");
+                    return false;
+                }
+
+                cJSON* period_item = cJSON_GetObjectItem(data_obj, "period_ms");
+                if (period_item && cJSON_IsNumber(period_item))
+                {
+                    data.period_ms = static_cast<uint32_t>(cJSON_GetNumberValue(period_item));
+                }
+
+                cJSON* windows_item = cJSON_GetObjectItem(data_obj, "windows");
+                if (windows_item && cJSON_IsArray(windows_item))
+                {
+                    int size = cJSON_GetArraySize(windows_item);
+                    for (int i = 0; i < size && i < 3; i++)
+                    {
+                        cJSON* elem = cJSON_GetArrayItem(windows_item, i);
+                        if (elem && cJSON_IsNumber(elem))
+                        {
+                            data.windows[i] = static_cast<int>(cJSON_GetNumberValue(elem));
+                        }
+                    }
+                }
+
+                data.cores.clear();
+                cJSON* cores_item = cJSON_GetObjectItem(data_obj, "cores");
+                cJSON* core_obj   = nullptr;
+                cJSON_ArrayForEach(core_obj, cores_item)
+                {
+                    CpuCoreLoad core;
+                    cJSON*      core_item = cJSON_GetObjectItem(core_obj, "core");
+                    if (core_item && cJSON_IsNumber(core_item))
+                    {
+                        core.core = static_cast<int>(cJSON_GetNumberValue(core_item));
+                    }
+                    parseLoadArray(cJSON_GetObjectItem(core_obj, "load"), core.load);
+                    cJSON* peak_item = cJSON_GetObjectItem(core_obj, "peak");
+                    if (peak_item && cJSON_IsNumber(peak_item))
+                    {
+                        core.peak = static_cast<float>(cJSON_GetNumberValue(peak_item));
+                    }
+                    data.cores.push_back(core);
+                }
+
+                data.tasks.clear();
+                cJSON* tasks_item = cJSON_GetObjectItem(data_obj, "tasks");
+                cJSON* task_obj   = nullptr;
+                cJSON_ArrayForEach(task_obj, tasks_item)
+                {
+                    CpuTaskLoad task;
+                    cJSON*      name_item = cJSON_GetObjectItem(task_obj, "name");
+                    if (name_item && cJSON_IsString(name_item))
+                    {
+                        task.name = cJSON_GetStringValue(name_item);
+                    }
+                    cJSON* core_item = cJSON_GetObjectItem(task_obj, "core");
+                    if (core_item && cJSON_IsNumber(core_item))
+                    {
+                        task.core = static_cast<int>(cJSON_GetNumberValue(core_item));
+                    }
+                    cJSON* priority_item = cJSON_GetObjectItem(task_obj, "priority");
+                    if (priority_item && cJSON_IsNumber(priority_item))
+                    {
+                        task.priority = static_cast<int>(cJSON_GetNumberValue(priority_item));
+                    }
+                    parseLoadArray(cJSON_GetObjectItem(task_obj, "load"), task.load);
+                    data.tasks.push_back(task);
+                }
+
+                return true;
+            }
+
+            // ========== TraceDumpMessage 实现 ==========
+
+            std::string TraceDumpMessage::toJson() const
+            {
+                using namespace app::tool::ota;
+                JsonRAII json;
+
+                // 基础字段
+                cJSON_AddStringToObject(json.get(), "type", messageTypeToString(base.type));
+                cJSON_AddStringToObject(json.get(), "from", base.from.c_str());
+                cJSON_AddStringToObject(json.get(), "to", base.to.c_str());
+                cJSON_AddStringToObject(json.get(), "timestamp", base.timestamp.c_str());
+
+                // data 对象
+                cJSON* data_obj = cJSON_CreateObject();
+                cJSON_AddNumberToObject(data_obj, "records", data.records);
+                cJSON_AddNumberToObject(data_obj, "length", data.length);
+                cJSON_AddItemToObject(json.get(), "data", data_obj);
+
+                JsonStringRAII json_str(cJSON_Print(json.get()));
+                if (!json_str.get())
+                {
+                    ESP_LOGE(TAG, "构建 trace_dump 消息失败");
+                    return "";
+                }
+
+                return std::string(json_str.get());
+            }
+
+            bool TraceDumpMessage::fromJson(const std::string& json_str)
+            {
+                using namespace app::tool::ota;
+                JsonRAII root(json_str.c_str());
+                if (!root.get())
+                {
+                    ESP_LOGE(TAG, "JSON 解析失败: %s", cJSON_GetErrorPtr());
+                    return false;
+                }
+
+                // 解析基础字段
+                if (!MessageFactory::parseBase(root.get(), base))
+                {
+                    return false;
+                }
+
+                // 验证类型
+                if (base.type != MessageType::TRACE_DUMP)
+                {
+                    ESP_LOGE(TAG, "消息类型不匹配");
+                    return false;
+                }
+
+                // 解析 data 对象（请求中可省略）
+                cJSON* data_obj = cJSON_GetObjectItem(root.get(), "data");
+                if (data_obj && cJSON_IsObject(data_obj))
+                {
+                    cJSON* records_item = cJSON_GetObjectItem(data_obj, "records");
+                    if (records_item && cJSON_IsNumber(records_item))
+                    {
+                        data.records = static_cast<uint32_t>(cJSON_GetNumberValue(records_item));
+                    }
+
+                    cJSON* length_item = cJSON_GetObjectItem(data_obj, "length");
+                    if (length_item && cJSON_IsNumber(length_item))
+                    {
+                        data.length = static_cast<uint32_t>(cJSON_GetNumberValue(length_item));
+                    }
+                }
+
+                return true;
+            }
+
             // ========== MessageFactory 实现 ==========
 
             std::unique_ptr<Message> MessageFactory::createFromJson(const std::string& json_str)
@@ -700,6 +1135,8 @@ namespace app
                     return std::make_unique<RecvInfoMessage>();
                 case MessageType::MOV_INFO:
                     return std::make_unique<MovInfoMessage>();
+                case MessageType::MOV_CLIP:
+                    return std::make_unique<MovClipMessage>();
                 case MessageType::LISTEN:
                     return std::make_unique<ListenMessage>();
                 case MessageType::PLAY:
@@ -708,6 +1145,12 @@ namespace app
                     return std::make_unique<EmotionMessage>();
                 case MessageType::ERROR:
                     return std::make_unique<ErrorMessage>();
+                case MessageType::RECORDER_DUMP:
+                    return std::make_unique<RecorderDumpMessage>();
+                case MessageType::CPU_INFO:
+                    return std::make_unique<CpuInfoMessage>();
+                case MessageType::TRACE_DUMP:
+                    return std::make_unique<TraceDumpMessage>();
                 default:
                     return nullptr;
                 }
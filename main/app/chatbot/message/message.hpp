@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cJSON.h"
 #include "tool/time/time.hpp"
@@ -24,10 +25,14 @@ namespace app
                 BLUETOOTH_INFO, // 蓝牙信息
                 RECV_INFO,      // 数据接收
                 MOV_INFO,       // 运动数据接收
+                MOV_CLIP,       // 播放预置动作片段
                 LISTEN,         // 音频监听
                 PLAY,           // 音频播放
                 EMOTION,        // 情绪反馈
                 ERROR,          // 错误
+                RECORDER_DUMP,  // 飞行记录器导出
+                CPU_INFO,       // CPU 占用上报
+                TRACE_DUMP,     // 跟踪记录导出
                 UNKNOWN         // 未知类型
             };
 
@@ -46,6 +51,8 @@ namespace app
                     return "recv_info";
                 case MessageType::MOV_INFO:
                     return "mov_info";
+                case MessageType::MOV_CLIP:
+                    return "mov_clip";
                 case MessageType::LISTEN:
                     return "listen";
                 case MessageType::PLAY:
@@ -54,6 +61,12 @@ namespace app
                     return "emotion";
                 case MessageType::ERROR:
                     return "error";
+                case MessageType::RECORDER_DUMP:
+                    return "recorder_dump";
+                case MessageType::CPU_INFO:
+                    return "cpu_info";
+                case MessageType::TRACE_DUMP:
+                    return "trace_dump";
                 default:
                     return "unknown";
                 }
@@ -72,6 +85,8 @@ namespace app
                     return MessageType::RECV_INFO;
                 if (type_str == "mov_info")
                     return MessageType::MOV_INFO;
+                if (type_str == "mov_clip")
+                    return MessageType::MOV_CLIP;
                 if (type_str == "listen")
                     return MessageType::LISTEN;
                 if (type_str == "play")
@@ -80,6 +95,12 @@ namespace app
                     return MessageType::EMOTION;
                 if (type_str == "error")
                     return MessageType::ERROR;
+                if (type_str == "recorder_dump")
+                    return MessageType::RECORDER_DUMP;
+                if (type_str == "cpu_info")
+                    return MessageType::CPU_INFO;
+                if (type_str == "trace_dump")
+                    return MessageType::TRACE_DUMP;
                 return MessageType::UNKNOWN;
             }
 
@@ -262,6 +283,88 @@ namespace app
                 explicit EmotionData(const std::string& c) : code(c) {}
             };
 
+            /**
+             * @brief 动作片段播放参数
+             */
+            struct MovClipData
+            {
+                int         id;     // 片段 id（见 assets 中的 motions.bin）
+                double      speed;  // 播放速度，1.0 为原速
+                double      scale;  // 动作幅度（以居中位置为基准），1.0 为原幅度
+                std::string policy; // 与正在执行的动作的衔接方式：mix（默认）、blend、queue
+
+                MovClipData() : id(0), speed(1.0), scale(1.0), policy("mix") {}
+            };
+
+            /**
+             * @brief 飞行记录器导出数据（设备回复时填写）
+             */
+            struct RecorderDumpData
+            {
+                uint32_t records; // 记录条数
+                uint32_t length;  // 随后发送的二进制数据总字节数
+
+                RecorderDumpData() : records(0), length(0) {}
+            };
+
+            /**
+             * @brief 单个核心的 CPU 占用（用于cpu_info）
+             */
+            struct CpuCoreLoad
+            {
+                int                  core; // 核心编号
+                std::array<float, 3> load; // 短、中、长窗口的占用，单位：%
+                float                peak; // 长窗口内单次采样的最高占用，单位：%
+
+                CpuCoreLoad() : core(0), peak(0)
+                {
+                    load.fill(0);
+                }
+            };
+
+            /**
+             * @brief 单个任务的 CPU 占用（用于cpu_info）
+             */
+            struct CpuTaskLoad
+            {
+                std::string          name;     // 任务名称
+                int                  core;     // 绑定的核心，-1 表示未绑定
+                int                  priority; // 优先级
+                std::array<float, 3> load;     // 短、中、长窗口的占用（占单个核心），单位：%
+
+                CpuTaskLoad() : core(-1), priority(0)
+                {
+                    load.fill(0);
+                }
+            };
+
+            /**
+             * @brief CPU 占用上报数据
+             */
+            struct CpuInfoData
+            {
+                uint32_t                 period_ms; // 采样周期，单位：毫秒
+                std::array<int, 3>       windows;   // 各窗口包含的采样次数
+                std::vector<CpuCoreLoad> cores;     // 各核心占用
+                std::vector<CpuTaskLoad> tasks;     // 占用最高的任务
+
+                CpuInfoData() : period_ms(0)
+                {
+                    windows.fill(0);
+                }
+            };
+
+            /**
+             * @brief 跟踪记录导出数据（设备回复时填写）
+             */
+            struct TraceDumpData
+            {
+                uint32_t records; // 记录条数
+                uint32_t length;  // 随后发送的二进制数据总字节数
+
+                TraceDumpData() : records(0), length(0) {}
+            };
+
             /**
              * @brief 消息基类（抽象接口）
              */
@@ -410,7 +513,8 @@ namespace app
             {
             public:
                 BaseMessage  base;
-                MovementData data; // 舵机控制数据映射
+                MovementData data;            // 舵机控制数据映射
+                int          media_time = -1; // 可选：开始时对应的音频媒体时间（毫秒），-1 不同步
 
                 MovInfoMessage() {}
                 MovInfoMessage(const BaseMessage& b, const MovementData& mov_data)
@@ -437,6 +541,42 @@ namespace app
                 }
             };
 
+            /**
+             * @brief 动作片段播放消息 (mov_clip)
+             *
+             * 常用动作（点头、摇尾巴等）预先打包在 assets 分区中，服务器只需发送片段 id
+             */
+            class MovClipMessage : public Message
+            {
+            public:
+                BaseMessage base;
+                MovClipData data;
+
+                MovClipMessage() {}
+                MovClipMessage(const BaseMessage& b, const MovClipData& clip_data)
+                    : base(b), data(clip_data)
+                {
+                }
+
+                MessageType getType() const override
+                {
+                    return MessageType::MOV_CLIP;
+                }
+
+                std::string toJson() const override;
+                bool        fromJson(const std::string& json_str) override;
+
+                BaseMessage getBase() const override
+                {
+                    return base;
+                }
+
+                void setBase(const BaseMessage& b) override
+                {
+                    base = b;
+                }
+            };
+
             /**
              * @brief 音频监听消息 (listen)
              */
@@ -565,6 +705,113 @@ namespace app
                 }
             };
 
+            /**
+             * @brief 飞行记录器导出消息 (recorder_dump)
+             *
+             * 服务器发送不带 data 的请求，设备回复带 data 的同类型消息后以二进制帧发送导出数据
+             */
+            class RecorderDumpMessage : public Message
+            {
+            public:
+                BaseMessage      base;
+                RecorderDumpData data;
+
+                RecorderDumpMessage() {}
+                RecorderDumpMessage(const BaseMessage& b, const RecorderDumpData& dump_data)
+                    : base(b), data(dump_data)
+                {
+                }
+
+                MessageType getType() const override
+                {
+                    return MessageType::RECORDER_DUMP;
+                }
+
+                std::string toJson() const override;
+                bool        fromJson(const std::string& json_str) override;
+
+                BaseMessage getBase() const override
+                {
+                    return base;
+                }
+
+                void setBase(const BaseMessage& b) override
+                {
+                    base = b;
+                }
+            };
+
+            /**
+             * @brief CPU 占用上报消息 (cpu_info)
+             */
+            class CpuInfoMessage : public Message
+            {
+            public:
+                BaseMessage base;
+                CpuInfoData data;
+
+                CpuInfoMessage() {}
+                CpuInfoMessage(const BaseMessage& b, const CpuInfoData& cpu_data)
+                    : base(b), data(cpu_data)
+                {
+                }
+
+                MessageType getType() const override
+                {
+                    return MessageType::CPU_INFO;
+                }
+
+                std::string toJson() const override;
+                bool        fromJson(const std::string& json_str) override;
+
+                BaseMessage getBase() const override
+                {
+                    return base;
+                }
+
+                void setBase(const BaseMessage& b) override
+                {
+                    base = b;
+                }
+            };
+
+            /**
+             * @brief 跟踪记录导出消息 (trace_dump)
+             *
+             * 与 recorder_dump 相同：服务器发送不带 data 的请求，设备回复带 data 的同类型消息后
+             * 以二进制帧发送导出数据（格式见 tool/trace/trace.hpp）
+             */
+            class TraceDumpMessage : public Message
+            {
+            public:
+                BaseMessage   base;
+                TraceDumpData data;
+
+                TraceDumpMessage() {}
+                TraceDumpMessage(const BaseMessage& b, const TraceDumpData& dump_data)
+                    : base(b), data(dump_data)
+                {
+                }
+
+                MessageType getType() const override
+                {
+                    return MessageType::TRACE_DUMP;
+                }
+
+                std::string toJson() const override;
+                bool        fromJson(const std::string& json_str) override;
+
+                BaseMessage getBase() const override
+                {
+                    return base;
+                }
+
+                void setBase(const BaseMessage& b) override
+                {
+                    base = b;
+                }
+            };
+
             /**
              * @brief 消息工厂类（支持可扩展的消息创建和解析）
              */
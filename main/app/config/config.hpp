@@ -15,6 +15,10 @@ namespace app
         const i2c_port_t MPR121_I2C_PORT = I2C_NUM_1;
         const gpio_num_t MPR121_SDA      = GPIO_NUM_17;
         const gpio_num_t MPR121_SCL      = GPIO_NUM_18;
+        const gpio_num_t MPR121_IRQ      = GPIO_NUM_NC; // IRQ 引脚，未连接时使用轮询模式
+
+        // apds9930 pins
+        const gpio_num_t APDS9930_INT = GPIO_NUM_NC; // INT 引脚，未连接时使用轮询模式
 
         // i2s pins
         const gpio_num_t I2S_MCLK = GPIO_NUM_16;
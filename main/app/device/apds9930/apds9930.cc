@@ -4,6 +4,7 @@
 #include <cstring>
 #include <esp_log.h>
 #include "system/task/task.hpp"
+#include "tool/recorder/recorder.hpp"
 
 static const char* const TAG = "APDS9930";
 
@@ -19,7 +20,8 @@ namespace app
                 deinit();
             }
 
-            bool APDS9930::init(i2c_master_bus_handle_t bus_handle, uint8_t i2c_addr)
+            bool APDS9930::init(i2c_master_bus_handle_t bus_handle, uint8_t i2c_addr,
+                                gpio_num_t int_pin)
             {
                 if (bus_handle == nullptr)
                 {
@@ -29,6 +31,7 @@ namespace app
 
                 bus_handle_ = bus_handle;
                 i2c_addr_   = i2c_addr;
+                int_pin_    = int_pin;
 
                 // 添加 I2C 设备
                 i2c_device_config_t dev_cfg = {};
@@ -43,6 +46,16 @@ namespace app
                     return false;
                 }
 
+                // 登记到 I2C 调度器，之后的读写按优先级排队
+                i2c_device_ = i2c::scheduler::Scheduler::getInstance().registerDevice(
+                    "APDS9930", dev_handle_, i2c::scheduler::Priority::LOW);
+                if (i2c_device_ == i2c::scheduler::INVALID_DEVICE)
+                {
+                    ESP_LOGE(TAG, "登记 I2C 调度设备失败");
+                    deinit();
+                    return false;
+                }
+
                 // 读取 ID 寄存器并检查已知的 APDS-9930 值
                 uint8_t id = 0;
                 if (!wireReadDataByte(Reg::ID, id))
@@ -153,16 +166,35 @@ namespace app
                     return false;
                 }
 
+                // 配置 INT 引脚（可选），失败时回退到轮询模式
+                if (int_pin_ != GPIO_NUM_NC && !setupIrq())
+                {
+                    ESP_LOGW(TAG, "INT 引脚配置失败，回退到轮询模式");
+                    int_pin_ = GPIO_NUM_NC;
+                }
+
                 initialized_ = true;
-                ESP_LOGI(TAG, "APDS-9930 初始化成功 (地址: 0x%02X)", i2c_addr_);
+                ESP_LOGI(TAG, "APDS-9930 初始化成功 (地址: 0x%02X, 模式: %s)", i2c_addr_,
+                         isIrqMode() ? "中断" : "轮询");
                 return true;
             }
 
             void APDS9930::deinit()
             {
+                releaseIrq();
+
                 if (dev_handle_ != nullptr)
                 {
-                    i2c_master_bus_rm_device(dev_handle_);
+                    // 调度器中仍有该设备的事务时不能移除句柄
+                    if (i2c::scheduler::Scheduler::getInstance().unregisterDevice(i2c_device_))
+                    {
+                        i2c_master_bus_rm_device(dev_handle_);
+                    }
+                    else
+                    {
+                        ESP_LOGE(TAG, "I2C 事务未结束，保留设备句柄");
+                    }
+                    i2c_device_ = i2c::scheduler::INVALID_DEVICE;
                     dev_handle_ = nullptr;
                 }
                 bus_handle_  = nullptr;
@@ -963,7 +995,8 @@ namespace app
                 }
 
                 // 使用 1000ms 超时
-                esp_err_t ret = i2c_master_transmit(dev_handle_, &val, 1, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmit(i2c_device_, &val, 1);
                 return ret == ESP_OK;
             }
 
@@ -978,7 +1011,8 @@ namespace app
                 data[0] = static_cast<uint8_t>(reg | AUTO_INCREMENT);
                 data[1] = val;
                 // 使用 1000ms 超时
-                esp_err_t ret = i2c_master_transmit(dev_handle_, data, 2, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmit(i2c_device_, data, 2);
                 return ret == ESP_OK;
             }
 
@@ -1000,7 +1034,8 @@ namespace app
                 memcpy(&buffer[1], val, len);
 
                 // 使用 1000ms 超时
-                esp_err_t ret = i2c_master_transmit(dev_handle_, buffer, len + 1, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmit(i2c_device_, buffer, len + 1);
 
                 delete[] buffer;
                 return ret == ESP_OK;
@@ -1015,8 +1050,8 @@ namespace app
 
                 uint8_t reg_addr = reg | AUTO_INCREMENT;
                 // 使用 1000ms 超时
-                esp_err_t ret =
-                    i2c_master_transmit_receive(dev_handle_, &reg_addr, 1, &val, 1, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmitReceive(i2c_device_, &reg_addr, 1, &val, 1);
                 return ret == ESP_OK;
             }
 
@@ -1029,8 +1064,8 @@ namespace app
 
                 uint8_t reg_addr = reg | AUTO_INCREMENT;
                 // 使用 1000ms 超时
-                esp_err_t ret =
-                    i2c_master_transmit_receive(dev_handle_, &reg_addr, 1, val, len, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmitReceive(i2c_device_, &reg_addr, 1, val, len);
                 if (ret != ESP_OK)
                 {
                     return -1;
@@ -1083,6 +1118,16 @@ namespace app
                     return false;
                 }
 
+                // 中断模式：任务启动后再打开中断，确保通知目标有效
+                if (isIrqMode())
+                {
+                    irq_task_handle_ = data_collection_task_->getHandle();
+                    gpio_intr_enable(int_pin_);
+                    ESP_LOGI(TAG, "数据采集任务已启动（中断模式，兜底检查间隔: %lu ms）",
+                             (unsigned long)interval_ms);
+                    return true;
+                }
+
                 ESP_LOGI(TAG, "数据采集任务已启动，采集间隔: %lu ms", (unsigned long)interval_ms);
                 return true;
             }
@@ -1097,6 +1142,13 @@ namespace app
                 // 停止任务
                 collection_running_ = false;
 
+                // 先关闭中断，避免向已删除的任务发送通知
+                if (isIrqMode())
+                {
+                    gpio_intr_disable(int_pin_);
+                    irq_task_handle_ = nullptr;
+                }
+
                 // 删除任务
                 if (data_collection_task_ != nullptr)
                 {
@@ -1112,56 +1164,112 @@ namespace app
             {
                 ESP_LOGI(TAG, "数据采集任务开始运行");
 
-                uint32_t count             = 0;
-                int      last_light_status = -1; // 上次的光状态，-1表示未初始化
+                uint32_t  count             = 0;
+                int       last_light_status = -1; // 上次的光状态，-1表示未初始化
+                LightData last_data;              // 上次的测量结果，valid=false表示未初始化
 
                 while (collection_running_)
                 {
+                    // 中断模式：首次立即读取以建立阈值窗口，之后等待 INT 通知，
+                    // 超时后仅在 INT 引脚仍为低电平（有未清除中断）时读取
+                    if (isIrqMode() && count > 0)
+                    {
+                        uint32_t notified =
+                            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(collection_interval_ms_));
+                        if (!collection_running_)
+                        {
+                            break;
+                        }
+                        if (notified == 0 && gpio_get_level(int_pin_) != 0 && last_data.valid)
+                        {
+                            continue;
+                        }
+                    }
+
                     count++;
 
-                    // 读取环境光数据
-                    float lux      = 0.0f;
-                    bool  light_ok = readAmbientLightLux(lux);
+                    // 读取环境光和接近数据
+                    LightData data;
+                    bool      read_ok = readMeasurement(data);
+
+                    if (read_ok)
+                    {
+                        // 接近状态带回差判断，避免在阈值附近来回跳变
+                        data.near = last_data.near ? (data.proximity >= PROXIMITY_FAR_THRESHOLD)
+                                                   : (data.proximity > PROXIMITY_NEAR_THRESHOLD);
+
+                        bool light_changed     = !last_data.valid || data.ch0 < light_window_low_ ||
+                                                 data.ch0 > light_window_high_;
+                        bool proximity_changed = !last_data.valid || data.near != last_data.near;
 
-                    // 读取接近数据
-                    uint16_t proximity = 0;
-                    bool     prox_ok   = readProximity(proximity);
+                        // 光照超出窗口：以当前读数为中心重新设置窗口（自动量程）
+                        if (light_changed)
+                        {
+                            uint32_t half =
+                                static_cast<uint32_t>(data.ch0) * LIGHT_WINDOW_PERCENT / 100;
+                            if (half < LIGHT_WINDOW_MIN)
+                            {
+                                half = LIGHT_WINDOW_MIN;
+                            }
+                            uint32_t high      = data.ch0 + half;
+                            light_window_low_  = (data.ch0 > half) ? (data.ch0 - half) : 0;
+                            light_window_high_ = (high > 0xFFFF) ? 0xFFFF : high;
+                        }
+
+                        // 中断模式：同步硬件阈值后清除中断，释放 INT 引脚
+                        if (isIrqMode())
+                        {
+                            if (light_changed && !updateLightThresholds())
+                            {
+                                ESP_LOGW(TAG, "更新光中断阈值失败");
+                            }
+                            if (proximity_changed && !updateProximityThresholds(data.near))
+                            {
+                                ESP_LOGW(TAG, "更新接近中断阈值失败");
+                            }
+                            if (!clearAllInts())
+                            {
+                                ESP_LOGW(TAG, "清除中断失败");
+                            }
+                        }
+
+                        // 更新缓存
+                        {
+                            std::lock_guard<std::mutex> lock(data_mutex_);
+                            latest_data_ = data;
+                        }
+                        last_data = data;
+
+                        // 写入飞行记录器
+                        tool::recorder::Recorder::getInstance().recordLight(
+                            data.ch0, data.ch1, data.proximity, data.near);
+
+                        // 发送事件
+                        namespace bus = app::sys::event::bus;
+                        auto& event_bus = bus::EventBus::getInstance();
+                        if (light_changed)
+                        {
+                            event_bus.publish<bus::Topic::LIGHT_CHANGED>(data);
+                        }
+                        if (proximity_changed)
+                        {
+                            ESP_LOGD(TAG, "接近状态变化: %s, 接近值=%u",
+                                     data.near ? "靠近" : "离开", data.proximity);
+                            event_bus.publish<bus::Topic::PROXIMITY_CHANGED>(data);
+                        }
+                    }
 
                     // 判断环境光状态
                     int current_status = -1;
-                    if (light_ok)
+                    if (read_ok)
                     {
-                        current_status = (lux >= LIGHT_THRESHOLD_LUX) ? 1 : 0;
+                        current_status = (data.lux >= LIGHT_THRESHOLD_LUX) ? 1 : 0;
                         // 更新当前状态
                         current_light_status_ = current_status;
                     }
 
-                    // // 输出数据
-                    // ESP_LOGI(TAG,
-                    //          "========== APDS-9930 数据 [%lu] ==========", (unsigned long)count);
-                    // if (light_ok)
-                    // {
-                    //     // 显示环境光数据和状态
-                    //     const char* status_str = (current_status == 1) ? "亮" : "灭";
-                    //     ESP_LOGI(TAG, "  环境光: %.2f lux (%s)", lux, status_str);
-                    // }
-                    // else
-                    // {
-                    //     ESP_LOGW(TAG, "  环境光: 读取失败");
-                    // }
-
-                    // if (prox_ok)
-                    // {
-                    //     ESP_LOGI(TAG, "  接近值: %u", proximity);
-                    // }
-                    // else
-                    // {
-                    //     ESP_LOGW(TAG, "  接近值: 读取失败");
-                    // }
-                    // ESP_LOGI(TAG, "==========================================");
-
                     // 触发回调（只在状态变化时）
-                    if (light_ok)
+                    if (read_ok)
                     {
                         // 只在状态变化时触发回调，或者首次读取时也触发
                         if (last_light_status != current_status || last_light_status == -1)
@@ -1171,7 +1279,7 @@ namespace app
                             // 显示状态变化信息
                             const char* status_str = (current_status == 1) ? "亮" : "灭";
                             ESP_LOGI(TAG, "环境光状态变化: %d (%s), lux=%.2f", current_status,
-                                     status_str, lux);
+                                     status_str, data.lux);
 
                             // 调用回调函数
                             if (light_status_callback_ != nullptr)
@@ -1181,13 +1289,138 @@ namespace app
                         }
                     }
 
-                    // 等待指定间隔
-                    app::sys::task::TaskManager::delayMs(collection_interval_ms_);
+                    // 轮询模式：等待指定间隔
+                    if (!isIrqMode())
+                    {
+                        app::sys::task::TaskManager::delayMs(collection_interval_ms_);
+                    }
                 }
 
                 ESP_LOGI(TAG, "数据采集任务结束");
             }
 
+            bool APDS9930::readMeasurement(LightData& data)
+            {
+                if (!readCh0Light(data.ch0) || !readCh1Light(data.ch1))
+                {
+                    return false;
+                }
+                if (!readProximity(data.proximity))
+                {
+                    return false;
+                }
+
+                data.lux       = floatAmbientToLux(data.ch0, data.ch1);
+                data.valid     = true;
+                data.timestamp = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                return true;
+            }
+
+            bool APDS9930::updateLightThresholds()
+            {
+                // ALS 中断比较的是 Ch0 原始值：Ch0 < AILT 或 Ch0 > AIHT 时触发
+                if (!setLightIntLowThreshold(light_window_low_))
+                {
+                    return false;
+                }
+                if (!setLightIntHighThreshold(light_window_high_))
+                {
+                    return false;
+                }
+
+                return true;
+            }
+
+            bool APDS9930::updateProximityThresholds(bool near)
+            {
+                // 离开状态只等待靠近（PDATA > 靠近阈值），靠近状态只等待离开（PDATA < 离开阈值）
+                uint16_t low  = near ? PROXIMITY_FAR_THRESHOLD : 0;
+                uint16_t high = near ? 0xFFFF : PROXIMITY_NEAR_THRESHOLD;
+
+                if (!setProximityIntLowThreshold(low))
+                {
+                    return false;
+                }
+                if (!setProximityIntHighThreshold(high))
+                {
+                    return false;
+                }
+
+                return true;
+            }
+
+            bool APDS9930::setupIrq()
+            {
+                // APDS-9930 的 INT 为开漏低电平有效输出，超出阈值时拉低，写入清除命令后释放
+                gpio_config_t io_conf = {};
+                io_conf.pin_bit_mask  = 1ULL << int_pin_;
+                io_conf.mode          = GPIO_MODE_INPUT;
+                io_conf.pull_up_en    = GPIO_PULLUP_ENABLE;
+                io_conf.pull_down_en  = GPIO_PULLDOWN_DISABLE;
+                io_conf.intr_type     = GPIO_INTR_NEGEDGE;
+
+                esp_err_t ret = gpio_config(&io_conf);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "配置 INT 引脚失败: %s", esp_err_to_name(ret));
+                    return false;
+                }
+
+                // GPIO 中断服务可能已被其他模块安装
+                ret = gpio_install_isr_service(0);
+                if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE)
+                {
+                    ESP_LOGE(TAG, "安装 GPIO 中断服务失败: %s", esp_err_to_name(ret));
+                    gpio_reset_pin(int_pin_);
+                    return false;
+                }
+
+                // 采集任务启动前保持中断关闭
+                gpio_intr_disable(int_pin_);
+
+                ret = gpio_isr_handler_add(int_pin_, &APDS9930::irqHandler, this);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "注册 INT 中断处理函数失败: %s", esp_err_to_name(ret));
+                    gpio_reset_pin(int_pin_);
+                    return false;
+                }
+
+                irq_installed_ = true;
+                return true;
+            }
+
+            void APDS9930::releaseIrq()
+            {
+                if (!irq_installed_)
+                {
+                    return;
+                }
+
+                gpio_intr_disable(int_pin_);
+                gpio_isr_handler_remove(int_pin_);
+                gpio_reset_pin(int_pin_);
+                irq_task_handle_ = nullptr;
+                irq_installed_   = false;
+            }
+
+            void IRAM_ATTR APDS9930::irqHandler(void* arg)
+            {
+                auto*        self   = static_cast<APDS9930*>(arg);
+                TaskHandle_t target = self->irq_task_handle_;
+                if (target == nullptr)
+                {
+                    return;
+                }
+
+                BaseType_t higher_priority_task_woken = pdFALSE;
+                vTaskNotifyGiveFromISR(target, &higher_priority_task_woken);
+                if (higher_priority_task_woken == pdTRUE)
+                {
+                    portYIELD_FROM_ISR();
+                }
+            }
+
         } // namespace apds9930
     } // namespace device
 } // namespace app
@@ -2,9 +2,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <driver/i2c_master.h>
+#include <driver/gpio.h>
 #include "system/task/task.hpp"
+#include "i2c/scheduler/scheduler.hpp"
+#include "system/event/bus/bus.hpp"
 
 namespace app
 {
@@ -141,6 +145,33 @@ namespace app
             constexpr float C  = 0.746f;
             constexpr float D  = 1.291f;
 
+            // 中断模式参数
+            constexpr uint16_t LIGHT_WINDOW_PERCENT     = 20;  // 光阈值窗口：当前 Ch0 的 ±20%
+            constexpr uint16_t LIGHT_WINDOW_MIN         = 8;   // 光阈值窗口最小半宽（暗光下防抖）
+            constexpr uint16_t PROXIMITY_NEAR_THRESHOLD = 400; // 接近值高于此值判定为靠近
+            constexpr uint16_t PROXIMITY_FAR_THRESHOLD  = 300; // 接近值低于此值判定为离开
+
+            /**
+             * @brief APDS-9930 最新测量结果
+             * @note 也是事件总线 Topic::LIGHT_CHANGED 和 Topic::PROXIMITY_CHANGED 的负载
+             */
+            struct LightData
+            {
+                float    lux;       // 环境光照度（lux）
+                uint16_t ch0;       // 通道 0 原始值（可见光 + 红外）
+                uint16_t ch1;       // 通道 1 原始值（红外）
+                uint16_t proximity; // 接近原始值
+                bool     near;      // 是否有物体靠近
+                bool     valid;     // 数据是否有效
+                uint32_t timestamp; // 采集时间戳（毫秒）
+
+                LightData()
+                    : lux(0.0f), ch0(0), ch1(0), proximity(0), near(false), valid(false),
+                      timestamp(0)
+                {
+                }
+            };
+
             /**
              * @brief APDS-9930 光环境和接近检测传感器驱动类（单例模式）
              */
@@ -165,9 +196,11 @@ namespace app
                  * @brief 初始化传感器
                  * @param bus_handle I2C 总线句柄
                  * @param i2c_addr I2C 地址，默认 0x39
+                 * @param int_pin INT 引脚，GPIO_NUM_NC 表示不使用中断（轮询模式）
                  * @return true 成功, false 失败
                  */
-                bool init(i2c_master_bus_handle_t bus_handle, uint8_t i2c_addr = APDS9930_I2C_ADDR);
+                bool init(i2c_master_bus_handle_t bus_handle, uint8_t i2c_addr = APDS9930_I2C_ADDR,
+                          gpio_num_t int_pin = GPIO_NUM_NC);
 
                 /**
                  * @brief 反初始化
@@ -364,12 +397,22 @@ namespace app
                  * @brief 静态方法：初始化传感器（便捷接口）
                  * @param bus_handle I2C 总线句柄
                  * @param i2c_addr I2C 地址，默认 0x39
+                 * @param int_pin INT 引脚，GPIO_NUM_NC 表示不使用中断（轮询模式）
                  * @return true 成功, false 失败
                  */
                 static bool Init(i2c_master_bus_handle_t bus_handle,
-                                 uint8_t                 i2c_addr = APDS9930_I2C_ADDR)
+                                 uint8_t                 i2c_addr = APDS9930_I2C_ADDR,
+                                 gpio_num_t              int_pin  = GPIO_NUM_NC)
                 {
-                    return getInstance().init(bus_handle, i2c_addr);
+                    return getInstance().init(bus_handle, i2c_addr, int_pin);
+                }
+
+                /**
+                 * @brief 是否工作在中断模式（init 时指定了 INT 引脚）
+                 */
+                bool isIrqMode() const
+                {
+                    return int_pin_ != GPIO_NUM_NC;
                 }
 
                 /**
@@ -396,6 +439,9 @@ namespace app
                  * @brief 启动后台数据采集任务
                  * @param interval_ms 采集间隔（毫秒），默认 5000ms
                  * @return true 成功, false 失败
+                 * @note 中断模式下任务只在 INT 触发时读取数据，并把光阈值重新设置在当前读数附近，
+                 *       interval_ms 作为兜底检查周期（防止丢失边沿），此时 I2C 只在 INT
+                 *       引脚为低电平时才访问
                  */
                 bool startDataCollection(uint32_t interval_ms = 5000);
 
@@ -467,9 +513,49 @@ namespace app
                     return getInstance().getCurrentLightStatus();
                 }
 
+                /**
+                 * @brief 获取采集任务缓存的最新测量结果（不访问 I2C）
+                 * @param data 输出最新测量结果
+                 * @return true 有有效数据, false 尚未采集到数据
+                 */
+                bool getLatestData(LightData& data) const
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    data = latest_data_;
+                    return data.valid;
+                }
+
+                /**
+                 * @brief 静态方法：获取最新测量结果（便捷接口）
+                 * @param data 输出最新测量结果
+                 * @return true 有有效数据, false 尚未采集到数据
+                 */
+                static bool GetLatestData(LightData& data)
+                {
+                    return getInstance().getLatestData(data);
+                }
+
             private:
                 APDS9930() = default;
                 ~APDS9930();
+
+                // 配置 INT 引脚中断
+                bool setupIrq();
+
+                // 释放 INT 引脚中断
+                void releaseIrq();
+
+                // INT 中断服务函数
+                static void irqHandler(void* arg);
+
+                // 读取一次环境光和接近原始值并换算照度
+                bool readMeasurement(LightData& data);
+
+                // 将光阈值窗口写入 AILT/AIHT
+                bool updateLightThresholds();
+
+                // 根据靠近/离开状态写入带回差的接近阈值
+                bool updateProximityThresholds(bool near);
                 // 接近中断阈值
                 uint8_t getProximityIntLowThreshold();
                 bool    setProximityIntLowThreshold(uint16_t threshold);
@@ -495,6 +581,9 @@ namespace app
                 bool                    initialized_ = false;
                 uint8_t                 i2c_addr_    = APDS9930_I2C_ADDR;
 
+                // I2C 调度器中的设备 ID
+                i2c::scheduler::DeviceId i2c_device_ = i2c::scheduler::INVALID_DEVICE;
+
                 // 数据采集任务相关
                 std::unique_ptr<app::sys::task::Task> data_collection_task_;
                 uint32_t                              collection_interval_ms_ = 5000;
@@ -508,6 +597,19 @@ namespace app
 
                 // 环境光阈值（lux）
                 static constexpr float LIGHT_THRESHOLD_LUX = 1000.0f;
+
+                // 最新测量结果（采集任务写入，其他任务读取）
+                mutable std::mutex data_mutex_;
+                LightData          latest_data_;
+
+                // 自动量程的光阈值窗口（Ch0 原始值）
+                uint16_t light_window_low_  = 0;
+                uint16_t light_window_high_ = 0;
+
+                // 中断模式相关
+                gpio_num_t   int_pin_         = GPIO_NUM_NC; // INT 引脚
+                bool         irq_installed_   = false;       // 是否已注册中断处理函数
+                TaskHandle_t irq_task_handle_ = nullptr;     // 中断通知的目标任务
             };
 
         } // namespace apds9930
@@ -1,7 +1,11 @@
 #include "led.hpp"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
 #include "system/task/task.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 static const char* const TAG = "WS2812";
@@ -14,13 +18,31 @@ namespace app::device::led
 #define WS2812_T1H_NS (800)  // 1码高电平时间（纳秒）
 #define WS2812_T1L_NS (450)  // 1码低电平时间（纳秒）
 #define WS2812_RESET_US (50) // 复位时间（微秒）
+#define WS2812_GAMMA (2.2f)  // 亮度感知的 gamma 值
 
 // 计算时钟周期数（80MHz = 12.5ns per tick）
 #define NS_TO_TICKS(ns) ((ns) / 12.5)
 
+    // 按权重（0-256）从 from 过渡到 to
+    static Color mix(const Color& from, const Color& to, int32_t weight)
+    {
+        return Color((uint8_t)(from.r + (((int32_t)to.r - from.r) * weight >> 8)),
+                     (uint8_t)(from.g + (((int32_t)to.g - from.g) * weight >> 8)),
+                     (uint8_t)(from.b + (((int32_t)to.b - from.b) * weight >> 8)));
+    }
+
+    // 按电平（0-255）缩放颜色
+    static Color scale(const Color& color, uint32_t level)
+    {
+        return Color((uint8_t)(color.r * level / 255), (uint8_t)(color.g * level / 255),
+                     (uint8_t)(color.b * level / 255));
+    }
+
     WS2812::WS2812()
         : encoder_handle_(nullptr), channel_handle_(nullptr), current_gpio_(GPIO_NUM_NC),
-          brightness_(100)
+          led_count_(1), emotion_active_(false), audio_active_(false), emotion_weight_(0),
+          audio_glow_(0), lut_brightness_(0xFF), back_(0), sent_count_(0), wake_sem_(nullptr),
+          stopped_sem_(nullptr), tx_done_sem_(nullptr)
     {
         memset(&blink_config_, 0, sizeof(blink_config_));
         blink_config_.interval_ms = -1;
@@ -29,14 +51,15 @@ namespace app::device::led
 
         memset(&breathing_config_, 0, sizeof(breathing_config_));
         breathing_config_.cycle_ms   = 2000;
-        breathing_config_.led_count  = 1;
         breathing_config_.is_running = false;
+
+        memset(lut_, 0, sizeof(lut_));
+        memset(frames_, 0, sizeof(frames_));
     }
 
     WS2812::~WS2812()
     {
-        stopBlink(current_gpio_);
-        stopBreathing(current_gpio_);
+        stopRenderTask();
         deinitRMTChannel();
     }
 
@@ -83,10 +106,17 @@ namespace app::device::led
         ESP_RETURN_ON_ERROR(rmt_new_tx_channel(&tx_chan_config, &channel_handle_), TAG,
                             "创建RMT通道失败");
 
+        // 发送完成回调通知渲染任务上一帧已发完（需在使能通道前注册）
+        rmt_tx_event_callbacks_t callbacks = {};
+        callbacks.on_trans_done            = &WS2812::onTransDone;
+        ESP_RETURN_ON_ERROR(rmt_tx_register_event_callbacks(channel_handle_, &callbacks, this), TAG,
+                            "注册RMT发送完成回调失败");
+
         // 使能RMT通道
         ESP_RETURN_ON_ERROR(rmt_enable(channel_handle_), TAG, "使能RMT通道失败");
 
         current_gpio_ = gpio_num;
+        sent_count_   = 0;
         ESP_LOGI(TAG, "RMT通道初始化成功，GPIO: %d", gpio_num);
         return true;
     }
@@ -95,6 +125,7 @@ namespace app::device::led
     {
         if (channel_handle_ != nullptr)
         {
+            rmt_tx_wait_all_done(channel_handle_, pdMS_TO_TICKS(FRAME_MS));
             rmt_disable(channel_handle_);
             rmt_del_channel(channel_handle_);
             channel_handle_ = nullptr;
@@ -109,136 +140,101 @@ namespace app::device::led
         current_gpio_ = GPIO_NUM_NC;
     }
 
-    bool WS2812::sendColor(const Color& color)
+    bool WS2812::prepare(gpio_num_t gpio_num)
     {
-        if (channel_handle_ == nullptr || encoder_handle_ == nullptr)
+        if (!initRMTChannel(gpio_num))
         {
-            ESP_LOGE(TAG, "RMT通道未初始化");
+            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
             return false;
         }
+        return running_ || startRenderTask();
+    }
 
-        // 根据亮度调整颜色值
-        Color adjusted_color;
-        if (brightness_ == 100)
-        {
-            // 亮度100%，直接使用原色
-            adjusted_color = color;
-        }
-        else if (brightness_ == 0)
+    bool WS2812::startRenderTask()
+    {
+        // 首次启动时创建信号量，之后复用
+        if (wake_sem_ == nullptr)
         {
-            // 亮度0%，关闭LED
-            adjusted_color = Color(0, 0, 0);
+            wake_sem_    = xSemaphoreCreateBinary();
+            stopped_sem_ = xSemaphoreCreateBinary();
+            tx_done_sem_ = xSemaphoreCreateBinary();
+
+            // 还没有发送过，缓冲区空闲
+            if (tx_done_sem_ != nullptr)
+            {
+                xSemaphoreGive(tx_done_sem_);
+            }
         }
-        else
+        if (wake_sem_ == nullptr || stopped_sem_ == nullptr || tx_done_sem_ == nullptr)
         {
-            // 计算亮度比例（0.0 - 1.0）
-            float brightness_factor = brightness_ / 100.0f;
-            adjusted_color.r        = (uint8_t)(color.r * brightness_factor);
-            adjusted_color.g        = (uint8_t)(color.g * brightness_factor);
-            adjusted_color.b        = (uint8_t)(color.b * brightness_factor);
+            ESP_LOGE(TAG, "创建渲染信号量失败");
+            return false;
         }
 
-        // WS2812数据格式：GRB（注意顺序）
-        uint8_t led_data[3] = {adjusted_color.g, adjusted_color.r, adjusted_color.b};
-
-        rmt_transmit_config_t tx_config = {};
-        tx_config.loop_count            = 0;
-        tx_config.flags.eot_level       = 0;
-
-        ESP_RETURN_ON_ERROR(
-            rmt_transmit(channel_handle_, encoder_handle_, led_data, sizeof(led_data), &tx_config),
-            TAG, "发送颜色数据失败");
+        app::sys::task::Config task_config;
+        task_config.name       = "led_render";
+        task_config.stack_size = 3 * 1024;
+        task_config.priority   = app::sys::task::Priority::NORMAL;
+        task_config.core_id    = -1;
+        task_config.delay_ms   = 0;
 
-        // 等待传输完成并发送复位信号
-        rmt_tx_wait_all_done(channel_handle_, portMAX_DELAY);
-        app::sys::task::TaskManager::delayMs(WS2812_RESET_US / 1000);
+        render_task_ = std::unique_ptr<app::sys::task::Task>(new app::sys::task::Task(
+            [this](void* param) { this->renderTaskFunction(param); }, task_config, this));
 
+        running_ = true;
+        if (!render_task_->start())
+        {
+            ESP_LOGE(TAG, "启动LED渲染任务失败");
+            running_ = false;
+            render_task_.reset();
+            return false;
+        }
         return true;
     }
 
-    bool WS2812::sendColors(const Color* colors, size_t count)
+    void WS2812::stopRenderTask()
     {
-        if (channel_handle_ == nullptr || encoder_handle_ == nullptr)
+        if (!running_)
         {
-            ESP_LOGE(TAG, "RMT通道未初始化");
-            return false;
+            return;
         }
 
-        if (colors == nullptr || count == 0)
+        running_ = false;
+        wake();
+        if (xSemaphoreTake(stopped_sem_, pdMS_TO_TICKS(1000)) != pdTRUE)
         {
-            ESP_LOGE(TAG, "颜色数组为空或数量为0");
-            return false;
+            ESP_LOGW(TAG, "等待LED渲染任务退出超时");
         }
 
-        // 为所有LED准备数据（每个LED 3个字节：GRB）
-        uint8_t* led_data = new uint8_t[count * 3];
-        if (led_data == nullptr)
+        if (render_task_ != nullptr)
         {
-            ESP_LOGE(TAG, "内存分配失败");
-            return false;
+            render_task_->destroy();
+            render_task_.reset();
         }
+    }
 
-        // 填充LED数据
-        for (size_t i = 0; i < count; i++)
+    void WS2812::wake()
+    {
+        if (wake_sem_ != nullptr)
         {
-            Color adjusted_color;
-            if (brightness_ == 100)
-            {
-                adjusted_color = colors[i];
-            }
-            else if (brightness_ == 0)
-            {
-                adjusted_color = Color(0, 0, 0);
-            }
-            else
-            {
-                float brightness_factor = brightness_ / 100.0f;
-                adjusted_color.r        = (uint8_t)(colors[i].r * brightness_factor);
-                adjusted_color.g        = (uint8_t)(colors[i].g * brightness_factor);
-                adjusted_color.b        = (uint8_t)(colors[i].b * brightness_factor);
-            }
-
-            // WS2812数据格式：GRB（注意顺序）
-            led_data[i * 3 + 0] = adjusted_color.g;
-            led_data[i * 3 + 1] = adjusted_color.r;
-            led_data[i * 3 + 2] = adjusted_color.b;
+            xSemaphoreGive(wake_sem_);
         }
-
-        rmt_transmit_config_t tx_config = {};
-        tx_config.loop_count            = 0;
-        tx_config.flags.eot_level       = 0;
-
-        esp_err_t ret =
-            rmt_transmit(channel_handle_, encoder_handle_, led_data, count * 3, &tx_config);
-        delete[] led_data;
-
-        ESP_RETURN_ON_ERROR(ret, TAG, "发送多个LED颜色数据失败");
-
-        // 等待传输完成并发送复位信号
-        rmt_tx_wait_all_done(channel_handle_, portMAX_DELAY);
-        app::sys::task::TaskManager::delayMs(WS2812_RESET_US / 1000);
-
-        return true;
     }
 
     bool WS2812::setBlinkConfig(gpio_num_t gpio_num, int32_t interval_ms, int32_t count)
     {
-        // 停止当前闪烁任务
-        if (blink_config_.is_running && blink_task_ != nullptr)
-        {
-            stopBlink(current_gpio_);
-        }
+        std::lock_guard<std::mutex> lock(mutex_);
 
-        // 保存配置
+        // 停止当前闪烁，保存配置
+        blink_config_.is_running  = false;
         blink_config_.interval_ms = interval_ms;
         blink_config_.count       = count;
 
-        // 初始化RMT通道
-        if (!initRMTChannel(gpio_num))
+        if (!prepare(gpio_num))
         {
-            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
             return false;
         }
+        wake();
 
         ESP_LOGI(TAG, "设置闪烁配置 - GPIO: %d, 间隔: %ld ms, 次数: %ld", gpio_num,
                  (long)interval_ms, (long)count);
@@ -247,23 +243,16 @@ namespace app::device::led
 
     bool WS2812::setColor(gpio_num_t gpio_num, const Color& color)
     {
-        // 初始化RMT通道
-        if (!initRMTChannel(gpio_num))
-        {
-            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
-            return false;
-        }
-
-        // 保存颜色
-        blink_config_.color = color;
-
-        // 发送颜色
-        if (!sendColor(color))
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
             ESP_LOGE(TAG, "设置颜色失败，GPIO: %d", gpio_num);
             return false;
         }
 
+        std::fill(colors_, colors_ + MAX_LEDS, color);
+        wake();
+
         ESP_LOGI(TAG, "设置颜色成功 - GPIO: %d, RGB(%d, %d, %d)", gpio_num, color.r, color.g,
                  color.b);
         return true;
@@ -276,150 +265,61 @@ namespace app::device::led
             ESP_LOGE(TAG, "颜色数组为空或数量为0");
             return false;
         }
-
-        // 初始化RMT通道
-        if (!initRMTChannel(gpio_num))
+        if (count > MAX_LEDS)
         {
-            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
-            return false;
+            ESP_LOGW(TAG, "LED数量 %lu 超过上限，只显示前 %lu 个", (unsigned long)count,
+                     (unsigned long)MAX_LEDS);
+            count = MAX_LEDS;
         }
 
-        // 发送多个LED的颜色数据
-        if (!sendColors(colors, count))
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
             ESP_LOGE(TAG, "设置多个LED颜色失败，GPIO: %d", gpio_num);
             return false;
         }
 
-        // ESP_LOGI(TAG, "设置多个LED颜色成功 - GPIO: %d, LED数量: %lu", gpio_num, (unsigned
-        // long)count);
+        std::copy(colors, colors + count, colors_);
+        led_count_ = count;
+        wake();
         return true;
     }
 
     bool WS2812::startBlink(gpio_num_t gpio_num)
     {
-        // 如果已经在运行，先停止
-        if (blink_config_.is_running)
-        {
-            stopBlink(current_gpio_);
-        }
-
-        // 确保RMT通道已初始化
-        if (!initRMTChannel(gpio_num))
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
-            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
             return false;
         }
 
-        // 如果间隔为-1，表示常亮，直接设置颜色
-        if (blink_config_.interval_ms == -1)
-        {
-            if (!sendColor(blink_config_.color))
-            {
-                ESP_LOGE(TAG, "设置常亮颜色失败");
-                return false;
-            }
-            ESP_LOGI(TAG, "LED常亮 - GPIO: %d", gpio_num);
-            return true;
-        }
-
-        // 创建闪烁任务
-        app::sys::task::Config task_config;
-        task_config.name       = "led_blink";
-        task_config.stack_size = 4096;
-        task_config.priority   = app::sys::task::Priority::NORMAL;
-        task_config.core_id    = -1;
-        task_config.delay_ms   = 0;
+        // 如果间隔为-1，表示常亮，显示当前颜色即可
+        blink_config_.is_running = blink_config_.interval_ms > 0;
+        blink_config_.start_us   = esp_timer_get_time();
+        wake();
 
-        blink_task_ = std::unique_ptr<app::sys::task::Task>(new app::sys::task::Task(
-            [this](void* param) { this->blinkTaskFunction(param); }, task_config, this));
-
-        if (!blink_task_)
-        {
-            ESP_LOGE(TAG, "创建闪烁任务对象失败");
-            return false;
-        }
-
-        blink_config_.is_running = true;
-        if (!blink_task_->start())
-        {
-            ESP_LOGE(TAG, "启动闪烁任务失败");
-            blink_config_.is_running = false;
-            blink_task_.reset();
-            return false;
-        }
-
-        ESP_LOGI(TAG, "开始闪烁 - GPIO: %d", gpio_num);
+        ESP_LOGI(TAG, "%s - GPIO: %d", blink_config_.is_running ? "开始闪烁" : "LED常亮",
+                 gpio_num);
         return true;
     }
 
     bool WS2812::stopBlink(gpio_num_t gpio_num)
     {
+        std::lock_guard<std::mutex> lock(mutex_);
         if (!blink_config_.is_running)
         {
             return true;
         }
 
-        // 停止任务
+        // 停止闪烁并关闭LED
         blink_config_.is_running = false;
-
-        // 删除任务
-        if (blink_task_ != nullptr)
-        {
-            blink_task_->destroy();
-            blink_task_.reset();
-        }
-
-        // 关闭LED
-        Color black(0, 0, 0);
-        sendColor(black);
+        std::fill(colors_, colors_ + MAX_LEDS, Color());
+        wake();
 
         ESP_LOGI(TAG, "停止闪烁 - GPIO: %d", gpio_num);
         return true;
     }
 
-    void WS2812::blinkTaskFunction(void* param)
-    {
-        int32_t count       = blink_config_.count;
-        int32_t interval_ms = blink_config_.interval_ms;
-        bool    infinite    = (count == -1);
-
-        ESP_LOGI(TAG, "闪烁任务开始 - 间隔: %ld ms, 次数: %s", (long)interval_ms,
-                 infinite ? "无限" : "有限");
-
-        while (blink_config_.is_running)
-        {
-            // 点亮LED
-            sendColor(blink_config_.color);
-            app::sys::task::TaskManager::delayMs(interval_ms);
-
-            // 如果任务还在运行，熄灭LED
-            if (blink_config_.is_running)
-            {
-                Color black(0, 0, 0);
-                sendColor(black);
-                app::sys::task::TaskManager::delayMs(interval_ms);
-            }
-
-            // 如果不是无限闪烁，减少计数
-            if (!infinite)
-            {
-                count--;
-                if (count <= 0)
-                {
-                    break;
-                }
-            }
-        }
-
-        // 任务结束，关闭LED
-        Color black(0, 0, 0);
-        sendColor(black);
-        blink_config_.is_running = false;
-
-        ESP_LOGI(TAG, "闪烁任务结束");
-    }
-
     bool WS2812::setBrightness(uint8_t brightness)
     {
         // 验证亮度值范围
@@ -429,232 +329,360 @@ namespace app::device::led
             return false;
         }
 
-        brightness_ = brightness;
+        // 渲染任务在下一帧按新亮度重建查找表
+        brightness_.store(brightness, std::memory_order_relaxed);
+        wake();
+
         ESP_LOGI(TAG, "设置亮度: %d%%", brightness);
+        return true;
+    }
 
-        // 如果LED当前正在显示颜色，立即应用新的亮度
-        if (blink_config_.is_running)
-        {
-            // 如果正在闪烁，重新发送当前颜色以应用新亮度
-            sendColor(blink_config_.color);
-        }
-        else if (current_gpio_ != GPIO_NUM_NC)
+    bool WS2812::startBreathing(gpio_num_t gpio_num, const Color& color, uint32_t cycle_ms,
+                                size_t led_count)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
-            // 如果LED常亮，重新发送当前颜色以应用新亮度
-            sendColor(blink_config_.color);
+            return false;
         }
 
+        breathing_config_.color      = color;
+        breathing_config_.cycle_ms   = cycle_ms >= 2 ? cycle_ms : 2000;
+        breathing_config_.start_us   = esp_timer_get_time();
+        breathing_config_.is_running = true;
+        led_count_                   = std::max<size_t>(1, std::min(led_count, MAX_LEDS));
+        wake();
+
+        ESP_LOGI(TAG, "开始呼吸灯 - GPIO: %d, 周期: %lu ms, LED数量: %lu", gpio_num,
+                 (unsigned long)cycle_ms, (unsigned long)led_count_);
         return true;
     }
 
-    bool WS2812::startBreathing(gpio_num_t gpio_num, const Color& color, uint32_t cycle_ms,
-                                size_t led_count)
+    bool WS2812::stopBreathing(gpio_num_t gpio_num)
     {
-        // 如果已经在运行，先停止
-        if (breathing_config_.is_running)
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!breathing_config_.is_running)
         {
-            stopBreathing(current_gpio_);
+            return true;
         }
 
-        // 确保RMT通道已初始化
-        if (!initRMTChannel(gpio_num))
+        // 停止呼吸灯并关闭LED
+        breathing_config_.is_running = false;
+        std::fill(colors_, colors_ + MAX_LEDS, Color());
+        wake();
+
+        ESP_LOGI(TAG, "停止呼吸灯 - GPIO: %d", gpio_num);
+        return true;
+    }
+
+    bool WS2812::updateBreathingColor(const Color& color)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!breathing_config_.is_running)
         {
-            ESP_LOGE(TAG, "初始化RMT通道失败，GPIO: %d", gpio_num);
+            ESP_LOGW(TAG, "呼吸灯未运行，无法更新颜色");
             return false;
         }
 
-        // 保存配置
-        breathing_config_.color     = color;
-        breathing_config_.cycle_ms  = cycle_ms;
-        breathing_config_.led_count = led_count;
-
-        // 创建呼吸灯任务
-        app::sys::task::Config task_config;
-        task_config.name       = "led_breathing";
-        task_config.stack_size = 4096;
-        task_config.priority   = app::sys::task::Priority::NORMAL;
-        task_config.core_id    = -1;
-        task_config.delay_ms   = 0;
-
-        breathing_task_ = std::unique_ptr<app::sys::task::Task>(new app::sys::task::Task(
-            [this](void* param) { this->breathingTaskFunction(param); }, task_config, this));
+        // 下一帧生效
+        breathing_config_.color = color;
+        return true;
+    }
 
-        if (!breathing_task_)
+    bool WS2812::setEmotionColor(gpio_num_t gpio_num, const Color& color)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
-            ESP_LOGE(TAG, "创建呼吸灯任务对象失败");
             return false;
         }
 
-        breathing_config_.is_running = true;
-        if (!breathing_task_->start())
+        emotion_color_  = color;
+        emotion_active_ = true;
+        wake();
+        return true;
+    }
+
+    void WS2812::clearEmotionColor()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        emotion_active_ = false;
+        wake();
+    }
+
+    bool WS2812::enableAudioLevel(gpio_num_t gpio_num, const Color& color)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!prepare(gpio_num))
         {
-            ESP_LOGE(TAG, "启动呼吸灯任务失败");
-            breathing_config_.is_running = false;
-            breathing_task_.reset();
             return false;
         }
 
-        ESP_LOGI(TAG, "开始呼吸灯 - GPIO: %d, 周期: %lu ms, LED数量: %lu", gpio_num,
-                 (unsigned long)cycle_ms, (unsigned long)led_count);
+        audio_color_  = color;
+        audio_active_ = true;
+        wake();
         return true;
     }
 
-    bool WS2812::stopBreathing(gpio_num_t gpio_num)
+    void WS2812::setAudioLevelSource(LevelSource source)
     {
-        if (!breathing_config_.is_running)
+        std::lock_guard<std::mutex> lock(mutex_);
+        audio_source_ = std::move(source);
+    }
+
+    void WS2812::disableAudioLevel()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        audio_active_ = false;
+        wake();
+    }
+
+    void WS2812::buildLut(uint8_t brightness)
+    {
+        // 先做 gamma 校正（亮度感知均匀），再按亮度缩放；渲染时每个分量只需查一次表
+        for (int i = 0; i < 256; i++)
         {
-            return true;
+            float linear = powf(i / 255.0f, WS2812_GAMMA);
+            lut_[i]      = (uint8_t)(linear * 255.0f * brightness / 100.0f + 0.5f);
         }
+        lut_brightness_ = brightness;
+    }
 
-        // 停止任务
-        breathing_config_.is_running = false;
+    bool WS2812::render(int64_t now_us, size_t& count)
+    {
+        bool animated = false;
+        count         = led_count_;
+
+        Color pixels[MAX_LEDS];
+        std::copy(colors_, colors_ + count, pixels);
 
-        // 删除任务
-        if (breathing_task_ != nullptr)
+        // 情绪颜色：每帧向目标权重移动一步，淡入淡出中途切换也不会跳变
+        int32_t target = emotion_active_ ? 256 : 0;
+        if (emotion_weight_ != target)
         {
-            breathing_task_->destroy();
-            breathing_task_.reset();
+            int32_t step    = std::max<int32_t>(1, 256 * FRAME_MS / EMOTION_FADE_MS);
+            emotion_weight_ = emotion_weight_ < target ? std::min(emotion_weight_ + step, target)
+                                                       : std::max(emotion_weight_ - step, target);
+            animated        = true;
+        }
+        if (emotion_weight_ > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                pixels[i] = mix(pixels[i], emotion_color_, emotion_weight_);
+            }
         }
 
-        // 关闭LED
-        if (breathing_config_.led_count == 1)
+        // 呼吸灯：三角波，前半周期变亮、后半周期变暗（感知上的均匀由 gamma 保证）
+        if (breathing_config_.is_running)
         {
-            Color black(0, 0, 0);
-            sendColor(black);
+            uint32_t cycle = breathing_config_.cycle_ms;
+            uint32_t half  = cycle / 2;
+            uint32_t phase = (uint32_t)(((now_us - breathing_config_.start_us) / 1000) % cycle);
+            uint32_t level = std::min<uint32_t>(
+                255, (phase < half ? phase : cycle - phase) * 255 / half);
+            Color color = scale(breathing_config_.color, level);
+            std::fill(pixels, pixels + count, color);
+            animated = true;
+        }
+
+        // 音频电平：叠加发光，饱和到 255。上升立即跟随，下降按 AUDIO_RELEASE_MS 回落（来源
+        // 突然归零或停止更新时也平滑熄灭）；只有发光强度在变化时才算动画，电平不变时不按帧率渲染
+        if (audio_active_)
+        {
+            int32_t level =
+                audio_source_ ? audio_source_() : audio_level_.load(std::memory_order_relaxed);
+            int32_t step = std::max<int32_t>(1, 255 * FRAME_MS / AUDIO_RELEASE_MS);
+            int32_t glow = std::max(level, (int32_t)audio_glow_ - step);
+            if (glow != audio_glow_)
+            {
+                audio_glow_ = (uint8_t)glow;
+                animated    = true;
+            }
+
+            Color color = scale(audio_color_, audio_glow_);
+            for (size_t i = 0; i < count; i++)
+            {
+                pixels[i] = Color((uint8_t)std::min(255, pixels[i].r + color.r),
+                                  (uint8_t)std::min(255, pixels[i].g + color.g),
+                                  (uint8_t)std::min(255, pixels[i].b + color.b));
+            }
         }
         else
         {
-            Color* colors = new Color[breathing_config_.led_count];
-            for (size_t i = 0; i < breathing_config_.led_count; i++)
+            audio_glow_ = 0;
+        }
+
+        // 闪烁：偶数个间隔点亮、奇数个间隔熄灭，次数用完后关闭LED
+        if (blink_config_.is_running)
+        {
+            int64_t phase = (now_us - blink_config_.start_us) / 1000 / blink_config_.interval_ms;
+            if (blink_config_.count >= 0 && phase >= 2 * (int64_t)blink_config_.count)
             {
-                colors[i] = Color(0, 0, 0);
+                blink_config_.is_running = false;
+                std::fill(colors_, colors_ + MAX_LEDS, Color());
+                std::fill(pixels, pixels + count, Color());
+                ESP_LOGI(TAG, "闪烁结束");
+            }
+            else
+            {
+                if (phase % 2 != 0)
+                {
+                    std::fill(pixels, pixels + count, Color());
+                }
+                animated = true;
             }
-            sendColors(colors, breathing_config_.led_count);
-            delete[] colors;
         }
 
-        ESP_LOGI(TAG, "停止呼吸灯 - GPIO: %d", gpio_num);
-        return true;
+        // gamma / 亮度查找表，输出 GRB
+        uint8_t brightness = brightness_.load(std::memory_order_relaxed);
+        if (lut_brightness_ != brightness)
+        {
+            buildLut(brightness);
+        }
+        uint8_t* frame = frames_[back_];
+        for (size_t i = 0; i < count; i++)
+        {
+            frame[i * 3 + 0] = lut_[pixels[i].g];
+            frame[i * 3 + 1] = lut_[pixels[i].r];
+            frame[i * 3 + 2] = lut_[pixels[i].b];
+        }
+        return animated;
     }
 
-    bool WS2812::updateBreathingColor(const Color& color)
+    bool WS2812::isNewFrame(size_t count) const
     {
-        if (!breathing_config_.is_running)
+        return count != sent_count_ || memcmp(frames_[back_], frames_[back_ ^ 1], count * 3) != 0;
+    }
+
+    void WS2812::waitTxDone()
+    {
+        // 通道重建等原因丢失完成回调时，最多等一帧周期
+        if (xSemaphoreTake(tx_done_sem_, pdMS_TO_TICKS(FRAME_MS)) != pdTRUE)
         {
-            ESP_LOGW(TAG, "呼吸灯未运行，无法更新颜色");
-            return false;
+            ESP_LOGW(TAG, "等待LED数据发送完成超时");
         }
 
-        // 更新颜色配置（呼吸灯任务会读取最新颜色）
-        breathing_config_.color = color;
-        return true;
+        // 完成回调在数据发完时触发，之后还需保持低电平复位时间
+        uint32_t elapsed_us = static_cast<uint32_t>(esp_timer_get_time()) -
+                              tx_done_us_.load(std::memory_order_acquire);
+        if (elapsed_us < WS2812_RESET_US)
+        {
+            esp_rom_delay_us(WS2812_RESET_US - elapsed_us);
+        }
     }
 
-    void WS2812::breathingTaskFunction(void* param)
+    bool WS2812::transmit(size_t count)
     {
-        uint32_t cycle_ms  = breathing_config_.cycle_ms;
-        size_t   led_count = breathing_config_.led_count;
-
-        ESP_LOGI(TAG, "呼吸灯任务开始 - 周期: %lu ms, LED数量: %lu", (unsigned long)cycle_ms,
-                 (unsigned long)led_count);
+        if (channel_handle_ == nullptr || encoder_handle_ == nullptr)
+        {
+            // 没有发送，完成回调不会到来
+            xSemaphoreGive(tx_done_sem_);
+            return false;
+        }
 
-        // 计算每步的延迟时间（使用100步来实现平滑的呼吸效果）
-        const uint32_t steps      = 100;
-        uint32_t       step_delay = cycle_ms / (2 * steps); // 一半时间上升，一半时间下降
+        rmt_transmit_config_t tx_config = {};
+        tx_config.loop_count            = 0;
+        tx_config.flags.eot_level       = 0;
 
-        while (breathing_config_.is_running)
+        // 发送在后台进行，下一帧渲染到另一块缓冲区
+        esp_err_t ret = rmt_transmit(channel_handle_, encoder_handle_, frames_[back_], count * 3,
+                                     &tx_config);
+        if (ret != ESP_OK)
         {
-            // 每次循环都读取最新的颜色（支持动态切换颜色）
-            Color base_color = breathing_config_.color;
-
-            // 上升阶段：从0到255
-            for (uint32_t step = 0; step <= steps && breathing_config_.is_running; step++)
-            {
-                // 每次循环都读取最新的颜色（支持动态切换颜色）
-                base_color = breathing_config_.color;
+            ESP_LOGE(TAG, "发送LED数据失败: %s", esp_err_to_name(ret));
+            xSemaphoreGive(tx_done_sem_);
+            return false;
+        }
+        sent_count_ = count;
+        back_ ^= 1;
+        return true;
+    }
 
-                // 计算当前亮度（0-255）
-                uint8_t brightness = (uint8_t)((step * 255) / steps);
+    bool IRAM_ATTR WS2812::onTransDone(rmt_channel_handle_t channel,
+                                       const rmt_tx_done_event_data_t* edata, void* user_ctx)
+    {
+        (void)channel;
+        (void)edata;
+        auto* self = static_cast<WS2812*>(user_ctx);
+        self->tx_done_us_.store(static_cast<uint32_t>(esp_timer_get_time()),
+                                std::memory_order_release);
+
+        BaseType_t higher_priority_task_woken = pdFALSE;
+        xSemaphoreGiveFromISR(self->tx_done_sem_, &higher_priority_task_woken);
+        return higher_priority_task_woken == pdTRUE;
+    }
 
-                // 根据亮度调整颜色
-                Color current_color;
-                current_color.r = (uint8_t)((base_color.r * brightness) / 255);
-                current_color.g = (uint8_t)((base_color.g * brightness) / 255);
-                current_color.b = (uint8_t)((base_color.b * brightness) / 255);
+    void WS2812::renderTaskFunction(void* param)
+    {
+        (void)param;
+        ESP_LOGI(TAG, "LED渲染任务开始运行，帧周期: %lu ms", (unsigned long)FRAME_MS);
 
-                // 发送颜色
-                if (led_count == 1)
-                {
-                    sendColor(current_color);
-                }
-                else
-                {
-                    Color* colors = new Color[led_count];
-                    for (size_t i = 0; i < led_count; i++)
-                    {
-                        colors[i] = current_color;
-                    }
-                    sendColors(colors, led_count);
-                    delete[] colors;
-                }
+        const TickType_t period    = std::max<TickType_t>(pdMS_TO_TICKS(FRAME_MS), 1);
+        TickType_t       last_wake = xTaskGetTickCount();
 
-                app::sys::task::TaskManager::delayMs(step_delay);
+        while (running_)
+        {
+            bool   animated = false;
+            bool   changed  = false;
+            bool   polled   = false;
+            size_t count    = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                animated = render(esp_timer_get_time(), count);
+                changed  = isNewFrame(count);
+                polled   = audio_active_ && audio_source_ != nullptr;
             }
 
-            // 下降阶段：从255到0
-            for (uint32_t step = steps; step > 0 && breathing_config_.is_running; step--)
+            // 与上一帧相同时不发送；等待上一帧发完时不持有锁，设置接口不会被阻塞
+            if (changed)
             {
-                // 每次循环都读取最新的颜色（支持动态切换颜色）
-                base_color = breathing_config_.color;
-
-                // 计算当前亮度（0-255）
-                uint8_t brightness = (uint8_t)((step * 255) / steps);
-
-                // 根据亮度调整颜色
-                Color current_color;
-                current_color.r = (uint8_t)((base_color.r * brightness) / 255);
-                current_color.g = (uint8_t)((base_color.g * brightness) / 255);
-                current_color.b = (uint8_t)((base_color.b * brightness) / 255);
+                waitTxDone();
+                std::lock_guard<std::mutex> lock(mutex_);
+                transmit(count);
+            }
 
-                // 发送颜色
-                if (led_count == 1)
-                {
-                    sendColor(current_color);
-                }
-                else
+            if (animated)
+            {
+                // 有动画时按帧率渲染，错过的帧不补
+                if (xTaskDelayUntil(&last_wake, period) == pdFALSE)
                 {
-                    Color* colors = new Color[led_count];
-                    for (size_t i = 0; i < led_count; i++)
-                    {
-                        colors[i] = current_color;
-                    }
-                    sendColors(colors, led_count);
-                    delete[] colors;
+                    last_wake = xTaskGetTickCount();
                 }
-
-                app::sys::task::TaskManager::delayMs(step_delay);
+                xSemaphoreTake(wake_sem_, 0);
+            }
+            else
+            {
+                // 画面静止时等待设置变化；电平来源只能轮询，此时按 AUDIO_POLL_MS 检查一次
+                xSemaphoreTake(wake_sem_, polled ? pdMS_TO_TICKS(AUDIO_POLL_MS) : portMAX_DELAY);
+                last_wake = xTaskGetTickCount();
             }
         }
 
-        // 任务结束，关闭LED
-        if (led_count == 1)
+        // 关闭LED，等最后一帧发完后归还缓冲区，下次启动时可以直接发送
+        memset(frames_[back_], 0, sizeof(frames_[back_]));
+        bool changed = false;
         {
-            Color black(0, 0, 0);
-            sendColor(black);
+            std::lock_guard<std::mutex> lock(mutex_);
+            changed = isNewFrame(sent_count_);
         }
-        else
+        if (changed)
         {
-            Color* colors = new Color[led_count];
-            for (size_t i = 0; i < led_count; i++)
-            {
-                colors[i] = Color(0, 0, 0);
-            }
-            sendColors(colors, led_count);
-            delete[] colors;
+            waitTxDone();
+            std::lock_guard<std::mutex> lock(mutex_);
+            transmit(sent_count_);
         }
+        waitTxDone();
+        xSemaphoreGive(tx_done_sem_);
 
-        breathing_config_.is_running = false;
-        ESP_LOGI(TAG, "呼吸灯任务结束");
+        ESP_LOGI(TAG, "LED渲染任务结束");
+        xSemaphoreGive(stopped_sem_);
+
+        // 等待 stopRenderTask() 删除本任务
+        while (true)
+        {
+            vTaskDelay(portMAX_DELAY);
+        }
     }
 
 } // namespace app::device::led
@@ -1,13 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include "driver/rmt_tx.h"
 #include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "system/task/task.hpp"
 
 namespace app::device::led
 {
+    constexpr size_t   MAX_LEDS         = 32;  // 级联 LED 数量上限（帧缓冲按此分配）
+    constexpr uint32_t FRAME_MS         = 20;  // 渲染帧周期（50fps）
+    constexpr uint32_t EMOTION_FADE_MS  = 300; // 情绪颜色淡入淡出时间
+    constexpr uint32_t AUDIO_RELEASE_MS = 300; // 音频电平发光从 255 回落到 0 的时间
+    constexpr uint32_t AUDIO_POLL_MS    = 100; // 画面静止时轮询电平来源的间隔
+
     // RGB颜色结构体
     struct Color
     {
@@ -19,10 +31,26 @@ namespace app::device::led
         Color(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
     };
 
-    // LED控制类
+    /**
+     * @brief LED控制类
+     *
+     * 所有效果由一个渲染任务按固定帧率合成，从下到上依次为：
+     * 静态颜色（setColor / setColors）→ 情绪颜色（淡入淡出覆盖）→ 呼吸灯（替换为呼吸颜色）
+     * → 音频电平（叠加发光）→ 闪烁（熄灭阶段输出黑色），最后经 gamma / 亮度查找表转换为 GRB。
+     *
+     * 帧数据写入两块常驻缓冲区轮流发送：RMT 发送当前帧时渲染下一帧，RMT 发送完成回调通知
+     * 上一帧已发完，渲染任务等待时不持有锁；与上一帧相同的帧不发送。没有动画效果时渲染任务
+     * 阻塞等待，设置变化时才重新渲染。
+     * 公共接口可以在任意任务中调用，立即返回。
+     */
     class WS2812
     {
     public:
+        /**
+         * @brief 音频电平来源（0-255），渲染任务每帧调用一次，不能阻塞
+         */
+        using LevelSource = std::function<uint8_t()>;
+
         WS2812();
         ~WS2812();
 
@@ -36,7 +64,7 @@ namespace app::device::led
         bool setBlinkConfig(gpio_num_t gpio_num, int32_t interval_ms, int32_t count);
 
         /**
-         * @brief 设置LED颜色
+         * @brief 设置LED颜色（所有级联的LED）
          * @param gpio_num GPIO引脚号
          * @param color 颜色值（RGB）
          * @return true 成功，false 失败
@@ -47,20 +75,20 @@ namespace app::device::led
          * @brief 设置多个LED颜色（用于级联的WS2812）
          * @param gpio_num GPIO引脚号
          * @param colors 颜色数组
-         * @param count LED数量
+         * @param count LED数量（最多 MAX_LEDS）
          * @return true 成功，false 失败
          */
         bool setColors(gpio_num_t gpio_num, const Color* colors, size_t count);
 
         /**
-         * @brief 开始闪烁功能
+         * @brief 开始闪烁功能（闪烁当前颜色）
          * @param gpio_num GPIO引脚号
          * @return true 成功，false 失败
          */
         bool startBlink(gpio_num_t gpio_num);
 
         /**
-         * @brief 停止闪烁功能
+         * @brief 停止闪烁功能并关闭LED
          * @param gpio_num GPIO引脚号
          * @return true 成功，false 失败
          */
@@ -80,7 +108,7 @@ namespace app::device::led
          */
         uint8_t getBrightness() const
         {
-            return brightness_;
+            return brightness_.load(std::memory_order_relaxed);
         }
 
         /**
@@ -95,7 +123,7 @@ namespace app::device::led
                             size_t led_count = 1);
 
         /**
-         * @brief 停止呼吸灯效果
+         * @brief 停止呼吸灯效果并关闭LED
          * @param gpio_num GPIO引脚号
          * @return true 成功，false 失败
          */
@@ -108,6 +136,51 @@ namespace app::device::led
          */
         bool updateBreathingColor(const Color& color);
 
+        /**
+         * @brief 设置情绪颜色，在 EMOTION_FADE_MS 内淡入覆盖静态颜色
+         * @param gpio_num GPIO引脚号
+         * @param color 情绪颜色
+         * @return true 成功，false 失败
+         */
+        bool setEmotionColor(gpio_num_t gpio_num, const Color& color);
+
+        /**
+         * @brief 清除情绪颜色（淡出）
+         */
+        void clearEmotionColor();
+
+        /**
+         * @brief 开启音频电平效果：按 setAudioLevel() 的电平叠加发光
+         * @param gpio_num GPIO引脚号
+         * @param color 电平最大时叠加的颜色
+         * @return true 成功，false 失败
+         */
+        bool enableAudioLevel(gpio_num_t gpio_num, const Color& color);
+
+        /**
+         * @brief 关闭音频电平效果
+         */
+        void disableAudioLevel();
+
+        /**
+         * @brief 更新音频电平，电平变化时唤醒渲染任务（不加锁，可在音频任务中调用）
+         * @param level 电平（0-255）
+         */
+        void setAudioLevel(uint8_t level)
+        {
+            if (audio_level_.exchange(level, std::memory_order_relaxed) != level)
+            {
+                wake();
+            }
+        }
+
+        /**
+         * @brief 设置音频电平来源，设置后渲染任务每帧读取，不再使用 setAudioLevel() 的值
+         * @param source 电平来源，空函数表示恢复使用 setAudioLevel()
+         * @note 电平不变时渲染任务不按帧率运行，改为每 AUDIO_POLL_MS 读取一次来源
+         */
+        void setAudioLevelSource(LevelSource source);
+
     private:
         // RMT编码器句柄
         rmt_encoder_handle_t encoder_handle_;
@@ -118,32 +191,56 @@ namespace app::device::led
         // 当前GPIO引脚
         gpio_num_t current_gpio_;
 
-        // 亮度值（0-100），默认100（最亮）
-        uint8_t brightness_;
+        // 亮度值（0-100），默认100（最亮），渲染任务每帧读取
+        std::atomic<uint8_t> brightness_{100};
+
+        // 以下效果参数由 mutex_ 保护
+        std::mutex mutex_;
+        Color      colors_[MAX_LEDS]; // 静态颜色
+        size_t     led_count_;        // 级联的LED数量
 
         // 闪烁参数
         struct BlinkConfig
         {
             int32_t interval_ms; // 闪烁间隔（毫秒），-1表示常亮
             int32_t count;       // 闪烁次数，-1表示无限
-            Color   color;       // 闪烁颜色
+            int64_t start_us;    // 开始时间（微秒）
             bool    is_running;  // 是否正在运行
         } blink_config_;
 
-        // 闪烁任务对象
-        std::unique_ptr<app::sys::task::Task> blink_task_;
-
         // 呼吸灯参数
         struct BreathingConfig
         {
             Color    color;      // 呼吸灯颜色
             uint32_t cycle_ms;   // 一个完整呼吸周期的时间（毫秒）
-            size_t   led_count;  // LED数量
+            int64_t  start_us;   // 开始时间（微秒）
             bool     is_running; // 是否正在运行
         } breathing_config_;
 
-        // 呼吸灯任务对象
-        std::unique_ptr<app::sys::task::Task> breathing_task_;
+        // 情绪颜色和音频电平
+        Color                emotion_color_;
+        bool                 emotion_active_;
+        Color                audio_color_;
+        bool                 audio_active_;
+        std::atomic<uint8_t> audio_level_{0};
+        LevelSource          audio_source_;
+
+        // 以下只在渲染任务中访问
+        int32_t emotion_weight_;          // 情绪颜色当前权重（0-256）
+        uint8_t audio_glow_;              // 音频电平当前发光强度（0-255，按 AUDIO_RELEASE_MS 回落）
+        uint8_t lut_[256];                // gamma 校正 + 亮度缩放查找表
+        uint8_t lut_brightness_;          // 查找表对应的亮度，0xFF 表示未建立
+        uint8_t frames_[2][MAX_LEDS * 3]; // GRB 帧缓冲，轮流发送
+        size_t  back_;                    // 下一帧渲染到的缓冲区
+        size_t  sent_count_;              // 上一帧发送的LED数量
+
+        // 渲染任务
+        std::unique_ptr<app::sys::task::Task> render_task_;
+        std::atomic<bool>                     running_{false};
+        SemaphoreHandle_t                     wake_sem_;      // 设置变化时唤醒渲染任务
+        SemaphoreHandle_t                     stopped_sem_;   // 渲染任务退出信号
+        SemaphoreHandle_t                     tx_done_sem_;   // 上一帧已发完（另一块缓冲区空闲）
+        std::atomic<uint32_t>                 tx_done_us_{0}; // 上一帧发完的时间（低 32 位）
 
         // 初始化RMT通道
         bool initRMTChannel(gpio_num_t gpio_num);
@@ -151,17 +248,37 @@ namespace app::device::led
         // 释放RMT通道
         void deinitRMTChannel();
 
-        // 发送颜色数据到WS2812
-        bool sendColor(const Color& color);
+        // 初始化RMT通道并确保渲染任务在运行（需持有 mutex_）
+        bool prepare(gpio_num_t gpio_num);
+
+        // 启动 / 停止渲染任务
+        bool startRenderTask();
+        void stopRenderTask();
+
+        // 唤醒渲染任务重新渲染
+        void wake();
+
+        // 合成一帧写入后台缓冲区，返回是否有动画效果（需要按帧率继续渲染），需持有 mutex_
+        bool render(int64_t now_us, size_t& count);
+
+        // 后台缓冲区是否与上一帧不同（需持有 mutex_）
+        bool isNewFrame(size_t count) const;
+
+        // 等待上一帧发送完成和复位时间（不能持有 mutex_）
+        void waitTxDone();
+
+        // 发送后台缓冲区，返回是否已启动发送（需持有 mutex_，调用前已 waitTxDone()）
+        bool transmit(size_t count);
 
-        // 发送多个LED颜色数据到WS2812
-        bool sendColors(const Color* colors, size_t count);
+        // RMT 发送完成回调（中断上下文）
+        static bool onTransDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t* edata,
+                                void* user_ctx);
 
-        // 闪烁任务函数
-        void blinkTaskFunction(void* param);
+        // 重建 gamma / 亮度查找表
+        void buildLut(uint8_t brightness);
 
-        // 呼吸灯任务函数
-        void breathingTaskFunction(void* param);
+        // 渲染任务函数
+        void renderTaskFunction(void* param);
     };
 
 } // namespace app::device::led
@@ -0,0 +1,212 @@
+#include "calibration.hpp"
+
+#include <cmath>
+
+namespace app
+{
+    namespace device
+    {
+        namespace m0404
+        {
+            namespace calibration
+            {
+                ZeroTracker::ZeroTracker(const Config& config) : config_(config) {}
+
+                void ZeroTracker::setConfig(const Config& config)
+                {
+                    config_ = config;
+                    resetWindow();
+                    quiet_run_ = 0;
+                }
+
+                void ZeroTracker::seed(const std::array<uint16_t, CELL_COUNT>& zero_points,
+                                       uint8_t confidence, uint32_t timestamp_ms)
+                {
+                    if (confidence > CONFIDENCE_MAX)
+                    {
+                        confidence = CONFIDENCE_MAX;
+                    }
+
+                    zero_points_          = zero_points;
+                    has_zero_             = true;
+                    evidence_             = (confidence * config_.confidence_windows + 50) / 100;
+                    stats_.last_update_ms = timestamp_ms;
+                    stats_.noise          = 0.0f;
+                    resetWindow();
+                    quiet_run_ = 0;
+                }
+
+                void ZeroTracker::clear()
+                {
+                    zero_points_.fill(0);
+                    has_zero_ = false;
+                    evidence_ = 0;
+                    stats_    = Stats();
+                    resetWindow();
+                    quiet_run_ = 0;
+                }
+
+                bool ZeroTracker::update(const std::array<uint16_t, CELL_COUNT>& raw,
+                                         uint32_t timestamp_ms)
+                {
+                    stats_.frames++;
+
+                    // 无触摸判断：尚无零点时无法判断，假设无人触摸，由窗口噪声检查把关
+                    bool quiet = true;
+                    if (has_zero_)
+                    {
+                        for (size_t i = 0; i < CELL_COUNT; i++)
+                        {
+                            int32_t offset = (int32_t)raw[i] - (int32_t)zero_points_[i];
+                            if (offset > (int32_t)config_.quiet_threshold)
+                            {
+                                quiet = false;
+                                break;
+                            }
+                        }
+                    }
+
+                    // 有触摸：丢弃当前窗口，松开后重新等待回弹
+                    if (!quiet)
+                    {
+                        if (count_ > 0)
+                        {
+                            stats_.windows_aborted++;
+                        }
+                        resetWindow();
+                        quiet_run_ = 0;
+                        return false;
+                    }
+
+                    quiet_run_++;
+                    if (has_zero_ && quiet_run_ <= config_.holdoff_frames)
+                    {
+                        return false;
+                    }
+
+                    // Welford 在线均值和方差
+                    stats_.quiet_frames++;
+                    count_++;
+                    for (size_t i = 0; i < CELL_COUNT; i++)
+                    {
+                        float value = raw[i];
+                        float delta = value - mean_[i];
+                        mean_[i] += delta / count_;
+                        m2_[i] += delta * (value - mean_[i]);
+                    }
+
+                    if (count_ < config_.window_frames)
+                    {
+                        return false;
+                    }
+
+                    bool changed = finishWindow(timestamp_ms);
+                    resetWindow();
+                    return changed;
+                }
+
+                uint8_t ZeroTracker::getConfidence(uint32_t now_ms) const
+                {
+                    if (!has_zero_ || config_.confidence_windows == 0)
+                    {
+                        return 0;
+                    }
+
+                    // 证据：有效窗口数占比
+                    uint32_t evidence = evidence_ < config_.confidence_windows
+                                            ? evidence_
+                                            : config_.confidence_windows;
+                    float    score    = (float)evidence / config_.confidence_windows;
+
+                    // 稳定性：噪声达到上限时减半
+                    if (config_.noise_max > 0.0f)
+                    {
+                        float ratio = stats_.noise / config_.noise_max;
+                        score *= 1.0f - 0.5f * (ratio < 1.0f ? ratio : 1.0f);
+                    }
+
+                    // 时效：超过 stale_ms 后线性衰减，到 expire_ms 为 0
+                    uint32_t age = now_ms - stats_.last_update_ms;
+                    if (age > config_.stale_ms)
+                    {
+                        if (age >= config_.expire_ms || config_.expire_ms <= config_.stale_ms)
+                        {
+                            return 0;
+                        }
+                        score *= 1.0f - (float)(age - config_.stale_ms) /
+                                            (config_.expire_ms - config_.stale_ms);
+                    }
+
+                    return (uint8_t)lroundf(score * CONFIDENCE_MAX);
+                }
+
+                void ZeroTracker::resetWindow()
+                {
+                    mean_.fill(0.0f);
+                    m2_.fill(0.0f);
+                    count_ = 0;
+                }
+
+                bool ZeroTracker::finishWindow(uint32_t timestamp_ms)
+                {
+                    // 计算各点位标准差，任何一点噪声过大都说明不是静止状态
+                    std::array<float, CELL_COUNT> sigma{};
+                    float                         noise_sum = 0.0f;
+                    for (size_t i = 0; i < CELL_COUNT; i++)
+                    {
+                        sigma[i] = count_ > 1 ? sqrtf(m2_[i] / (count_ - 1)) : 0.0f;
+                        if (sigma[i] > config_.noise_max)
+                        {
+                            stats_.windows_noisy++;
+                            if (evidence_ > 0)
+                            {
+                                evidence_--;
+                            }
+                            return false;
+                        }
+                        noise_sum += sigma[i];
+                    }
+
+                    stats_.windows_accepted++;
+                    stats_.noise          = noise_sum / CELL_COUNT;
+                    stats_.last_update_ms = timestamp_ms;
+                    if (evidence_ < config_.confidence_windows)
+                    {
+                        evidence_++;
+                    }
+
+                    // 候选零点低于当前值时立即跟随，高于时限速上调
+                    bool changed = !has_zero_;
+                    for (size_t i = 0; i < CELL_COUNT; i++)
+                    {
+                        float candidate = mean_[i] + config_.margin_sigma * sigma[i];
+                        long  target    = lroundf(candidate);
+                        if (target < 0)
+                        {
+                            target = 0;
+                        }
+                        if (target > UINT16_MAX)
+                        {
+                            target = UINT16_MAX;
+                        }
+
+                        if (has_zero_ && target > (long)zero_points_[i] + config_.max_step_up)
+                        {
+                            target = (long)zero_points_[i] + config_.max_step_up;
+                        }
+
+                        if ((uint16_t)target != zero_points_[i])
+                        {
+                            zero_points_[i] = (uint16_t)target;
+                            changed         = true;
+                        }
+                    }
+
+                    has_zero_ = true;
+                    return changed;
+                }
+
+            } // namespace calibration
+        } // namespace m0404
+    } // namespace device
+} // namespace app
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace app
+{
+    namespace device
+    {
+        namespace m0404
+        {
+            namespace calibration
+            {
+                constexpr size_t  CELL_COUNT     = 16;  // 压力点位数
+                constexpr uint8_t CONFIDENCE_MAX = 100; // 置信度上限（百分比）
+
+                /**
+                 * @brief 在线零点估计参数
+                 */
+                struct Config
+                {
+                    uint16_t quiet_threshold;    // 所有点位补偿后不超过此值视为"无触摸"帧
+                    uint32_t holdoff_frames;     // 触摸结束后等待织物回弹的帧数（不参与统计）
+                    uint32_t window_frames;      // 一个统计窗口的无触摸帧数
+                    float    noise_max;          // 窗口内单点标准差上限，超过则丢弃该窗口
+                    float    margin_sigma;       // 零点 = 均值 + margin_sigma * 标准差
+                    uint16_t max_step_up;        // 每个窗口零点最多上调的量（下调不限）
+                    uint32_t confidence_windows; // 置信度达到 100% 所需的有效窗口数
+                    uint32_t stale_ms;           // 超过此时间未更新，置信度开始衰减
+                    uint32_t expire_ms;          // 超过此时间未更新，置信度衰减到 0
+
+                    Config()
+                        : quiet_threshold(30), holdoff_frames(20), window_frames(50),
+                          noise_max(8.0f), margin_sigma(2.0f), max_step_up(4),
+                          confidence_windows(6), stale_ms(10 * 60 * 1000),
+                          expire_ms(60 * 60 * 1000)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 在线零点估计统计
+                 */
+                struct Stats
+                {
+                    uint32_t frames;           // 处理的帧数
+                    uint32_t quiet_frames;     // 参与统计的无触摸帧数
+                    uint32_t windows_accepted; // 采纳的窗口数
+                    uint32_t windows_noisy;    // 因噪声过大丢弃的窗口数
+                    uint32_t windows_aborted;  // 因触摸中断的窗口数
+                    uint32_t last_update_ms;   // 最近一次更新零点的时间
+                    float    noise;            // 最近一个采纳窗口的平均标准差
+
+                    Stats()
+                        : frames(0), quiet_frames(0), windows_accepted(0), windows_noisy(0),
+                          windows_aborted(0), last_update_ms(0), noise(0.0f)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 压力阵列在线零点估计器
+                 *
+                 * 在数据采集路径中逐帧调用 update()。只有"无触摸"帧（所有点位相对当前零点
+                 * 不超过 quiet_threshold，且触摸结束后已等待 holdoff_frames 帧）参与统计，
+                 * 每个点位用 Welford 算法累计均值和方差。凑满一个窗口且噪声正常时，
+                 * 以 均值 + margin_sigma * 标准差 作为候选零点（margin_sigma 倍标准差为安全余量）：
+                 * 低于当前零点时立即跟随（跟踪最小值），高于时每个窗口最多上调 max_step_up，
+                 * 防止缓慢按压被吸收进零点。尚无零点时不做触摸判断，第一个平稳窗口直接采纳。
+                 *
+                 * @note 非线程安全，应在同一个任务中调用 update()
+                 */
+                class ZeroTracker
+                {
+                public:
+                    explicit ZeroTracker(const Config& config = Config());
+
+                    /**
+                     * @brief 设置估计参数（会重置窗口状态）
+                     * @param config 估计参数
+                     */
+                    void setConfig(const Config& config);
+
+                    /**
+                     * @brief 获取估计参数
+                     */
+                    const Config& getConfig() const
+                    {
+                        return config_;
+                    }
+
+                    /**
+                     * @brief 以已知零点（NVS 或手动标定）为起点
+                     * @param zero_points 零点值
+                     * @param confidence 初始置信度（0 ~ 100）
+                     * @param timestamp_ms 当前时间（毫秒）
+                     */
+                    void seed(const std::array<uint16_t, CELL_COUNT>& zero_points,
+                              uint8_t confidence, uint32_t timestamp_ms);
+
+                    /**
+                     * @brief 清除零点和统计，重新从第一个平稳窗口开始估计
+                     */
+                    void clear();
+
+                    /**
+                     * @brief 处理一帧原始压力数据（未做零点补偿）
+                     * @param raw 16 个点位的原始值
+                     * @param timestamp_ms 帧时间戳（毫秒）
+                     * @return true 零点已更新, false 未更新
+                     */
+                    bool update(const std::array<uint16_t, CELL_COUNT>& raw, uint32_t timestamp_ms);
+
+                    /**
+                     * @brief 是否已有零点
+                     */
+                    bool hasZeroPoints() const
+                    {
+                        return has_zero_;
+                    }
+
+                    /**
+                     * @brief 获取当前零点
+                     */
+                    const std::array<uint16_t, CELL_COUNT>& getZeroPoints() const
+                    {
+                        return zero_points_;
+                    }
+
+                    /**
+                     * @brief 获取零点置信度
+                     *
+                     * 由有效窗口数（证据）、最近窗口的噪声水平和距上次更新的时间共同决定。
+                     *
+                     * @param now_ms 当前时间（毫秒）
+                     * @return 置信度（0 ~ 100）
+                     */
+                    uint8_t getConfidence(uint32_t now_ms) const;
+
+                    /**
+                     * @brief 获取统计信息
+                     */
+                    const Stats& getStats() const
+                    {
+                        return stats_;
+                    }
+
+                private:
+                    // 清空当前窗口的累计值
+                    void resetWindow();
+
+                    // 窗口凑满后计算候选零点并更新，返回零点是否变化
+                    bool finishWindow(uint32_t timestamp_ms);
+
+                    Config config_;
+                    Stats  stats_;
+
+                    std::array<uint16_t, CELL_COUNT> zero_points_{};
+                    bool                             has_zero_ = false;
+                    uint32_t                         evidence_ = 0; // 有效窗口数（封顶）
+
+                    // 当前窗口的 Welford 累计值
+                    std::array<float, CELL_COUNT> mean_{};
+                    std::array<float, CELL_COUNT> m2_{};
+                    uint32_t                      count_     = 0;
+                    uint32_t                      quiet_run_ = 0; // 连续无触摸帧数
+                };
+
+            } // namespace calibration
+        } // namespace m0404
+    } // namespace device
+} // namespace app
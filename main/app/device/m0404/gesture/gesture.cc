@@ -0,0 +1,312 @@
+#include "gesture.hpp"
+
+#include <cstdlib>
+
+namespace app
+{
+    namespace device
+    {
+        namespace m0404
+        {
+            namespace gesture
+            {
+                namespace
+                {
+                    // 每个点位的列/行坐标（Q8），避免逐帧做除法和取模
+                    constexpr std::array<int32_t, CELL_COUNT> makeColumnTable()
+                    {
+                        std::array<int32_t, CELL_COUNT> table{};
+                        for (size_t i = 0; i < CELL_COUNT; i++)
+                        {
+                            table[i] = static_cast<int32_t>(i % GRID_COLS) * Q8_ONE;
+                        }
+                        return table;
+                    }
+
+                    constexpr std::array<int32_t, CELL_COUNT> makeRowTable()
+                    {
+                        std::array<int32_t, CELL_COUNT> table{};
+                        for (size_t i = 0; i < CELL_COUNT; i++)
+                        {
+                            table[i] = static_cast<int32_t>(i / GRID_COLS) * Q8_ONE;
+                        }
+                        return table;
+                    }
+
+                    constexpr std::array<int32_t, CELL_COUNT> COLUMN_Q8 = makeColumnTable();
+                    constexpr std::array<int32_t, CELL_COUNT> ROW_Q8    = makeRowTable();
+
+                    int32_t maxAbs(int32_t a, int32_t b)
+                    {
+                        a = std::abs(a);
+                        b = std::abs(b);
+                        return (a > b) ? a : b;
+                    }
+                } // namespace
+
+                GestureEngine::GestureEngine(const Config& config) : config_(config) {}
+
+                void GestureEngine::setConfig(const Config& config)
+                {
+                    config_ = config;
+                    reset();
+                }
+
+                void GestureEngine::reset()
+                {
+                    features_         = FrameFeatures();
+                    history_head_     = 0;
+                    history_count_    = 0;
+                    session_active_   = false;
+                    session_start_    = 0;
+                    session_last_     = 0;
+                    session_start_x_  = 0;
+                    session_start_y_  = 0;
+                    session_travel_   = 0;
+                    session_peak_     = 0;
+                    session_contacts_ = 0;
+                    release_frames_   = 0;
+                    stroke_emitted_   = false;
+                    hold_emitted_     = false;
+                    squeeze_emitted_  = false;
+                }
+
+                void GestureEngine::computeFeatures(
+                    const std::array<uint16_t, CELL_COUNT>& pressures, uint32_t timestamp_ms)
+                {
+                    const uint32_t threshold = config_.contact_threshold;
+
+                    uint32_t total   = 0;
+                    uint32_t max_val = 0;
+                    uint32_t mask    = 0;
+                    int64_t  sum_x   = 0;
+                    int64_t  sum_y   = 0;
+
+                    // 单次遍历，循环体无数据相关分支，便于编译器展开
+                    for (size_t i = 0; i < CELL_COUNT; i++)
+                    {
+                        const uint32_t raw    = pressures[i];
+                        const uint32_t active = (raw > threshold) ? 1U : 0U;
+                        const uint32_t value  = raw * active;
+
+                        total += value;
+                        max_val = (value > max_val) ? value : max_val;
+                        mask |= active << i;
+                        sum_x += static_cast<int64_t>(value) * COLUMN_Q8[i];
+                        sum_y += static_cast<int64_t>(value) * ROW_Q8[i];
+                    }
+
+                    features_.timestamp     = timestamp_ms;
+                    features_.total_force   = total;
+                    features_.max_pressure  = static_cast<uint16_t>(max_val);
+                    features_.contact_mask  = static_cast<uint16_t>(mask);
+                    features_.contact_count = static_cast<uint8_t>(__builtin_popcount(mask));
+
+                    if (total > 0)
+                    {
+                        features_.centroid_x = static_cast<int32_t>(sum_x / total);
+                        features_.centroid_y = static_cast<int32_t>(sum_y / total);
+                    }
+                }
+
+                void GestureEngine::updateVelocity()
+                {
+                    features_.velocity_x = 0;
+                    features_.velocity_y = 0;
+
+                    if (history_count_ < 2)
+                    {
+                        return;
+                    }
+
+                    const size_t newest = (history_head_ + HISTORY_SIZE - 1) % HISTORY_SIZE;
+                    const size_t oldest =
+                        (history_head_ + HISTORY_SIZE - history_count_) % HISTORY_SIZE;
+
+                    const uint32_t dt = history_[newest].timestamp - history_[oldest].timestamp;
+                    if (dt == 0)
+                    {
+                        return;
+                    }
+
+                    features_.velocity_x =
+                        (history_[newest].x - history_[oldest].x) * 1000 / static_cast<int32_t>(dt);
+                    features_.velocity_y =
+                        (history_[newest].y - history_[oldest].y) * 1000 / static_cast<int32_t>(dt);
+                }
+
+                void GestureEngine::fillEvent(GestureEvent& event, GestureType type,
+                                              StrokeDirection direction) const
+                {
+                    event.type          = type;
+                    event.direction     = direction;
+                    event.duration_ms   = session_last_ - session_start_;
+                    event.peak_force    = session_peak_;
+                    event.peak_contacts = session_contacts_;
+                    event.features      = features_;
+                }
+
+                bool GestureEngine::process(const std::array<uint16_t, CELL_COUNT>& pressures,
+                                            uint32_t timestamp_ms, GestureEvent& event)
+                {
+                    computeFeatures(pressures, timestamp_ms);
+
+                    // 无接触：判断是否松开，松开时识别轻拍
+                    if (features_.contact_count == 0)
+                    {
+                        features_.velocity_x = 0;
+                        features_.velocity_y = 0;
+
+                        if (!session_active_)
+                        {
+                            return false;
+                        }
+
+                        release_frames_++;
+                        if (release_frames_ < config_.session_end_frames)
+                        {
+                            return false;
+                        }
+
+                        session_active_ = false;
+                        history_count_  = 0;
+
+                        const uint32_t duration = session_last_ - session_start_;
+                        if (!stroke_emitted_ && !hold_emitted_ && !squeeze_emitted_ &&
+                            duration <= config_.pat_max_duration_ms &&
+                            session_travel_ <= config_.still_max_distance)
+                        {
+                            fillEvent(event, GestureType::PAT, StrokeDirection::NONE);
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    // 有接触：开始或延续一次接触会话
+                    release_frames_ = 0;
+                    if (!session_active_)
+                    {
+                        session_active_   = true;
+                        session_start_    = timestamp_ms;
+                        session_start_x_  = features_.centroid_x;
+                        session_start_y_  = features_.centroid_y;
+                        session_travel_   = 0;
+                        session_peak_     = 0;
+                        session_contacts_ = 0;
+                        stroke_emitted_   = false;
+                        hold_emitted_     = false;
+                        squeeze_emitted_  = false;
+                        history_head_     = 0;
+                        history_count_    = 0;
+                    }
+                    session_last_ = timestamp_ms;
+
+                    history_[history_head_] = {timestamp_ms, features_.centroid_x,
+                                               features_.centroid_y};
+                    history_head_           = (history_head_ + 1) % HISTORY_SIZE;
+                    if (history_count_ < HISTORY_SIZE)
+                    {
+                        history_count_++;
+                    }
+                    updateVelocity();
+
+                    if (features_.total_force > session_peak_)
+                    {
+                        session_peak_ = features_.total_force;
+                    }
+                    if (features_.contact_count > session_contacts_)
+                    {
+                        session_contacts_ = features_.contact_count;
+                    }
+
+                    const int32_t dx       = features_.centroid_x - session_start_x_;
+                    const int32_t dy       = features_.centroid_y - session_start_y_;
+                    const int32_t distance = maxAbs(dx, dy);
+                    if (distance > session_travel_)
+                    {
+                        session_travel_ = distance;
+                    }
+
+                    // 挤压：大面积且大力度，每次接触只触发一次
+                    if (!squeeze_emitted_ &&
+                        features_.contact_count >= config_.squeeze_min_contacts &&
+                        features_.total_force >= config_.squeeze_min_force)
+                    {
+                        squeeze_emitted_ = true;
+                        fillEvent(event, GestureType::SQUEEZE, StrokeDirection::NONE);
+                        return true;
+                    }
+
+                    // 抚摸：质心位移和速度都超过阈值，触发后以当前位置为新起点，支持连续抚摸
+                    const int32_t speed = maxAbs(features_.velocity_x, features_.velocity_y);
+                    if (distance >= config_.stroke_min_distance &&
+                        speed >= config_.stroke_min_speed)
+                    {
+                        StrokeDirection direction;
+                        if (std::abs(dy) >= std::abs(dx))
+                        {
+                            direction = (dy > 0) ? StrokeDirection::UP : StrokeDirection::DOWN;
+                        }
+                        else
+                        {
+                            direction = (dx > 0) ? StrokeDirection::RIGHT : StrokeDirection::LEFT;
+                        }
+
+                        stroke_emitted_  = true;
+                        session_start_x_ = features_.centroid_x;
+                        session_start_y_ = features_.centroid_y;
+                        fillEvent(event, GestureType::STROKE, direction);
+                        return true;
+                    }
+
+                    // 按住：接触时间足够长且质心基本不动
+                    if (!hold_emitted_ && !stroke_emitted_ &&
+                        (timestamp_ms - session_start_) >= config_.hold_min_duration_ms &&
+                        session_travel_ <= config_.still_max_distance)
+                    {
+                        hold_emitted_ = true;
+                        fillEvent(event, GestureType::HOLD, StrokeDirection::NONE);
+                        return true;
+                    }
+
+                    return false;
+                }
+
+                const char* getGestureName(GestureType type)
+                {
+                    switch (type)
+                    {
+                    case GestureType::STROKE:
+                        return "抚摸";
+                    case GestureType::PAT:
+                        return "轻拍";
+                    case GestureType::HOLD:
+                        return "按住";
+                    case GestureType::SQUEEZE:
+                        return "挤压";
+                    default:
+                        return "无";
+                    }
+                }
+
+                const char* getDirectionName(StrokeDirection direction)
+                {
+                    switch (direction)
+                    {
+                    case StrokeDirection::UP:
+                        return "从下往上";
+                    case StrokeDirection::DOWN:
+                        return "从上往下";
+                    case StrokeDirection::LEFT:
+                        return "从右往左";
+                    case StrokeDirection::RIGHT:
+                        return "从左往右";
+                    default:
+                        return "无方向";
+                    }
+                }
+
+            } // namespace gesture
+        } // namespace m0404
+    } // namespace device
+} // namespace app
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace app
+{
+    namespace device
+    {
+        namespace m0404
+        {
+            namespace gesture
+            {
+                // 压力阵列布局：4x4，传感器索引 i 对应 行 = i / 4（0 为最下面一行），列 = i % 4
+                constexpr size_t GRID_ROWS  = 4;
+                constexpr size_t GRID_COLS  = 4;
+                constexpr size_t CELL_COUNT = GRID_ROWS * GRID_COLS;
+
+                // 定点数格式：Q8（1 个格子 = 256）
+                constexpr int32_t Q8_ONE = 256;
+
+                // 质心历史帧数（用于计算质心速度）
+                constexpr size_t HISTORY_SIZE = 8;
+
+                /**
+                 * @brief 手势类型
+                 */
+                enum class GestureType : uint8_t
+                {
+                    NONE    = 0, // 无手势
+                    STROKE  = 1, // 抚摸（质心持续移动）
+                    PAT     = 2, // 轻拍（短时接触后松开）
+                    HOLD    = 3, // 按住（长时间接触且质心基本不动）
+                    SQUEEZE = 4  // 挤压（大面积、大力度接触）
+                };
+
+                /**
+                 * @brief 抚摸方向
+                 * @note UP 表示从下往上（行 0 -> 行 3，即传感器 0->4->8->12）
+                 */
+                enum class StrokeDirection : uint8_t
+                {
+                    NONE  = 0, // 无方向
+                    UP    = 1, // 从下往上
+                    DOWN  = 2, // 从上往下
+                    LEFT  = 3, // 从右往左
+                    RIGHT = 4  // 从左往右
+                };
+
+                /**
+                 * @brief 单帧压力分析结果
+                 * @note 坐标和速度均为 Q8 定点数，单位分别为 格 和 格/秒
+                 */
+                struct FrameFeatures
+                {
+                    uint32_t timestamp;     // 帧时间戳（毫秒）
+                    uint32_t total_force;   // 激活点压力总和
+                    uint16_t max_pressure;  // 最大单点压力
+                    uint16_t contact_mask;  // 激活点位掩码（bit i 对应传感器 i）
+                    uint8_t  contact_count; // 激活点数量
+                    int32_t  centroid_x;    // 压力加权质心列坐标（Q8，0 ~ 3*256）
+                    int32_t  centroid_y;    // 压力加权质心行坐标（Q8，0 ~ 3*256）
+                    int32_t  velocity_x;    // 质心列方向速度（Q8 格/秒）
+                    int32_t  velocity_y;    // 质心行方向速度（Q8 格/秒）
+
+                    FrameFeatures()
+                        : timestamp(0), total_force(0), max_pressure(0), contact_mask(0),
+                          contact_count(0), centroid_x(0), centroid_y(0), velocity_x(0),
+                          velocity_y(0)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 手势事件
+                 */
+                struct GestureEvent
+                {
+                    GestureType     type;          // 手势类型
+                    StrokeDirection direction;     // 抚摸方向（仅 STROKE 有效）
+                    uint32_t        duration_ms;   // 本次接触已持续时间
+                    uint32_t        peak_force;    // 本次接触的峰值总压力
+                    uint8_t         peak_contacts; // 本次接触的峰值激活点数
+                    FrameFeatures   features;      // 触发时的帧特征
+
+                    GestureEvent()
+                        : type(GestureType::NONE), direction(StrokeDirection::NONE),
+                          duration_ms(0), peak_force(0), peak_contacts(0)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 手势识别参数
+                 */
+                struct Config
+                {
+                    uint16_t contact_threshold;    // 激活阈值，超过此值认为该点被触摸
+                    uint32_t pat_max_duration_ms;  // 轻拍最长接触时间
+                    uint32_t hold_min_duration_ms; // 按住最短接触时间
+                    int32_t  stroke_min_distance;  // 抚摸最小质心位移（Q8 格）
+                    int32_t  stroke_min_speed;     // 抚摸最小质心速度（Q8 格/秒）
+                    int32_t  still_max_distance;   // 视为"静止"的最大质心位移（Q8 格）
+                    uint8_t  squeeze_min_contacts; // 挤压最少激活点数
+                    uint32_t squeeze_min_force;    // 挤压最小总压力
+                    uint32_t session_end_frames;   // 连续多少帧无接触视为松开
+
+                    Config()
+                        : contact_threshold(30), pat_max_duration_ms(350),
+                          hold_min_duration_ms(800), stroke_min_distance(Q8_ONE * 3 / 2),
+                          stroke_min_speed(Q8_ONE * 2), still_max_distance(Q8_ONE / 2),
+                          squeeze_min_contacts(6), squeeze_min_force(3000), session_end_frames(1)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 压力阵列手势引擎
+                 *
+                 * 每帧计算总压力、加权质心、激活点数和质心速度，
+                 * 并基于一次接触（按下到松开）的统计信息识别抚摸、轻拍、按住和挤压手势。
+                 * 全部使用整数运算，单帧处理只遍历一次 16 个点位。
+                 *
+                 * @note 非线程安全，应在同一个任务中调用 process()
+                 */
+                class GestureEngine
+                {
+                public:
+                    explicit GestureEngine(const Config& config = Config());
+
+                    /**
+                     * @brief 设置识别参数（会重置内部状态）
+                     * @param config 识别参数
+                     */
+                    void setConfig(const Config& config);
+
+                    /**
+                     * @brief 获取识别参数
+                     */
+                    const Config& getConfig() const
+                    {
+                        return config_;
+                    }
+
+                    /**
+                     * @brief 重置内部状态
+                     */
+                    void reset();
+
+                    /**
+                     * @brief 处理一帧压力数据
+                     * @param pressures 16 个点位的压力值（已做零点补偿）
+                     * @param timestamp_ms 帧时间戳（毫秒）
+                     * @param event 输出识别到的手势事件
+                     * @return true 本帧识别到手势, false 无手势
+                     * @note 每帧最多输出一个手势事件
+                     */
+                    bool process(const std::array<uint16_t, CELL_COUNT>& pressures,
+                                 uint32_t timestamp_ms, GestureEvent& event);
+
+                    /**
+                     * @brief 获取最近一帧的分析结果
+                     */
+                    const FrameFeatures& getFeatures() const
+                    {
+                        return features_;
+                    }
+
+                    /**
+                     * @brief 当前是否处于接触中
+                     */
+                    bool isTouching() const
+                    {
+                        return session_active_;
+                    }
+
+                private:
+                    // 计算单帧特征（总压力、质心、激活点）
+                    void computeFeatures(const std::array<uint16_t, CELL_COUNT>& pressures,
+                                         uint32_t timestamp_ms);
+
+                    // 根据质心历史计算速度
+                    void updateVelocity();
+
+                    // 填充手势事件
+                    void fillEvent(GestureEvent& event, GestureType type,
+                                   StrokeDirection direction) const;
+
+                    Config        config_;
+                    FrameFeatures features_;
+
+                    // 质心历史（环形缓冲，仅保存当前接触期间的帧）
+                    struct HistoryEntry
+                    {
+                        uint32_t timestamp;
+                        int32_t  x;
+                        int32_t  y;
+                    };
+                    std::array<HistoryEntry, HISTORY_SIZE> history_{};
+                    size_t                                 history_head_  = 0;
+                    size_t                                 history_count_ = 0;
+
+                    // 当前接触会话
+                    bool     session_active_   = false;
+                    uint32_t session_start_    = 0; // 按下时间
+                    uint32_t session_last_     = 0; // 最后一帧有接触的时间
+                    int32_t  session_start_x_  = 0; // 起始质心（抚摸触发后重新计起点）
+                    int32_t  session_start_y_  = 0;
+                    int32_t  session_travel_   = 0; // 质心相对按下位置的最大位移（Q8）
+                    uint32_t session_peak_     = 0; // 峰值总压力
+                    uint8_t  session_contacts_ = 0; // 峰值激活点数
+                    uint32_t release_frames_   = 0; // 连续无接触帧数
+                    bool     stroke_emitted_   = false;
+                    bool     hold_emitted_     = false;
+                    bool     squeeze_emitted_  = false;
+                };
+
+                /**
+                 * @brief 获取手势名称
+                 */
+                const char* getGestureName(GestureType type);
+
+                /**
+                 * @brief 获取抚摸方向名称
+                 */
+                const char* getDirectionName(StrokeDirection direction);
+
+            } // namespace gesture
+        } // namespace m0404
+    } // namespace device
+} // namespace app
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <esp_log.h>
 #include "system/task/task.hpp"
+#include "tool/recorder/recorder.hpp"
 #include "driver/uart.h"
 #include "nvs.h"
 
@@ -15,12 +16,20 @@ static const char* const TAG                = "M0404";
 static const char* const NVS_NAMESPACE      = "m0404";
 static const char* const NVS_KEY_ZERO_POINT = "zero_point";
 
+// 在线零点标定的 NVS 写入策略（减少 Flash 擦写）
+static constexpr uint32_t ZERO_SAVE_MIN_INTERVAL_MS = 30 * 60 * 1000; // 两次写入的最小间隔
+static constexpr uint16_t ZERO_SAVE_MIN_DELTA       = 8;  // 任一点位变化超过此值才写入
+static constexpr uint8_t  ZERO_SAVE_MIN_CONFIDENCE  = 60; // 置信度达到此值才写入
+static constexpr uint8_t  ZERO_LOADED_CONFIDENCE    = 50; // 从NVS加载的零点的初始置信度
+
 namespace app
 {
     namespace device
     {
         namespace m0404
         {
+            static_assert(calibration::CELL_COUNT == PRESSURE_COUNT, "零点估计点位数不匹配");
+
             M0404::~M0404()
             {
                 stopDataCollection();
@@ -76,6 +85,7 @@ namespace app
                 initialized_ = true;
 
                 // 初始化零点值
+                std::lock_guard<std::mutex> lock(zero_mutex_);
                 zero_points_.fill(0);
                 zero_point_calibrated_ = false;
 
@@ -86,15 +96,22 @@ namespace app
                 last_touch_detect_time_ = 0;
                 last_activated_row_     = -1;
                 current_activated_row_  = -1;
+                gesture_engine_.reset();
 
-                // 尝试从NVS加载零点值
+                // 尝试从NVS加载零点值，作为在线标定的起点
+                uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                last_save_time_ = now;
                 if (loadZeroPointFromNVS())
                 {
                     ESP_LOGI(TAG, "已从NVS加载零点标定值");
+                    zero_tracker_.seed(zero_points_, ZERO_LOADED_CONFIDENCE, now);
+                    saved_zero_points_ = zero_points_;
                 }
                 else
                 {
-                    ESP_LOGI(TAG, "未找到保存的零点标定值，需要执行标定");
+                    ESP_LOGI(TAG, "未找到保存的零点标定值，将在无触摸时自动标定");
+                    zero_tracker_.clear();
+                    saved_zero_points_.fill(0);
                 }
 
                 ESP_LOGI(TAG, "M0404 压力传感器初始化成功 (UART%d, 波特率: %d)", uart_num_,
@@ -490,10 +507,21 @@ namespace app
                 {
                     // 读取压力数据
                     PressureData data;
-                    if (read(data))
+                    if (readRaw(data))
                     {
+                        // 在线零点标定使用原始值，之后再做零点补偿
+                        updateOnlineCalibration(data);
+                        applyZeroPointCompensation(data);
+
                         // 更新最新的压力数据（供外部获取）
-                        latest_data_ = data;
+                        {
+                            std::lock_guard<std::mutex> lock(data_mutex_);
+                            latest_data_ = data;
+                        }
+
+                        // 写入飞行记录器
+                        tool::recorder::Recorder::getInstance().recordPressure(
+                            data.pressures.data(), data.pressures.size());
 
                         uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
 
@@ -586,6 +614,9 @@ namespace app
                             detectTouchState(data);
                         }
 
+                        // 逐帧手势识别（无压力的帧用于判断松开）
+                        processGesture(data);
+
                         // 触发回调（只在状态变化时，且只在有压力时输出）
                         if (last_pressure_status != current_status || last_pressure_status == -1)
                         {
@@ -678,24 +709,34 @@ namespace app
 
                 // 计算平均值，并加上波动范围的一半作为安全余量
                 // 这样可以确保标定后的值更稳定
+                std::array<uint16_t, PRESSURE_COUNT> zero_points;
                 for (size_t i = 0; i < PRESSURE_COUNT; i++)
                 {
                     uint32_t avg   = sum[i] / valid_samples;
                     uint16_t range = max_val[i] - min_val[i];
                     // 零点值 = 平均值 + 波动范围的一半，这样标定后相对值会更接近0
-                    zero_points_[i] = (uint16_t)(avg + range / 2);
+                    zero_points[i] = (uint16_t)(avg + range / 2);
                 }
 
-                zero_point_calibrated_ = true;
-
-                // 保存到NVS
-                if (saveZeroPointToNVS())
                 {
-                    ESP_LOGI(TAG, "零点标定值已保存到NVS");
-                }
-                else
-                {
-                    ESP_LOGW(TAG, "保存零点标定值到NVS失败");
+                    // 采集任务可能同时在更新在线标定
+                    std::lock_guard<std::mutex> lock(zero_mutex_);
+                    zero_points_           = zero_points;
+                    zero_point_calibrated_ = true;
+
+                    // 手动标定结果作为在线标定的起点（完全置信）
+                    zero_tracker_.seed(zero_points_, calibration::CONFIDENCE_MAX,
+                                       xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+                    // 保存到NVS
+                    if (saveZeroPointToNVS())
+                    {
+                        ESP_LOGI(TAG, "零点标定值已保存到NVS");
+                    }
+                    else
+                    {
+                        ESP_LOGW(TAG, "保存零点标定值到NVS失败");
+                    }
                 }
 
                 // 打印标定结果
@@ -704,7 +745,7 @@ namespace app
                 {
                     uint32_t avg = sum[i] / valid_samples;
                     ESP_LOGI(TAG, "  传感器[%2lu]: 平均值=%5u, 范围=[%5u-%5u], 零点值=%5u",
-                             (unsigned long)i, avg, min_val[i], max_val[i], zero_points_[i]);
+                             (unsigned long)i, avg, min_val[i], max_val[i], zero_points[i]);
                 }
 
                 return true;
@@ -712,8 +753,13 @@ namespace app
 
             bool M0404::clearZeroPoint()
             {
-                zero_points_.fill(0);
-                zero_point_calibrated_ = false;
+                {
+                    std::lock_guard<std::mutex> lock(zero_mutex_);
+                    zero_points_.fill(0);
+                    zero_point_calibrated_ = false;
+                    zero_tracker_.clear();
+                    saved_zero_points_.fill(0);
+                }
 
                 // 从NVS删除
                 nvs_handle_t nvs_handle;
@@ -731,12 +777,77 @@ namespace app
 
             bool M0404::getZeroPoint(std::array<uint16_t, PRESSURE_COUNT>& zero_points) const
             {
+                std::lock_guard<std::mutex> lock(zero_mutex_);
                 zero_points = zero_points_;
                 return zero_point_calibrated_;
             }
 
+            uint8_t M0404::getZeroPointConfidence() const
+            {
+                std::lock_guard<std::mutex> lock(zero_mutex_);
+                if (!zero_point_calibrated_)
+                {
+                    return 0;
+                }
+                return zero_tracker_.getConfidence(xTaskGetTickCount() * portTICK_PERIOD_MS);
+            }
+
+            void M0404::updateOnlineCalibration(const PressureData& raw)
+            {
+                if (!online_calibration_enabled_)
+                {
+                    return;
+                }
+
+                // 手动标定和清除零点可能在其他任务中同时修改零点
+                std::lock_guard<std::mutex> lock(zero_mutex_);
+                uint32_t                    now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                if (!zero_tracker_.update(raw.pressures, now))
+                {
+                    return;
+                }
+
+                if (!zero_point_calibrated_)
+                {
+                    ESP_LOGI(TAG, "在线零点标定完成");
+                }
+                zero_points_           = zero_tracker_.getZeroPoints();
+                zero_point_calibrated_ = true;
+
+                // 写入NVS：置信度足够、距上次写入足够久且零点有明显变化时才写
+                uint8_t confidence = zero_tracker_.getConfidence(now);
+                if (confidence < ZERO_SAVE_MIN_CONFIDENCE ||
+                    now - last_save_time_ < ZERO_SAVE_MIN_INTERVAL_MS)
+                {
+                    return;
+                }
+
+                uint16_t max_delta = 0;
+                for (size_t i = 0; i < PRESSURE_COUNT; i++)
+                {
+                    uint16_t delta = zero_points_[i] > saved_zero_points_[i]
+                                         ? zero_points_[i] - saved_zero_points_[i]
+                                         : saved_zero_points_[i] - zero_points_[i];
+                    if (delta > max_delta)
+                    {
+                        max_delta = delta;
+                    }
+                }
+                if (max_delta < ZERO_SAVE_MIN_DELTA)
+                {
+                    return;
+                }
+
+                if (saveZeroPointToNVS())
+                {
+                    ESP_LOGI(TAG, "在线零点已保存到NVS (最大变化: %u, 置信度: %u%%)", max_delta,
+                             confidence);
+                }
+            }
+
             void M0404::applyZeroPointCompensation(PressureData& data) const
             {
+                std::lock_guard<std::mutex> lock(zero_mutex_);
                 if (!zero_point_calibrated_)
                 {
                     return; // 未标定，不应用补偿
@@ -775,7 +886,7 @@ namespace app
                 return false;
             }
 
-            bool M0404::saveZeroPointToNVS() const
+            bool M0404::saveZeroPointToNVS()
             {
                 nvs_handle_t nvs_handle;
                 esp_err_t    ret = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
@@ -793,12 +904,16 @@ namespace app
                 }
                 nvs_close(nvs_handle);
 
+                // 无论成功与否都推迟下一次写入，避免失败时反复擦写
+                last_save_time_ = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
                 if (ret != ESP_OK)
                 {
                     ESP_LOGE(TAG, "保存零点值到NVS失败: %s", esp_err_to_name(ret));
                     return false;
                 }
 
+                saved_zero_points_ = zero_points_;
                 return true;
             }
 
@@ -947,6 +1062,40 @@ namespace app
                 }
             }
 
+            void M0404::processGesture(const PressureData& data)
+            {
+                gesture::GestureEvent event;
+                bool detected = gesture_engine_.process(data.pressures, data.timestamp, event);
+
+                // 手势引擎属于采集任务，分析结果在锁内复制一份供其他任务读取
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    latest_features_ = gesture_engine_.getFeatures();
+                }
+
+                if (!detected)
+                {
+                    return;
+                }
+
+                ESP_LOGD(TAG, "手势: %s, 方向: %s, 持续: %lu ms, 峰值压力: %lu",
+                         gesture::getGestureName(event.type),
+                         gesture::getDirectionName(event.direction),
+                         (unsigned long)event.duration_ms, (unsigned long)event.peak_force);
+
+                tool::recorder::Recorder::getInstance().recordGesture(
+                    static_cast<uint8_t>(event.type), static_cast<uint8_t>(event.direction),
+                    event.peak_contacts, event.duration_ms);
+
+                if (gesture_callback_ != nullptr)
+                {
+                    gesture_callback_(event);
+                }
+
+                namespace bus = app::sys::event::bus;
+                bus::EventBus::getInstance().publish<bus::Topic::GESTURE>(event);
+            }
+
         } // namespace m0404
     } // namespace device
 } // namespace app
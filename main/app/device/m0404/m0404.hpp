@@ -2,12 +2,16 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <array>
 #include <driver/uart.h>
 #include <driver/gpio.h>
 #include <esp_log.h>
 #include "system/task/task.hpp"
+#include "system/event/bus/bus.hpp"
+#include "gesture/gesture.hpp"
+#include "calibration/calibration.hpp"
 
 namespace app
 {
@@ -170,6 +174,13 @@ namespace app
                 using TouchStateCallback = std::function<void(
                     TouchIntensity intensity, TouchDirection direction, uint16_t max_pressure)>;
 
+                /**
+                 * @brief 手势回调函数类型
+                 * @param event 识别到的手势事件
+                 * @note 在数据采集任务中按帧调用，回调内不要执行耗时操作
+                 */
+                using GestureCallback = std::function<void(const gesture::GestureEvent& event)>;
+
                 /**
                  * @brief 设置压力状态回调函数
                  * @param callback 回调函数，当压力状态变化时调用
@@ -207,6 +218,60 @@ namespace app
                     getInstance().setTouchStateCallback(callback);
                 }
 
+                /**
+                 * @brief 设置手势回调函数
+                 * @param callback 回调函数，识别到抚摸/轻拍/按住/挤压时调用
+                 * @note 手势同时以 Topic::GESTURE 发布到事件总线
+                 */
+                void setGestureCallback(GestureCallback callback)
+                {
+                    gesture_callback_ = callback;
+                }
+
+                /**
+                 * @brief 静态方法：设置手势回调函数（便捷接口）
+                 * @param callback 回调函数
+                 */
+                static void SetGestureCallback(GestureCallback callback)
+                {
+                    getInstance().setGestureCallback(callback);
+                }
+
+                /**
+                 * @brief 设置手势识别参数
+                 * @param config 识别参数
+                 */
+                void setGestureConfig(const gesture::Config& config)
+                {
+                    gesture_engine_.setConfig(config);
+                }
+
+                /**
+                 * @brief 获取最新一帧的压力分析结果（总压力、质心、激活点数、质心速度）
+                 * @param features 输出分析结果
+                 * @return true 数据有效, false 尚未采集到数据
+                 */
+                bool getLatestFeatures(gesture::FrameFeatures& features) const
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    if (!latest_data_.valid)
+                    {
+                        return false;
+                    }
+                    features = latest_features_;
+                    return true;
+                }
+
+                /**
+                 * @brief 静态方法：获取最新一帧的压力分析结果（便捷接口）
+                 * @param features 输出分析结果
+                 * @return true 数据有效, false 尚未采集到数据
+                 */
+                static bool GetLatestFeatures(gesture::FrameFeatures& features)
+                {
+                    return getInstance().getLatestFeatures(features);
+                }
+
                 /**
                  * @brief 启用默认触摸状态日志输出
                  * @note 会自动设置一个回调函数，输出触摸强度和方向的日志
@@ -283,6 +348,7 @@ namespace app
                  */
                 bool getLatestPressureData(PressureData& data) const
                 {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
                     if (!latest_data_.valid)
                     {
                         return false;
@@ -354,6 +420,49 @@ namespace app
                     return getInstance().getZeroPoint(zero_points);
                 }
 
+                /**
+                 * @brief 获取零点置信度（在线标定根据无触摸期间的数据持续更新零点）
+                 * @return 置信度（0 ~ 100），未标定时为 0
+                 */
+                uint8_t getZeroPointConfidence() const;
+
+                /**
+                 * @brief 静态方法：获取零点置信度（便捷接口）
+                 * @return 置信度（0 ~ 100），未标定时为 0
+                 */
+                static uint8_t GetZeroPointConfidence()
+                {
+                    return getInstance().getZeroPointConfidence();
+                }
+
+                /**
+                 * @brief 启用或禁用在线零点标定（默认启用）
+                 * @param enabled 是否启用
+                 */
+                void setOnlineCalibrationEnabled(bool enabled)
+                {
+                    online_calibration_enabled_ = enabled;
+                }
+
+                /**
+                 * @brief 设置在线零点标定参数
+                 * @param config 标定参数
+                 */
+                void setOnlineCalibrationConfig(const calibration::Config& config)
+                {
+                    std::lock_guard<std::mutex> lock(zero_mutex_);
+                    zero_tracker_.setConfig(config);
+                }
+
+                /**
+                 * @brief 获取在线零点标定统计（采集任务持续更新，返回加锁复制的快照）
+                 */
+                calibration::Stats getOnlineCalibrationStats() const
+                {
+                    std::lock_guard<std::mutex> lock(zero_mutex_);
+                    return zero_tracker_.getStats();
+                }
+
             private:
                 M0404() = default;
                 ~M0404();
@@ -373,11 +482,14 @@ namespace app
                 // 应用零点补偿
                 void applyZeroPointCompensation(PressureData& data) const;
 
-                // 从NVS加载零点值
+                // 从NVS加载零点值（需持有 zero_mutex_）
                 bool loadZeroPointFromNVS();
 
-                // 保存零点值到NVS
-                bool saveZeroPointToNVS() const;
+                // 保存零点值到NVS（需持有 zero_mutex_）
+                bool saveZeroPointToNVS();
+
+                // 在线零点标定：用原始帧更新零点，必要时保存到NVS
+                void updateOnlineCalibration(const PressureData& raw);
 
                 uart_port_t uart_num_    = UART_NUM_MAX;
                 bool        initialized_ = false;
@@ -413,15 +525,34 @@ namespace app
                 // 检测触摸状态和方向
                 void detectTouchState(const PressureData& data);
 
-                // 最新的压力数据（由后台数据采集任务更新）
-                PressureData latest_data_;
+                // 逐帧手势识别，并分发手势事件
+                void processGesture(const PressureData& data);
+
+                // 手势识别
+                gesture::GestureEngine gesture_engine_;
+                GestureCallback        gesture_callback_ = nullptr;
+
+                // 最新的压力数据和分析结果（由后台数据采集任务更新，data_mutex_ 保护）
+                mutable std::mutex     data_mutex_;
+                PressureData           latest_data_;
+                gesture::FrameFeatures latest_features_;
 
                 // 接收缓冲区
                 uint8_t rx_buffer_[PACKET_SIZE * 2]; // 足够大的缓冲区
 
+                // 零点标定值和在线标定状态由 zero_mutex_ 保护：采集任务逐帧更新，
+                // 手动标定、清除和查询接口在其他任务中调用
+                mutable std::mutex zero_mutex_;
+
                 // 零点标定值（16个传感器的基准值）
                 std::array<uint16_t, PRESSURE_COUNT> zero_points_;
                 bool                                 zero_point_calibrated_ = false; // 是否已标定
+
+                // 在线零点标定
+                calibration::ZeroTracker             zero_tracker_;
+                bool                                 online_calibration_enabled_ = true;
+                std::array<uint16_t, PRESSURE_COUNT> saved_zero_points_{}; // 最近保存到NVS的零点
+                uint32_t                             last_save_time_ = 0;  // 最近保存到NVS的时间
             };
 
         } // namespace m0404
@@ -35,7 +35,9 @@
 #include <stdio.h>
 #include <stdint.h>
 
-#define DEBUG_EN // 启用调试输出，显示所有通道的详细数据
+// 启用调试输出，显示所有通道的详细数据。默认关闭：MC1081S 在 I2C 调度器任务的完成回调中
+// 解析数据，每次转换都 printf 会阻塞总线上的其他设备，只在单独调试该芯片时打开
+// #define DEBUG_EN
 
 #if defined DEBUG_EN
 #define PR(format, ...) printf(format, ##__VA_ARGS__);
@@ -112,6 +112,16 @@ void GPIOI2C_Bus_Init(void)
     GPIOI2C_Bus_Init_WithHandle(NULL);
 }
 
+/**-----------------------------------------------------------------------
+  * @brief  Get the MC1081 device handle (i2c_master_dev_handle_t)
+  * @param  None
+  * @retval Device handle, NULL if the bus is not initialized
+-------------------------------------------------------------------------*/
+void* GPIOI2C_Get_Device_Handle(void)
+{
+    return i2c_initialized ? (void*)i2c_dev_handle : NULL;
+}
+
 /**-----------------------------------------------------------------------
   * @brief  Write data to an I2C device
   * @param  DeviceAddr I2C device address
@@ -28,8 +28,66 @@
 #include "mc1081.h"
 #include "mc1081_reg.h"
 #include "common.h"
+#include "i2c_adapter.h"
 
 
+/**-----------------------------------------------------------------------
+  * @brief  Trigger temperature conversion without waiting for completion
+  * @param  None
+  * @retval Success or failure of the transmission
+-------------------------------------------------------------------------*/
+int MC1081_T_Start(void)
+{
+	if(CAP_AFE_Transmit(I2C_ADDR, STATUS, 0x10) != GPIOI2C_XFER_LASTACK)	// Clear historical overflow flag
+	{
+		return 0;
+	}
+
+#if defined T_HIGH_RESOLUTION
+	/* Enable temperature high resolution conversion, completed in 3ms */
+	return CAP_AFE_Transmit(I2C_ADDR, T_CMD, TCV_3MS|STC) == GPIOI2C_XFER_LASTACK;
+#else
+	/* Enable temperature low resolution conversion, completed in 1.7ms */
+	return CAP_AFE_Transmit(I2C_ADDR, T_CMD, TCV_1p7MS|STC) == GPIOI2C_XFER_LASTACK;
+#endif
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Read the temperature conversion flag once
+  * @param  None
+  * @retval 1: converting, 0: completed, -1: bus error
+-------------------------------------------------------------------------*/
+int MC1081_T_Is_Busy(void)
+{
+	unsigned char status = 0x2;
+
+	if(CAP_AFE_Receive(I2C_ADDR, STATUS, &status, 1) != GPIOI2C_XFER_LASTNACK)
+	{
+		return -1;
+	}
+	return (status >> 1) & 1;
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Read temperature conversion result
+  * @param  *temp
+  * @retval Success or failure of the transmission
+-------------------------------------------------------------------------*/
+int MC1081_T_Read(float *temp)
+{
+	unsigned char dat[2];
+	signed short tmp_dat = 0;
+
+	if(CAP_AFE_Receive(I2C_ADDR, T_MSB, dat, 2) != GPIOI2C_XFER_LASTNACK)
+	{
+		return 0;
+	}
+	tmp_dat = dat[0]<<8|dat[1];
+	*temp= (float)tmp_dat/255.0f+28.7f;
+
+	return 1;
+}
+
 /**-----------------------------------------------------------------------
   * @brief  Start temperature measurement
   * @param  *temp 
@@ -38,39 +96,30 @@
 int MC1081_T_Measure(float *temp)
 {
 	int timeout = 10000;
-	unsigned char status = 0x2;
-	unsigned char dat[2];
-	signed short tmp_dat = 0;
+	int busy = 1;
 
-	CAP_AFE_Transmit(I2C_ADDR, STATUS, 0x10);	// Clear historical overflow flag
+	MC1081_T_Start();
 
 #if defined T_HIGH_RESOLUTION
-	CAP_AFE_Transmit(I2C_ADDR, T_CMD, TCV_3MS|STC);	// Enable temperature high resolution conversion, completed in 3ms
 	Delay_ms(3);		// Delay 3ms to wait for measurement completion
-
 #else
-	CAP_AFE_Transmit(I2C_ADDR, T_CMD, TCV_1p7MS|STC);	// Enable temperature low resolution conversion, completed in 1.7ms
 	Delay_ms(2);		// Delay 2ms to wait for measurement completion
 #endif
 
 	do
 	{
-			CAP_AFE_Receive(I2C_ADDR, STATUS, &status, 1);
+			busy = MC1081_T_Is_Busy();
 			timeout--;
-	}while((status >> 1 &1) == 1 && timeout > 0);
+	}while(busy != 0 && timeout > 0);
 	
 	if(timeout == 0)
 	{
-			PR("\r\n### Temperature conversion completion flag not read, STATUS Value = %02X\r\n",status);
+			PR("\r\n### Temperature conversion completion flag not read\r\n");
 			return 0;
 	}
 	else
 	{
-			CAP_AFE_Receive(I2C_ADDR, T_MSB, dat, 2);
-			tmp_dat = dat[0]<<8|dat[1];
-
-			*temp= (float)tmp_dat/255.0f+28.7f;
-			
+			MC1081_T_Read(temp);
 	}
 	PR("\r\n\r\nT:%.1f C\r\n",*temp);
 	
@@ -78,84 +127,218 @@ int MC1081_T_Measure(float *temp)
 }
 
 /**-----------------------------------------------------------------------
-  * @brief  Start differential mode measurement
-  * @param  CAP_AFE_DoubleEnded
-  * @param  MC1081_InitStructure
+  * @brief  Trigger capacitance conversion without waiting for completion
+  * @param  *init_structure: Capacitor initialization configuration (selects OSC1/OSC2)
+  * @param  mode: SLEEP_x | CAVG_x | CR_x | OS_SD_x bits written to C_CMD
   * @retval Success or failure of the transmission
 -------------------------------------------------------------------------*/
-int MC1081_OSC2_Measure(CAP_AFE_DoubleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+int MC1081_C_Start(MC1081_InitStructure * init_structure, unsigned char mode)
+{
+	unsigned char osc_sel;
+	osc_sel = (init_structure->MC1081_OSC_MODE == OSC2) ? OSC2_EN : OSC1_EN;
+	/* Clear historical overflow flag */
+	if(CAP_AFE_Transmit(I2C_ADDR, STATUS, OF_CLEAR) != GPIOI2C_XFER_LASTACK)
+	{
+		return 0;
+	}
+	return CAP_AFE_Transmit(I2C_ADDR, C_CMD, osc_sel|mode) == GPIOI2C_XFER_LASTACK;
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Read the capacitance conversion flag once
+  * @param  None
+  * @retval 1: converting, 0: completed, -1: bus error
+-------------------------------------------------------------------------*/
+int MC1081_C_Is_Busy(void)
 {
-	int timeout = 10000;
 	unsigned char status = 0x1;
-	unsigned char dat[12];
+
+	if(CAP_AFE_Receive(I2C_ADDR, STATUS, &status, 1) != GPIOI2C_XFER_LASTNACK)
+	{
+		return -1;
+	}
+	return status & 1;
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Parse differential mode conversion data
+  * @param  *raw: MC1081_DATA_LEN bytes burst read from D0_MSB
+  * @param  CAP_AFE_DoubleEnded
+  * @param  MC1081_InitStructure
+  * @retval None
+-------------------------------------------------------------------------*/
+void MC1081_OSC2_Parse(const unsigned char * raw, CAP_AFE_DoubleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+{
+	const unsigned char *dat;
 	unsigned char OSC2_OF_FLAG = 0;
 	unsigned char Fin_Div_VALUE,Fref_Div_VALUE;
 	unsigned char Ch_Sel = 0;
 	Ch_Sel = init_structure->MC1081_OSC2_CHANNEL;
 	Fin_Div_VALUE = 1<<(init_structure ->MC1081_FINDIV);
 	Fref_Div_VALUE = 1<<(init_structure ->MC1081_FREFDIV);
-	/* Clear historical overflow flag */
-	CAP_AFE_Transmit(I2C_ADDR, STATUS, OF_CLEAR);	
+
+	OSC2_OF_FLAG = raw[OSC2_OF - D0_MSB];
+	dat = &raw[DREF_MSB - D0_MSB];
+	Cap_Structure -> data_ref = dat[0]<<8|dat[1];
+	
+	if(Cap_Structure -> data_ref>=65535)
+	{
+		PR("\r\n ### Internal channel data overflow, OSC2_OF:%02X \r\n",OSC2_OF_FLAG);
+	}
+	else
+	{
+		Cap_Structure -> freq_ref = (float)(init_structure ->MC1081_CNT_CFG) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ref);;
+		PR("data_ref:%d\t\tfreq_ref:%.3f MHz\r\n",Cap_Structure -> data_ref,Cap_Structure -> freq_ref);
+	}
+			
+		
+	for(int i = 0; i < 5; i++)
+	{
+			if(((OSC2_OF_FLAG>>i)&1)!= 0)
+			{
+					PR("\r\n ### Channel %d data overflow, OSC2_OF:%02X \r\n",i,OSC2_OF_FLAG);
+					continue;
+			
+			}
+			else
+			{
+					dat = &raw[2*i];
+					Cap_Structure -> data_ch[i] = dat[0]<<8|dat[1];
+					Cap_Structure -> freq_ch[i] = (float)(init_structure ->MC1081_CNT_CFG) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ch[i]);;
+					PR("data_ch[%d]:%d \tfreq_ch[%d]:%.3f MHz\t",i,Cap_Structure -> data_ch[i],i,Cap_Structure -> freq_ch[i]);
+					if((Ch_Sel&OSC2_Ref_Channel) && !(OSC2_OF_FLAG&OSC2_Ref_Channel))
+					{
+						Cap_Structure -> cap_ch[i] = (float)Cap_Structure -> data_ch[i] / (float)Cap_Structure -> data_ref * Cref;
+						PR("cap_ch[%d]:%.3f pF\r\n",i,Cap_Structure -> cap_ch[i]);
+					}
+					
+			}
+	}
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Read differential mode conversion result (single burst read)
+  * @param  CAP_AFE_DoubleEnded
+  * @param  MC1081_InitStructure
+  * @retval Success or failure of the transmission
+-------------------------------------------------------------------------*/
+int MC1081_OSC2_Read(CAP_AFE_DoubleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+{
+	unsigned char raw[MC1081_DATA_LEN];
+
+	if(CAP_AFE_Receive(I2C_ADDR, D0_MSB, raw, MC1081_DATA_LEN) != GPIOI2C_XFER_LASTNACK)
+	{
+		return 0;
+	}
+	MC1081_OSC2_Parse(raw, Cap_Structure, init_structure);
+	return 1;
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Start differential mode measurement
+  * @param  CAP_AFE_DoubleEnded
+  * @param  MC1081_InitStructure
+  * @retval Success or failure of the transmission
+-------------------------------------------------------------------------*/
+int MC1081_OSC2_Measure(CAP_AFE_DoubleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+{
+	int timeout = 10000;
+	int busy = 1;
 	/* Enable differential mode single conversion, sleep mode, 32 times averaging */
-	CAP_AFE_Transmit(I2C_ADDR, C_CMD, OSC2_EN|SLEEP_EN|CAVG_32|OS_SD_ONE);	
+	MC1081_C_Start(init_structure, MC1081_CONV_ONE_SHOT);
 	do
 	{
 		Delay_ms(1);
 		/* Wait for conversion completion */
-		CAP_AFE_Receive(I2C_ADDR, STATUS, &status, 1);
+		busy = MC1081_C_Is_Busy();
 		timeout--;
-	}while((status&1) == 1 && timeout > 0);
+	}while(busy != 0 && timeout > 0);
 	
 	if(timeout == 0)
 	{
-		PR("\r\n### Differential conversion completion flag not read, STATUS Value = %02X\r\n",status);
+		PR("\r\n### Differential conversion completion flag not read\r\n");
 		return 0;
 	}
-	else
-	{	
-			CAP_AFE_Receive(I2C_ADDR, OSC2_OF, &OSC2_OF_FLAG, 1);
-			CAP_AFE_Receive(I2C_ADDR, DREF_MSB, dat, 2);
+	
+	return MC1081_OSC2_Read(Cap_Structure, init_structure);
+}
+
+/**-----------------------------------------------------------------------
+  * @brief  Parse single-ended mode conversion data
+  * @param  *raw: MC1081_DATA_LEN bytes burst read from D0_MSB
+  * @param  *Cap_Structure: Single-ended mode capacitor related information
+  * @param  *init_structure: Capacitor initialization configuration
+  * @retval None
+-------------------------------------------------------------------------*/
+void MC1081_OSC1_Parse(const unsigned char * raw, CAP_AFE_SingleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+{
+	const unsigned char *dat;
+	unsigned char Fin_Div_VALUE,Fref_Div_VALUE;
+	unsigned short  CNT_VALUE;
+	unsigned short Ch_Sel = 0;
+	unsigned short OF_FLAG;
+	CNT_VALUE = init_structure ->MC1081_CNT_CFG;
+	Fin_Div_VALUE = 1<<(init_structure ->MC1081_FINDIV);
+	Fref_Div_VALUE = 1<<(init_structure ->MC1081_FREFDIV);
+	Ch_Sel  = init_structure ->MC1081_OSC1_CHANNEL;
+
+	OF_FLAG = raw[OSC1_OF_MSB - D0_MSB]<<8|raw[OSC1_OF_LSB - D0_MSB];
+	if((Ch_Sel&OSC1_Ref_Channel))
+	{
+		if(OF_FLAG&OSC1_Ref_Channel)
+		{
+			PR("\r\n ### Internal channel data overflow, OSC1_OF:%04X \r\n",OF_FLAG);
+		}
+		else
+		{
+			dat = &raw[DREF_MSB - D0_MSB];
 			Cap_Structure -> data_ref = dat[0]<<8|dat[1];
+			Cap_Structure -> freq_ref = (float)(CNT_VALUE) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ref);
+			//PR("data_ref:%d\tfreq_ref:%.3f MHz\r\n",Cap_Structure -> data_ref,Cap_Structure -> freq_ref);  // 注释掉参考通道调试信息
+		}
 			
-			if(Cap_Structure -> data_ref>=65535)
+	}	
+	for(int i = 0; i < 10; i++)
+	{
+			if(((OF_FLAG>>i)&1)!= 0)
 			{
-				PR("\r\n ### Internal channel data overflow, OSC2_OF:%02X \r\n",OSC2_OF_FLAG);
+					PR("\r\n ### Measurement channel %d has data overflow, OSC1_OF:%04X \r\n",i,OF_FLAG);
+					continue;
+			
 			}
 			else
 			{
-				Cap_Structure -> freq_ref = (float)(init_structure ->MC1081_CNT_CFG) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ref);;
-				PR("data_ref:%d\t\tfreq_ref:%.3f MHz\r\n",Cap_Structure -> data_ref,Cap_Structure -> freq_ref);
-			}
-					
-				
-			for(int i = 0; i < 5; i++)
-			{
-					if(((OSC2_OF_FLAG>>i)&1)!= 0)
+					dat = &raw[2*i];
+					Cap_Structure -> data_ch[i] = dat[0]<<8|dat[1];
+					Cap_Structure -> freq_ch[i] = (float)(CNT_VALUE) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure ->  data_ch[i]);
+					//PR("data_ch[%d]:%d\tfreq_ch[%d]:%.3f MHz\t",i,Cap_Structure -> data_ch[i],i,Cap_Structure -> freq_ch[i]);  // 注释掉通道数据和频率调试信息
+					if((Ch_Sel&OSC1_Ref_Channel) && !(OF_FLAG&OSC1_Ref_Channel))
 					{
-							PR("\r\n ### Channel %d data overflow, OSC2_OF:%02X \r\n",i,OSC2_OF_FLAG);
-							continue;
-					
-					}
-					else
-					{
-							CAP_AFE_Receive(I2C_ADDR, (MC1081_REG)(D0_MSB+2*i), dat, 2);
-							Cap_Structure -> data_ch[i] = dat[0]<<8|dat[1];
-							Cap_Structure -> freq_ch[i] = (float)(init_structure ->MC1081_CNT_CFG) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ch[i]);;
-							PR("data_ch[%d]:%d \tfreq_ch[%d]:%.3f MHz\t",i,Cap_Structure -> data_ch[i],i,Cap_Structure -> freq_ch[i]);
-							if((Ch_Sel&OSC2_Ref_Channel) && !(OSC2_OF_FLAG&OSC2_Ref_Channel))
-							{
-								Cap_Structure -> cap_ch[i] = (float)Cap_Structure -> data_ch[i] / (float)Cap_Structure -> data_ref * Cref;
-								PR("cap_ch[%d]:%.3f pF\r\n",i,Cap_Structure -> cap_ch[i]);
-							}
-							
+						Cap_Structure -> cap_ch[i] = (float)Cap_Structure -> data_ch[i] / (float)Cap_Structure -> data_ref * Cref;
+						//PR("cap_ch[%d]:%.3f pF\r\n",i,Cap_Structure -> cap_ch[i]);  // 注释掉通道电容值调试信息
 					}
+					
 			}
 	}
-	
-	return 1;
 }
 
+/**-----------------------------------------------------------------------
+  * @brief  Read single-ended mode conversion result (single burst read)
+  * @param  *Cap_Structure: Single-ended mode capacitor related information
+  * @param  *init_structure: Capacitor initialization configuration
+  * @retval Transmission success status
+-------------------------------------------------------------------------*/
+int MC1081_OSC1_Read(CAP_AFE_SingleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
+{
+	unsigned char raw[MC1081_DATA_LEN];
 
+	if(CAP_AFE_Receive(I2C_ADDR, D0_MSB, raw, MC1081_DATA_LEN) != GPIOI2C_XFER_LASTNACK)
+	{
+		return 0;
+	}
+	MC1081_OSC1_Parse(raw, Cap_Structure, init_structure);
+	return 1;
+}
 
 /**-----------------------------------------------------------------------
   * @brief  Start single-ended mode measurement
@@ -166,78 +349,24 @@ int MC1081_OSC2_Measure(CAP_AFE_DoubleEnded * Cap_Structure,MC1081_InitStructure
 int MC1081_OSC1_Measure(CAP_AFE_SingleEnded * Cap_Structure,MC1081_InitStructure * init_structure)
 {
 	int timeout = 10000;
-	unsigned char status = 0x1;
-	unsigned char dat[2];
-	unsigned char OSC1_OF_FLAG[2] = {0};
-	unsigned char Fin_Div_VALUE,Fref_Div_VALUE;
-	unsigned short  CNT_VALUE;
-	unsigned short Ch_Sel = 0;
-	unsigned short OF_FLAG;
-	CNT_VALUE = init_structure ->MC1081_CNT_CFG;
-	Fin_Div_VALUE = 1<<(init_structure ->MC1081_FINDIV);
-	Fref_Div_VALUE = 1<<(init_structure ->MC1081_FREFDIV);
-	Ch_Sel  = init_structure ->MC1081_OSC1_CHANNEL;
-	/* Clear the history overflow flag */
-	CAP_AFE_Transmit(I2C_ADDR, STATUS, OF_CLEAR);	
+	int busy = 1;
 	/* Start single-ended mode capacitor single conversion, sleep mode, 32 times average */
-	CAP_AFE_Transmit(I2C_ADDR, C_CMD, OSC1_EN|SLEEP_EN|CAVG_32|OS_SD_ONE);	
+	MC1081_C_Start(init_structure, MC1081_CONV_ONE_SHOT);
 	do
 	{
 		Delay_ms(1);		
 		/* Wait for conversion to complete */
-		CAP_AFE_Receive(I2C_ADDR, STATUS, &status, 1);
+		busy = MC1081_C_Is_Busy();
 		timeout--;
-	}while((status&1) == 1 && timeout > 0);
+	}while(busy != 0 && timeout > 0);
 	
 	if(timeout == 0)
 	{
-			PR("\r\n### Failed to read the capacitor conversion complete flag, STATUS Value = %02X\r\n",status);
+			PR("\r\n### Failed to read the capacitor conversion complete flag\r\n");
 			return 0;
 	}
-	else
-	{	
-			CAP_AFE_Receive(I2C_ADDR, OSC1_OF_MSB, OSC1_OF_FLAG, 2);
-			OF_FLAG = OSC1_OF_FLAG[0]<<8|OSC1_OF_FLAG[1];
-			if((Ch_Sel&OSC1_Ref_Channel))
-			{
-				if(OF_FLAG&OSC1_Ref_Channel)
-				{
-					PR("\r\n ### Internal channel data overflow, OSC1_OF:%04X \r\n",(OSC1_OF_FLAG[0]<<8|OSC1_OF_FLAG[1]));
-				}
-				else
-				{
-					CAP_AFE_Receive(I2C_ADDR, DREF_MSB, dat, 2);
-					Cap_Structure -> data_ref = dat[0]<<8|dat[1];
-					Cap_Structure -> freq_ref = (float)(CNT_VALUE) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure -> data_ref);
-					//PR("data_ref:%d\tfreq_ref:%.3f MHz\r\n",Cap_Structure -> data_ref,Cap_Structure -> freq_ref);  // 注释掉参考通道调试信息
-				}
-					
-			}	
-			for(int i = 0; i < 10; i++)
-			{
-					if(((OF_FLAG>>i)&1)!= 0)
-					{
-							PR("\r\n ### Measurement channel %d has data overflow, OSC1_OF:%04X \r\n",i,(OSC1_OF_FLAG[0]<<8|OSC1_OF_FLAG[1]));
-							continue;
-					
-					}
-					else
-					{
-							CAP_AFE_Receive(I2C_ADDR, (MC1081_REG)(D0_MSB+2*i), dat, 2);
-							Cap_Structure -> data_ch[i] = dat[0]<<8|dat[1];
-							Cap_Structure -> freq_ch[i] = (float)(CNT_VALUE) * IN_CLK * (float)Fin_Div_VALUE/(float)Fref_Div_VALUE/(float)(Cap_Structure ->  data_ch[i]);
-							//PR("data_ch[%d]:%d\tfreq_ch[%d]:%.3f MHz\t",i,Cap_Structure -> data_ch[i],i,Cap_Structure -> freq_ch[i]);  // 注释掉通道数据和频率调试信息
-							if((Ch_Sel&OSC1_Ref_Channel) && !(OF_FLAG&OSC1_Ref_Channel))
-							{
-								Cap_Structure -> cap_ch[i] = (float)Cap_Structure -> data_ch[i] / (float)Cap_Structure -> data_ref * Cref;
-								//PR("cap_ch[%d]:%.3f pF\r\n",i,Cap_Structure -> cap_ch[i]);  // 注释掉通道电容值调试信息
-							}
-							
-					}
-			}
-	}
 	
-	return 1;
+	return MC1081_OSC1_Read(Cap_Structure, init_structure);
 }
 
 
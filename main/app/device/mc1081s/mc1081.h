@@ -38,6 +38,34 @@
 
 #define T_HIGH_RESOLUTION
 
+#define MC1081_DATA_LEN (OSC2_OF - D0_MSB + 1) /*!< Burst read length: D0_MSB ~ OSC2_OF */
+#define MC1081_CONV_ONE_SHOT                                                                       \
+    (SLEEP_EN | CAVG_32 | OS_SD_ONE) /*!< Single conversion, sleep mode, 32 times averaging */
+
+/*******************************************************************
+ * @brief  Trigger temperature conversion, return without waiting.
+ * @note  	Poll MC1081_T_Is_Busy() and then call MC1081_T_Read().
+ * @param  None.
+ * @retval 1: success, 0: bus error.
+ ******************************************************************/
+int MC1081_T_Start(void);
+
+/*******************************************************************
+ * @brief  Read the temperature conversion flag once.
+ * @note  	none
+ * @param  None.
+ * @retval 1: converting, 0: completed, -1: bus error.
+ ******************************************************************/
+int MC1081_T_Is_Busy(void);
+
+/*******************************************************************
+ * @brief  Read temperature conversion result.
+ * @note  	none
+ * @param  *temp.
+ * @retval 1: success, 0: bus error.
+ ******************************************************************/
+int MC1081_T_Read(float* temp);
+
 /*******************************************************************
  * @brief  Convert and read Temperature.
  * @note  	none
@@ -55,6 +83,64 @@ int MC1081_T_Measure(float* temp);
  ******************************************************************/
 int MC1081_OSC2_Measure(CAP_AFE_DoubleEnded* Cap_Structure, MC1081_InitStructure* init_structure);
 
+/*******************************************************************
+ * @brief  Trigger capacitance conversion, return without waiting.
+ * @note  	Poll MC1081_C_Is_Busy() (or wait for the expected conversion time)
+ *          and then call MC1081_OSC1_Read() / MC1081_OSC2_Read().
+ * @param  MCP1081_InitStructure (MC1081_OSC_MODE selects OSC1/OSC2).
+ * @param  mode: SLEEP_x | CAVG_x | CR_x | OS_SD_x bits written to C_CMD.
+ * @retval 1: success, 0: bus error.
+ ******************************************************************/
+int MC1081_C_Start(MC1081_InitStructure* init_structure, unsigned char mode);
+
+/*******************************************************************
+ * @brief  Read the capacitance conversion flag once.
+ * @note  	none
+ * @param  None.
+ * @retval 1: converting, 0: completed, -1: bus error.
+ ******************************************************************/
+int MC1081_C_Is_Busy(void);
+
+/*******************************************************************
+ * @brief  Parse double ended conversion data.
+ * @note  	Overflowed channels keep their previous values.
+ * @param  *raw: MC1081_DATA_LEN bytes burst read from D0_MSB.
+ * @param  CAP_AFE_DoubleEnded.
+ * @param  MCP1081_InitStructure.
+ * @retval None.
+ ******************************************************************/
+void MC1081_OSC2_Parse(const unsigned char* raw, CAP_AFE_DoubleEnded* Cap_Structure,
+                       MC1081_InitStructure* init_structure);
+
+/*******************************************************************
+ * @brief  Read double ended conversion result (single burst read).
+ * @note  	none
+ * @param  CAP_AFE_DoubleEnded.
+ * @param  MCP1081_InitStructure.
+ * @retval 1: success, 0: bus error.
+ ******************************************************************/
+int MC1081_OSC2_Read(CAP_AFE_DoubleEnded* Cap_Structure, MC1081_InitStructure* init_structure);
+
+/*******************************************************************
+ * @brief  Parse single-ended conversion data.
+ * @note  	Overflowed channels keep their previous values.
+ * @param  *raw: MC1081_DATA_LEN bytes burst read from D0_MSB.
+ * @param  CAP_AFE_SingleEnded.
+ * @param  MCP1081_InitStructure.
+ * @retval None.
+ ******************************************************************/
+void MC1081_OSC1_Parse(const unsigned char* raw, CAP_AFE_SingleEnded* Cap_Structure,
+                       MC1081_InitStructure* init_structure);
+
+/*******************************************************************
+ * @brief  Read single-ended conversion result (single burst read).
+ * @note  	none
+ * @param  CAP_AFE_SingleEnded.
+ * @param  MCP1081_InitStructure.
+ * @retval 1: success, 0: bus error.
+ ******************************************************************/
+int MC1081_OSC1_Read(CAP_AFE_SingleEnded* Cap_Structure, MC1081_InitStructure* init_structure);
+
 /**-----------------------------------------------------------------------
   * @brief  Start single-ended mode measurement
   * @param  *Cap_Structure: Single-ended mode capacitor related information
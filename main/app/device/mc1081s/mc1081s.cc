@@ -0,0 +1,494 @@
+#include "mc1081s.hpp"
+
+#include <cstring>
+#include <esp_log.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// MC1081 厂商驱动（C 代码）
+extern "C"
+{
+#include "device/mc1081s/mc1081.h"
+#include "device/mc1081s/mc1081_reg.h"
+#include "device/mc1081s/common.h"
+#include "device/mc1081s/i2c_adapter.h"
+}
+
+static const char* const TAG = "MC1081S";
+
+namespace app
+{
+    namespace device
+    {
+        namespace mc1081s
+        {
+            constexpr uint8_t  CHIP_ID_MSB_VALUE  = 0x10; // 芯片 ID 高字节
+            constexpr uint8_t  CHIP_ID_LSB_VALUE  = 0x81; // 芯片 ID 低字节
+            constexpr uint8_t  DIFFERENTIAL_COUNT = 5;    // 差分模式通道数
+            constexpr uint16_t RAW_OVERFLOW       = 0xFFFF;
+
+            // 厂商驱动的初始化配置（Cap_Afe_Init 填充，解析结果时使用）
+            static MC1081_InitStructure s_init_structure;
+
+            // 厂商解析函数的输出（溢出通道保留上一次的值，因此需要持久保存）
+            static CAP_AFE_SingleEnded s_single_ended;
+            static CAP_AFE_DoubleEnded s_double_ended;
+
+            MC1081S::~MC1081S()
+            {
+                deinit();
+            }
+
+            bool MC1081S::init(i2c_master_bus_handle_t bus_handle, Mode mode)
+            {
+                if (bus_handle == nullptr)
+                {
+                    ESP_LOGE(TAG, "I2C 总线句柄为空");
+                    return false;
+                }
+
+                if (initialized_)
+                {
+                    ESP_LOGW(TAG, "传感器已初始化，先反初始化");
+                    deinit();
+                }
+
+                mode_     = mode;
+                channels_ =
+                    mode_ == Mode::DIFFERENTIAL ? DIFFERENTIAL_COUNT : MC1081S_CHANNEL_COUNT;
+
+                // 由厂商驱动添加设备并配置寄存器（同步访问，仅在初始化时执行）
+                memset(&s_init_structure, 0, sizeof(s_init_structure));
+                s_init_structure.MC1081_OSC_MODE = mode_ == Mode::DIFFERENTIAL ? OSC2 : OSC1;
+                s_init_structure.MC1081_SHLD_CFG = SHLD_DIS;
+                Cap_Afe_Init_WithHandle(&s_init_structure, bus_handle);
+
+                dev_handle_ = static_cast<i2c_master_dev_handle_t>(GPIOI2C_Get_Device_Handle());
+                if (dev_handle_ == nullptr)
+                {
+                    ESP_LOGE(TAG, "添加 I2C 设备失败");
+                    return false;
+                }
+
+                // 登记到 I2C 调度器，之后的测量事务按优先级排队
+                i2c_device_ = i2c::scheduler::Scheduler::getInstance().registerDevice(
+                    "MC1081S", dev_handle_, i2c::scheduler::Priority::NORMAL);
+                if (i2c_device_ == i2c::scheduler::INVALID_DEVICE)
+                {
+                    ESP_LOGE(TAG, "登记 I2C 调度设备失败");
+                    deinit();
+                    return false;
+                }
+
+                // 读取芯片 ID 验证通信
+                uint8_t   reg        = CHIP_ID_MSB;
+                uint8_t   chip_id[2] = {0};
+                esp_err_t ret        = i2c::scheduler::Scheduler::getInstance().transmitReceive(
+                    i2c_device_, &reg, 1, chip_id, sizeof(chip_id));
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "读取芯片 ID 失败: %s", esp_err_to_name(ret));
+                    deinit();
+                    return false;
+                }
+                if (chip_id[0] != CHIP_ID_MSB_VALUE || chip_id[1] != CHIP_ID_LSB_VALUE)
+                {
+                    ESP_LOGW(TAG, "芯片 ID 不匹配: 0x%02X 0x%02X (期望: 0x%02X 0x%02X)", chip_id[0],
+                             chip_id[1], CHIP_ID_MSB_VALUE, CHIP_ID_LSB_VALUE);
+                }
+
+                esp_timer_create_args_t timer_args = {};
+                timer_args.callback                = &MC1081S::timerCallback;
+                timer_args.arg                     = this;
+                timer_args.dispatch_method         = ESP_TIMER_TASK;
+                timer_args.name                    = "mc1081s";
+                ret                                = esp_timer_create(&timer_args, &timer_);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "创建定时器失败: %s", esp_err_to_name(ret));
+                    deinit();
+                    return false;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    latest_ = CapData();
+                    stats_  = Stats();
+                }
+                state_       = State::IDLE;
+                initialized_ = true;
+                ESP_LOGI(TAG, "MC1081S 初始化成功 (模式: %s, 通道数: %d)",
+                         mode_ == Mode::DIFFERENTIAL ? "差分" : "单端", channels_);
+                return true;
+            }
+
+            void MC1081S::deinit()
+            {
+                stop();
+
+                // 等待正在进行的转换结束，避免异步事务访问已释放的资源
+                for (uint32_t i = 0; i < MAX_POLLS && state_ != State::IDLE; i++)
+                {
+                    vTaskDelay(pdMS_TO_TICKS(1));
+                }
+
+                if (timer_ != nullptr)
+                {
+                    esp_timer_stop(timer_);
+                    esp_timer_delete(timer_);
+                    timer_ = nullptr;
+                }
+
+                if (i2c_device_ != i2c::scheduler::INVALID_DEVICE)
+                {
+                    i2c::scheduler::Scheduler::getInstance().unregisterDevice(i2c_device_);
+                    i2c_device_ = i2c::scheduler::INVALID_DEVICE;
+                }
+
+                // 设备句柄归厂商 I2C 适配层所有，不在此移除
+                dev_handle_  = nullptr;
+                state_       = State::IDLE;
+                initialized_ = false;
+            }
+
+            bool MC1081S::startMeasurement(Callback callback)
+            {
+                return start(false, 0, 1, std::move(callback));
+            }
+
+            bool MC1081S::startContinuous(uint32_t interval_ms, uint8_t average, Callback callback)
+            {
+                return start(true, interval_ms, average, std::move(callback));
+            }
+
+            bool MC1081S::start(bool continuous, uint32_t interval_ms, uint8_t average,
+                                Callback callback)
+            {
+                if (!initialized_)
+                {
+                    ESP_LOGE(TAG, "传感器未初始化");
+                    return false;
+                }
+
+                State expected = State::IDLE;
+                if (!state_.compare_exchange_strong(expected, State::STARTING))
+                {
+                    ESP_LOGW(TAG, "测量正在进行");
+                    return false;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    callback_ = std::move(callback);
+                }
+
+                if (average < 1)
+                {
+                    average = 1;
+                }
+                if (average > MAX_AVERAGE)
+                {
+                    average = MAX_AVERAGE;
+                }
+                average_       = average;
+                history_count_ = 0;
+                history_index_ = 0;
+                interval_ms_   = interval_ms;
+                continuous_    = continuous;
+
+                if (continuous)
+                {
+                    ESP_LOGI(TAG, "启动连续测量 (间隔: %lu ms, 平均: %d 次)",
+                             (unsigned long)interval_ms, average_);
+                }
+
+                startConversion();
+                return true;
+            }
+
+            void MC1081S::stop()
+            {
+                continuous_ = false;
+
+                // 等待下一次转换时可以立即停止，转换中的由状态机在完成后停止
+                State expected = State::WAITING;
+                if (state_.compare_exchange_strong(expected, State::IDLE) && timer_ != nullptr)
+                {
+                    esp_timer_stop(timer_);
+                }
+            }
+
+            bool MC1081S::getLatest(CapData& data) const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                data = latest_;
+                return latest_.valid;
+            }
+
+            Stats MC1081S::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return stats_;
+            }
+
+            void MC1081S::startConversion()
+            {
+                state_    = State::STARTING;
+                polls_    = 0;
+                start_us_ = esp_timer_get_time();
+
+                // 清除溢出标志后启动单次转换（休眠模式，硬件 32 次平均）
+                uint8_t osc_sel    = mode_ == Mode::DIFFERENTIAL ? OSC2_EN : OSC1_EN;
+                uint8_t clear[2]   = {STATUS, OF_CLEAR};
+                uint8_t command[2] = {C_CMD, static_cast<uint8_t>(osc_sel | MC1081_CONV_ONE_SHOT)};
+
+                // 同一设备的事务按提交顺序执行，只需在命令写入完成后推进状态机
+                auto& bus = i2c::scheduler::Scheduler::getInstance();
+                if (!bus.submit(i2c_device_, clear, sizeof(clear), nullptr, 0, nullptr) ||
+                    !bus.submit(i2c_device_, command, sizeof(command), nullptr, 0,
+                                [this](esp_err_t result) { onStarted(result); }))
+                {
+                    ESP_LOGW(TAG, "提交转换命令失败");
+                    finish(CapData());
+                }
+            }
+
+            void MC1081S::timerCallback(void* arg)
+            {
+                auto* self = static_cast<MC1081S*>(arg);
+
+                State state = self->state_;
+                if (state == State::CONVERTING)
+                {
+                    // 单字节读取状态寄存器
+                    uint8_t reg = STATUS;
+                    if (!i2c::scheduler::Scheduler::getInstance().submit(
+                            self->i2c_device_, &reg, 1, &self->status_, 1,
+                            [self](esp_err_t result) { self->onStatus(result); }))
+                    {
+                        ESP_LOGW(TAG, "提交状态查询失败");
+                        self->finish(CapData());
+                    }
+                }
+                else if (state == State::WAITING)
+                {
+                    State expected = State::WAITING;
+                    if (!self->continuous_)
+                    {
+                        self->state_.compare_exchange_strong(expected, State::IDLE);
+                    }
+                    else if (self->state_.compare_exchange_strong(expected, State::STARTING))
+                    {
+                        self->startConversion();
+                    }
+                }
+            }
+
+            void MC1081S::onStarted(esp_err_t result)
+            {
+                if (result != ESP_OK)
+                {
+                    ESP_LOGW(TAG, "写入转换命令失败: %s", esp_err_to_name(result));
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stats_.errors++;
+                    }
+                    finish(CapData());
+                    return;
+                }
+
+                state_ = State::CONVERTING;
+                armTimer(CONVERSION_WAIT_US);
+            }
+
+            void MC1081S::onStatus(esp_err_t result)
+            {
+                polls_++;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stats_.polls++;
+                    if (result != ESP_OK)
+                    {
+                        stats_.errors++;
+                    }
+                }
+
+                if (result != ESP_OK)
+                {
+                    ESP_LOGW(TAG, "读取状态失败: %s", esp_err_to_name(result));
+                    finish(CapData());
+                    return;
+                }
+
+                // 状态位 0 为 1 表示电容转换仍在进行
+                if (status_ & 0x01)
+                {
+                    if (polls_ >= MAX_POLLS)
+                    {
+                        ESP_LOGW(TAG, "转换超时 (STATUS: 0x%02X)", status_);
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            stats_.timeouts++;
+                        }
+                        finish(CapData());
+                        return;
+                    }
+                    armTimer(POLL_INTERVAL_US);
+                    return;
+                }
+
+                // 转换完成：一次突发读取全部通道数据、参考通道和溢出标志
+                static_assert(MC1081_DATA_LEN <= sizeof(raw_), "raw_ buffer too small");
+                state_      = State::READING;
+                uint8_t reg = D0_MSB;
+                if (!i2c::scheduler::Scheduler::getInstance().submit(
+                        i2c_device_, &reg, 1, raw_, MC1081_DATA_LEN,
+                        [this](esp_err_t result) { onData(result); }))
+                {
+                    ESP_LOGW(TAG, "提交数据读取失败");
+                    finish(CapData());
+                }
+            }
+
+            void MC1081S::onData(esp_err_t result)
+            {
+                if (result != ESP_OK)
+                {
+                    ESP_LOGW(TAG, "读取转换结果失败: %s", esp_err_to_name(result));
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stats_.errors++;
+                    }
+                    finish(CapData());
+                    return;
+                }
+
+                CapData data;
+                processData(data);
+                finish(data);
+            }
+
+            void MC1081S::processData(CapData& data)
+            {
+                const float*    cap      = nullptr;
+                const uint16_t* raw      = nullptr;
+                uint16_t        data_ref = 0;
+                if (mode_ == Mode::DIFFERENTIAL)
+                {
+                    MC1081_OSC2_Parse(raw_, &s_double_ended, &s_init_structure);
+                    cap      = s_double_ended.cap_ch;
+                    raw      = s_double_ended.data_ch;
+                    data_ref = s_double_ended.data_ref;
+                }
+                else
+                {
+                    MC1081_OSC1_Parse(raw_, &s_single_ended, &s_init_structure);
+                    cap      = s_single_ended.cap_ch;
+                    raw      = s_single_ended.data_ch;
+                    data_ref = s_single_ended.data_ref;
+                }
+
+                // 滑动平均：保存本次结果，对窗口内的样本求均值
+                for (uint8_t ch = 0; ch < channels_; ch++)
+                {
+                    history_[history_index_][ch] = cap[ch];
+                }
+                history_index_ = (history_index_ + 1) % average_;
+                if (history_count_ < average_)
+                {
+                    history_count_++;
+                }
+
+                for (uint8_t ch = 0; ch < channels_; ch++)
+                {
+                    float sum = 0.0f;
+                    for (uint8_t i = 0; i < history_count_; i++)
+                    {
+                        sum += history_[i][ch];
+                    }
+                    data.cap[ch] = sum / history_count_;
+                    data.raw[ch] = raw[ch];
+                }
+
+                int64_t now_us     = esp_timer_get_time();
+                data.ref           = data_ref;
+                data.channels      = channels_;
+                data.samples       = history_count_;
+                data.conversion_us = static_cast<uint32_t>(now_us - start_us_);
+                data.timestamp     = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                data.valid         = data_ref != 0 && data_ref != RAW_OVERFLOW;
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                stats_.conversions++;
+                if (data.conversion_us > stats_.conversion_us_max)
+                {
+                    stats_.conversion_us_max = data.conversion_us;
+                }
+                latest_ = data;
+            }
+
+            void MC1081S::finish(const CapData& data)
+            {
+                Callback callback;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    callback = callback_;
+                }
+
+                // 单次测量在回调前回到空闲，回调中可以直接启动下一次测量
+                bool continuous = continuous_;
+                state_          = continuous ? State::WAITING : State::IDLE;
+
+                if (callback)
+                {
+                    callback(data);
+                }
+
+                if (!continuous)
+                {
+                    return;
+                }
+
+                if (interval_ms_ > 0)
+                {
+                    armTimer(static_cast<uint64_t>(interval_ms_) * 1000);
+                    return;
+                }
+
+                // 背靠背转换
+                State expected = State::WAITING;
+                if (continuous_ && state_.compare_exchange_strong(expected, State::STARTING))
+                {
+                    startConversion();
+                }
+                else
+                {
+                    state_ = State::IDLE;
+                }
+            }
+
+            void MC1081S::armTimer(uint64_t timeout_us)
+            {
+                if (timer_ == nullptr)
+                {
+                    state_ = State::IDLE;
+                    return;
+                }
+
+                esp_err_t ret = esp_timer_start_once(timer_, timeout_us);
+                if (ret == ESP_ERR_INVALID_STATE)
+                {
+                    // 定时器仍在运行（stop 与重新启动交错），重启一次
+                    esp_timer_stop(timer_);
+                    ret = esp_timer_start_once(timer_, timeout_us);
+                }
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "启动定时器失败: %s", esp_err_to_name(ret));
+                    state_ = State::IDLE;
+                }
+            }
+
+        } // namespace mc1081s
+    } // namespace device
+} // namespace app
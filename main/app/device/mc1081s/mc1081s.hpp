@@ -0,0 +1,265 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <driver/i2c_master.h>
+#include <esp_timer.h>
+#include "i2c/scheduler/scheduler.hpp"
+
+namespace app
+{
+    namespace device
+    {
+        namespace mc1081s
+        {
+            constexpr size_t   MC1081S_CHANNEL_COUNT = 10;   // 单端模式通道数（差分模式为 5）
+            constexpr uint8_t  MAX_AVERAGE           = 16;   // 软件滑动平均窗口上限
+            constexpr uint32_t CONVERSION_WAIT_US    = 1000; // 启动转换后首次查询状态的等待时间
+            constexpr uint32_t POLL_INTERVAL_US      = 1000; // 转换未完成时的查询间隔
+            constexpr uint32_t MAX_POLLS             = 200;  // 单次转换最多查询次数（超时）
+
+            /**
+             * @brief 测量模式
+             */
+            enum class Mode : uint8_t
+            {
+                SINGLE_ENDED = 0, // 单端模式（OSC1，10 通道）
+                DIFFERENTIAL = 1  // 差分模式（OSC2，5 通道）
+            };
+
+            /**
+             * @brief 测量状态机的状态
+             */
+            enum class State : uint8_t
+            {
+                IDLE       = 0, // 空闲
+                STARTING   = 1, // 正在写入转换命令
+                CONVERTING = 2, // 转换中（定时查询状态位）
+                READING    = 3, // 正在突发读取转换结果
+                WAITING    = 4  // 连续模式下等待下一次转换
+            };
+
+            /**
+             * @brief 电容测量数据
+             */
+            struct CapData
+            {
+                float    cap[MC1081S_CHANNEL_COUNT]; // 各通道电容值（pF，已平均）
+                uint16_t raw[MC1081S_CHANNEL_COUNT]; // 各通道原始计数（最近一次转换）
+                uint16_t ref;                        // 参考通道原始计数
+                uint8_t  channels;                   // 通道数
+                uint8_t  samples;                    // 参与平均的样本数
+                uint32_t conversion_us;              // 本次转换耗时（启动到读出，微秒）
+                uint32_t timestamp;                  // 时间戳（毫秒）
+                bool     valid;                      // 数据是否有效
+
+                CapData()
+                    : cap{}, raw{}, ref(0), channels(0), samples(0), conversion_us(0),
+                      timestamp(0), valid(false)
+                {
+                }
+            };
+
+            /**
+             * @brief 测量统计
+             */
+            struct Stats
+            {
+                uint32_t conversions;       // 完成的转换次数
+                uint32_t errors;            // 总线错误次数
+                uint32_t timeouts;          // 转换超时次数
+                uint32_t polls;             // 状态查询累计次数
+                uint32_t conversion_us_max; // 最长转换耗时（微秒）
+
+                Stats() : conversions(0), errors(0), timeouts(0), polls(0), conversion_us_max(0)
+                {
+                }
+            };
+
+            /**
+             * @brief MC1081S 电容传感器异步测量驱动（单例模式）
+             *
+             * 测量由状态机推进：写入转换命令 -> 定时器等待转换 -> 查询状态位 -> 突发读取结果。
+             * 所有总线访问都作为异步事务提交给 I2C 调度器，等待转换期间不占用任何任务和总线，
+             * 因此可以与同一总线上的其他设备并行工作。连续模式下按间隔重复转换，
+             * 并对最近若干次结果做滑动平均。
+             * 完成回调在 I2C 调度任务中执行（调度器未启动时在定时器任务中执行），应尽快返回。
+             */
+            class MC1081S
+            {
+            public:
+                /**
+                 * @brief 测量完成回调函数类型
+                 * @param data 测量数据（失败时 valid 为 false）
+                 */
+                using Callback = std::function<void(const CapData& data)>;
+
+                /**
+                 * @brief 获取单例实例
+                 * @return MC1081S 实例的引用
+                 */
+                static MC1081S& getInstance()
+                {
+                    static MC1081S instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                MC1081S(const MC1081S&)            = delete;
+                MC1081S& operator=(const MC1081S&) = delete;
+
+                /**
+                 * @brief 初始化传感器（配置寄存器并登记到 I2C 调度器）
+                 * @param bus_handle I2C 总线句柄
+                 * @param mode 测量模式
+                 * @return true 成功, false 失败
+                 */
+                bool init(i2c_master_bus_handle_t bus_handle, Mode mode = Mode::SINGLE_ENDED);
+
+                /**
+                 * @brief 停止测量并释放资源
+                 */
+                void deinit();
+
+                /**
+                 * @brief 是否已初始化
+                 */
+                bool isInitialized() const
+                {
+                    return initialized_;
+                }
+
+                /**
+                 * @brief 启动一次测量，立即返回
+                 * @param callback 完成回调，可为空
+                 * @return true 已启动, false 未初始化或正在测量
+                 */
+                bool startMeasurement(Callback callback);
+
+                /**
+                 * @brief 启动连续测量，立即返回
+                 * @param interval_ms 两次转换之间的间隔（毫秒），0 表示背靠背转换
+                 * @param average 滑动平均窗口（1 ~ MAX_AVERAGE）
+                 * @param callback 每次转换完成后回调，可为空
+                 * @return true 已启动, false 未初始化或正在测量
+                 */
+                bool startContinuous(uint32_t interval_ms, uint8_t average, Callback callback);
+
+                /**
+                 * @brief 停止连续测量（正在进行的转换完成后停止）
+                 */
+                void stop();
+
+                /**
+                 * @brief 获取状态机当前状态
+                 */
+                State getState() const
+                {
+                    return state_;
+                }
+
+                /**
+                 * @brief 获取最近一次测量数据
+                 * @param data 输出数据
+                 * @return true 有有效数据, false 尚无数据
+                 */
+                bool getLatest(CapData& data) const;
+
+                /**
+                 * @brief 获取测量统计
+                 */
+                Stats getStats() const;
+
+                /**
+                 * @brief 静态方法：初始化传感器（便捷接口）
+                 * @param bus_handle I2C 总线句柄
+                 * @param mode 测量模式
+                 * @return true 成功, false 失败
+                 */
+                static bool Init(i2c_master_bus_handle_t bus_handle,
+                                 Mode                    mode = Mode::SINGLE_ENDED)
+                {
+                    return getInstance().init(bus_handle, mode);
+                }
+
+                /**
+                 * @brief 静态方法：启动连续测量（便捷接口）
+                 */
+                static bool StartContinuous(uint32_t interval_ms, uint8_t average,
+                                            Callback callback)
+                {
+                    return getInstance().startContinuous(interval_ms, average, callback);
+                }
+
+                /**
+                 * @brief 静态方法：停止连续测量（便捷接口）
+                 */
+                static void Stop()
+                {
+                    getInstance().stop();
+                }
+
+            private:
+                MC1081S() = default;
+                ~MC1081S();
+
+                // 启动测量（单次或连续）
+                bool start(bool continuous, uint32_t interval_ms, uint8_t average,
+                           Callback callback);
+
+                // 提交转换命令
+                void startConversion();
+
+                // 定时器回调：按状态查询转换状态或启动下一次转换
+                static void timerCallback(void* arg);
+
+                // 事务完成处理
+                void onStarted(esp_err_t result);
+                void onStatus(esp_err_t result);
+                void onData(esp_err_t result);
+
+                // 结束一次转换并回调（失败时 data.valid 为 false），连续模式下安排下一次
+                void finish(const CapData& data);
+
+                // 解析结果并更新滑动平均
+                void processData(CapData& data);
+
+                // 启动一次性定时器
+                void armTimer(uint64_t timeout_us);
+
+                i2c_master_dev_handle_t  dev_handle_  = nullptr;
+                i2c::scheduler::DeviceId i2c_device_  = i2c::scheduler::INVALID_DEVICE;
+                esp_timer_handle_t       timer_       = nullptr;
+                bool                     initialized_ = false;
+                Mode                     mode_        = Mode::SINGLE_ENDED;
+                uint8_t                  channels_    = MC1081S_CHANNEL_COUNT;
+
+                // 状态机
+                std::atomic<State> state_{State::IDLE};
+                std::atomic<bool>  continuous_{false};
+                uint32_t           interval_ms_ = 0;
+                uint32_t           polls_       = 0; // 本次转换的查询次数
+                int64_t            start_us_    = 0; // 本次转换的启动时间
+                Callback           callback_;
+
+                // 异步事务的读缓冲（需在回调前保持有效）
+                uint8_t status_ = 0;
+                uint8_t raw_[32];
+
+                // 滑动平均
+                float   history_[MAX_AVERAGE][MC1081S_CHANNEL_COUNT];
+                uint8_t average_       = 1;
+                uint8_t history_count_ = 0;
+                uint8_t history_index_ = 0;
+
+                mutable std::mutex mutex_;
+                CapData            latest_;
+                Stats              stats_;
+            };
+
+        } // namespace mc1081s
+    } // namespace device
+} // namespace app
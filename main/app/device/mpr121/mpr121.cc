@@ -2,7 +2,9 @@
 
 #include <cstring>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include "system/task/task.hpp"
+#include "tool/recorder/recorder.hpp"
 
 static const char* const TAG = "MPR121";
 
@@ -73,6 +75,16 @@ namespace app
                     return false;
                 }
 
+                // 登记到 I2C 调度器，之后的读写按优先级排队
+                i2c_device_ = i2c::scheduler::Scheduler::getInstance().registerDevice(
+                    "MPR121", dev_handle_, i2c::scheduler::Priority::NORMAL);
+                if (i2c_device_ == i2c::scheduler::INVALID_DEVICE)
+                {
+                    ESP_LOGE(TAG, "登记 I2C 调度设备失败");
+                    deinit();
+                    return false;
+                }
+
                 // 软复位：写入 0x63 到软复位寄存器（参考原始组件 MPR121_reset）
                 if (!wireWriteDataByte(SRST, SOFT_RESET_VALUE))
                 {
@@ -134,16 +146,35 @@ namespace app
                 // 等待配置生效
                 vTaskDelay(pdMS_TO_TICKS(10));
 
+                // 配置 IRQ 引脚（可选），失败时回退到轮询模式
+                if (irq_pin_ != GPIO_NUM_NC && !setupIrq())
+                {
+                    ESP_LOGW(TAG, "IRQ 引脚配置失败，回退到轮询模式");
+                    irq_pin_ = GPIO_NUM_NC;
+                }
+
                 initialized_ = true;
-                ESP_LOGI(TAG, "MPR121 初始化成功 (地址: 0x%02X)", i2c_addr_);
+                ESP_LOGI(TAG, "MPR121 初始化成功 (地址: 0x%02X, 模式: %s)", i2c_addr_,
+                         isIrqMode() ? "中断" : "轮询");
                 return true;
             }
 
             void MPR121::deinit()
             {
+                releaseIrq();
+
                 if (dev_handle_ != nullptr)
                 {
-                    i2c_master_bus_rm_device(dev_handle_);
+                    // 调度器中仍有该设备的事务时不能移除句柄
+                    if (i2c::scheduler::Scheduler::getInstance().unregisterDevice(i2c_device_))
+                    {
+                        i2c_master_bus_rm_device(dev_handle_);
+                    }
+                    else
+                    {
+                        ESP_LOGE(TAG, "I2C 事务未结束，保留设备句柄");
+                    }
+                    i2c_device_ = i2c::scheduler::INVALID_DEVICE;
                     dev_handle_ = nullptr;
                 }
                 bus_handle_  = nullptr;
@@ -242,6 +273,17 @@ namespace app
                     return false;
                 }
 
+                // 中断模式：任务启动后再打开中断，确保通知目标有效
+                if (isIrqMode())
+                {
+                    irq_task_handle_.store(data_collection_task_->getHandle(),
+                                           std::memory_order_release);
+                    gpio_intr_enable(irq_pin_);
+                    ESP_LOGI(TAG, "数据采集任务已启动（中断模式，兜底检查间隔: %lu ms）",
+                             (unsigned long)interval_ms);
+                    return true;
+                }
+
                 ESP_LOGI(TAG, "数据采集任务已启动，采集间隔: %lu ms", (unsigned long)interval_ms);
                 return true;
             }
@@ -256,6 +298,13 @@ namespace app
                 // 停止任务
                 collection_running_ = false;
 
+                // 先关闭中断，避免向已删除的任务发送通知
+                if (isIrqMode())
+                {
+                    gpio_intr_disable(irq_pin_);
+                    irq_task_handle_.store(nullptr, std::memory_order_release);
+                }
+
                 // 删除任务
                 if (data_collection_task_ != nullptr)
                 {
@@ -273,15 +322,38 @@ namespace app
 
                 uint32_t count             = 0;
                 int      last_touch_status = -1; // 上次的触摸状态，-1表示未初始化
+                int32_t  last_touched      = -1; // 上次的触摸位掩码，-1表示未初始化
 
                 while (collection_running_)
                 {
+                    // 中断模式：等待 IRQ 通知，超时后仅在 IRQ 引脚仍为低电平（有未读变化）时读取
+                    uint32_t irq_time_us = 0;
+                    if (isIrqMode())
+                    {
+                        uint32_t notified =
+                            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(collection_interval_ms_));
+                        if (!collection_running_)
+                        {
+                            break;
+                        }
+                        if (notified == 0 && gpio_get_level(irq_pin_) != 0 && last_touched >= 0)
+                        {
+                            continue;
+                        }
+                        irq_time_us = irq_time_us_.exchange(0, std::memory_order_acq_rel);
+                    }
+
                     count++;
 
-                    // 读取触摸数据
+                    // 读取触摸数据（读取触摸状态寄存器同时会清除 MPR121 的 IRQ）
                     TouchData data;
                     bool      read_ok = readTouch(data);
 
+                    if (read_ok && irq_time_us != 0)
+                    {
+                        recordIrqLatency(irq_time_us);
+                    }
+
                     // 判断触摸状态
                     int current_status = -1;
                     if (read_ok && data.valid)
@@ -359,13 +431,134 @@ namespace app
                         }
                     }
 
-                    // 等待指定间隔
-                    app::sys::task::TaskManager::delayMs(collection_interval_ms_);
+                    // 触摸位掩码变化时发送事件
+                    if (read_ok && data.valid && static_cast<int32_t>(data.touched) != last_touched)
+                    {
+                        last_touched = data.touched;
+                        tool::recorder::Recorder::getInstance().recordTouch(data.touched);
+
+                        namespace bus = app::sys::event::bus;
+                        bus::EventBus::getInstance().publish<bus::Topic::TOUCH_CHANGED>(data);
+                    }
+
+                    // 轮询模式：等待指定间隔
+                    if (!isIrqMode())
+                    {
+                        app::sys::task::TaskManager::delayMs(collection_interval_ms_);
+                    }
                 }
 
                 ESP_LOGI(TAG, "数据采集任务结束");
             }
 
+            bool MPR121::setupIrq()
+            {
+                // MPR121 的 IRQ 为开漏低电平有效输出，触摸状态变化时拉低，读取状态寄存器后释放
+                gpio_config_t io_conf = {};
+                io_conf.pin_bit_mask  = 1ULL << irq_pin_;
+                io_conf.mode          = GPIO_MODE_INPUT;
+                io_conf.pull_up_en    = GPIO_PULLUP_ENABLE;
+                io_conf.pull_down_en  = GPIO_PULLDOWN_DISABLE;
+                io_conf.intr_type     = GPIO_INTR_NEGEDGE;
+
+                esp_err_t ret = gpio_config(&io_conf);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "配置 IRQ 引脚失败: %s", esp_err_to_name(ret));
+                    return false;
+                }
+
+                // GPIO 中断服务可能已被其他模块安装
+                ret = gpio_install_isr_service(0);
+                if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE)
+                {
+                    ESP_LOGE(TAG, "安装 GPIO 中断服务失败: %s", esp_err_to_name(ret));
+                    gpio_reset_pin(irq_pin_);
+                    return false;
+                }
+
+                // 采集任务启动前保持中断关闭
+                gpio_intr_disable(irq_pin_);
+
+                ret = gpio_isr_handler_add(irq_pin_, &MPR121::irqHandler, this);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "注册 IRQ 中断处理函数失败: %s", esp_err_to_name(ret));
+                    gpio_reset_pin(irq_pin_);
+                    return false;
+                }
+
+                irq_installed_ = true;
+                {
+                    std::lock_guard<std::mutex> lock(irq_stats_mutex_);
+                    irq_latency_stats_  = IrqLatencyStats();
+                    irq_latency_sum_us_ = 0;
+                }
+                return true;
+            }
+
+            void MPR121::releaseIrq()
+            {
+                if (!irq_installed_)
+                {
+                    return;
+                }
+
+                gpio_intr_disable(irq_pin_);
+                gpio_isr_handler_remove(irq_pin_);
+                gpio_reset_pin(irq_pin_);
+                irq_task_handle_.store(nullptr, std::memory_order_release);
+                irq_installed_ = false;
+            }
+
+            void IRAM_ATTR MPR121::irqHandler(void* arg)
+            {
+                auto*        self   = static_cast<MPR121*>(arg);
+                TaskHandle_t target = self->irq_task_handle_.load(std::memory_order_acquire);
+                if (target == nullptr)
+                {
+                    return;
+                }
+
+                // 只记录一次变化中的第一个边沿，用于计算响应延迟
+                // 只取时间戳低 32 位（约 71 分钟回绕，延迟用无符号减法计算），0 表示无记录
+                uint32_t now_us   = static_cast<uint32_t>(esp_timer_get_time());
+                uint32_t expected = 0;
+                self->irq_time_us_.compare_exchange_strong(expected, now_us != 0 ? now_us : 1,
+                                                           std::memory_order_acq_rel);
+
+                BaseType_t higher_priority_task_woken = pdFALSE;
+                vTaskNotifyGiveFromISR(target, &higher_priority_task_woken);
+                if (higher_priority_task_woken == pdTRUE)
+                {
+                    portYIELD_FROM_ISR();
+                }
+            }
+
+            void MPR121::recordIrqLatency(uint32_t irq_time_us)
+            {
+                uint32_t latency_us = static_cast<uint32_t>(esp_timer_get_time()) - irq_time_us;
+
+                IrqLatencyStats stats;
+                {
+                    std::lock_guard<std::mutex> lock(irq_stats_mutex_);
+                    irq_latency_stats_.count++;
+                    irq_latency_stats_.last_us = latency_us;
+                    if (latency_us > irq_latency_stats_.max_us)
+                    {
+                        irq_latency_stats_.max_us = latency_us;
+                    }
+                    irq_latency_sum_us_ += latency_us;
+                    irq_latency_stats_.avg_us =
+                        static_cast<uint32_t>(irq_latency_sum_us_ / irq_latency_stats_.count);
+                    stats = irq_latency_stats_;
+                }
+
+                ESP_LOGD(TAG, "触摸响应延迟: %lu us (平均 %lu us, 最大 %lu us)",
+                         (unsigned long)latency_us, (unsigned long)stats.avg_us,
+                         (unsigned long)stats.max_us);
+            }
+
             // 原始 I2C 读写函数
             bool MPR121::wireWriteDataByte(uint8_t reg, uint8_t val)
             {
@@ -379,7 +572,8 @@ namespace app
                 data[1] = val;
 
                 // 使用 1000ms 超时
-                esp_err_t ret = i2c_master_transmit(dev_handle_, data, 2, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmit(i2c_device_, data, 2);
                 if (ret != ESP_OK)
                 {
                     ESP_LOGE(TAG, "写入寄存器 0x%02X 失败: %s", reg, esp_err_to_name(ret));
@@ -398,8 +592,8 @@ namespace app
 
                 uint8_t reg_addr = reg;
                 // 使用 1000ms 超时
-                esp_err_t ret =
-                    i2c_master_transmit_receive(dev_handle_, &reg_addr, 1, &val, 1, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmitReceive(i2c_device_, &reg_addr, 1, &val, 1);
                 if (ret != ESP_OK)
                 {
                     ESP_LOGE(TAG, "读取寄存器 0x%02X 失败: %s", reg, esp_err_to_name(ret));
@@ -418,8 +612,8 @@ namespace app
 
                 uint8_t reg_addr = reg;
                 // 使用 1000ms 超时
-                esp_err_t ret =
-                    i2c_master_transmit_receive(dev_handle_, &reg_addr, 1, val, len, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmitReceive(i2c_device_, &reg_addr, 1, val, len);
                 if (ret != ESP_OK)
                 {
                     ESP_LOGE(TAG, "读取寄存器块 0x%02X 失败: %s", reg, esp_err_to_name(ret));
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <driver/i2c_master.h>
 #include <driver/gpio.h>
 #include "system/task/task.hpp"
+#include "i2c/scheduler/scheduler.hpp"
+#include "system/event/bus/bus.hpp"
 
 namespace app
 {
@@ -21,6 +25,7 @@ namespace app
 
             /**
              * @brief MPR121 触摸传感器数据结构
+             * @note 也是事件总线 Topic::TOUCH_CHANGED 的负载
              */
             struct TouchData
             {
@@ -31,6 +36,19 @@ namespace app
                 TouchData() : touched(0), valid(false), timestamp(0) {}
             };
 
+            /**
+             * @brief 中断模式下的触摸响应延迟统计（IRQ 下降沿 -> 触摸状态读取完成）
+             */
+            struct IrqLatencyStats
+            {
+                uint32_t count;   // 统计次数
+                uint32_t last_us; // 最近一次延迟（微秒）
+                uint32_t avg_us;  // 平均延迟（微秒）
+                uint32_t max_us;  // 最大延迟（微秒）
+
+                IrqLatencyStats() : count(0), last_us(0), avg_us(0), max_us(0) {}
+            };
+
             /**
              * @brief MPR121 触摸传感器驱动类（单例模式）
              */
@@ -94,10 +112,21 @@ namespace app
                     return initialized_;
                 }
 
+                /**
+                 * @brief 是否工作在中断模式（init 时指定了 IRQ 引脚）
+                 */
+                bool isIrqMode() const
+                {
+                    return irq_pin_ != GPIO_NUM_NC;
+                }
+
                 /**
                  * @brief 启动后台数据采集任务
                  * @param interval_ms 采集间隔（毫秒），默认 100ms
                  * @return true 成功, false 失败
+                 * @note 中断模式下任务只在 IRQ 触发时读取触摸状态寄存器，
+                 *       interval_ms 作为兜底检查周期（防止丢失边沿），此时 I2C 只在 IRQ
+                 *       引脚为低电平时才访问
                  */
                 bool startDataCollection(uint32_t interval_ms = 100);
 
@@ -183,10 +212,32 @@ namespace app
                     return getInstance().getCurrentTouchStatus();
                 }
 
+                /**
+                 * @brief 获取中断模式下的触摸响应延迟统计
+                 * @return 延迟统计（轮询模式下 count 为 0）
+                 */
+                IrqLatencyStats getIrqLatencyStats() const
+                {
+                    std::lock_guard<std::mutex> lock(irq_stats_mutex_);
+                    return irq_latency_stats_;
+                }
+
             private:
                 MPR121() = default;
                 ~MPR121();
 
+                // 配置 IRQ 引脚中断
+                bool setupIrq();
+
+                // 释放 IRQ 引脚中断
+                void releaseIrq();
+
+                // IRQ 中断服务函数
+                static void irqHandler(void* arg);
+
+                // 记录一次中断响应延迟
+                void recordIrqLatency(uint32_t irq_time_us);
+
                 // 原始 I2C 读写函数
                 bool wireWriteDataByte(uint8_t reg, uint8_t val);
                 bool wireReadDataByte(uint8_t reg, uint8_t& val);
@@ -199,6 +250,9 @@ namespace app
                 i2c_master_dev_handle_t dev_handle_  = nullptr;
                 bool                    initialized_ = false;
                 uint8_t                 i2c_addr_    = MPR121_I2C_ADDR;
+
+                // I2C 调度器中的设备 ID
+                i2c::scheduler::DeviceId i2c_device_ = i2c::scheduler::INVALID_DEVICE;
                 gpio_num_t              irq_pin_     = GPIO_NUM_NC;
 
                 // 数据采集任务相关
@@ -211,6 +265,16 @@ namespace app
 
                 // 当前触摸状态：0=未触摸，1=触摸，-1=未初始化
                 int current_touch_status_ = -1;
+
+                // 中断模式相关（ISR 只访问两个原子量；64 位原子操作在 Xtensa 上不是无锁的）
+                bool                      irq_installed_ = false;    // 是否已注册中断处理函数
+                std::atomic<TaskHandle_t> irq_task_handle_{nullptr}; // 中断通知的目标任务
+                std::atomic<uint32_t>     irq_time_us_{0};           // IRQ 时间戳低 32 位，0=无
+
+                // 响应延迟统计（采集任务更新，getIrqLatencyStats() 在其他任务读取）
+                mutable std::mutex irq_stats_mutex_;
+                IrqLatencyStats    irq_latency_stats_;
+                uint64_t           irq_latency_sum_us_ = 0; // 延迟累计（用于求平均）
             };
 
         } // namespace mpr121
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <esp_log.h>
 #include "system/task/task.hpp"
+#include "tool/recorder/recorder.hpp"
 
 static const char* const TAG = "QMI8658A";
 
@@ -49,6 +50,16 @@ namespace app
                     return false;
                 }
 
+                // 登记到 I2C 调度器，之后的读写按优先级排队
+                i2c_device_ = i2c::scheduler::Scheduler::getInstance().registerDevice(
+                    "QMI8658A", dev_handle_, i2c::scheduler::Priority::NORMAL);
+                if (i2c_device_ == i2c::scheduler::INVALID_DEVICE)
+                {
+                    ESP_LOGE(TAG, "登记 I2C 调度设备失败");
+                    deinit();
+                    return false;
+                }
+
                 // 检查设备 ID，带重试机制
                 uint8_t who_am_i    = 0;
                 int     retry_count = 0;
@@ -113,7 +124,16 @@ namespace app
             {
                 if (dev_handle_ != nullptr)
                 {
-                    i2c_master_bus_rm_device(dev_handle_);
+                    // 调度器中仍有该设备的事务时不能移除句柄
+                    if (i2c::scheduler::Scheduler::getInstance().unregisterDevice(i2c_device_))
+                    {
+                        i2c_master_bus_rm_device(dev_handle_);
+                    }
+                    else
+                    {
+                        ESP_LOGE(TAG, "I2C 事务未结束，保留设备句柄");
+                    }
+                    i2c_device_ = i2c::scheduler::INVALID_DEVICE;
                     dev_handle_ = nullptr;
                 }
                 bus_handle_  = nullptr;
@@ -172,6 +192,11 @@ namespace app
                     data.gyro_x = static_cast<float>(data.gyr_x_raw) * GYRO_SCALE;
                     data.gyro_y = static_cast<float>(data.gyr_y_raw) * GYRO_SCALE;
                     data.gyro_z = static_cast<float>(data.gyr_z_raw) * GYRO_SCALE;
+
+                    // 写入飞行记录器
+                    const int16_t raw[6] = {data.acc_x_raw, data.acc_y_raw, data.acc_z_raw,
+                                            data.gyr_x_raw, data.gyr_y_raw, data.gyr_z_raw};
+                    tool::recorder::Recorder::getInstance().recordImu(raw);
                 }
 
                 // 计算姿态角
@@ -235,7 +260,8 @@ namespace app
 
                 uint8_t data[2] = {reg, value};
                 // 使用 1000ms 超时
-                esp_err_t ret = i2c_master_transmit(dev_handle_, data, 2, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmit(i2c_device_, data, 2);
 
                 return ret == ESP_OK;
             }
@@ -248,8 +274,8 @@ namespace app
                 }
 
                 // 使用 1000ms 超时
-                esp_err_t ret =
-                    i2c_master_transmit_receive(dev_handle_, &reg, 1, buffer, length, 1000);
+                auto&     bus = i2c::scheduler::Scheduler::getInstance();
+                esp_err_t ret = bus.transmitReceive(i2c_device_, &reg, 1, buffer, length);
 
                 return ret == ESP_OK;
             }
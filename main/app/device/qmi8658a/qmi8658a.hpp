@@ -5,6 +5,7 @@
 #include <functional>
 #include <driver/i2c_master.h>
 #include "system/task/task.hpp"
+#include "i2c/scheduler/scheduler.hpp"
 
 namespace app
 {
@@ -241,6 +242,9 @@ namespace app
                 bool                    initialized_ = false;
                 uint8_t                 i2c_addr_    = QMI8658A_ADDR_LOW;
 
+                // I2C 调度器中的设备 ID
+                i2c::scheduler::DeviceId i2c_device_ = i2c::scheduler::INVALID_DEVICE;
+
                 // 标定相关
                 bool      calibrated_ = false; // 是否已标定
                 AngleData reference_angle_;    // 参考角度（标定时的角度）
@@ -0,0 +1,634 @@
+#include "scheduler.hpp"
+
+#include <cstring>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char* const TAG = "I2CScheduler";
+
+namespace app
+{
+    namespace i2c
+    {
+        namespace scheduler
+        {
+            namespace
+            {
+                const char* getPriorityName(Priority priority)
+                {
+                    switch (priority)
+                    {
+                    case Priority::HIGH:
+                        return "高";
+                    case Priority::NORMAL:
+                        return "中";
+                    case Priority::LOW:
+                        return "低";
+                    default:
+                        return "?";
+                    }
+                }
+            } // namespace
+
+            Scheduler::~Scheduler()
+            {
+                stop();
+            }
+
+            bool Scheduler::start()
+            {
+                if (running_)
+                {
+                    return true;
+                }
+
+                // 首次启动时创建队列和信号量，之后复用
+                if (free_queue_ == nullptr)
+                {
+                    free_queue_  = xQueueCreate(REQUEST_POOL_SIZE, sizeof(uint8_t));
+                    pending_sem_ = xSemaphoreCreateCounting(REQUEST_POOL_SIZE, 0);
+                    stopped_sem_ = xSemaphoreCreateBinary();
+                    for (auto& queue : priority_queues_)
+                    {
+                        queue = xQueueCreate(REQUEST_POOL_SIZE, sizeof(uint8_t));
+                    }
+                    for (auto& request : requests_)
+                    {
+                        request.done = xSemaphoreCreateBinary();
+                    }
+                }
+
+                bool created = free_queue_ != nullptr && pending_sem_ != nullptr &&
+                               stopped_sem_ != nullptr;
+                for (size_t i = 0; i < PRIORITY_COUNT; i++)
+                {
+                    created = created && priority_queues_[i] != nullptr;
+                }
+                for (size_t i = 0; i < REQUEST_POOL_SIZE; i++)
+                {
+                    created = created && requests_[i].done != nullptr;
+                }
+                if (!created)
+                {
+                    ESP_LOGE(TAG, "创建调度队列失败");
+                    return false;
+                }
+
+                // 所有请求槽位放回空闲队列
+                xQueueReset(free_queue_);
+                for (uint8_t i = 0; i < REQUEST_POOL_SIZE; i++)
+                {
+                    xQueueSend(free_queue_, &i, 0);
+                }
+
+                app::sys::task::Config task_config;
+                task_config.name       = "i2c_scheduler";
+                task_config.stack_size = 3 * 1024;
+                task_config.priority   = app::sys::task::Priority::HIGH;
+                task_config.core_id    = -1;
+                task_config.delay_ms   = 0;
+
+                scheduler_task_ =
+                    std::unique_ptr<app::sys::task::Task>(new app::sys::task::Task(
+                        [this](void* param) { this->schedulerTaskFunction(param); },
+                        task_config, this));
+
+                running_ = true;
+                if (!scheduler_task_->start())
+                {
+                    ESP_LOGE(TAG, "启动调度任务失败");
+                    running_ = false;
+                    scheduler_task_.reset();
+                    return false;
+                }
+
+                resetStats();
+                ESP_LOGI(TAG, "I2C 事务调度器已启动");
+                return true;
+            }
+
+            void Scheduler::stop()
+            {
+                if (!running_)
+                {
+                    return;
+                }
+
+                // 唤醒调度任务，等待其结束排队中的事务后再删除
+                running_ = false;
+                xSemaphoreGive(pending_sem_);
+                if (xSemaphoreTake(stopped_sem_, pdMS_TO_TICKS(DEFAULT_TIMEOUT_MS * 2)) != pdTRUE)
+                {
+                    ESP_LOGW(TAG, "等待调度任务退出超时");
+                }
+
+                if (scheduler_task_ != nullptr)
+                {
+                    scheduler_task_->destroy();
+                    scheduler_task_.reset();
+                }
+
+                ESP_LOGI(TAG, "I2C 事务调度器已停止");
+            }
+
+            DeviceId Scheduler::registerDevice(const char* name, i2c_master_dev_handle_t handle,
+                                               Priority priority)
+            {
+                if (handle == nullptr)
+                {
+                    ESP_LOGE(TAG, "设备句柄为空");
+                    return INVALID_DEVICE;
+                }
+
+                // 正在注销的槽位仍为占用状态，旧 ID 的事务结束前不会被复用
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                for (size_t i = 0; i < MAX_DEVICES; i++)
+                {
+                    if (!devices_[i].used)
+                    {
+                        devices_[i].used           = true;
+                        devices_[i].closing        = false;
+                        devices_[i].queued         = 0;
+                        devices_[i].active         = 0;
+                        devices_[i].handle         = handle;
+                        devices_[i].stats          = DeviceStats();
+                        devices_[i].stats.name     = name;
+                        devices_[i].stats.priority = priority;
+                        ESP_LOGI(TAG, "登记设备 %s (ID: %d, 优先级: %s)", name, (int)i,
+                                 getPriorityName(priority));
+                        return static_cast<DeviceId>(i);
+                    }
+                }
+
+                ESP_LOGE(TAG, "设备数量超过上限 %u，无法登记 %s", (unsigned int)MAX_DEVICES, name);
+                return INVALID_DEVICE;
+            }
+
+            bool Scheduler::unregisterDevice(DeviceId id)
+            {
+                if (id < 0 || static_cast<size_t>(id) >= MAX_DEVICES)
+                {
+                    return true;
+                }
+
+                // 调度任务等待自己取消排队事务会死锁
+                if (running_ && scheduler_task_ != nullptr &&
+                    xTaskGetCurrentTaskHandle() == scheduler_task_->getHandle())
+                {
+                    ESP_LOGE(TAG, "不能在调度任务中注销设备");
+                    return false;
+                }
+
+                const char* name = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    if (!devices_[id].used)
+                    {
+                        return true;
+                    }
+                    devices_[id].closing = true;
+                    name                 = devices_[id].stats.name;
+                }
+
+                // 排队中的事务由调度任务取出时取消，这里只需等待计数归零
+                int64_t deadline_us = esp_timer_get_time() + UNREGISTER_WAIT_MS * 1000LL;
+                while (true)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(stats_mutex_);
+                        Device& device = devices_[id];
+                        if (device.queued == 0 && device.active == 0)
+                        {
+                            device.used    = false;
+                            device.closing = false;
+                            device.handle  = nullptr;
+                            return true;
+                        }
+                    }
+
+                    if (esp_timer_get_time() >= deadline_us)
+                    {
+                        ESP_LOGE(TAG, "注销设备 %s 超时，仍有事务未结束", name);
+                        return false;
+                    }
+                    vTaskDelay(1);
+                }
+            }
+
+            esp_err_t Scheduler::transmit(DeviceId id, const uint8_t* data, size_t len,
+                                          int timeout_ms)
+            {
+                return transfer(id, data, len, nullptr, 0, timeout_ms);
+            }
+
+            esp_err_t Scheduler::receive(DeviceId id, uint8_t* data, size_t len, int timeout_ms)
+            {
+                return transfer(id, nullptr, 0, data, len, timeout_ms);
+            }
+
+            esp_err_t Scheduler::transmitReceive(DeviceId id, const uint8_t* write_data,
+                                                 size_t write_len, uint8_t* read_data,
+                                                 size_t read_len, int timeout_ms)
+            {
+                return transfer(id, write_data, write_len, read_data, read_len, timeout_ms);
+            }
+
+            esp_err_t Scheduler::transfer(DeviceId id, const uint8_t* write_data,
+                                          size_t write_len, uint8_t* read_data, size_t read_len,
+                                          int timeout_ms)
+            {
+                if (!isValidDevice(id))
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+
+                if (shouldBypass())
+                {
+                    return execute(id, write_data, write_len, read_data, read_len, timeout_ms,
+                                   esp_timer_get_time());
+                }
+
+                // 获取空闲请求槽位，等待时间计入排队时间
+                int64_t enqueue_us = esp_timer_get_time();
+                uint8_t index      = 0;
+                if (xQueueReceive(free_queue_, &index, pdMS_TO_TICKS(timeout_ms)) != pdTRUE)
+                {
+                    ESP_LOGW(TAG, "事务队列已满");
+                    return ESP_ERR_TIMEOUT;
+                }
+
+                Request& request   = requests_[index];
+                request.device     = id;
+                request.write_data = write_data;
+                request.write_len  = write_len;
+                request.read_data  = read_data;
+                request.read_len   = read_len;
+                request.timeout_ms = timeout_ms;
+                request.enqueue_us = enqueue_us;
+                request.result     = ESP_FAIL;
+                request.callback   = nullptr;
+                request.sync       = true;
+
+                // 同步事务的数据缓冲在调用者栈上，等待完成后才返回，因此无需复制
+                if (!enqueue(index))
+                {
+                    release(index);
+                    return ESP_ERR_INVALID_STATE;
+                }
+                xSemaphoreTake(request.done, portMAX_DELAY);
+
+                esp_err_t result = request.result;
+                release(index);
+                return result;
+            }
+
+            bool Scheduler::submit(DeviceId id, const uint8_t* write_data, size_t write_len,
+                                   uint8_t* read_data, size_t read_len, Callback callback,
+                                   int timeout_ms)
+            {
+                if (!isValidDevice(id) || write_len > MAX_ASYNC_WRITE ||
+                    (write_len > 0 && write_data == nullptr) ||
+                    (read_len > 0 && read_data == nullptr))
+                {
+                    ESP_LOGE(TAG, "异步事务参数无效");
+                    return false;
+                }
+
+                // 未启动时直接执行并回调
+                if (shouldBypass())
+                {
+                    esp_err_t result = execute(id, write_data, write_len, read_data, read_len,
+                                               timeout_ms, esp_timer_get_time());
+                    if (callback)
+                    {
+                        callback(result);
+                    }
+                    return true;
+                }
+
+                uint8_t index = 0;
+                if (xQueueReceive(free_queue_, &index, 0) != pdTRUE)
+                {
+                    ESP_LOGW(TAG, "事务队列已满，丢弃异步事务");
+                    return false;
+                }
+
+                Request& request = requests_[index];
+                if (write_len > 0)
+                {
+                    memcpy(request.write_copy, write_data, write_len);
+                }
+                request.device     = id;
+                request.write_data = request.write_copy;
+                request.write_len  = write_len;
+                request.read_data  = read_data;
+                request.read_len   = read_len;
+                request.timeout_ms = timeout_ms;
+                request.enqueue_us = esp_timer_get_time();
+                request.result     = ESP_FAIL;
+                request.callback   = std::move(callback);
+                request.sync       = false;
+
+                if (!enqueue(index))
+                {
+                    request.callback = nullptr;
+                    release(index);
+                    return false;
+                }
+                return true;
+            }
+
+            bool Scheduler::enqueue(uint8_t index)
+            {
+                Priority priority = Priority::NORMAL;
+                {
+                    // 与注销互斥：入队成功的事务一定计入 queued，注销会等待它结束
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    Device& device = devices_[requests_[index].device];
+                    if (!device.used || device.closing)
+                    {
+                        return false;
+                    }
+                    device.queued++;
+                    priority = device.stats.priority;
+
+                    uint32_t pending = ++pending_;
+                    if (pending > pending_max_)
+                    {
+                        pending_max_ = pending;
+                    }
+                }
+
+                // 槽位总数不超过队列深度，入队不会失败
+                xQueueSend(priority_queues_[static_cast<size_t>(priority)], &index, 0);
+                xSemaphoreGive(pending_sem_);
+                return true;
+            }
+
+            void Scheduler::complete(uint8_t index, esp_err_t result)
+            {
+                Request& request = requests_[index];
+                request.result   = result;
+                pending_--;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    devices_[request.device].queued--;
+                }
+
+                if (request.sync)
+                {
+                    // 同步调用者负责归还槽位
+                    xSemaphoreGive(request.done);
+                    return;
+                }
+
+                Callback callback = std::move(request.callback);
+                request.callback  = nullptr;
+                release(index);
+
+                if (callback)
+                {
+                    callback(result);
+                }
+            }
+
+            void Scheduler::release(uint8_t index)
+            {
+                xQueueSend(free_queue_, &index, 0);
+            }
+
+            bool Scheduler::shouldBypass() const
+            {
+                if (!running_ || scheduler_task_ == nullptr)
+                {
+                    return true;
+                }
+
+                // 回调中再发起同步事务时直接执行，避免调度任务等待自己
+                return xTaskGetCurrentTaskHandle() == scheduler_task_->getHandle();
+            }
+
+            bool Scheduler::isValidDevice(DeviceId id) const
+            {
+                if (id < 0 || static_cast<size_t>(id) >= MAX_DEVICES)
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                return devices_[id].used && !devices_[id].closing;
+            }
+
+            esp_err_t Scheduler::execute(DeviceId id, const uint8_t* write_data, size_t write_len,
+                                         uint8_t* read_data, size_t read_len, int timeout_ms,
+                                         int64_t enqueue_us)
+            {
+                // 计入进行中的事务，注销会等到 recordStats 之后才释放句柄；
+                // 正在注销的设备不再访问总线，排队中的事务在此被取消
+                i2c_master_dev_handle_t handle = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    Device& device = devices_[id];
+                    if (!device.used || device.closing || device.handle == nullptr)
+                    {
+                        return ESP_ERR_INVALID_STATE;
+                    }
+                    handle = device.handle;
+                    device.active++;
+                }
+
+                int64_t   start_us = esp_timer_get_time();
+                esp_err_t result   = ESP_ERR_INVALID_ARG;
+                if (write_len > 0 && read_len > 0)
+                {
+                    result = i2c_master_transmit_receive(handle, write_data, write_len, read_data,
+                                                         read_len, timeout_ms);
+                }
+                else if (write_len > 0)
+                {
+                    result = i2c_master_transmit(handle, write_data, write_len, timeout_ms);
+                }
+                else if (read_len > 0)
+                {
+                    result = i2c_master_receive(handle, read_data, read_len, timeout_ms);
+                }
+                int64_t end_us = esp_timer_get_time();
+
+                recordStats(id, result, start_us - enqueue_us, end_us - start_us);
+                return result;
+            }
+
+            void Scheduler::schedulerTaskFunction(void* param)
+            {
+                ESP_LOGI(TAG, "调度任务开始运行");
+
+                while (true)
+                {
+                    xSemaphoreTake(pending_sem_, portMAX_DELAY);
+                    if (!running_)
+                    {
+                        break;
+                    }
+
+                    // 每次只取一个事务，且总是从最高优先级的非空队列取
+                    uint8_t index = 0;
+                    bool    found = false;
+                    for (size_t i = 0; i < PRIORITY_COUNT && !found; i++)
+                    {
+                        found = xQueueReceive(priority_queues_[i], &index, 0) == pdTRUE;
+                    }
+                    if (!found)
+                    {
+                        continue;
+                    }
+
+                    const Request& req    = requests_[index];
+                    esp_err_t      result = execute(req.device, req.write_data, req.write_len,
+                                                    req.read_data, req.read_len, req.timeout_ms,
+                                                    req.enqueue_us);
+                    complete(index, result);
+                }
+
+                // 结束排队中的事务，避免同步调用者永久阻塞
+                uint8_t index = 0;
+                for (size_t i = 0; i < PRIORITY_COUNT; i++)
+                {
+                    while (xQueueReceive(priority_queues_[i], &index, 0) == pdTRUE)
+                    {
+                        complete(index, ESP_ERR_INVALID_STATE);
+                    }
+                }
+                while (xSemaphoreTake(pending_sem_, 0) == pdTRUE)
+                {
+                }
+
+                ESP_LOGI(TAG, "调度任务结束");
+                xSemaphoreGive(stopped_sem_);
+
+                // 等待 stop() 删除本任务
+                while (true)
+                {
+                    vTaskDelay(portMAX_DELAY);
+                }
+            }
+
+            void Scheduler::recordStats(DeviceId id, esp_err_t result, int64_t wait_us,
+                                        int64_t busy_us)
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+
+                devices_[id].active--;
+
+                DeviceStats& stats = devices_[id].stats;
+                stats.transactions++;
+                stats.busy_us += busy_us;
+                stats.wait_sum_us += wait_us;
+                if (wait_us > stats.wait_max_us)
+                {
+                    stats.wait_max_us = static_cast<uint32_t>(wait_us);
+                }
+
+                if (result != ESP_OK)
+                {
+                    stats.errors++;
+                    if (result == ESP_ERR_TIMEOUT)
+                    {
+                        stats.timeouts++;
+                    }
+                    // 不同 IDF 版本的 i2c_master 对 NACK 返回的错误码不同
+                    else if (result == ESP_ERR_INVALID_STATE || result == ESP_ERR_INVALID_RESPONSE)
+                    {
+                        stats.nacks++;
+                    }
+                }
+
+                transactions_++;
+                busy_us_ += busy_us;
+            }
+
+            bool Scheduler::getDeviceStats(DeviceId id, DeviceStats& stats) const
+            {
+                if (id < 0 || static_cast<size_t>(id) >= MAX_DEVICES)
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                if (!devices_[id].used)
+                {
+                    return false;
+                }
+                stats = devices_[id].stats;
+                return true;
+            }
+
+            BusStats Scheduler::getBusStats() const
+            {
+                BusStats stats;
+
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats.transactions = transactions_;
+                stats.pending      = pending_;
+                stats.pending_max  = pending_max_;
+                stats.busy_us      = busy_us_;
+                stats.elapsed_us   = esp_timer_get_time() - stats_start_us_;
+                if (stats.elapsed_us > 0)
+                {
+                    stats.utilization_permille =
+                        static_cast<uint32_t>(stats.busy_us * 1000 / stats.elapsed_us);
+                }
+                return stats;
+            }
+
+            void Scheduler::resetStats()
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                for (auto& device : devices_)
+                {
+                    const char* name     = device.stats.name;
+                    Priority    priority = device.stats.priority;
+                    device.stats          = DeviceStats();
+                    device.stats.name     = name;
+                    device.stats.priority = priority;
+                }
+                pending_max_    = pending_;
+                transactions_   = 0;
+                busy_us_        = 0;
+                stats_start_us_ = esp_timer_get_time();
+            }
+
+            void Scheduler::logStats() const
+            {
+                BusStats bus = getBusStats();
+                ESP_LOGI(TAG, "I2C 总线: 事务 %lu, 利用率 %lu.%lu%%, 排队 %lu (峰值 %lu)",
+                         (unsigned long)bus.transactions,
+                         (unsigned long)(bus.utilization_permille / 10),
+                         (unsigned long)(bus.utilization_permille % 10), (unsigned long)bus.pending,
+                         (unsigned long)bus.pending_max);
+
+                for (size_t i = 0; i < MAX_DEVICES; i++)
+                {
+                    DeviceStats stats;
+                    if (!getDeviceStats(static_cast<DeviceId>(i), stats))
+                    {
+                        continue;
+                    }
+
+                    uint32_t wait_avg_us =
+                        (stats.transactions > 0)
+                            ? static_cast<uint32_t>(stats.wait_sum_us / stats.transactions)
+                            : 0;
+                    ESP_LOGI(TAG,
+                             "  %-10s [%s] 事务 %lu, 占用 %lu ms, 等待 平均/最大 %lu/%lu us, "
+                             "错误 %lu (NACK %lu, 超时 %lu)",
+                             stats.name, getPriorityName(stats.priority),
+                             (unsigned long)stats.transactions,
+                             (unsigned long)(stats.busy_us / 1000), (unsigned long)wait_avg_us,
+                             (unsigned long)stats.wait_max_us, (unsigned long)stats.errors,
+                             (unsigned long)stats.nacks, (unsigned long)stats.timeouts);
+                }
+            }
+
+        } // namespace scheduler
+    } // namespace i2c
+} // namespace app
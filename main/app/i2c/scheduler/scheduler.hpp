@@ -0,0 +1,320 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <driver/i2c_master.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "system/task/task.hpp"
+
+namespace app
+{
+    namespace i2c
+    {
+        namespace scheduler
+        {
+            /**
+             * @brief 事务优先级（数值越小越优先）
+             */
+            enum class Priority : uint8_t
+            {
+                HIGH   = 0, // 高优先级：音频编解码、舵机
+                NORMAL = 1, // 普通优先级：触摸、姿态
+                LOW    = 2  // 低优先级：环境光等遥测数据
+            };
+
+            constexpr size_t PRIORITY_COUNT     = 3;
+            constexpr size_t MAX_DEVICES        = 8;    // 最多登记的设备数
+            constexpr size_t REQUEST_POOL_SIZE  = 16;   // 同时排队的事务数上限
+            constexpr size_t MAX_ASYNC_WRITE    = 16;   // 异步事务写数据上限（会被复制）
+            constexpr int    DEFAULT_TIMEOUT_MS = 1000; // 单次事务默认超时
+            constexpr int    UNREGISTER_WAIT_MS = 4000; // 注销设备时等待其事务结束的上限
+
+            // 设备 ID，由 registerDevice 分配
+            using DeviceId = int8_t;
+
+            constexpr DeviceId INVALID_DEVICE = -1;
+
+            /**
+             * @brief 异步事务完成回调
+             * @param result 事务结果（ESP_OK 表示成功）
+             * @note 在调度任务中执行，应尽快返回
+             */
+            using Callback = std::function<void(esp_err_t result)>;
+
+            /**
+             * @brief 单个设备的总线统计
+             */
+            struct DeviceStats
+            {
+                const char* name;         // 设备名称
+                Priority    priority;     // 设备优先级
+                uint32_t    transactions; // 完成的事务数
+                uint32_t    errors;       // 失败的事务数（含 NACK 和超时）
+                uint32_t    nacks;        // NACK 次数
+                uint32_t    timeouts;     // 超时次数
+                uint64_t    busy_us;      // 占用总线的累计时间（微秒）
+                uint64_t    wait_sum_us;  // 排队等待的累计时间（微秒）
+                uint32_t    wait_max_us;  // 最长排队等待时间（微秒）
+
+                DeviceStats()
+                    : name(nullptr), priority(Priority::NORMAL), transactions(0), errors(0),
+                      nacks(0), timeouts(0), busy_us(0), wait_sum_us(0), wait_max_us(0)
+                {
+                }
+            };
+
+            /**
+             * @brief 总线整体统计
+             */
+            struct BusStats
+            {
+                uint32_t transactions;         // 完成的事务数
+                uint32_t pending;              // 当前排队中的事务数
+                uint32_t pending_max;          // 排队事务数峰值
+                uint64_t busy_us;              // 总线占用累计时间（微秒）
+                uint64_t elapsed_us;           // 统计时长（微秒）
+                uint32_t utilization_permille; // 总线利用率（千分比）
+
+                BusStats()
+                    : transactions(0), pending(0), pending_max(0), busy_us(0), elapsed_us(0),
+                      utilization_permille(0)
+                {
+                }
+            };
+
+            /**
+             * @brief I2C 事务调度器（单例模式）
+             *
+             * 共享同一条 I2C 总线的设备先登记，之后的读写都经由调度任务按优先级串行执行：
+             * 高优先级事务（舵机、音频编解码）总是先于排队中的低优先级事务（遥测），
+             * 最多只需等待当前正在进行的一个事务。
+             * 同步接口在调用任务中阻塞等待结果；异步接口在完成后于调度任务中回调。
+             * 调度器未启动时，所有接口退化为在调用任务中直接访问总线（仍记录统计）。
+             */
+            class Scheduler
+            {
+            public:
+                /**
+                 * @brief 获取单例实例
+                 * @return Scheduler 实例的引用
+                 */
+                static Scheduler& getInstance()
+                {
+                    static Scheduler instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                Scheduler(const Scheduler&)            = delete;
+                Scheduler& operator=(const Scheduler&) = delete;
+
+                /**
+                 * @brief 启动调度任务
+                 * @return true 成功, false 失败
+                 */
+                bool start();
+
+                /**
+                 * @brief 停止调度任务，排队中的事务以 ESP_ERR_INVALID_STATE 结束
+                 */
+                void stop();
+
+                /**
+                 * @brief 调度任务是否在运行
+                 */
+                bool isRunning() const
+                {
+                    return running_;
+                }
+
+                /**
+                 * @brief 登记总线上的设备
+                 * @param name 设备名称（需为静态字符串）
+                 * @param handle i2c_master_bus_add_device 得到的设备句柄
+                 * @param priority 该设备事务的优先级
+                 * @return 设备 ID，失败返回 INVALID_DEVICE
+                 */
+                DeviceId registerDevice(const char* name, i2c_master_dev_handle_t handle,
+                                        Priority priority);
+
+                /**
+                 * @brief 注销设备（在 i2c_master_bus_rm_device 之前调用）
+                 *
+                 * 之后提交的事务立即失败，排队中的事务以 ESP_ERR_INVALID_STATE 取消，
+                 * 并阻塞到该设备正在进行的事务结束。等待期间设备 ID 不会分配给其他设备。
+                 * @param id 设备 ID（INVALID_DEVICE 直接返回 true）
+                 * @return true 已注销，可以移除总线设备, false 等待超时或在调度任务中调用，
+                 *         此时设备句柄仍可能被使用，不能移除
+                 * @note 不能在异步事务回调中调用
+                 */
+                bool unregisterDevice(DeviceId id);
+
+                /**
+                 * @brief 同步写
+                 * @param id 设备 ID
+                 * @param data 写数据
+                 * @param len 写数据长度
+                 * @param timeout_ms 总线事务超时（不含排队时间）
+                 * @return ESP_OK 成功，其他为错误码
+                 */
+                esp_err_t transmit(DeviceId id, const uint8_t* data, size_t len,
+                                   int timeout_ms = DEFAULT_TIMEOUT_MS);
+
+                /**
+                 * @brief 同步读
+                 * @param id 设备 ID
+                 * @param data 读缓冲
+                 * @param len 读取长度
+                 * @param timeout_ms 总线事务超时（不含排队时间）
+                 * @return ESP_OK 成功，其他为错误码
+                 */
+                esp_err_t receive(DeviceId id, uint8_t* data, size_t len,
+                                  int timeout_ms = DEFAULT_TIMEOUT_MS);
+
+                /**
+                 * @brief 同步写后读（中间为重复起始条件，不释放总线）
+                 * @param id 设备 ID
+                 * @param write_data 写数据（通常为寄存器地址）
+                 * @param write_len 写数据长度
+                 * @param read_data 读缓冲
+                 * @param read_len 读取长度
+                 * @param timeout_ms 总线事务超时（不含排队时间）
+                 * @return ESP_OK 成功，其他为错误码
+                 */
+                esp_err_t transmitReceive(DeviceId id, const uint8_t* write_data,
+                                          size_t write_len, uint8_t* read_data, size_t read_len,
+                                          int timeout_ms = DEFAULT_TIMEOUT_MS);
+
+                /**
+                 * @brief 提交异步事务（写、读或写后读）
+                 * @param id 设备 ID
+                 * @param write_data 写数据，提交时被复制，长度不超过 MAX_ASYNC_WRITE
+                 * @param write_len 写数据长度，0 表示纯读
+                 * @param read_data 读缓冲，需保持有效直到回调执行
+                 * @param read_len 读取长度，0 表示纯写
+                 * @param callback 完成回调，可为空
+                 * @param timeout_ms 总线事务超时
+                 * @return true 已入队, false 参数错误或队列已满
+                 */
+                bool submit(DeviceId id, const uint8_t* write_data, size_t write_len,
+                            uint8_t* read_data, size_t read_len, Callback callback,
+                            int timeout_ms = DEFAULT_TIMEOUT_MS);
+
+                /**
+                 * @brief 获取设备统计
+                 * @param id 设备 ID
+                 * @param stats 输出统计
+                 * @return true 成功, false 设备不存在
+                 */
+                bool getDeviceStats(DeviceId id, DeviceStats& stats) const;
+
+                /**
+                 * @brief 获取总线整体统计
+                 */
+                BusStats getBusStats() const;
+
+                /**
+                 * @brief 清零所有统计
+                 */
+                void resetStats();
+
+                /**
+                 * @brief 打印总线和各设备的统计信息
+                 */
+                void logStats() const;
+
+            private:
+                Scheduler() = default;
+                ~Scheduler();
+
+                // 排队中的事务
+                struct Request
+                {
+                    DeviceId          device;     // 目标设备
+                    const uint8_t*    write_data; // 写数据
+                    size_t            write_len;  // 写数据长度
+                    uint8_t*          read_data;  // 读缓冲
+                    size_t            read_len;   // 读取长度
+                    int               timeout_ms; // 总线事务超时
+                    int64_t           enqueue_us; // 入队时间
+                    esp_err_t         result;     // 事务结果
+                    Callback          callback;   // 异步回调（同步事务为空）
+                    bool              sync;       // 是否为同步事务
+                    SemaphoreHandle_t done;       // 同步事务完成信号
+                    uint8_t           write_copy[MAX_ASYNC_WRITE]; // 异步事务的写数据副本
+                };
+
+                // 已登记的设备
+                struct Device
+                {
+                    bool                    used;    // 槽位已占用（注销完成前保持占用）
+                    bool                    closing; // 正在注销，不再接受和执行事务
+                    uint16_t                queued;  // 排队中的事务数
+                    uint16_t                active;  // 正在执行的事务数
+                    i2c_master_dev_handle_t handle;
+                    DeviceStats             stats;
+                };
+
+                // 同步事务：排队并等待完成
+                esp_err_t transfer(DeviceId id, const uint8_t* write_data, size_t write_len,
+                                   uint8_t* read_data, size_t read_len, int timeout_ms);
+
+                // 在当前任务中直接执行事务
+                esp_err_t execute(DeviceId id, const uint8_t* write_data, size_t write_len,
+                                  uint8_t* read_data, size_t read_len, int timeout_ms,
+                                  int64_t enqueue_us);
+
+                // 将请求放入对应优先级队列（设备已注销或正在注销时返回 false）
+                bool enqueue(uint8_t index);
+
+                // 完成请求（通知同步调用者或执行回调）
+                void complete(uint8_t index, esp_err_t result);
+
+                // 归还请求槽位
+                void release(uint8_t index);
+
+                // 是否应绕过队列直接执行（未启动或在调度任务内调用）
+                bool shouldBypass() const;
+
+                // 设备 ID 是否有效
+                bool isValidDevice(DeviceId id) const;
+
+                // 调度任务函数
+                void schedulerTaskFunction(void* param);
+
+                // 结束事务并更新统计
+                void recordStats(DeviceId id, esp_err_t result, int64_t wait_us, int64_t busy_us);
+
+                std::array<Request, REQUEST_POOL_SIZE> requests_{};
+                std::array<Device, MAX_DEVICES>        devices_{};
+
+                // 队列保存请求槽位下标
+                QueueHandle_t                             free_queue_ = nullptr;
+                std::array<QueueHandle_t, PRIORITY_COUNT> priority_queues_{};
+
+                SemaphoreHandle_t pending_sem_ = nullptr; // 待处理事务计数
+                SemaphoreHandle_t stopped_sem_ = nullptr; // 调度任务退出信号
+
+                std::unique_ptr<app::sys::task::Task> scheduler_task_;
+                std::atomic<bool>                     running_{false};
+
+                // 统计
+                mutable std::mutex    stats_mutex_;
+                std::atomic<uint32_t> pending_{0};
+                uint32_t              pending_max_    = 0;
+                uint32_t              transactions_   = 0;
+                uint64_t              busy_us_        = 0;
+                int64_t               stats_start_us_ = 0;
+            };
+
+        } // namespace scheduler
+    } // namespace i2c
+} // namespace app
@@ -12,8 +12,24 @@ typedef struct
     uint8_t camera : 5;   // 4-bit 预留/额外配置
 } logic_config_t;
 
+// 输入位（传感器状态，组合成 0~31 的查找表下标）
+constexpr uint8_t LOGIC_INPUT_TOUCH    = 1 << 4; // 触摸
+constexpr uint8_t LOGIC_INPUT_PRESSURE = 1 << 3; // 压力
+constexpr uint8_t LOGIC_INPUT_GYRO     = 1 << 2; // 陀螺仪
+constexpr uint8_t LOGIC_INPUT_LIGHT    = 1 << 1; // 光敏
+constexpr uint8_t LOGIC_INPUT_VOICE    = 1 << 0; // 人声
+constexpr uint8_t LOGIC_INPUT_COUNT    = 32;     // 输入组合数
+
+// 输出位（上传控制，顺序与 command 字符串一致：触摸-压力-陀螺仪-光敏-摄像头）
+constexpr uint8_t LOGIC_OUTPUT_TOUCH    = 1 << 4; // 上传触摸数据
+constexpr uint8_t LOGIC_OUTPUT_PRESSURE = 1 << 3; // 上传压力数据
+constexpr uint8_t LOGIC_OUTPUT_GYRO     = 1 << 2; // 上传陀螺仪数据
+constexpr uint8_t LOGIC_OUTPUT_LIGHT    = 1 << 1; // 上传光敏数据
+constexpr uint8_t LOGIC_OUTPUT_CAMERA   = 1 << 0; // 上传摄像头数据
+constexpr uint8_t LOGIC_OUTPUT_ALL      = 0x1F;   // 全部输出位
+
 // 初始化默认配置
-inline logic_config_t initLogicConfig()
+constexpr logic_config_t initLogicConfig()
 {
     logic_config_t cfg{};
     cfg.touch    = 0b00100;
@@ -24,14 +40,50 @@ inline logic_config_t initLogicConfig()
     return cfg;
 }
 
-// 函数声明：计算 control 值
-// touch_status: 触摸状态 (0或1)
-// pressure_status: 压力状态 (0或1)
-// gyro_status: 陀螺仪状态 (0或1)
-// light_status: 光敏状态 (0或1)
+// 计算一种输入组合对应的输出位
+// inputs: LOGIC_INPUT_* 的组合
 // config: 配置参数
-// zero_streak: 连续 0 的计数（通过引用传递，可以修改）
-// tag: 日志标签
-int calculateControl(int touch_status, int pressure_status, int gyro_status, int light_status,
-                     int voice_status, const logic_config_t& config, int& zero_streak,
-                     const char* tag);
\ No newline at end of file
+// 注意：配置掩码按 4 位状态值匹配（触摸-压力-陀螺仪-光敏/人声），光敏和人声共用最低位
+constexpr uint8_t calculateControl(uint8_t inputs, const logic_config_t& config)
+{
+    uint8_t value = 0;
+    if (inputs & LOGIC_INPUT_TOUCH)
+    {
+        value |= 0x8;
+    }
+    if (inputs & LOGIC_INPUT_PRESSURE)
+    {
+        value |= 0x4;
+    }
+    if (inputs & LOGIC_INPUT_GYRO)
+    {
+        value |= 0x2;
+    }
+    if (inputs & (LOGIC_INPUT_LIGHT | LOGIC_INPUT_VOICE))
+    {
+        value |= 0x1;
+    }
+
+    uint8_t control = 0;
+    if (value & config.touch)
+    {
+        control |= LOGIC_OUTPUT_TOUCH;
+    }
+    if (value & config.pressure)
+    {
+        control |= LOGIC_OUTPUT_PRESSURE;
+    }
+    if (value & config.gyro)
+    {
+        control |= LOGIC_OUTPUT_GYRO;
+    }
+    if (value & config.sitive)
+    {
+        control |= LOGIC_OUTPUT_LIGHT;
+    }
+    if (value & config.camera)
+    {
+        control |= LOGIC_OUTPUT_CAMERA;
+    }
+    return control;
+}
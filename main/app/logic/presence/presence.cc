@@ -0,0 +1,112 @@
+#include "presence.hpp"
+
+namespace app
+{
+    namespace logic
+    {
+        namespace presence
+        {
+            const char* getSourceName(Source source)
+            {
+                switch (source)
+                {
+                case Source::MOTION:
+                    return "运动";
+                case Source::PROXIMITY:
+                    return "接近";
+                case Source::TOUCH:
+                    return "触摸";
+                case Source::PRESSURE:
+                    return "压力";
+                case Source::VOICE:
+                    return "语音";
+                default:
+                    return "未知";
+                }
+            }
+
+            void PresenceDetector::setConfig(const Config& config)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                config_ = config;
+            }
+
+            bool PresenceDetector::report(Source source, bool active, uint32_t now_ms)
+            {
+                size_t index = static_cast<size_t>(source);
+                if (index >= SOURCE_COUNT)
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (active && !active_[index])
+                {
+                    stats_.triggers[index]++;
+                    if (!present_)
+                    {
+                        stats_.last_trigger = source;
+                    }
+                }
+                else if (!active && active_[index])
+                {
+                    release_ms_[index] = now_ms;
+                }
+                active_[index] = active;
+                if (active)
+                {
+                    seen_[index] = true;
+                }
+
+                return updateLocked(now_ms);
+            }
+
+            bool PresenceDetector::tick(uint32_t now_ms)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return updateLocked(now_ms);
+            }
+
+            bool PresenceDetector::isPresent() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return present_;
+            }
+
+            Stats PresenceDetector::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return stats_;
+            }
+
+            bool PresenceDetector::updateLocked(uint32_t now_ms)
+            {
+                bool present = false;
+                for (size_t i = 0; i < SOURCE_COUNT && !present; i++)
+                {
+                    // 有效，或释放后仍在保持时间内
+                    present = active_[i] ||
+                              (seen_[i] && now_ms - release_ms_[i] < config_.hold_ms[i]);
+                }
+
+                if (present == present_)
+                {
+                    return false;
+                }
+
+                if (present)
+                {
+                    stats_.activations++;
+                }
+                else
+                {
+                    stats_.present_ms += now_ms - stats_.last_change_ms;
+                }
+                stats_.last_change_ms = now_ms;
+                present_              = present;
+                return true;
+            }
+
+        } // namespace presence
+    } // namespace logic
+} // namespace app
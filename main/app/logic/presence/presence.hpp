@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace app
+{
+    namespace logic
+    {
+        namespace presence
+        {
+            /**
+             * @brief 在场证据来源
+             */
+            enum class Source : uint8_t
+            {
+                MOTION    = 0, // 陀螺仪检测到被移动
+                PROXIMITY = 1, // 接近传感器检测到靠近
+                TOUCH     = 2, // 触摸传感器
+                PRESSURE  = 3, // 压力阵列
+                VOICE     = 4, // 检测到语音（对话进行中保持预热）
+                COUNT     = 5
+            };
+
+            constexpr size_t SOURCE_COUNT = static_cast<size_t>(Source::COUNT);
+
+            /**
+             * @brief 获取来源名称
+             */
+            const char* getSourceName(Source source);
+
+            /**
+             * @brief 在场检测参数
+             */
+            struct Config
+            {
+                // 各来源释放后继续保持"有人"的时间（毫秒），下标为 Source
+                std::array<uint32_t, SOURCE_COUNT> hold_ms;
+
+                Config() : hold_ms{20000, 30000, 60000, 60000, 30000} {}
+            };
+
+            /**
+             * @brief 在场检测统计
+             */
+            struct Stats
+            {
+                uint32_t                           activations;    // 进入"有人"的次数
+                std::array<uint32_t, SOURCE_COUNT> triggers;       // 各来源的触发次数
+                Source                             last_trigger;   // 最近一次进入"有人"的来源
+                uint32_t                           present_ms;     // 累计"有人"的时间
+                uint32_t                           last_change_ms; // 最近一次状态变化的时间
+
+                Stats()
+                    : activations(0), triggers{}, last_trigger(Source::MOTION), present_ms(0),
+                      last_change_ms(0)
+                {
+                }
+            };
+
+            /**
+             * @brief 在场检测器
+             *
+             * 融合运动、接近、触摸、压力和语音等低成本信号判断附近是否有人。
+             * 任一来源有效即判为"有人"；所有来源都释放、且各自的保持时间都已过去后判为"无人"。
+             * 调用方据此提前打开耗时的子系统（编解码器、摄像头流、网络连接），无人后再关闭。
+             *
+             * report() 可以在各传感器任务中调用；保持时间到期需要周期调用 tick() 检查。
+             */
+            class PresenceDetector
+            {
+            public:
+                PresenceDetector() = default;
+
+                /**
+                 * @brief 设置检测参数
+                 */
+                void setConfig(const Config& config);
+
+                /**
+                 * @brief 报告一个来源的状态
+                 * @param source 来源
+                 * @param active 是否有效
+                 * @param now_ms 当前时间（毫秒）
+                 * @return true 在场状态发生变化, false 未变化
+                 */
+                bool report(Source source, bool active, uint32_t now_ms);
+
+                /**
+                 * @brief 检查保持时间是否到期
+                 * @param now_ms 当前时间（毫秒）
+                 * @return true 在场状态发生变化, false 未变化
+                 */
+                bool tick(uint32_t now_ms);
+
+                /**
+                 * @brief 是否有人
+                 */
+                bool isPresent() const;
+
+                /**
+                 * @brief 获取统计信息
+                 */
+                Stats getStats() const;
+
+            private:
+                // 重新计算在场状态，返回是否变化（调用方持有锁）
+                bool updateLocked(uint32_t now_ms);
+
+                mutable std::mutex                 mutex_;
+                Config                             config_;
+                Stats                              stats_;
+                std::array<bool, SOURCE_COUNT>     active_{};
+                std::array<uint32_t, SOURCE_COUNT> release_ms_{}; // 各来源最近一次释放的时间
+                std::array<bool, SOURCE_COUNT>     seen_{};       // 各来源是否触发过
+                bool                               present_ = false;
+            };
+
+        } // namespace presence
+    } // namespace logic
+} // namespace app
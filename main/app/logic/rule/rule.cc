@@ -0,0 +1,161 @@
+#include "rule.hpp"
+
+#include "esp_log.h"
+
+static const char* const TAG = "RuleEngine";
+
+namespace app
+{
+    namespace logic
+    {
+        namespace rule
+        {
+            std::string toCommandString(uint8_t outputs)
+            {
+                std::string command(5, '0');
+                for (int i = 0; i < 5; i++)
+                {
+                    if (outputs & (1 << (4 - i)))
+                    {
+                        command[i] = '1';
+                    }
+                }
+                return command;
+            }
+
+            bool fromCommandString(const std::string& command, uint8_t& outputs)
+            {
+                if (command.length() != 5)
+                {
+                    return false;
+                }
+
+                uint8_t result = 0;
+                for (int i = 0; i < 5; i++)
+                {
+                    if (command[i] == '1')
+                    {
+                        result |= static_cast<uint8_t>(1 << (4 - i));
+                    }
+                    else if (command[i] != '0')
+                    {
+                        return false;
+                    }
+                }
+                outputs = result;
+                return true;
+            }
+
+            void RuleEngine::setConfig(const logic_config_t& config)
+            {
+                uint8_t outputs = 0;
+                uint8_t inputs  = 0;
+                bool    changed = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    config_ = config;
+                    lut_    = compile(config_, server_outputs_);
+                    changed = updateLocked();
+                    outputs = outputs_;
+                    inputs  = inputs_;
+                }
+                if (changed)
+                {
+                    notify(outputs, inputs);
+                }
+            }
+
+            void RuleEngine::setServerOutputs(uint8_t server_outputs)
+            {
+                uint8_t outputs = 0;
+                uint8_t inputs  = 0;
+                bool    changed = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    server_outputs_ = server_outputs & LOGIC_OUTPUT_ALL;
+                    lut_            = compile(config_, server_outputs_);
+                    changed         = updateLocked();
+                    outputs         = outputs_;
+                    inputs          = inputs_;
+                }
+                ESP_LOGI(TAG, "服务器上传规则: %s", toCommandString(server_outputs).c_str());
+                if (changed)
+                {
+                    notify(outputs, inputs);
+                }
+            }
+
+            bool RuleEngine::setInput(uint8_t input, bool active)
+            {
+                uint8_t outputs = 0;
+                uint8_t inputs  = 0;
+                bool    changed = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    uint8_t new_inputs =
+                        active ? (inputs_ | input) : (inputs_ & static_cast<uint8_t>(~input));
+                    new_inputs &= LOGIC_INPUT_COUNT - 1;
+                    if (new_inputs == inputs_)
+                    {
+                        return false; // 输入未变化，无需查表
+                    }
+                    inputs_ = new_inputs;
+                    changed = updateLocked();
+                    outputs = outputs_;
+                    inputs  = inputs_;
+                }
+                if (changed)
+                {
+                    notify(outputs, inputs);
+                }
+                return changed;
+            }
+
+            uint8_t RuleEngine::getInputs() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return inputs_;
+            }
+
+            uint8_t RuleEngine::getOutputs() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return outputs_;
+            }
+
+            void RuleEngine::setChangeCallback(ChangeCallback callback)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                change_callback_ = std::move(callback);
+            }
+
+            bool RuleEngine::updateLocked()
+            {
+                uint8_t outputs = lut_[inputs_];
+                if (outputs == outputs_)
+                {
+                    return false;
+                }
+                outputs_ = outputs;
+                return true;
+            }
+
+            void RuleEngine::notify(uint8_t outputs, uint8_t inputs)
+            {
+                ESP_LOGI(TAG, "上传控制变化: 输入 0x%02X -> 输出 %s", inputs,
+                         toCommandString(outputs).c_str());
+
+                ChangeCallback callback;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    callback = change_callback_;
+                }
+                if (callback)
+                {
+                    callback(outputs, inputs);
+                }
+            }
+
+        } // namespace rule
+    } // namespace logic
+} // namespace app
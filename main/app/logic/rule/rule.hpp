@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "logic/logic.h"
+
+namespace app
+{
+    namespace logic
+    {
+        namespace rule
+        {
+            // 查找表：下标为输入位组合（LOGIC_INPUT_*），值为输出位（LOGIC_OUTPUT_*）
+            using Lut = std::array<uint8_t, LOGIC_INPUT_COUNT>;
+
+            /**
+             * @brief 将配置规则和服务器下发的输出位编译为查找表
+             * @param config 本地配置规则
+             * @param server_outputs 服务器要求始终上传的输出位
+             * @return 查找表
+             */
+            constexpr Lut compile(const logic_config_t& config, uint8_t server_outputs = 0)
+            {
+                Lut lut{};
+                for (uint8_t inputs = 0; inputs < LOGIC_INPUT_COUNT; inputs++)
+                {
+                    lut[inputs] =
+                        calculateControl(inputs, config) | (server_outputs & LOGIC_OUTPUT_ALL);
+                }
+                return lut;
+            }
+
+            // 默认配置编译出的查找表（编译期生成）
+            constexpr Lut DEFAULT_LUT = compile(initLogicConfig());
+
+            /**
+             * @brief 输出位转换为 5 位 command 字符串（触摸-压力-陀螺仪-光敏-摄像头）
+             */
+            std::string toCommandString(uint8_t outputs);
+
+            /**
+             * @brief 解析 5 位 command 字符串为输出位
+             * @param command command 字符串
+             * @param outputs 输出位
+             * @return true 成功, false 格式错误
+             */
+            bool fromCommandString(const std::string& command, uint8_t& outputs);
+
+            /**
+             * @brief 事件驱动的上传控制规则引擎
+             *
+             * 各传感器在状态变化时调用 setInput 更新对应输入位，引擎只在输入变化时查表，
+             * 输出位变化时回调通知。规则（本地配置 + 服务器下发）变化时重新编译查找表。
+             */
+            class RuleEngine
+            {
+            public:
+                /**
+                 * @brief 输出变化回调函数类型
+                 * @param outputs 新的输出位
+                 * @param inputs 当前输入位
+                 */
+                using ChangeCallback = std::function<void(uint8_t outputs, uint8_t inputs)>;
+
+                RuleEngine() : lut_(DEFAULT_LUT) {}
+
+                /**
+                 * @brief 设置本地配置规则并重新编译查找表
+                 */
+                void setConfig(const logic_config_t& config);
+
+                /**
+                 * @brief 设置服务器下发的输出位（这些数据始终上传）并重新编译查找表
+                 */
+                void setServerOutputs(uint8_t server_outputs);
+
+                /**
+                 * @brief 更新一个输入位
+                 * @param input 输入位（LOGIC_INPUT_*）
+                 * @param active 是否有效
+                 * @return true 输出位发生变化, false 未变化
+                 */
+                bool setInput(uint8_t input, bool active);
+
+                /**
+                 * @brief 获取当前输入位
+                 */
+                uint8_t getInputs() const;
+
+                /**
+                 * @brief 获取当前输出位
+                 */
+                uint8_t getOutputs() const;
+
+                /**
+                 * @brief 设置输出变化回调（在调用 setInput 的任务中执行）
+                 */
+                void setChangeCallback(ChangeCallback callback);
+
+            private:
+                // 查表更新输出，返回输出是否变化（调用方持有锁）
+                bool updateLocked();
+
+                // 输出变化后记录日志并回调（不持有锁）
+                void notify(uint8_t outputs, uint8_t inputs);
+
+                mutable std::mutex mutex_;
+                Lut                lut_;
+                logic_config_t     config_         = initLogicConfig();
+                uint8_t            server_outputs_ = 0;
+                uint8_t            inputs_         = 0;
+                uint8_t            outputs_        = 0;
+                ChangeCallback     change_callback_;
+            };
+
+        } // namespace rule
+    } // namespace logic
+} // namespace app
@@ -5,9 +5,13 @@
 #include <driver/i2s_std.h>
 #include <driver/gpio.h>
 #include <algorithm>
+#include <esp_timer.h>
+#include "media/audio/level/level.hpp"
+#include "media/clock/clock.hpp"
 
 #define AUDIO_CODEC_DMA_DESC_NUM 6
 #define AUDIO_CODEC_DMA_FRAME_NUM 240
+#define AUDIO_WRITE_BLOCKED_US 2000 // 写入耗时超过此值说明等待过 DMA 空位
 
 static const char* const TAG = "Audio";
 
@@ -198,6 +202,7 @@ namespace app
                     return false;
                 }
 
+                level::LevelMeter::output().setSampleRate(config_.output_sample_rate);
                 initialized_ = true;
                 return true;
             }
@@ -307,12 +312,18 @@ namespace app
             }
 
             int Audio::write(const int16_t* data, int samples)
+            {
+                return write(data, samples, samples);
+            }
+
+            int Audio::write(const int16_t* data, int samples, int media_samples)
             {
                 if (!initialized_ || !output_enabled_ || output_dev_ == nullptr)
                 {
                     return 0;
                 }
 
+                int64_t   start_us = esp_timer_get_time();
                 esp_err_t ret =
                     esp_codec_dev_write(output_dev_, (void*)data, samples * sizeof(int16_t));
                 if (ret != ESP_OK)
@@ -320,9 +331,23 @@ namespace app
                     ESP_LOGE(TAG, "写入音频数据失败: %s", esp_err_to_name(ret));
                     return 0;
                 }
+
+                // 设备播放的电平（供 LED 等按帧率读取）
+                level::LevelMeter::output().process(data, samples);
+
+                // 写入返回时这些采样已进入 DMA，由媒体时钟推算正在播放的位置
+                int64_t now_us = esp_timer_get_time();
+                media::clock::MediaClock::getInstance().onWrite(
+                    samples, std::max(media_samples, 0), now_us,
+                    now_us - start_us > AUDIO_WRITE_BLOCKED_US);
                 return samples;
             }
 
+            int Audio::getOutputLatencySamples() const
+            {
+                return AUDIO_CODEC_DMA_DESC_NUM * AUDIO_CODEC_DMA_FRAME_NUM;
+            }
+
             bool Audio::setOutputVolume(int volume)
             {
                 volume         = std::max(0, std::min(100, volume));
@@ -54,6 +54,14 @@ namespace app
                 // [mic1,ref1,mic2,ref2,mic3,ref3,mic4,ref4,...] (dest 长度 >= samples*8)
                 int read(int16_t* dest, int samples);
                 int write(const int16_t* data, int samples);
+                /**
+                 * @brief 写入音频数据，并向媒体时钟报告这些采样代表的媒体时长
+                 * @param data PCM 数据
+                 * @param samples 采样数
+                 * @param media_samples 代表的媒体采样数（补偿帧为 0，变速播放时与 samples 不同）
+                 * @return 写入的采样数，失败返回 0
+                 */
+                int write(const int16_t* data, int samples, int media_samples);
                 /**
                  * @brief 设置输出音量
                  * @param volume 音量值，范围：0-100
@@ -95,6 +103,11 @@ namespace app
                     return initialized_ ? config_.output_sample_rate : 0;
                 }
 
+                /**
+                 * @brief 获取输出延迟：写入返回时仍在 DMA 中排队的采样数
+                 */
+                int getOutputLatencySamples() const;
+
                 /**
                  * @brief 检查是否使用参考信号模式
                  * @return true 如果使用参考信号（8通道），false 如果普通模式（4通道）
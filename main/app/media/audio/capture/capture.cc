@@ -5,6 +5,7 @@
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "freertos/task.h"
+#include "tool/trace/trace.hpp"
 
 static const char* const TAG = "AudioCapture";
 
@@ -257,6 +258,7 @@ namespace app
 
                             // 分发数据给所有注册的回调
                             {
+                                TRACE_SCOPE("capture.dispatch");
                                 std::lock_guard<std::mutex> lock(callbacks_mutex_);
 
                                 for (const auto& cb_info : callbacks_)
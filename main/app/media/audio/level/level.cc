@@ -0,0 +1,87 @@
+#include "level.hpp"
+
+#include <algorithm>
+
+namespace app
+{
+    namespace media
+    {
+        namespace audio
+        {
+            namespace level
+            {
+                // log2(x) 的 Q8 近似：整数部分取最高位，小数部分取其后 8 位（误差约 0.5dB）
+                static int32_t log2Q8(uint32_t x)
+                {
+                    int32_t  n        = 31 - __builtin_clz(x);
+                    uint32_t mantissa = n >= 8 ? x >> (n - 8) : x << (8 - n);
+                    return n * 256 + static_cast<int32_t>(mantissa & 0xFF);
+                }
+
+                uint8_t LevelMeter::powerToLevel(uint32_t mean_square)
+                {
+                    if (mean_square == 0)
+                    {
+                        return 0;
+                    }
+
+                    // 满量程的均方值为 2^30：dB = 10 * log10(2) * (log2(ms) - 30)，
+                    // 10 * log10(2) 约为 771 / 256
+                    int32_t db_q8 = (log2Q8(mean_square) - 30 * 256) * 771 / 256;
+                    int32_t level = (db_q8 - FLOOR_DB * 256) * 255 / (-FLOOR_DB * 256);
+                    return static_cast<uint8_t>(std::max(0, std::min(255, level)));
+                }
+
+                void LevelMeter::process(const int16_t* data, size_t samples)
+                {
+                    if (data == nullptr || samples == 0)
+                    {
+                        return;
+                    }
+
+                    // 一次遍历求平方和与峰值，每个采样只有一次乘加和一次比较
+                    uint64_t sum  = 0;
+                    uint32_t peak = 0;
+                    for (size_t i = 0; i < samples; i++)
+                    {
+                        int32_t  sample    = data[i];
+                        uint32_t magnitude = static_cast<uint32_t>(sample < 0 ? -sample : sample);
+                        sum += static_cast<uint32_t>(sample * sample);
+                        peak = std::max(peak, magnitude);
+                    }
+
+                    int32_t level = powerToLevel(static_cast<uint32_t>(sum / samples)) * 256;
+
+                    // 上升时每帧跟随一半差值，下降时按 RELEASE_MS 线性回落
+                    if (level > envelope_)
+                    {
+                        envelope_ += (level - envelope_ + 1) / 2;
+                    }
+                    else
+                    {
+                        int64_t decay = (int64_t)samples * 255 * 256 * 1000 /
+                                        ((int64_t)sample_rate_ * RELEASE_MS);
+                        envelope_ = std::max<int32_t>(level, envelope_ - (int32_t)decay);
+                    }
+
+                    frames_++;
+                    uint32_t packed = static_cast<uint32_t>(envelope_ >> 8) |
+                                      static_cast<uint32_t>(powerToLevel(peak * peak)) << 8 |
+                                      static_cast<uint32_t>(frames_) << 16;
+                    packed_.store(packed, std::memory_order_relaxed);
+                }
+
+                Reading LevelMeter::read() const
+                {
+                    uint32_t packed = packed_.load(std::memory_order_relaxed);
+                    Reading  reading;
+                    reading.level  = static_cast<uint8_t>(packed);
+                    reading.peak   = static_cast<uint8_t>(packed >> 8);
+                    reading.frames = static_cast<uint16_t>(packed >> 16);
+                    return reading;
+                }
+
+            } // namespace level
+        } // namespace audio
+    } // namespace media
+} // namespace app
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace app
+{
+    namespace media
+    {
+        namespace audio
+        {
+            namespace level
+            {
+                constexpr int32_t  FLOOR_DB   = -60; // 电平 0 对应的 dBFS，电平 255 对应 0dBFS
+                constexpr uint32_t RELEASE_MS = 300; // 包络从 255 回落到 0 的时间
+
+                /**
+                 * @brief 一次读数
+                 */
+                struct Reading
+                {
+                    uint8_t  level;  // 平滑后的 RMS 包络（0-255，按 dB 线性）
+                    uint8_t  peak;   // 最近一帧的峰值（0-255，按 dB 线性）
+                    uint16_t frames; // 已处理的帧数（回绕），用于判断是否有新数据
+                };
+
+                /**
+                 * @brief 音频电平表
+                 *
+                 * 音频任务每处理完一帧 PCM 调用一次 process()：一次遍历求出均方值和峰值，
+                 * 用整数 log2 近似换算为 dB 刻度的 0-255 电平，上升时快速跟随、下降时在
+                 * RELEASE_MS 内线性回落（dB 刻度上线性即幅度上指数衰减）。结果打包成一个
+                 * 原子变量发布，LED 等消费者按自己的帧率随时读取，不需要锁，也不复制音频。
+                 *
+                 * input() 由 AFE 输出（用户说话）更新，output() 由写入编解码器的 PCM
+                 * （设备播放）更新。每个电平表只能有一个写入方。
+                 */
+                class LevelMeter
+                {
+                public:
+                    /**
+                     * @brief 用户说话的电平（AFE 输出）
+                     */
+                    static LevelMeter& input()
+                    {
+                        static LevelMeter instance;
+                        return instance;
+                    }
+
+                    /**
+                     * @brief 设备播放的电平（写入编解码器的 PCM）
+                     */
+                    static LevelMeter& output()
+                    {
+                        static LevelMeter instance;
+                        return instance;
+                    }
+
+                    // 禁止拷贝和赋值
+                    LevelMeter(const LevelMeter&)            = delete;
+                    LevelMeter& operator=(const LevelMeter&) = delete;
+
+                    /**
+                     * @brief 设置采样率（决定包络的回落速度）
+                     */
+                    void setSampleRate(uint32_t sample_rate)
+                    {
+                        sample_rate_ = sample_rate > 0 ? sample_rate : 16000;
+                    }
+
+                    /**
+                     * @brief 处理一帧单声道 PCM 并发布新的电平
+                     * @param data PCM 数据
+                     * @param samples 采样数
+                     */
+                    void process(const int16_t* data, size_t samples);
+
+                    /**
+                     * @brief 读取当前电平（无锁，可在任意任务中调用）
+                     */
+                    Reading read() const;
+
+                    /**
+                     * @brief 读取平滑后的电平（0-255）
+                     */
+                    uint8_t getLevel() const
+                    {
+                        return static_cast<uint8_t>(packed_.load(std::memory_order_relaxed));
+                    }
+
+                    /**
+                     * @brief 均方值换算为电平（0-255），0 表示静音或低于 FLOOR_DB
+                     */
+                    static uint8_t powerToLevel(uint32_t mean_square);
+
+                private:
+                    LevelMeter() = default;
+
+                    uint32_t              sample_rate_ = 16000;
+                    int32_t               envelope_    = 0; // Q8，只在写入方访问
+                    uint16_t              frames_      = 0;
+                    std::atomic<uint32_t> packed_{0}; // level | peak << 8 | frames << 16
+                };
+
+            } // namespace level
+        } // namespace audio
+    } // namespace media
+} // namespace app
@@ -4,6 +4,8 @@
 
 #include "esp_log.h"
 #include "esp_afe_sr_models.h"
+#include "media/audio/level/level.hpp"
+#include "tool/trace/trace.hpp"
 
 static const char* const TAG = "Afe";
 
@@ -181,6 +183,7 @@ namespace app
                         }
 
                         initialized_ = true;
+                        audio::level::LevelMeter::input().setSampleRate(config_.sample_rate);
 
                         ESP_LOGI(TAG,
                                  "AFE 初始化成功: input_format=%s, sample_rate=%d, "
@@ -243,6 +246,8 @@ namespace app
 
                     bool Afe::feed(const int16_t* data, size_t samples)
                     {
+                        TRACE_SCOPE("afe.feed");
+
                         if (!isValid())
                         {
                             return false;
@@ -297,6 +302,8 @@ namespace app
 
                     void Afe::processFetchResult(const afe_fetch_result_t* result)
                     {
+                        TRACE_SCOPE("afe.process");
+
                         if (result == nullptr)
                         {
                             return;
@@ -318,11 +325,18 @@ namespace app
                             is_speaking_ = (result->vad_state == VAD_SPEECH);
                         }
 
+                        if (result->data == nullptr || result->data_size == 0)
+                        {
+                            return;
+                        }
+
+                        // 用户说话的电平（供 LED 等按帧率读取）
+                        size_t samples = result->data_size / sizeof(int16_t);
+                        audio::level::LevelMeter::input().process(result->data, samples);
+
                         // 处理音频输出
-                        if (audio_output_callback_ && result->data != nullptr &&
-                            result->data_size > 0)
+                        if (audio_output_callback_)
                         {
-                            size_t samples = result->data_size / sizeof(int16_t);
                             audio_output_callback_(result->data, samples);
                         }
                     }
@@ -5,6 +5,7 @@
 #include "esp_log.h"
 #include "esp_opus_enc.h"
 #include "esp_heap_caps.h"
+#include "tool/trace/trace.hpp"
 
 static const char* const TAG = "OpusEncoder";
 
@@ -147,6 +148,8 @@ namespace app
                         bool OpusEncoder::encode(const uint8_t* input_data, size_t input_size,
                                                  const uint8_t** output_data, size_t* encoded_bytes)
                         {
+                            TRACE_SCOPE("opus.encode");
+
                             if (!isValid() || input_data == nullptr || output_data == nullptr ||
                                 encoded_bytes == nullptr)
                             {
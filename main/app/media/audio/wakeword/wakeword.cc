@@ -24,8 +24,6 @@ namespace app
         {
             namespace wakeword
             {
-                const char* WAKEWORD_EVENT_BASE = "WAKEWORD";
-
                 struct Command
                 {
                     std::string command;
@@ -221,9 +219,8 @@ namespace app
                     strncpy(event_data.action, cmd.action.c_str(), sizeof(event_data.action) - 1);
                     event_data.probability = probability;
 
-                    auto& event_mgr = app::sys::event::EventManager::getInstance();
-                    event_mgr.post(WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_DETECTED,
-                                   {&event_data, sizeof(event_data)});
+                    namespace bus = app::sys::event::bus;
+                    bus::EventBus::getInstance().publish<bus::Topic::WAKEWORD_DETECTED>(event_data);
                 }
 
                 bool CustomWakeWord::init(srmodel_list_t* models_list, int sample_rate,
@@ -477,8 +474,8 @@ namespace app
 
                     running_ = true;
 
-                    auto& event_mgr = app::sys::event::EventManager::getInstance();
-                    event_mgr.post(WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_STARTED, {});
+                    namespace bus = app::sys::event::bus;
+                    bus::EventBus::getInstance().publish<bus::Topic::WAKEWORD_STARTED>();
                 }
 
                 void CustomWakeWord::stop()
@@ -490,8 +487,8 @@ namespace app
 
                     running_ = false;
 
-                    auto& event_mgr = app::sys::event::EventManager::getInstance();
-                    event_mgr.post(WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_STOPPED, {});
+                    namespace bus = app::sys::event::bus;
+                    bus::EventBus::getInstance().publish<bus::Topic::WAKEWORD_STOPPED>();
                 }
 
                 void CustomWakeWord::feed(const std::vector<int16_t>& data)
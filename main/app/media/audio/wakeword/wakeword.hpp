@@ -8,7 +8,7 @@
 
 #include <model_path.h>
 
-#include "system/event/event.hpp"
+#include "system/event/bus/bus.hpp"
 
 namespace app
 {
@@ -18,16 +18,7 @@ namespace app
         {
             namespace wakeword
             {
-                // 事件定义
-                extern const char* WAKEWORD_EVENT_BASE;
-
-                enum WakeWordEventId : int32_t
-                {
-                    WAKEWORD_EVENT_DETECTED = 0,
-                    WAKEWORD_EVENT_STARTED,
-                    WAKEWORD_EVENT_STOPPED,
-                };
-
+                // 事件总线 Topic::WAKEWORD_DETECTED 的负载
                 struct WakeWordEventData
                 {
                     char  text[64];
@@ -91,12 +91,7 @@ namespace app
                 }
 
                 // 停止视频流
-                if (streaming_on_ && video_fd_ >= 0)
-                {
-                    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                    ioctl(video_fd_, VIDIOC_STREAMOFF, &type);
-                    streaming_on_ = false;
-                }
+                stopStreaming();
 
                 // 释放 mmap 缓冲区
                 for (auto& buf : mmap_buffers_)
@@ -295,8 +290,31 @@ namespace app
 
                     mmap_buffers_[i].start  = start;
                     mmap_buffers_[i].length = buf.length;
+                }
+
+                // 启动视频流
+                return startStreaming();
+            }
+
+            bool Camera::startStreaming()
+            {
+                if (video_fd_ < 0)
+                {
+                    return false;
+                }
+                if (streaming_on_)
+                {
+                    return true;
+                }
+
+                // STREAMOFF 会让驱动收回所有缓冲区，每次启动前都要重新入队
+                for (uint32_t i = 0; i < mmap_buffers_.size(); i++)
+                {
+                    struct v4l2_buffer buf = {};
+                    buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    buf.memory             = V4L2_MEMORY_MMAP;
+                    buf.index              = i;
 
-                    // 将缓冲区入队
                     if (ioctl(video_fd_, VIDIOC_QBUF, &buf) != 0)
                     {
                         ESP_LOGE(TAG, "VIDIOC_QBUF 失败: %d", errno);
@@ -304,7 +322,6 @@ namespace app
                     }
                 }
 
-                // 启动视频流
                 int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
                 if (ioctl(video_fd_, VIDIOC_STREAMON, &type) != 0)
                 {
@@ -314,10 +331,27 @@ namespace app
 
                 streaming_on_ = true;
                 ESP_LOGI(TAG, "视频流已启动");
-
                 return true;
             }
 
+            void Camera::stopStreaming()
+            {
+                if (!streaming_on_ || video_fd_ < 0)
+                {
+                    return;
+                }
+
+                int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (ioctl(video_fd_, VIDIOC_STREAMOFF, &type) != 0)
+                {
+                    ESP_LOGE(TAG, "VIDIOC_STREAMOFF 失败: %d", errno);
+                    return;
+                }
+
+                streaming_on_ = false;
+                ESP_LOGI(TAG, "视频流已停止");
+            }
+
             uint32_t Camera::selectBestFormat()
             {
                 // 枚举支持的格式，按优先级选择
@@ -372,12 +406,22 @@ namespace app
 
             bool Camera::capture(FrameBuffer& frame_out, int skip_frames)
             {
-                if (!initialized_ || !streaming_on_)
+                if (!initialized_)
                 {
-                    ESP_LOGE(TAG, "摄像头未初始化或流未启动");
+                    ESP_LOGE(TAG, "摄像头未初始化");
                     return false;
                 }
 
+                // 流已停止（未预热）时按需启动，首帧会多等一段时间
+                if (!streaming_on_)
+                {
+                    ESP_LOGW(TAG, "视频流未启动，按需启动");
+                    if (!startStreaming())
+                    {
+                        return false;
+                    }
+                }
+
                 // 跳过旧帧，获取最新帧
                 for (int i = 0; i <= skip_frames; i++)
                 {
@@ -123,6 +123,25 @@ namespace app
                  */
                 bool capture(FrameBuffer& frame_out, int skip_frames = 2);
 
+                /**
+                 * @brief 启动视频流（初始化时自动启动；停止后 capture 也会按需启动）
+                 * @return true=成功, false=失败
+                 */
+                bool startStreaming();
+
+                /**
+                 * @brief 停止视频流（保留设备和缓冲区，降低空闲功耗）
+                 */
+                void stopStreaming();
+
+                /**
+                 * @brief 视频流是否已启动
+                 */
+                bool isStreaming() const
+                {
+                    return streaming_on_;
+                }
+
                 /**
                  * @brief 获取当前分辨率
                  */
@@ -0,0 +1,258 @@
+#include "clock.hpp"
+#include "esp_log.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+static const char* const TAG = "MediaClock";
+
+static int32_t clampPpm(int64_t ppm)
+{
+    return static_cast<int32_t>(std::max<int64_t>(
+        -app::media::clock::MAX_SLEW_PPM, std::min<int64_t>(ppm, app::media::clock::MAX_SLEW_PPM)));
+}
+
+namespace app
+{
+    namespace media
+    {
+        namespace clock
+        {
+            void MediaClock::start(uint32_t sample_rate, uint32_t latency_samples)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                started_          = true;
+                locked_           = false;
+                sample_rate_      = sample_rate > 0 ? sample_rate : 16000;
+                latency_samples_  = latency_samples;
+                mark_count_       = 0;
+                mark_next_        = 0;
+                output_written_   = 0;
+                media_written_    = 0;
+                queue_end_us_     = 0;
+                base_local_us_    = 0;
+                base_media_us_    = 0;
+                freq_ppm_         = 0;
+                rate_ppm_         = 0;
+                last_returned_us_ = INT64_MIN;
+                stats_            = Stats();
+                ESP_LOGI(TAG, "媒体时钟开始: %lu Hz, 输出延迟 %lu 采样",
+                         (unsigned long)sample_rate_, (unsigned long)latency_samples_);
+            }
+
+            void MediaClock::stop()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!started_)
+                {
+                    return;
+                }
+                started_ = false;
+                locked_  = false;
+                ESP_LOGI(TAG, "媒体时钟结束: %llu ms, 写入 %lu 次, 重新对齐 %lu 次",
+                         (unsigned long long)stats_.media_ms, (unsigned long)stats_.writes,
+                         (unsigned long)stats_.resyncs);
+            }
+
+            bool MediaClock::isStarted() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return started_;
+            }
+
+            bool MediaClock::isPlaying(int64_t now_us) const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return started_ && locked_ && now_us <= queue_end_us_ + DRAIN_TIMEOUT_US;
+            }
+
+            void MediaClock::onWrite(uint32_t output_samples, uint32_t media_samples,
+                                     int64_t now_us, bool queue_full)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!started_)
+                {
+                    return;
+                }
+
+                // 外推值不超过本次写入之前的音频（欠载期间媒体时间停住）
+                int64_t predicted = std::min(extrapolate(now_us), samplesToUs(media_written_));
+
+                output_written_ += output_samples;
+                media_written_ += media_samples;
+                stats_.writes++;
+                stats_.media_ms = static_cast<uint64_t>(samplesToUs(media_written_) / 1000);
+
+                if (output_samples == 0)
+                {
+                    // 丢弃的帧：媒体位置前进但没有输出，并入上一条记录
+                    if (mark_count_ > 0)
+                    {
+                        marks_[(mark_next_ + MARK_COUNT - 1) % MARK_COUNT].media_end =
+                            media_written_;
+                    }
+                    return;
+                }
+
+                marks_[mark_next_] = {output_written_, media_written_};
+                mark_next_         = (mark_next_ + 1) % MARK_COUNT;
+                mark_count_        = std::min(mark_count_ + 1, MARK_COUNT);
+
+                // 写入阻塞过说明 DMA 已满；否则按写入量估算，DMA 已经放空（流开始或欠载）时
+                // 新写入的第一个采样立即开始播放
+                if (queue_full)
+                {
+                    queue_end_us_ = now_us + samplesToUs(latency_samples_);
+                }
+                else
+                {
+                    queue_end_us_ = std::max(queue_end_us_, now_us) + samplesToUs(output_samples);
+                }
+
+                // 写入返回时仍在排队的采样：最多 latency 个
+                int64_t queued =
+                    std::min(usToSamples(queue_end_us_ - now_us), (int64_t)latency_samples_);
+                int64_t presented = output_written_ - queued;
+                int64_t measured  = samplesToUs(mediaAt(presented));
+
+                // 接下来播放的采样代表的媒体时长与输出时长之差（变速播放、补偿帧），直接计入速率
+                int32_t stretch_ppm = stretchPpm(presented, queued);
+
+                if (!locked_)
+                {
+                    base_local_us_    = now_us;
+                    base_media_us_    = measured;
+                    freq_ppm_         = 0;
+                    rate_ppm_         = stretch_ppm;
+                    last_returned_us_ = INT64_MIN;
+                    locked_           = true;
+                    return;
+                }
+
+                int64_t error = measured - predicted;
+                if (std::llabs(error) > RESYNC_US)
+                {
+                    ESP_LOGW(TAG, "媒体时间偏差 %lld us，重新对齐", (long long)error);
+                    base_local_us_    = now_us;
+                    base_media_us_    = measured;
+                    freq_ppm_         = 0;
+                    rate_ppm_         = stretch_ppm;
+                    last_returned_us_ = INT64_MIN;
+                    stats_.resyncs++;
+                    return;
+                }
+
+                // PI 控制：比例项在 SLEW_WINDOW_US 内消除当前偏差，积分项跟踪 DAC 时钟的长期偏差
+                base_local_us_ = now_us;
+                base_media_us_ = predicted;
+                freq_ppm_      = clampPpm(freq_ppm_ + error * 1000000 / (SLEW_WINDOW_US * 8));
+                rate_ppm_      = std::max<int32_t>(
+                    -1000000, stretch_ppm + clampPpm(freq_ppm_ + error * 1000000 / SLEW_WINDOW_US));
+                stats_.error_max_us =
+                    std::max(stats_.error_max_us, static_cast<uint32_t>(std::llabs(error)));
+                stats_.rate_ppm = rate_ppm_;
+            }
+
+            bool MediaClock::getTime(int64_t now_us, uint32_t& media_ms)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!started_ || !locked_)
+                {
+                    return false;
+                }
+
+                // 已写入的音频播完后不再有新的写入，视为流结束
+                if (now_us > queue_end_us_ + DRAIN_TIMEOUT_US)
+                {
+                    return false;
+                }
+
+                int64_t media_us  = std::min(extrapolate(now_us), samplesToUs(media_written_));
+                media_us          = std::max(media_us, last_returned_us_);
+                last_returned_us_ = media_us;
+                if (media_us < 0)
+                {
+                    return false;
+                }
+
+                media_ms = static_cast<uint32_t>(media_us / 1000);
+                return true;
+            }
+
+            Stats MediaClock::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return stats_;
+            }
+
+            void MediaClock::logStats() const
+            {
+                Stats stats = getStats();
+                ESP_LOGI(TAG, "媒体时钟: 已写入 %llu ms, 写入 %lu 次, 重新对齐 %lu 次",
+                         (unsigned long long)stats.media_ms, (unsigned long)stats.writes,
+                         (unsigned long)stats.resyncs);
+                ESP_LOGI(TAG, "  最大偏差: %lu us, 速率校正: %ld ppm",
+                         (unsigned long)stats.error_max_us, (long)stats.rate_ppm);
+            }
+
+            int64_t MediaClock::mediaAt(int64_t output_pos) const
+            {
+                if (mark_count_ == 0)
+                {
+                    return output_pos;
+                }
+
+                size_t      first  = (mark_next_ + MARK_COUNT - mark_count_) % MARK_COUNT;
+                const Mark& oldest = marks_[first];
+                if (output_pos <= oldest.output_end)
+                {
+                    // 早于记录范围（或流开始之前）：按 1:1 倒推
+                    return oldest.media_end - (oldest.output_end - output_pos);
+                }
+
+                const Mark* prev = &oldest;
+                for (size_t i = 1; i < mark_count_; i++)
+                {
+                    const Mark& mark = marks_[(first + i) % MARK_COUNT];
+                    if (output_pos <= mark.output_end)
+                    {
+                        int64_t output_span = mark.output_end - prev->output_end;
+                        int64_t media_span  = mark.media_end - prev->media_end;
+                        return prev->media_end +
+                               (output_pos - prev->output_end) * media_span / output_span;
+                    }
+                    prev = &mark;
+                }
+
+                return prev->media_end + (output_pos - prev->output_end);
+            }
+
+            int32_t MediaClock::stretchPpm(int64_t output_pos, int64_t span) const
+            {
+                span = std::min(span, (int64_t)sample_rate_ / 10);
+                if (span <= 0)
+                {
+                    return 0;
+                }
+                int64_t media_span = mediaAt(output_pos + span) - mediaAt(output_pos);
+                return static_cast<int32_t>((media_span - span) * 1000000 / span);
+            }
+
+            int64_t MediaClock::extrapolate(int64_t now_us) const
+            {
+                return base_media_us_ +
+                       (now_us - base_local_us_) * (1000000 + rate_ppm_) / 1000000;
+            }
+
+            int64_t MediaClock::samplesToUs(int64_t samples) const
+            {
+                return samples * 1000000 / sample_rate_;
+            }
+
+            int64_t MediaClock::usToSamples(int64_t us) const
+            {
+                return us * sample_rate_ / 1000000;
+            }
+        } // namespace clock
+    } // namespace media
+} // namespace app
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace app
+{
+    namespace media
+    {
+        namespace clock
+        {
+            constexpr size_t  MARK_COUNT       = 16;      // 保留的最近写入记录数
+            constexpr int64_t RESYNC_US        = 50000;   // 偏差超过此值时直接对齐，不再平滑
+            constexpr int64_t SLEW_WINDOW_US   = 1000000; // 偏差在这段时间内被平滑消除
+            constexpr int32_t MAX_SLEW_PPM     = 50000;   // 速率校正上限（5%）
+            constexpr int64_t DRAIN_TIMEOUT_US = 200000;  // 音频播完后超过此时间视为流结束
+
+            /**
+             * @brief 媒体时钟统计
+             */
+            struct Stats
+            {
+                uint32_t writes;       // 写入次数
+                uint32_t resyncs;      // 偏差过大直接对齐的次数
+                uint32_t error_max_us; // 平滑范围内的最大偏差（微秒）
+                int32_t  rate_ppm;     // 当前速率校正（百万分之一）
+                uint64_t media_ms;     // 已写入的媒体时长（毫秒）
+
+                Stats() : writes(0), resyncs(0), error_max_us(0), rate_ppm(0), media_ms(0) {}
+            };
+
+            /**
+             * @brief 媒体时钟（单例模式）
+             *
+             * 播放管线每次把 PCM 交给编解码器后调用 onWrite()，报告写入的输出采样数和它们代表的
+             * 媒体采样数（正常解码时相等；抖动缓冲插入补偿帧或变速播放时不相等）。写入阻塞过时
+             * DMA 中还排着 latency 个采样，否则按写入量估算，据此算出正在发声的采样对应的媒体
+             * 位置。接下来要播放的采样的媒体/输出比例直接计入外推速率。
+             *
+             * getTime() 在两次写入之间用本地时钟外推，测量值与外推值的偏差通过调整速率
+             * 在 SLEW_WINDOW_US 内平滑消除（PI 控制，输出连续且单调），偏差超过 RESYNC_US
+             * （首次写入、长时间欠载）时直接对齐。外推不会超过已写入的音频；已写入的音频播完
+             * DRAIN_TIMEOUT_US 后视为流结束，getTime() 返回 false。
+             *
+             * 运动引擎据此把服务器下发的动作对齐到音频的播放时间（见 MotionEngine::submitSynced）。
+             */
+            class MediaClock
+            {
+            public:
+                /**
+                 * @brief 获取单例实例
+                 * @return MediaClock 实例的引用
+                 */
+                static MediaClock& getInstance()
+                {
+                    static MediaClock instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                MediaClock(const MediaClock&)            = delete;
+                MediaClock& operator=(const MediaClock&) = delete;
+
+                /**
+                 * @brief 开始一个新的音频流，媒体时间 0 为流的第一个采样
+                 * @param sample_rate 输出采样率
+                 * @param latency_samples 写入返回时仍在 DMA 中排队的采样数
+                 */
+                void start(uint32_t sample_rate, uint32_t latency_samples);
+
+                /**
+                 * @brief 结束当前音频流
+                 */
+                void stop();
+
+                /**
+                 * @brief 是否有音频流（start() 之后、stop() 之前）
+                 */
+                bool isStarted() const;
+
+                /**
+                 * @brief 是否正在播放：已写入的音频尚未播完（含流结束判定的余量）
+                 * @param now_us 当前时间（esp_timer_get_time()）
+                 */
+                bool isPlaying(int64_t now_us) const;
+
+                /**
+                 * @brief 记录一次写入（未开始音频流时忽略）
+                 * @param output_samples 写入编解码器的采样数
+                 * @param media_samples 这些采样代表的媒体采样数
+                 * @param now_us 写入返回的时间（esp_timer_get_time()）
+                 * @param queue_full 写入是否因 DMA 已满而阻塞过（返回时 DMA 是满的）
+                 */
+                void onWrite(uint32_t output_samples, uint32_t media_samples, int64_t now_us,
+                             bool queue_full);
+
+                /**
+                 * @brief 获取当前正在播放的媒体时间
+                 * @param now_us 当前时间（esp_timer_get_time()）
+                 * @param media_ms 输出：媒体时间（毫秒）
+                 * @return true 成功, false 没有音频流、第一个采样尚未播放或流已播完
+                 */
+                bool getTime(int64_t now_us, uint32_t& media_ms);
+
+                /**
+                 * @brief 获取统计信息
+                 */
+                Stats getStats() const;
+
+                /**
+                 * @brief 打印统计信息
+                 */
+                void logStats() const;
+
+            private:
+                MediaClock() = default;
+
+                // 一次写入结束时的输出位置和媒体位置（采样）
+                struct Mark
+                {
+                    int64_t output_end;
+                    int64_t media_end;
+                };
+
+                // 输出位置对应的媒体位置（采样），按最近的写入记录插值
+                int64_t mediaAt(int64_t output_pos) const;
+
+                // 从输出位置开始的 span 个采样（最多 100ms）中媒体时长相对输出时长的偏差（ppm）
+                int32_t stretchPpm(int64_t output_pos, int64_t span) const;
+
+                // 按当前基准和速率外推的媒体时间（微秒）
+                int64_t extrapolate(int64_t now_us) const;
+
+                // 采样数与微秒互换
+                int64_t samplesToUs(int64_t samples) const;
+                int64_t usToSamples(int64_t us) const;
+
+                mutable std::mutex mutex_;
+                bool               started_         = false;
+                bool               locked_          = false; // 是否已根据写入建立基准
+                uint32_t           sample_rate_     = 16000;
+                uint32_t           latency_samples_ = 0;
+
+                Mark    marks_[MARK_COUNT]{};
+                size_t  mark_count_     = 0;
+                size_t  mark_next_      = 0;
+                int64_t output_written_ = 0;
+                int64_t media_written_  = 0;
+                int64_t queue_end_us_   = 0; // 已写入的采样全部播完的时间
+
+                int64_t base_local_us_    = 0; // 外推基准：本地时间
+                int64_t base_media_us_    = 0; // 外推基准：媒体时间（第一个采样播放前为负）
+                int32_t freq_ppm_         = 0; // 积分项：长期速率偏差
+                int32_t rate_ppm_         = 0; // 当前速率校正（含比例项）
+                int64_t last_returned_us_ = 0; // 最近一次返回的媒体时间，保证单调
+
+                Stats stats_;
+            };
+
+        } // namespace clock
+    } // namespace media
+} // namespace app
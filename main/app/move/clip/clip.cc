@@ -0,0 +1,198 @@
+#include "clip.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <esp_log.h>
+
+static const char* const TAG = "MotionClip";
+
+namespace app
+{
+    namespace move
+    {
+        namespace clip
+        {
+            namespace
+            {
+                // 映射内存中的数据不保证对齐，逐字节按小端读取
+                uint16_t readU16(const uint8_t* p)
+                {
+                    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+                }
+
+                uint32_t readU32(const uint8_t* p)
+                {
+                    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                           (static_cast<uint32_t>(p[2]) << 16) |
+                           (static_cast<uint32_t>(p[3]) << 24);
+                }
+
+                // 关键帧中各字段的偏移
+                constexpr size_t KEYFRAME_START    = 0;
+                constexpr size_t KEYFRAME_DURATION = 4;
+                constexpr size_t KEYFRAME_CHANNEL  = 8;
+                constexpr size_t KEYFRAME_VALUE    = 9;
+                constexpr size_t KEYFRAME_EASING   = 10;
+            } // namespace
+
+            bool ClipLibrary::load(const void* data, size_t size)
+            {
+                clear();
+
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                if (bytes == nullptr || size < HEADER_SIZE)
+                {
+                    ESP_LOGE(TAG, "片段库数据为空或过短");
+                    return false;
+                }
+                if (readU32(bytes) != MAGIC)
+                {
+                    ESP_LOGE(TAG, "片段库魔数无效");
+                    return false;
+                }
+                if (readU16(bytes + 4) != VERSION)
+                {
+                    ESP_LOGE(TAG, "不支持的片段库版本: %u", readU16(bytes + 4));
+                    return false;
+                }
+
+                size_t count = readU16(bytes + 6);
+                if (size < HEADER_SIZE + count * ENTRY_SIZE)
+                {
+                    ESP_LOGE(TAG, "片段表越界 (%u 个片段)", (unsigned)count);
+                    return false;
+                }
+
+                // 加载时校验全部片段，播放时不再检查
+                data_  = bytes;
+                count_ = count;
+                for (size_t i = 0; i < count; i++)
+                {
+                    const uint8_t* entry  = bytes + HEADER_SIZE + i * ENTRY_SIZE;
+                    uint16_t       id     = readU16(entry);
+                    size_t         frames = readU16(entry + 2);
+                    size_t         offset = readU32(entry + 4);
+
+                    if (i > 0 && id <= readU16(entry - ENTRY_SIZE))
+                    {
+                        ESP_LOGE(TAG, "片段表未按 id 升序排列 (id=%u)", id);
+                        clear();
+                        return false;
+                    }
+                    if (entry[12 + NAME_LENGTH - 1] != '\0')
+                    {
+                        ESP_LOGE(TAG, "片段名称未结束 (id=%u)", id);
+                        clear();
+                        return false;
+                    }
+                    if (offset > size || frames > (size - offset) / KEYFRAME_SIZE)
+                    {
+                        ESP_LOGE(TAG, "片段关键帧越界 (id=%u)", id);
+                        clear();
+                        return false;
+                    }
+
+                    for (size_t k = 0; k < frames; k++)
+                    {
+                        const uint8_t* keyframe = bytes + offset + k * KEYFRAME_SIZE;
+                        uint8_t        channel  = keyframe[KEYFRAME_CHANNEL];
+                        if ((channel >= PCA9685::CHANNEL_COUNT && channel != MOTOR_CHANNEL) ||
+                            keyframe[KEYFRAME_VALUE] > PCA9685::MAX_ANGLE ||
+                            keyframe[KEYFRAME_EASING] >= timeline::EASING_COUNT)
+                        {
+                            ESP_LOGE(TAG, "片段关键帧无效 (id=%u, 第 %u 帧)", id, (unsigned)k);
+                            clear();
+                            return false;
+                        }
+                    }
+                }
+
+                ESP_LOGI(TAG, "动作片段库已加载: %u 个片段, %u 字节", (unsigned)count,
+                         (unsigned)size);
+                return true;
+            }
+
+            void ClipLibrary::clear()
+            {
+                data_  = nullptr;
+                count_ = 0;
+            }
+
+            bool ClipLibrary::getClip(size_t index, Clip& clip) const
+            {
+                if (index >= count_)
+                {
+                    return false;
+                }
+                readEntry(index, clip);
+                return true;
+            }
+
+            bool ClipLibrary::find(uint16_t id, Clip& clip) const
+            {
+                // 片段表按 id 升序排列，二分查找
+                size_t low  = 0;
+                size_t high = count_;
+                while (low < high)
+                {
+                    size_t   mid    = low + (high - low) / 2;
+                    uint16_t mid_id = readU16(data_ + HEADER_SIZE + mid * ENTRY_SIZE);
+                    if (mid_id == id)
+                    {
+                        readEntry(mid, clip);
+                        return true;
+                    }
+                    if (mid_id < id)
+                    {
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid;
+                    }
+                }
+                return false;
+            }
+
+            void ClipLibrary::expand(const Clip& clip, int32_t speed, int32_t scale,
+                                     std::vector<ServoMotion>& motions)
+            {
+                constexpr int32_t HALF = timeline::Q8_ONE / 2; // 四舍五入
+
+                speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+                scale = std::clamp(scale, 0, MAX_SCALE);
+
+                motions.clear();
+                motions.reserve(clip.keyframe_count);
+                for (size_t k = 0; k < clip.keyframe_count; k++)
+                {
+                    const uint8_t* keyframe = clip.keyframes + k * KEYFRAME_SIZE;
+                    uint64_t       start    = readU32(keyframe + KEYFRAME_START);
+                    uint64_t       duration = readU32(keyframe + KEYFRAME_DURATION);
+                    int32_t        offset   = keyframe[KEYFRAME_VALUE] - timeline::REST_VALUE;
+                    int32_t        scaled   = offset * scale + (offset >= 0 ? HALF : -HALF);
+                    int32_t        value    = timeline::REST_VALUE + scaled / timeline::Q8_ONE;
+
+                    ServoMotion motion;
+                    motion.channel    = keyframe[KEYFRAME_CHANNEL];
+                    motion.start_time = static_cast<uint32_t>(start * timeline::Q8_ONE / speed);
+                    motion.duration   = static_cast<uint32_t>(duration * timeline::Q8_ONE / speed);
+                    motion.angle      = static_cast<uint8_t>(std::clamp(value, 0, 180));
+                    motion.easing     = static_cast<timeline::Easing>(keyframe[KEYFRAME_EASING]);
+                    motions.push_back(motion);
+                }
+            }
+
+            void ClipLibrary::readEntry(size_t index, Clip& clip) const
+            {
+                const uint8_t* entry = data_ + HEADER_SIZE + index * ENTRY_SIZE;
+                clip.id              = readU16(entry);
+                clip.keyframe_count  = readU16(entry + 2);
+                clip.keyframes       = data_ + readU32(entry + 4);
+                clip.duration        = readU32(entry + 8);
+                memcpy(clip.name, entry + 12, NAME_LENGTH);
+            }
+
+        } // namespace clip
+    } // namespace move
+} // namespace app
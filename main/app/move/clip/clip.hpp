@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "move/move.hpp"
+
+namespace app
+{
+    namespace move
+    {
+        namespace clip
+        {
+            // 动作片段库在 assets 分区中的文件名（由 scripts/build_assets.py 生成）
+            constexpr const char* ASSET_NAME = "motions.bin";
+
+            // 文件格式（小端，字段不保证对齐，格式与 scripts/build_assets.py 保持一致）：
+            //   文件头   magic(4) version(2) clip_count(2)
+            //   片段表   clip_count 项，按 id 升序：
+            //            id(2) keyframe_count(2) offset(4) duration(4) name(16)
+            //   关键帧   每个片段 keyframe_count 项，offset 为第一项相对文件开头的偏移：
+            //            start_time(4) duration(4) channel(1) value(1) easing(1) reserved(1)
+            constexpr uint32_t MAGIC         = 0x434D5045; // "EPMC"
+            constexpr uint16_t VERSION       = 1;
+            constexpr size_t   HEADER_SIZE   = 8;
+            constexpr size_t   ENTRY_SIZE    = 28;
+            constexpr size_t   KEYFRAME_SIZE = 12;
+            constexpr size_t   NAME_LENGTH   = 16; // 含结尾的 '\0'
+
+            constexpr uint8_t MOTOR_CHANNEL = 254; // 电机的通道号（与 ServoMotion 一致）
+
+            // 播放参数（Q8，Q8_ONE 表示原速 / 原幅度）
+            constexpr int32_t MIN_SPEED = timeline::Q8_ONE / 8;
+            constexpr int32_t MAX_SPEED = timeline::Q8_ONE * 8;
+            constexpr int32_t MAX_SCALE = timeline::Q8_ONE * 2;
+
+            /**
+             * @brief 一个动作片段
+             *
+             * 描述信息从片段表中读出，关键帧仍留在 assets 分区的映射内存中，展开时直接读取
+             */
+            struct Clip
+            {
+                uint16_t       id;
+                uint16_t       keyframe_count;
+                uint32_t       duration;          // 原速时长（毫秒）
+                char           name[NAME_LENGTH]; // 片段名称（如 "nod"）
+                const uint8_t* keyframes;         // 指向映射内存中的第一个关键帧
+            };
+
+            /**
+             * @brief 动作片段库
+             *
+             * load() 只在加载时完整校验一次文件（片段表按 id 升序、偏移不越界、通道号 / 角度 /
+             * 缓动类型合法），之后 find() 在片段表上二分查找，expand() 直接从映射内存中读取
+             * 关键帧生成运动序列，片段数据不复制到 RAM。
+             *
+             * @note 数据指针需在使用期间保持有效（assets 分区映射在运行期间不会释放）
+             */
+            class ClipLibrary
+            {
+            public:
+                ClipLibrary() = default;
+
+                /**
+                 * @brief 加载片段库
+                 * @param data 文件数据（通常来自 Assets::getAssetData()）
+                 * @param size 数据长度
+                 * @return true 成功, false 格式错误
+                 */
+                bool load(const void* data, size_t size);
+
+                /**
+                 * @brief 卸载片段库
+                 */
+                void clear();
+
+                /**
+                 * @brief 是否已加载
+                 */
+                bool isLoaded() const
+                {
+                    return data_ != nullptr;
+                }
+
+                /**
+                 * @brief 片段数量
+                 */
+                size_t getClipCount() const
+                {
+                    return count_;
+                }
+
+                /**
+                 * @brief 按片段表中的下标获取片段
+                 * @param index 下标（0 ~ getClipCount() - 1）
+                 * @param clip 输出：片段
+                 * @return true 成功, false 下标越界
+                 */
+                bool getClip(size_t index, Clip& clip) const;
+
+                /**
+                 * @brief 按 id 查找片段
+                 * @param id 片段 id
+                 * @param clip 输出：片段
+                 * @return true 找到, false 不存在
+                 */
+                bool find(uint16_t id, Clip& clip) const;
+
+                /**
+                 * @brief 把片段展开为运动序列
+                 *
+                 * 时间除以 speed，角度（电机为速度）以 REST_VALUE 为中心乘以 scale 后限制在
+                 * 0 ~ 180，得到的序列与 mov_info 解析出的序列一样提交给运动引擎。
+                 *
+                 * @param clip 片段
+                 * @param speed 播放速度（Q8，限制在 MIN_SPEED ~ MAX_SPEED）
+                 * @param scale 动作幅度（Q8，限制在 0 ~ MAX_SCALE）
+                 * @param motions 输出：运动序列（与片段中的关键帧顺序一致）
+                 */
+                static void expand(const Clip& clip, int32_t speed, int32_t scale,
+                                   std::vector<ServoMotion>& motions);
+
+            private:
+                // 读取片段表中的一项
+                void readEntry(size_t index, Clip& clip) const;
+
+                const uint8_t* data_  = nullptr;
+                size_t         count_ = 0;
+            };
+
+        } // namespace clip
+    } // namespace move
+} // namespace app
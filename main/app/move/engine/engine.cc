@@ -0,0 +1,492 @@
+#include "engine.hpp"
+
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <new>
+
+#include "media/clock/clock.hpp"
+
+static const char* const TAG = "MotionEngine";
+
+namespace app
+{
+    namespace move
+    {
+        namespace engine
+        {
+            MotionEngine::~MotionEngine()
+            {
+                stop();
+            }
+
+            bool MotionEngine::start(uint32_t tick_ms)
+            {
+                if (running_)
+                {
+                    return true;
+                }
+
+                // 首次启动时创建队列和信号量，之后复用
+                if (queue_ == nullptr)
+                {
+                    queue_       = xQueueCreate(QUEUE_LENGTH, sizeof(Request*));
+                    stopped_sem_ = xSemaphoreCreateBinary();
+                }
+                if (queue_ == nullptr || stopped_sem_ == nullptr)
+                {
+                    ESP_LOGE(TAG, "创建运动队列失败");
+                    return false;
+                }
+
+                tick_ms_ = tick_ms > 0 ? tick_ms : DEFAULT_TICK_MS;
+
+                // 舵机刷新对时间敏感，使用实时优先级
+                app::sys::task::Config task_config;
+                task_config.name       = "motion_engine";
+                task_config.stack_size = 4 * 1024;
+                task_config.priority   = app::sys::task::Priority::REALTIME;
+                task_config.core_id    = -1;
+                task_config.delay_ms   = 0;
+
+                engine_task_ = std::unique_ptr<app::sys::task::Task>(new app::sys::task::Task(
+                    [this](void* param) { this->engineTaskFunction(param); }, task_config, this));
+
+                running_ = true;
+                if (!engine_task_->start())
+                {
+                    ESP_LOGE(TAG, "启动运动引擎任务失败");
+                    running_ = false;
+                    engine_task_.reset();
+                    return false;
+                }
+
+                ESP_LOGI(TAG, "运动引擎已启动，节拍周期: %lu ms", (unsigned long)tick_ms_);
+                return true;
+            }
+
+            void MotionEngine::stop()
+            {
+                if (!running_)
+                {
+                    return;
+                }
+
+                // 空指针用于唤醒等待队列的引擎任务
+                running_         = false;
+                Request* wake_up = nullptr;
+                xQueueSendToFront(queue_, &wake_up, 0);
+                if (xSemaphoreTake(stopped_sem_, pdMS_TO_TICKS(1000)) != pdTRUE)
+                {
+                    ESP_LOGW(TAG, "等待运动引擎任务退出超时");
+                }
+
+                if (engine_task_ != nullptr)
+                {
+                    engine_task_->destroy();
+                    engine_task_.reset();
+                }
+
+                drain();
+                ESP_LOGI(TAG, "运动引擎已停止");
+            }
+
+            bool MotionEngine::submit(std::vector<ServoMotion> motions, Policy policy)
+            {
+                return enqueue(new (std::nothrow) Request{std::move(motions), policy, false, 0});
+            }
+
+            bool MotionEngine::submitSynced(std::vector<ServoMotion> motions,
+                                            uint32_t media_start_ms, Policy policy)
+            {
+                return enqueue(
+                    new (std::nothrow) Request{std::move(motions), policy, true, media_start_ms});
+            }
+
+            bool MotionEngine::enqueue(Request* request)
+            {
+                if (request == nullptr)
+                {
+                    ESP_LOGE(TAG, "分配运动序列失败");
+                    return false;
+                }
+                if (!running_)
+                {
+                    delete request;
+                    ESP_LOGE(TAG, "运动引擎未启动");
+                    return false;
+                }
+                if (request->motions.empty())
+                {
+                    delete request;
+                    ESP_LOGW(TAG, "运动序列为空");
+                    return false;
+                }
+
+                if (xQueueSend(queue_, &request, 0) != pdTRUE)
+                {
+                    delete request;
+                    {
+                        std::lock_guard<std::mutex> lock(stats_mutex_);
+                        stats_.dropped++;
+                    }
+                    ESP_LOGW(TAG, "运动队列已满，丢弃序列");
+                    return false;
+                }
+                return true;
+            }
+
+            Stats MotionEngine::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                return stats_;
+            }
+
+            void MotionEngine::resetStats()
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_ = Stats();
+            }
+
+            void MotionEngine::logStats() const
+            {
+                Stats    stats     = getStats();
+                uint32_t jitter_us = stats.ticks > 0 ? stats.jitter_sum_us / stats.ticks : 0;
+                ESP_LOGI(TAG, "序列: %lu 完成 / %lu 打断 / %lu 丢弃, 交叉淡化: %lu",
+                         (unsigned long)stats.sequences, (unsigned long)stats.preempted,
+                         (unsigned long)stats.dropped, (unsigned long)stats.crossfades);
+                ESP_LOGI(TAG, "节拍: %lu, 超时: %lu", (unsigned long)stats.ticks,
+                         (unsigned long)stats.overruns);
+                ESP_LOGI(TAG, "抖动: 平均 %lu us / 最大 %lu us, 最长处理: %lu us, 结束偏差: %ld ms",
+                         (unsigned long)jitter_us, (unsigned long)stats.jitter_max_us,
+                         (unsigned long)stats.busy_max_us, (long)stats.end_error_ms);
+                ESP_LOGI(TAG, "音频同步: %lu, 等待音频超时: %lu", (unsigned long)stats.media_synced,
+                         (unsigned long)stats.sync_timeouts);
+            }
+
+            void MotionEngine::engineTaskFunction(void* param)
+            {
+                (void)param;
+                ESP_LOGI(TAG, "运动引擎任务开始运行");
+
+                // 上电后舵机位置未知，与原先的假定一致：舵机居中、电机停止
+                std::fill(std::begin(commanded_), std::end(commanded_),
+                          timeline::REST_VALUE * timeline::Q8_ONE);
+
+                while (running_)
+                {
+                    Request* request = nullptr;
+                    if (xQueueReceive(queue_, &request, portMAX_DELAY) != pdTRUE)
+                    {
+                        continue;
+                    }
+                    if (request == nullptr)
+                    {
+                        continue;
+                    }
+
+                    run(request);
+                }
+
+                ESP_LOGI(TAG, "运动引擎任务结束");
+                xSemaphoreGive(stopped_sem_);
+
+                // 等待 stop() 删除本任务
+                while (true)
+                {
+                    vTaskDelay(portMAX_DELAY);
+                }
+            }
+
+            void MotionEngine::run(Request* request)
+            {
+                const TickType_t period    = std::max<TickType_t>(pdMS_TO_TICKS(tick_ms_), 1);
+                const int64_t    period_us = (int64_t)period * portTICK_PERIOD_MS * 1000;
+                TickType_t       last_wake = xTaskGetTickCount();
+                int64_t          deadline  = esp_timer_get_time(); // 本节拍的截止时间（微秒）
+
+                busy_ = true;
+                startSequence(request, deadline);
+
+                while (running_)
+                {
+                    int64_t wake_us   = esp_timer_get_time();
+                    int64_t jitter_us = wake_us - deadline;
+
+                    // BLEND / MIX 序列立即切入；QUEUE 序列等当前序列和被叠加的序列结束后再开始
+                    Request* next = nullptr;
+                    if (xQueuePeek(queue_, &next, 0) == pdTRUE && next != nullptr &&
+                        (next->policy != Policy::QUEUE || (!current_.active && !layered_)))
+                    {
+                        xQueueReceive(queue_, &next, 0);
+                        startSequence(next, wake_us);
+                    }
+
+                    tick(wake_us);
+                    int64_t busy_us = esp_timer_get_time() - wake_us;
+
+                    if (!current_.active && !fading_ && !layered_ &&
+                        uxQueueMessagesWaiting(queue_) == 0)
+                    {
+                        recordTick(jitter_us, busy_us, false);
+                        break;
+                    }
+
+                    // 已错过下一个截止时间时不补偿错过的节拍，从当前时间重新对齐
+                    deadline += period_us;
+                    bool overrun = xTaskDelayUntil(&last_wake, period) == pdFALSE;
+                    if (overrun)
+                    {
+                        last_wake = xTaskGetTickCount();
+                        deadline  = esp_timer_get_time();
+                    }
+                    recordTick(jitter_us, busy_us, overrun);
+                }
+
+                busy_ = false;
+            }
+
+            bool MotionEngine::startSequence(Request* request, int64_t now_us)
+            {
+                // 新序列从各通道当前的指令值开始
+                Policy       policy         = request->policy;
+                bool         synced         = request->synced;
+                uint32_t     media_start_ms = request->media_start_ms;
+                MotionPlayer player;
+                bool         ok = player.begin(std::move(request->motions), commanded_);
+                delete request;
+                if (!ok)
+                {
+                    return false;
+                }
+
+                uint32_t crossfade_ms = crossfade_ms_;
+                uint32_t new_mask     = player.getTrackMask();
+                bool     interrupted  = current_.active;
+                bool     mix          = policy == Policy::MIX;
+
+                // 只剩被叠加的序列在执行时，新序列直接叠加在它上面，不需要淡化
+                bool keep_layer = mix && !interrupted && layered_;
+                bool blend_in   = !keep_layer && (interrupted || fading_) && crossfade_ms > 0;
+                if (blend_in || (mix && interrupted))
+                {
+                    std::swap(previous_, current_);
+                }
+
+                if (blend_in)
+                {
+                    // 旧序列继续沿原轨迹推进，记录它与指令值之差（嵌套打断时不为 0），
+                    // 淡化过程中这个差值随旧轨迹的权重一起消失
+                    const int32_t* values = previous_.player.getValues();
+                    fade_mask_            = previous_.player.getTrackMask();
+                    for (size_t slot = 0; slot < timeline::MAX_TRACKS; slot++)
+                    {
+                        fade_offset_[slot] = commanded_[slot] - values[slot];
+                        if (fade_offset_[slot] != 0)
+                        {
+                            fade_mask_ |= 1u << slot;
+                        }
+                    }
+                    fading_        = true;
+                    fade_start_us_ = now_us;
+                    fade_ms_       = crossfade_ms;
+                }
+                else
+                {
+                    fading_ = false;
+                }
+
+                // 叠加：原序列中新序列没有涉及的通道继续执行（已被接管过的通道不再交还）
+                uint32_t carried = 0;
+                if (mix && interrupted && previous_.active)
+                {
+                    carried = previous_.player.getTrackMask();
+                }
+                else if (keep_layer)
+                {
+                    carried = carry_mask_;
+                }
+                carry_mask_ = carried & ~new_mask;
+                layered_    = carry_mask_ != 0;
+
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    if (interrupted)
+                    {
+                        stats_.preempted++;
+                    }
+                    if (fading_)
+                    {
+                        stats_.crossfades++;
+                    }
+                }
+
+                current_.player         = std::move(player);
+                current_.start_us       = now_us;
+                current_.active         = true;
+                current_.synced         = synced;
+                current_.locked         = false;
+                current_.media_start_ms = media_start_ms;
+                ESP_LOGD(TAG, "开始运动序列，总时长: %lu ms%s%s",
+                         (unsigned long)current_.player.getTotalDuration(),
+                         fading_ ? "（交叉淡化）" : "", layered_ ? "（叠加）" : "");
+                return true;
+            }
+
+            void MotionEngine::tick(int64_t now_us)
+            {
+                // 序列时间取自实际时钟，节拍间隔不影响轨迹；到达总时长时的采样即为最终值
+                if (current_.active)
+                {
+                    uint32_t elapsed_ms = elapsedMs(current_, now_us);
+                    current_.active     = current_.player.advance(elapsed_ms);
+                    if (!current_.active)
+                    {
+                        int64_t error_ms = elapsed_ms - (int64_t)current_.player.getTotalDuration();
+
+                        std::lock_guard<std::mutex> lock(stats_mutex_);
+                        stats_.sequences++;
+                        stats_.end_error_ms = static_cast<int32_t>(error_ms);
+                    }
+                }
+
+                int32_t        values[timeline::MAX_TRACKS];
+                const int32_t* target = current_.player.getValues();
+                uint32_t       mask   = current_.player.getTrackMask();
+                std::copy(target, target + timeline::MAX_TRACKS, values);
+
+                if ((fading_ || layered_) && previous_.active)
+                {
+                    uint32_t elapsed_ms = elapsedMs(previous_, now_us);
+                    previous_.active    = previous_.player.advance(elapsed_ms);
+                }
+
+                // 叠加：新序列没有涉及的通道跟随原序列（淡化中的差值在下面照常消失）
+                if (layered_)
+                {
+                    const int32_t* carried = previous_.player.getValues();
+                    for (size_t slot = 0; slot < timeline::MAX_TRACKS; slot++)
+                    {
+                        if ((carry_mask_ & (1u << slot)) != 0)
+                        {
+                            values[slot] = carried[slot];
+                        }
+                    }
+                    mask |= carry_mask_;
+                }
+
+                if (fading_)
+                {
+                    // 缓入缓出权重：淡化开始和结束时权重变化率为 0，速度连续
+                    uint32_t fade_elapsed = static_cast<uint32_t>((now_us - fade_start_us_) / 1000);
+                    int32_t  weight       = timeline::Q15_ONE;
+                    if (fade_elapsed < fade_ms_)
+                    {
+                        int32_t progress = static_cast<int32_t>(
+                            static_cast<uint64_t>(fade_elapsed) * timeline::Q15_ONE / fade_ms_);
+                        weight = timeline::ease(timeline::Easing::EASE_IN_OUT, progress);
+                    }
+
+                    const int32_t* from = previous_.player.getValues();
+                    mask |= fade_mask_;
+                    for (size_t slot = 0; slot < timeline::MAX_TRACKS; slot++)
+                    {
+                        int32_t old_value = from[slot] + fade_offset_[slot];
+                        int64_t delta     = (int64_t)(values[slot] - old_value) * weight;
+                        values[slot]      = old_value + (int32_t)(delta / timeline::Q15_ONE);
+                    }
+
+                    if (weight >= timeline::Q15_ONE)
+                    {
+                        fading_ = false;
+                    }
+                }
+
+                // 只输出与当前指令值不同的通道
+                uint32_t changed = 0;
+                for (size_t slot = 0; slot < timeline::MAX_TRACKS; slot++)
+                {
+                    if ((mask & (1u << slot)) != 0 && values[slot] != commanded_[slot])
+                    {
+                        commanded_[slot] = values[slot];
+                        changed |= 1u << slot;
+                    }
+                }
+                if (changed != 0)
+                {
+                    MotionPlayer::output(commanded_, changed);
+                }
+
+                // 原序列结束后叠加的通道停在它的最终值
+                if (layered_ && !previous_.active && !fading_)
+                {
+                    layered_ = false;
+                }
+            }
+
+            uint32_t MotionEngine::elapsedMs(Voice& voice, int64_t now_us)
+            {
+                if (voice.synced)
+                {
+                    // 按正在播放的媒体时间计算进度，同时更新本地起点，音频结束后可以无缝接续
+                    uint32_t media_ms = 0;
+                    if (media::clock::MediaClock::getInstance().getTime(now_us, media_ms))
+                    {
+                        uint32_t elapsed_ms =
+                            media_ms > voice.media_start_ms ? media_ms - voice.media_start_ms : 0;
+                        voice.start_us = now_us - (int64_t)elapsed_ms * 1000;
+                        if (!voice.locked)
+                        {
+                            voice.locked = true;
+                            std::lock_guard<std::mutex> lock(stats_mutex_);
+                            stats_.media_synced++;
+                        }
+                        return elapsed_ms;
+                    }
+
+                    // 音频还没开始播放：停在起点等待
+                    if (!voice.locked && now_us - voice.start_us < SYNC_TIMEOUT_MS * 1000)
+                    {
+                        return 0;
+                    }
+
+                    if (!voice.locked)
+                    {
+                        ESP_LOGW(TAG, "等待音频超时，运动序列改用本地时钟");
+                        voice.start_us = now_us;
+                        std::lock_guard<std::mutex> lock(stats_mutex_);
+                        stats_.sync_timeouts++;
+                    }
+                    voice.synced = false;
+                }
+
+                return (uint32_t)((now_us - voice.start_us) / 1000);
+            }
+
+            void MotionEngine::recordTick(int64_t jitter_us, int64_t busy_us, bool overrun)
+            {
+                uint32_t jitter = static_cast<uint32_t>(jitter_us < 0 ? -jitter_us : jitter_us);
+
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.ticks++;
+                stats_.jitter_sum_us += jitter;
+                stats_.jitter_max_us = std::max(stats_.jitter_max_us, jitter);
+                stats_.busy_max_us   = std::max(stats_.busy_max_us, static_cast<uint32_t>(busy_us));
+                if (overrun)
+                {
+                    stats_.overruns++;
+                }
+            }
+
+            void MotionEngine::drain()
+            {
+                Request* request = nullptr;
+                while (xQueueReceive(queue_, &request, 0) == pdTRUE)
+                {
+                    delete request;
+                }
+            }
+
+        } // namespace engine
+    } // namespace move
+} // namespace app
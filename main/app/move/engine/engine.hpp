@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "move/move.hpp"
+#include "system/task/task.hpp"
+
+namespace app
+{
+    namespace move
+    {
+        namespace engine
+        {
+            constexpr size_t   QUEUE_LENGTH         = 4;    // 排队等待执行的序列数上限
+            constexpr uint32_t DEFAULT_TICK_MS      = 20;   // 默认节拍周期（与舵机 50Hz 刷新一致）
+            constexpr uint32_t DEFAULT_CROSSFADE_MS = 200;  // 默认交叉淡化时间
+            constexpr uint32_t SYNC_TIMEOUT_MS      = 1000; // 同步序列等待音频开始播放的时间上限
+
+            /**
+             * @brief 新序列与正在执行的序列的衔接方式
+             */
+            enum class Policy : uint8_t
+            {
+                QUEUE = 0, // 排队，等前面的序列执行完再开始
+                BLEND = 1, // 立即打断当前序列，在交叉淡化时间内从当前轨迹过渡到新序列
+                MIX   = 2  // 同 BLEND，但只接管新序列涉及的通道，其余通道继续执行原序列
+            };
+
+            /**
+             * @brief 运动引擎统计
+             */
+            struct Stats
+            {
+                uint32_t sequences;     // 完成的序列数
+                uint32_t preempted;     // 被新序列打断的序列数
+                uint32_t crossfades;    // 交叉淡化次数
+                uint32_t dropped;       // 队列已满被丢弃的序列数
+                uint32_t ticks;         // 执行的节拍数
+                uint32_t overruns;      // 错过截止时间的节拍数
+                uint32_t jitter_max_us; // 唤醒时间相对截止时间的最大偏差（微秒）
+                uint64_t jitter_sum_us; // 唤醒偏差累计（微秒）
+                uint32_t busy_max_us;   // 单个节拍的最长处理时间（微秒）
+                int32_t  end_error_ms;  // 最近一个序列实际用时与计划时长之差（毫秒）
+                uint32_t media_synced;  // 按媒体时钟对齐的序列数
+                uint32_t sync_timeouts; // 等不到音频、改用本地时钟的同步序列数
+
+                Stats()
+                    : sequences(0), preempted(0), crossfades(0), dropped(0), ticks(0), overruns(0),
+                      jitter_max_us(0), jitter_sum_us(0), busy_max_us(0), end_error_ms(0),
+                      media_synced(0), sync_timeouts(0)
+                {
+                }
+            };
+
+            /**
+             * @brief 实时运动引擎（单例模式）
+             *
+             * 运动序列通过队列提交给专用的高优先级任务执行，提交方立即返回。
+             * 任务按绝对截止时间（xTaskDelayUntil）推进节拍，序列时间取自实际时钟，
+             * 单个节拍的 I2C 写入或计算变慢不会让后续动作整体延后；错过截止时间时跳过
+             * 错过的节拍并计入 overruns。
+             *
+             * 引擎记录每个通道实际下发的指令值，新序列总是从当前位置开始而不是假定的居中位置。
+             * Policy::QUEUE 的序列按提交顺序依次执行；Policy::BLEND 的序列在下一个节拍立即切入，
+             * 被打断的序列继续沿原轨迹推进，输出在交叉淡化时间内（缓入缓出权重）从旧轨迹
+             * 过渡到新轨迹，位置和速度都不会跳变。交叉淡化时间为 0 时直接从当前位置开始新序列。
+             * 服务器可以据此高频下发短小的动作片段。
+             *
+             * Policy::MIX 用于把预置动作片段叠加在正在执行的序列上（如说话时摇尾巴）：
+             * 新序列涉及的通道按 BLEND 的方式切入，其余通道继续跟随原序列直到它结束。
+             * 叠加只保留一层，原序列结束前再次叠加时，被叠加的序列换成当前序列。
+             *
+             * submitSynced() 提交的序列以音频的媒体时间（media::clock::MediaClock）为时间轴：
+             * 每个节拍按正在播放的媒体时间重新计算序列进度，抖动缓冲拉长或缩短播放时动作随之
+             * 调整。音频还没播到序列开始时间时序列停在起点；SYNC_TIMEOUT_MS 内等不到音频
+             * 或音频播完后改用本地时钟继续。
+             */
+            class MotionEngine
+            {
+            public:
+                /**
+                 * @brief 获取单例实例
+                 * @return MotionEngine 实例的引用
+                 */
+                static MotionEngine& getInstance()
+                {
+                    static MotionEngine instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                MotionEngine(const MotionEngine&)            = delete;
+                MotionEngine& operator=(const MotionEngine&) = delete;
+
+                /**
+                 * @brief 启动引擎任务
+                 * @param tick_ms 节拍周期（毫秒）
+                 * @return true 成功, false 失败
+                 */
+                bool start(uint32_t tick_ms = DEFAULT_TICK_MS);
+
+                /**
+                 * @brief 停止引擎任务（正在执行的序列在下一个节拍中止，排队的序列被丢弃）
+                 */
+                void stop();
+
+                /**
+                 * @brief 引擎任务是否在运行
+                 */
+                bool isRunning() const
+                {
+                    return running_;
+                }
+
+                /**
+                 * @brief 是否正在执行序列
+                 */
+                bool isBusy() const
+                {
+                    return busy_;
+                }
+
+                /**
+                 * @brief 提交运动序列，立即返回
+                 * @param motions 运动信息列表（顺序不限）
+                 * @param policy 与正在执行的序列的衔接方式
+                 * @return true 已入队, false 引擎未运行、序列为空或队列已满
+                 */
+                bool submit(std::vector<ServoMotion> motions, Policy policy = Policy::QUEUE);
+
+                /**
+                 * @brief 提交与音频同步的运动序列，立即返回
+                 * @param motions 运动信息列表（开始时间相对 media_start_ms）
+                 * @param media_start_ms 序列开始对应的媒体时间（毫秒）
+                 * @param policy 与正在执行的序列的衔接方式
+                 * @return true 已入队, false 引擎未运行、序列为空或队列已满
+                 */
+                bool submitSynced(std::vector<ServoMotion> motions, uint32_t media_start_ms,
+                                  Policy policy = Policy::BLEND);
+
+                /**
+                 * @brief 设置 Policy::BLEND 序列的交叉淡化时间
+                 * @param crossfade_ms 交叉淡化时间（毫秒），0 表示直接从当前位置切换
+                 */
+                void setCrossfade(uint32_t crossfade_ms)
+                {
+                    crossfade_ms_ = crossfade_ms;
+                }
+
+                /**
+                 * @brief 获取交叉淡化时间（毫秒）
+                 */
+                uint32_t getCrossfade() const
+                {
+                    return crossfade_ms_;
+                }
+
+                /**
+                 * @brief 获取统计信息
+                 */
+                Stats getStats() const;
+
+                /**
+                 * @brief 清零统计
+                 */
+                void resetStats();
+
+                /**
+                 * @brief 打印统计信息
+                 */
+                void logStats() const;
+
+                /**
+                 * @brief 静态方法：提交运动序列（便捷接口）
+                 */
+                static bool Submit(std::vector<ServoMotion> motions, Policy policy = Policy::QUEUE)
+                {
+                    return getInstance().submit(std::move(motions), policy);
+                }
+
+            private:
+                MotionEngine() = default;
+                ~MotionEngine();
+
+                // 排队中的序列
+                struct Request
+                {
+                    std::vector<ServoMotion> motions;
+                    Policy                   policy;
+                    bool                     synced;         // 是否按媒体时间推进
+                    uint32_t                 media_start_ms; // 序列开始对应的媒体时间
+                };
+
+                // 一个正在播放的序列
+                struct Voice
+                {
+                    MotionPlayer player;
+                    int64_t      start_us       = 0; // 序列开始的时间（微秒）
+                    bool         active         = false;
+                    bool         synced         = false; // 是否按媒体时间推进
+                    bool         locked         = false; // 是否已经取得过媒体时间
+                    uint32_t     media_start_ms = 0;
+                };
+
+                // 校验并入队
+                bool enqueue(Request* request);
+
+                // 引擎任务函数
+                void engineTaskFunction(void* param);
+
+                // 按节拍执行序列，直到没有正在执行和排队的序列
+                void run(Request* request);
+
+                // 切入新序列（需要时与当前轨迹交叉淡化），释放 request
+                bool startSequence(Request* request, int64_t now_us);
+
+                // 推进各序列并输出与当前指令值不同的通道
+                void tick(int64_t now_us);
+
+                // 序列已经执行的时间（毫秒），同步序列取自媒体时钟
+                uint32_t elapsedMs(Voice& voice, int64_t now_us);
+
+                // 记录一个节拍的统计
+                void recordTick(int64_t jitter_us, int64_t busy_us, bool overrun);
+
+                // 丢弃排队中的序列
+                void drain();
+
+                QueueHandle_t     queue_       = nullptr; // 保存 Request* 指针
+                SemaphoreHandle_t stopped_sem_ = nullptr; // 引擎任务退出信号
+
+                std::unique_ptr<app::sys::task::Task> engine_task_;
+                std::atomic<bool>                     running_{false};
+                std::atomic<bool>                     busy_{false};
+                uint32_t                              tick_ms_ = DEFAULT_TICK_MS;
+                std::atomic<uint32_t>                 crossfade_ms_{DEFAULT_CROSSFADE_MS};
+
+                // 以下只在引擎任务中访问
+                Voice    current_;                             // 当前序列
+                Voice    previous_;                            // 被打断的序列（淡化或叠加中）
+                bool     fading_        = false;               // 是否在交叉淡化
+                int64_t  fade_start_us_ = 0;                   // 交叉淡化开始时间（微秒）
+                uint32_t fade_ms_       = 0;                   // 本次交叉淡化时长
+                uint32_t fade_mask_     = 0;                   // 参与交叉淡化的旧通道
+                bool     layered_       = false;               // 是否有通道由原序列继续驱动
+                uint32_t carry_mask_    = 0;                   // 由原序列继续驱动的通道
+                int32_t  fade_offset_[timeline::MAX_TRACKS]{}; // 切入时指令值与旧轨迹之差（Q8）
+                int32_t  commanded_[timeline::MAX_TRACKS]{};   // 各通道实际下发的指令值（Q8）
+
+                mutable std::mutex stats_mutex_;
+                Stats              stats_;
+            };
+
+        } // namespace engine
+    } // namespace move
+} // namespace app
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <algorithm>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <driver/i2c_master.h>
 #include <driver/gpio.h>
 #include <driver/ledc.h>
@@ -20,6 +21,10 @@ static constexpr uint8_t LED0_ON_H  = 0x07;
 static constexpr uint8_t LED0_OFF_L = 0x08;
 static constexpr uint8_t LED0_OFF_H = 0x09;
 
+// 角度计数表使用的舵机脉宽范围（与 setServoAngle 默认值一致）
+static constexpr uint32_t SERVO_MIN_PULSE_US = 500;
+static constexpr uint32_t SERVO_MAX_PULSE_US = 2500;
+
 static const char* const TAG = "PCA9685";
 
 // b2 电机控制相关常量
@@ -36,11 +41,15 @@ namespace app
     namespace move
     {
         // 静态成员定义
-        bool                    PCA9685::initialized_    = false;
-        i2c_master_bus_handle_t PCA9685::bus_handle_     = nullptr;
-        i2c_master_dev_handle_t PCA9685::dev_handle_     = nullptr;
-        uint8_t                 PCA9685::i2c_addr_       = PCA9685::DEFAULT_I2C_ADDR;
-        float                   PCA9685::current_freq_hz_ = 0.0f;
+        bool                     PCA9685::initialized_     = false;
+        i2c_master_bus_handle_t  PCA9685::bus_handle_      = nullptr;
+        i2c_master_dev_handle_t  PCA9685::dev_handle_      = nullptr;
+        uint8_t                  PCA9685::i2c_addr_        = PCA9685::DEFAULT_I2C_ADDR;
+        float                    PCA9685::current_freq_hz_ = 0.0f;
+        i2c::scheduler::DeviceId PCA9685::i2c_device_      = i2c::scheduler::INVALID_DEVICE;
+
+        uint16_t PCA9685::servo_counts_[PCA9685::MAX_ANGLE + 1]  = {};
+        uint16_t PCA9685::channel_counts_[PCA9685::CHANNEL_COUNT] = {};
 
         bool PCA9685::init(i2c_master_bus_handle_t bus_handle, uint8_t i2c_addr)
         {
@@ -76,6 +85,16 @@ namespace app
                 return false;
             }
 
+            // 登记到 I2C 调度器，之后的读写按优先级排队
+            i2c_device_ = i2c::scheduler::Scheduler::getInstance().registerDevice(
+                "PCA9685", dev_handle_, i2c::scheduler::Priority::HIGH);
+            if (i2c_device_ == i2c::scheduler::INVALID_DEVICE)
+            {
+                ESP_LOGE(TAG, "登记 I2C 调度设备失败");
+                deinit();
+                return false;
+            }
+
             initialized_     = true;
             current_freq_hz_ = 0.0f;
 
@@ -102,12 +121,22 @@ namespace app
         {
             if (dev_handle_ != nullptr)
             {
-                i2c_master_bus_rm_device(dev_handle_);
+                // 调度器中仍有该设备的事务时不能移除句柄
+                if (i2c::scheduler::Scheduler::getInstance().unregisterDevice(i2c_device_))
+                {
+                    i2c_master_bus_rm_device(dev_handle_);
+                }
+                else
+                {
+                    ESP_LOGE(TAG, "I2C 事务未结束，保留设备句柄");
+                }
+                i2c_device_ = i2c::scheduler::INVALID_DEVICE;
                 dev_handle_ = nullptr;
             }
             bus_handle_      = nullptr;
             initialized_     = false;
             current_freq_hz_ = 0.0f;
+            std::fill(std::begin(channel_counts_), std::end(channel_counts_), COUNT_UNKNOWN);
             ESP_LOGI(TAG, "PCA9685 已反初始化");
         }
 
@@ -125,6 +154,7 @@ namespace app
                 ESP_LOGE(TAG, "写入 MODE1 失败，无法复位");
                 return false;
             }
+            std::fill(std::begin(channel_counts_), std::end(channel_counts_), COUNT_UNKNOWN);
 
             // 等待一小段时间让芯片稳定
             vTaskDelay(pdMS_TO_TICKS(10));
@@ -190,6 +220,7 @@ namespace app
             }
 
             current_freq_hz_ = freq_hz;
+            buildServoTable(freq_hz);
             ESP_LOGI(TAG, "PCA9685 PWM 频率设置为: %.2f Hz", static_cast<double>(freq_hz));
             return true;
         }
@@ -215,13 +246,16 @@ namespace app
             buffer[3] = static_cast<uint8_t>(off & 0xFF);
             buffer[4] = static_cast<uint8_t>((off >> 8) & 0x0F);
 
-            esp_err_t ret = i2c_master_transmit(dev_handle_, buffer, sizeof(buffer), 1000);
+            auto&     bus = i2c::scheduler::Scheduler::getInstance();
+            esp_err_t ret = bus.transmit(i2c_device_, buffer, sizeof(buffer));
             if (ret != ESP_OK)
             {
                 ESP_LOGE(TAG, "I2C 发送 PWM 数据失败: %s", esp_err_to_name(ret));
+                channel_counts_[channel] = COUNT_UNKNOWN;
                 return false;
             }
 
+            channel_counts_[channel] = (on == 0 && off <= 4095) ? off : COUNT_UNKNOWN;
             return true;
         }
 
@@ -321,94 +355,123 @@ namespace app
             return setPWM(channel, 0, pulse_counts);
         }
 
-        /**
-         * @brief 缓动函数：将线性进度 t (0.0~1.0) 转换为缓动后的进度值
-         * @param t 线性进度 (0.0~1.0)
-         * @param type 缓动类型
-         * @return 缓动后的进度值 (0.0~1.0)
-         */
-        static float applyEasing(float t, PCA9685::EasingType type)
+        void PCA9685::buildServoTable(float freq_hz)
         {
-            // 限制 t 在 0.0~1.0 范围内
-            t = std::clamp(t, 0.0f, 1.0f);
+            // 每微秒对应的计数（Q16 定点），运行时只做整数乘法和移位
+            const uint64_t counts_per_us_q16 =
+                static_cast<uint64_t>(std::lround(4096.0 * freq_hz / 1000000.0 * 65536.0));
 
-            switch (type)
+            for (uint32_t angle = 0; angle <= MAX_ANGLE; angle++)
             {
-                case PCA9685::EasingType::LINEAR:
-                    return t;
+                // 脉宽放大 MAX_ANGLE 倍，避免中间结果取整
+                uint64_t pulse_scaled = SERVO_MIN_PULSE_US * MAX_ANGLE +
+                                        (SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) * angle;
+                uint64_t count_q16    = pulse_scaled * counts_per_us_q16 / MAX_ANGLE;
+                servo_counts_[angle] =
+                    static_cast<uint16_t>(std::min<uint64_t>((count_q16 + 0x8000) >> 16, 4095));
+            }
+        }
 
-                case PCA9685::EasingType::EASE_IN:
-                    // 二次缓入：t^2
-                    return t * t;
+        uint16_t PCA9685::angleToCount(uint8_t angle_deg)
+        {
+            return servo_counts_[std::min(angle_deg, MAX_ANGLE)];
+        }
 
-                case PCA9685::EasingType::EASE_OUT:
-                    // 二次缓出：1 - (1-t)^2
-                    {
-                        float t1 = 1.0f - t;
-                        return 1.0f - (t1 * t1);
-                    }
+        bool PCA9685::writeFrame(const ServoFrame& frame)
+        {
+            if (!initialized_ || dev_handle_ == nullptr)
+            {
+                ESP_LOGE(TAG, "PCA9685 未初始化，无法输出舵机帧");
+                return false;
+            }
 
-                case PCA9685::EasingType::EASE_IN_OUT:
-                    // 二次缓入缓出
-                    if (t < 0.5f)
-                    {
-                        return 2.0f * t * t;
-                    }
-                    else
+            // 按连续可写的通道分段，每段只写第一个到最后一个发生变化的通道。
+            // 段内未变化的通道按缓存值重写；缓存未知且本帧不输出的通道不能重写，作为分段点
+            bool ok    = true;
+            int  first = -1;
+            int  last  = -1;
+            for (int ch = 0; ch <= CHANNEL_COUNT; ch++)
+            {
+                bool in_range = ch < CHANNEL_COUNT;
+                bool in_frame = in_range && (frame.mask & (1u << ch)) != 0;
+                bool writable = in_frame || (in_range && channel_counts_[ch] != COUNT_UNKNOWN);
+                if (!writable)
+                {
+                    if (first >= 0)
                     {
-                        float t1 = (2.0f * t) - 1.0f;
-                        float t2 = 1.0f - t1;
-                        return 1.0f - (0.5f * t2 * t2);
+                        ok    = writeChannels(frame, first, last) && ok;
+                        first = -1;
                     }
+                    continue;
+                }
 
-                case PCA9685::EasingType::EASE_IN_QUAD:
-                    return t * t;
-
-                case PCA9685::EasingType::EASE_OUT_QUAD:
+                if (in_frame && frame.counts[ch] != channel_counts_[ch])
+                {
+                    if (first < 0)
                     {
-                        float t1 = 1.0f - t;
-                        return 1.0f - (t1 * t1);
+                        first = ch;
                     }
+                    last = ch;
+                }
+            }
 
-                case PCA9685::EasingType::EASE_IN_OUT_QUAD:
-                    if (t < 0.5f)
-                    {
-                        return 2.0f * t * t;
-                    }
-                    else
-                    {
-                        float t1 = (2.0f * t) - 1.0f;
-                        float t2 = 1.0f - t1;
-                        return 1.0f - (0.5f * t2 * t2);
-                    }
+            return ok;
+        }
 
-                case PCA9685::EasingType::EASE_IN_CUBIC:
-                    // 三次缓入：t^3
-                    return t * t * t;
+        bool PCA9685::writeChannels(const ServoFrame& frame, uint8_t first, uint8_t last)
+        {
+            uint8_t buffer[1 + 4 * CHANNEL_COUNT];
+            size_t  len   = 0;
+            buffer[len++] = LED0_ON_L + 4 * first;
+            for (uint8_t ch = first; ch <= last; ch++)
+            {
+                bool     in_frame = (frame.mask & (1u << ch)) != 0;
+                uint16_t off      = in_frame ? frame.counts[ch] : channel_counts_[ch];
 
-                case PCA9685::EasingType::EASE_OUT_CUBIC:
-                    // 三次缓出：1 - (1-t)^3
-                    {
-                        float t1 = 1.0f - t;
-                        return 1.0f - (t1 * t1 * t1);
-                    }
+                buffer[len++] = 0; // ON_L/ON_H 固定为 0
+                buffer[len++] = 0;
+                buffer[len++] = static_cast<uint8_t>(off & 0xFF);
+                buffer[len++] = static_cast<uint8_t>((off >> 8) & 0x0F);
+            }
 
-                case PCA9685::EasingType::EASE_IN_OUT_CUBIC:
-                    // 三次缓入缓出
-                    if (t < 0.5f)
-                    {
-                        return 4.0f * t * t * t;
-                    }
-                    else
-                    {
-                        float t1 = (2.0f * t) - 1.0f;
-                        float t2 = 1.0f - t1;
-                        return 1.0f - (0.5f * t2 * t2 * t2);
-                    }
+            // 超过调度器异步写入上限，使用同步事务
+            auto&     bus = i2c::scheduler::Scheduler::getInstance();
+            esp_err_t ret = bus.transmit(i2c_device_, buffer, len);
+            for (uint8_t ch = first; ch <= last; ch++)
+            {
+                if (ret != ESP_OK)
+                {
+                    channel_counts_[ch] = COUNT_UNKNOWN;
+                }
+                else if ((frame.mask & (1u << ch)) != 0)
+                {
+                    channel_counts_[ch] = frame.counts[ch];
+                }
+            }
 
-                default:
-                    return t; // 默认线性
+            if (ret != ESP_OK)
+            {
+                ESP_LOGE(TAG, "I2C 发送舵机帧失败 (通道 %u~%u): %s", first, last,
+                         esp_err_to_name(ret));
+                return false;
             }
+            return true;
+        }
+
+        /**
+         * @brief 缓动函数：将线性进度 t (0.0~1.0) 转换为缓动后的进度值
+         * @param t 线性进度 (0.0~1.0)
+         * @param type 缓动类型
+         * @return 缓动后的进度值 (0.0~1.0)
+         */
+        static float applyEasing(float t, PCA9685::EasingType type)
+        {
+            // 限制 t 在 0.0~1.0 范围内
+            t = std::clamp(t, 0.0f, 1.0f);
+
+            // 与运动时间线共用 Q15 查找表
+            int32_t progress = static_cast<int32_t>(t * timeline::Q15_ONE + 0.5f);
+            return static_cast<float>(timeline::ease(type, progress)) / timeline::Q15_ONE;
         }
 
         bool PCA9685::setServoAngleWithEasing(uint8_t    channel,
@@ -495,8 +558,8 @@ namespace app
                 return false;
             }
 
-            esp_err_t ret =
-                i2c_master_transmit_receive(dev_handle_, &reg_addr, 1, &value, 1, 1000);
+            auto&     bus = i2c::scheduler::Scheduler::getInstance();
+            esp_err_t ret = bus.transmitReceive(i2c_device_, &reg_addr, 1, &value, 1);
             if (ret != ESP_OK)
             {
                 ESP_LOGE(TAG, "I2C 读取寄存器 0x%02X 失败: %s", reg_addr,
@@ -515,8 +578,9 @@ namespace app
                 return false;
             }
 
-            uint8_t buf[2] = {reg_addr, value};
-            esp_err_t ret  = i2c_master_transmit(dev_handle_, buf, sizeof(buf), 1000);
+            uint8_t   buf[2] = {reg_addr, value};
+            auto&     bus    = i2c::scheduler::Scheduler::getInstance();
+            esp_err_t ret    = bus.transmit(i2c_device_, buf, sizeof(buf));
             if (ret != ESP_OK)
             {
                 ESP_LOGE(TAG, "I2C 写入寄存器 0x%02X 失败: %s", reg_addr,
@@ -760,6 +824,15 @@ namespace app
                     motion.duration = 1000;
                 }
 
+                // 解析 easing（可选）
+                cJSON* easing_item = cJSON_GetObjectItem(servo_item, "easing");
+                if (easing_item && cJSON_IsString(easing_item) &&
+                    !timeline::parseEasingName(cJSON_GetStringValue(easing_item), motion.easing))
+                {
+                    ESP_LOGW(TAG, "未知的 easing: %s，使用 linear",
+                             cJSON_GetStringValue(easing_item));
+                }
+
                 motions.push_back(motion);
                 ESP_LOGI(TAG, "解析第%d步: %s -> ch%d, start=%lums, angle=%d°, duration=%lums",
                          step_count, motion.move_part.c_str(), motion.channel, motion.start_time, motion.angle,
@@ -782,7 +855,7 @@ namespace app
             return true;
         }
 
-        bool executeMovements(const std::vector<ServoMotion>& motions, uint32_t update_interval_ms)
+        bool MotionPlayer::begin(std::vector<ServoMotion> motions, const int32_t* start_values)
         {
             if (motions.empty())
             {
@@ -796,203 +869,138 @@ namespace app
                 return false;
             }
 
-            // 检查是否需要初始化 b2 电机
-            bool need_motor_b2 = false;
+            // 通道号和电机标志在这里解析一次，节拍中不再比较字符串
+            std::vector<timeline::Keyframe> keyframes;
+            keyframes.reserve(motions.size());
             for (const auto& motion : motions)
             {
-                if (motion.move_part == "b2")
+                bool motor = motion.channel == 254; // b2 是直流电机
+                if (!motor && motion.channel >= PCA9685::CHANNEL_COUNT)
                 {
-                    need_motor_b2 = true;
-                    break;
+                    continue;
                 }
+
+                timeline::Keyframe keyframe;
+                keyframe.channel    = motion.channel;
+                keyframe.motor      = motor;
+                keyframe.start_time = motion.start_time;
+                keyframe.duration   = motion.duration;
+                keyframe.value      = motion.angle;
+                keyframe.easing     = motion.easing;
+                keyframes.push_back(keyframe);
+            }
+
+            if (!timeline_.compile(keyframes, start_values))
+            {
+                ESP_LOGE(TAG, "编译运动时间线失败");
+                return false;
             }
 
-            if (need_motor_b2 && !motor_b2_initialized_)
+            track_mask_ = 0;
+            dirty_mask_ = 0;
+            for (size_t slot = 0; slot < timeline::MAX_TRACKS; slot++)
+            {
+                values_[slot] = start_values ? start_values[slot]
+                                             : timeline::REST_VALUE * timeline::Q8_ONE;
+            }
+            for (const auto& keyframe : keyframes)
+            {
+                track_mask_ |= 1u << timeline::getSlot(keyframe.channel, keyframe.motor);
+            }
+
+            if (timeline_.hasMotor() && !motor_b2_initialized_)
             {
                 if (!initMotorB2())
                 {
                     ESP_LOGE(TAG, "b2 电机初始化失败");
+                    timeline_.clear();
                     return false;
                 }
             }
+            return true;
+        }
 
-            // 计算总时长（最后一个动作的开始时间 + 持续时间）
-            uint32_t total_duration = 0;
-            for (const auto& motion : motions)
+        bool MotionPlayer::advance(uint32_t current_time)
+        {
+            size_t count = timeline_.sample(current_time, samples_);
+            dirty_mask_  = 0;
+            for (size_t i = 0; i < count; i++)
             {
-                uint32_t end_time = motion.start_time + motion.duration;
-                if (end_time > total_duration)
-                {
-                    total_duration = end_time;
-                }
+                size_t slot   = timeline::getSlot(samples_[i].channel, samples_[i].motor);
+                values_[slot] = samples_[i].value;
+                dirty_mask_ |= 1u << slot;
             }
+            return current_time < timeline_.getDuration();
+        }
 
-            ESP_LOGI(TAG, "开始执行运动序列，总时长: %lu ms，更新间隔: %lu ms", total_duration,
-                     update_interval_ms);
-
-            // 记录每个通道的起始角度（假设当前角度为90度）
-            uint8_t start_angles[16] = {90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90, 90};
-
-            // 记录 b2 电机的起始速度（0%）
-            float start_speed_b2 = 0.0f;
-
-            // 记录每个通道当前正在执行的运动
-            struct ChannelState
-            {
-                bool     is_active;
-                uint32_t start_time;
-                uint32_t duration;
-                uint8_t  start_angle;
-                uint8_t  target_angle;
-            };
-            ChannelState channel_states[16] = {};
+        bool MotionPlayer::update(uint32_t current_time)
+        {
+            bool active = advance(current_time);
+            output(values_, dirty_mask_);
+            return active;
+        }
 
-            // b2 电机状态（速度控制）
-            struct MotorB2State
+        void MotionPlayer::finish()
+        {
+            // 确保所有运动都到达最终位置
+            size_t count = timeline_.getFinalValues(samples_);
+            for (size_t i = 0; i < count; i++)
             {
-                bool     is_active;
-                uint32_t start_time;
-                uint32_t duration;
-                float    start_speed;  // 起始速度百分比
-                float    target_speed; // 目标速度百分比
-            };
-            MotorB2State motor_b2_state = {};
-
-            uint32_t current_time = 0;
+                size_t slot   = timeline::getSlot(samples_[i].channel, samples_[i].motor);
+                values_[slot] = samples_[i].value;
+            }
+            output(values_, track_mask_);
+        }
 
-            while (current_time <= total_duration)
+        void MotionPlayer::output(const int32_t* values, uint32_t mask)
+        {
+            PCA9685::ServoFrame frame;
+            for (uint8_t ch = 0; ch < PCA9685::CHANNEL_COUNT; ch++)
             {
-                // 检查是否有新的运动需要开始
-                for (const auto& motion : motions)
-                {
-                    // 处理 b2 电机（特殊处理）
-                    if (motion.move_part == "b2")
-                    {
-                        if (motion.start_time <= current_time &&
-                            current_time < motion.start_time + motion.duration)
-                        {
-                            // 运动正在进行中，更新电机状态
-                            if (!motor_b2_state.is_active ||
-                                motor_b2_state.start_time != motion.start_time)
-                            {
-                                // 新运动开始
-                                motor_b2_state.is_active = true;
-                                motor_b2_state.start_time = motion.start_time;
-                                motor_b2_state.duration = motion.duration;
-                                motor_b2_state.start_speed = start_speed_b2;
-                                // angle (0-180) 映射到速度 (-100% ~ 100%)
-                                // 0 -> -100%, 90 -> 0%, 180 -> 100%
-                                float speed_percent = ((motion.angle / 180.0f) - 0.5f) * 200.0f;
-                                motor_b2_state.target_speed = speed_percent;
-                            }
-                        }
-                        else if (current_time >= motion.start_time + motion.duration)
-                        {
-                            // 运动已完成，更新起始速度为最终速度
-                            if (motor_b2_state.start_time == motion.start_time)
-                            {
-                                float speed_percent = ((motion.angle / 180.0f) - 0.5f) * 200.0f;
-                                start_speed_b2 = speed_percent;
-                                motor_b2_state.is_active = false;
-                            }
-                        }
-                    }
-                    // 处理舵机通道（h1, h2, b1）
-                    else if (motion.channel < 16)
-                    {
-                        if (motion.start_time <= current_time &&
-                            current_time < motion.start_time + motion.duration)
-                        {
-                            // 运动正在进行中，更新通道状态
-                            if (!channel_states[motion.channel].is_active ||
-                                channel_states[motion.channel].start_time != motion.start_time)
-                            {
-                                // 新运动开始
-                                channel_states[motion.channel].is_active   = true;
-                                channel_states[motion.channel].start_time   = motion.start_time;
-                                channel_states[motion.channel].duration    = motion.duration;
-                                channel_states[motion.channel].start_angle = start_angles[motion.channel];
-                                channel_states[motion.channel].target_angle = motion.angle;
-                            }
-                        }
-                        else if (current_time >= motion.start_time + motion.duration)
-                        {
-                            // 运动已完成，更新起始角度为最终角度
-                            if (channel_states[motion.channel].start_time == motion.start_time)
-                            {
-                                start_angles[motion.channel] = motion.angle;
-                                channel_states[motion.channel].is_active = false;
-                            }
-                        }
-                    }
-                }
-
-                // 更新所有活跃通道的角度（线性插值）
-                for (int ch = 0; ch < 16; ch++)
+                if ((mask & (1u << ch)) != 0)
                 {
-                    if (channel_states[ch].is_active)
-                    {
-                        uint32_t elapsed = current_time - channel_states[ch].start_time;
-                        if (elapsed >= channel_states[ch].duration)
-                        {
-                            // 运动完成，设置为目标角度
-                            PCA9685::setServoAngle(ch, channel_states[ch].target_angle);
-                            channel_states[ch].is_active = false;
-                            start_angles[ch]             = channel_states[ch].target_angle;
-                        }
-                        else
-                        {
-                            // 线性插值计算当前角度
-                            float progress = static_cast<float>(elapsed) / static_cast<float>(channel_states[ch].duration);
-                            float current_angle = channel_states[ch].start_angle +
-                                                  ((channel_states[ch].target_angle - channel_states[ch].start_angle) *
-                                                      progress);
-                            PCA9685::setServoAngle(ch, static_cast<uint8_t>(std::round(current_angle)));
-                        }
-                    }
+                    // Q8 角度四舍五入到整数度后查表
+                    int32_t angle = (values[ch] + timeline::Q8_ONE / 2) / timeline::Q8_ONE;
+                    frame.set(ch, PCA9685::angleToCount(static_cast<uint8_t>(angle)));
                 }
+            }
+            PCA9685::writeFrame(frame);
 
-                // 更新 b2 电机的速度（线性插值）
-                if (motor_b2_state.is_active)
-                {
-                    uint32_t elapsed = current_time - motor_b2_state.start_time;
-                    if (elapsed >= motor_b2_state.duration)
-                    {
-                        // 运动完成，设置为目标速度
-                        setMotorB2Speed(motor_b2_state.target_speed);
-                        motor_b2_state.is_active = false;
-                        start_speed_b2 = motor_b2_state.target_speed;
-                    }
-                    else
-                    {
-                        // 线性插值计算当前速度
-                        float progress = static_cast<float>(elapsed) / static_cast<float>(motor_b2_state.duration);
-                        float current_speed = motor_b2_state.start_speed +
-                                              ((motor_b2_state.target_speed - motor_b2_state.start_speed) * progress);
-                        setMotorB2Speed(current_speed);
-                    }
-                }
+            if ((mask & (1u << timeline::MOTOR_SLOT)) != 0)
+            {
+                // b2 电机：angle (0-180) 映射到速度 (-100% ~ 100%)
+                // 0 -> -100%, 90 -> 0%, 180 -> 100%
+                float angle = static_cast<float>(values[timeline::MOTOR_SLOT]) / timeline::Q8_ONE;
+                setMotorB2Speed(((angle / 180.0f) - 0.5f) * 200.0f);
+            }
+        }
 
-                vTaskDelay(pdMS_TO_TICKS(update_interval_ms));
-                current_time += update_interval_ms;
+        bool executeMovements(const std::vector<ServoMotion>& motions, uint32_t update_interval_ms)
+        {
+            MotionPlayer player;
+            if (!player.begin(motions))
+            {
+                return false;
             }
 
-            // 确保所有运动都到达最终位置
-            for (const auto& motion : motions)
+            ESP_LOGI(TAG, "开始执行运动序列，总时长: %lu ms，更新间隔: %lu ms",
+                     player.getTotalDuration(), update_interval_ms);
+
+            // 按绝对截止时间推进，序列时间取自实际时钟，I2C 写入和计算耗时不会累积成漂移
+            const TickType_t period    = std::max<TickType_t>(pdMS_TO_TICKS(update_interval_ms), 1);
+            TickType_t       last_wake = xTaskGetTickCount();
+            int64_t          start_us  = esp_timer_get_time();
+            while (player.update(static_cast<uint32_t>((esp_timer_get_time() - start_us) / 1000)))
             {
-                if (motion.move_part == "b2")
-                {
-                    // b2 电机：angle (0-180) 映射到速度 (-100% ~ 100%)
-                    float speed_percent = ((motion.angle / 180.0f) - 0.5f) * 200.0f;
-                    setMotorB2Speed(speed_percent);
-                }
-                else if (motion.channel < 16)
+                if (xTaskDelayUntil(&last_wake, period) == pdFALSE)
                 {
-                    // 舵机通道
-                    PCA9685::setServoAngle(motion.channel, motion.angle);
+                    // 已错过截止时间，不补偿错过的节拍
+                    last_wake = xTaskGetTickCount();
                 }
             }
 
+            player.finish();
+
             ESP_LOGI(TAG, "运动序列执行完成");
             return true;
         }
@@ -5,6 +5,8 @@
 #include <vector>
 #include <driver/i2c_master.h>
 #include "cJSON.h"
+#include "i2c/scheduler/scheduler.hpp"
+#include "move/timeline/timeline.hpp"
 
 namespace app
 {
@@ -23,6 +25,32 @@ namespace app
             /// PCA9685 默认 I2C 地址（Adafruit 板卡通常为 0x40，可通过焊盘修改）
             static constexpr uint8_t DEFAULT_I2C_ADDR = 0x44;
 
+            static constexpr uint8_t CHANNEL_COUNT = 16;  // PWM 通道数
+            static constexpr uint8_t MAX_ANGLE     = 180; // 舵机最大角度
+
+            /**
+             * @brief 一帧舵机输出（on 固定为 0，只记录 off 计数）
+             */
+            struct ServoFrame
+            {
+                uint16_t counts[CHANNEL_COUNT]; // 各通道 off 计数（0~4095）
+                uint16_t mask;                  // 本帧需要输出的通道位图
+
+                ServoFrame() : counts{}, mask(0) {}
+
+                /**
+                 * @brief 设置一个通道的计数（越界通道被忽略，计数上限 4095）
+                 */
+                void set(uint8_t channel, uint16_t count)
+                {
+                    if (channel < CHANNEL_COUNT)
+                    {
+                        counts[channel] = count < 4095 ? count : 4095;
+                        mask |= static_cast<uint16_t>(1u << channel);
+                    }
+                }
+            };
+
             /**
              * @brief 初始化 PCA9685 设备
              * @param bus_handle 已经初始化好的 I2C master bus 句柄（从 app::i2c::I2c::getBusHandle() 获取）
@@ -84,21 +112,27 @@ namespace app
                                       float   freq_hz      = 50.0f);
 
             /**
-             * @brief 缓动函数类型枚举
+             * @brief 角度转换为 off 计数（查表，脉宽范围 500~2500us）
+             * @param angle_deg 角度（0~180，超出按 180 处理）
+             * @return off 计数，频率尚未设置时返回 0
              */
-            enum class EasingType
-            {
-                LINEAR,      // 线性（匀速）
-                EASE_IN,     // 缓入（开始慢，逐渐加速）
-                EASE_OUT,    // 缓出（开始快，逐渐减速）
-                EASE_IN_OUT, // 缓入缓出（开始慢，中间快，结束慢）
-                EASE_IN_QUAD,  // 二次缓入
-                EASE_OUT_QUAD,  // 二次缓出
-                EASE_IN_OUT_QUAD, // 二次缓入缓出
-                EASE_IN_CUBIC,   // 三次缓入
-                EASE_OUT_CUBIC,  // 三次缓出
-                EASE_IN_OUT_CUBIC // 三次缓入缓出
-            };
+            static uint16_t angleToCount(uint8_t angle_deg);
+
+            /**
+             * @brief 输出一帧舵机计数
+             *
+             * 与上次写入值相同的通道被跳过；发生变化的通道用一次自动递增写入
+             * （LEDn_ON_L ~ LEDm_OFF_H）一起更新，所有舵机在同一个 PWM 周期生效。
+             *
+             * @param frame 舵机帧
+             * @return true 成功（包括无变化），false 失败
+             */
+            static bool writeFrame(const ServoFrame& frame);
+
+            /**
+             * @brief 缓动函数类型枚举（与运动时间线共用同一套查找表曲线）
+             */
+            using EasingType = timeline::Easing;
 
             /**
              * @brief 舵机变速转动（支持缓动函数）
@@ -138,9 +172,31 @@ namespace app
             static i2c_master_dev_handle_t dev_handle_;
             static uint8_t                 i2c_addr_;
 
+            // I2C 调度器中的设备 ID
+            static i2c::scheduler::DeviceId i2c_device_;
+
             // 内部缓存当前 PWM 频率，用于角度到脉宽的转换
             static float current_freq_hz_;
 
+            // 寄存器中的 off 计数未知（复位后或 on 不为 0）
+            static constexpr uint16_t COUNT_UNKNOWN = 0xFFFF;
+
+            // 当前频率下 0~180 度对应的 off 计数，设置频率时生成
+            static uint16_t servo_counts_[MAX_ANGLE + 1];
+
+            // 各通道最近写入的 off 计数（on 为 0 时有效），用于跳过未变化的通道
+            static uint16_t channel_counts_[CHANNEL_COUNT];
+
+            /**
+             * @brief 按频率生成角度计数表（定点运算）
+             */
+            static void buildServoTable(float freq_hz);
+
+            /**
+             * @brief 用一次自动递增写入输出 first ~ last 通道
+             */
+            static bool writeChannels(const ServoFrame& frame, uint8_t first, uint8_t last);
+
             /**
              * @brief 读取一个 8 位寄存器
              */
@@ -157,11 +213,95 @@ namespace app
          */
         struct ServoMotion
         {
-            std::string move_part;  // 运动部位标识 (h1, h2, b1, b2等)
-            uint8_t     channel;    // 对应的PCA9685通道号 (0-15)
-            uint32_t    start_time; // 起始时间（毫秒，相对于第一个动作）
-            uint8_t     angle;      // 目标角度 (0-180)
-            uint32_t    duration;   // 持续时间（毫秒）
+            std::string      move_part;  // 运动部位标识 (h1, h2, b1, b2等)
+            uint8_t          channel;    // 对应的PCA9685通道号 (0-15)
+            uint32_t         start_time; // 起始时间（毫秒，相对于第一个动作）
+            uint8_t          angle;      // 目标角度 (0-180)
+            uint32_t         duration;   // 持续时间（毫秒）
+
+            // 缓动类型（JSON 中的 easing 字段，缺省为线性）
+            timeline::Easing easing = timeline::Easing::LINEAR;
+        };
+
+        /**
+         * @brief 运动序列播放器（按时间点推进，不阻塞）
+         *
+         * begin() 把运动序列编译成 timeline::Timeline（每个通道一条按时间排序的轨道），
+         * 调用方按自己的节拍调用 update() 推进到指定时间，每个节拍只计算各通道当前所在的段，
+         * 推进间隔不影响轨迹（插值只取决于传入的时间）。
+         * 只调用 advance() 时不输出，调用方可以把多个播放器的值混合后再用 output() 写出。
+         * executeMovements() 和运动引擎任务都基于它实现。
+         */
+        class MotionPlayer
+        {
+        public:
+            /**
+             * @brief 载入并编译运动序列（需要时初始化 b2 电机）
+             * @param motions 运动信息列表（顺序不限）
+             * @param start_values 各通道的起始值（Q8，按 timeline::getSlot() 索引），
+             *                     为空时假定舵机居中、电机停止
+             * @return true 成功，false 序列为空或设备未就绪
+             */
+            bool begin(std::vector<ServoMotion> motions, const int32_t* start_values = nullptr);
+
+            /**
+             * @brief 推进到指定时间，只更新各通道的值，不输出
+             * @param current_time 序列内时间（毫秒，相对于第一个动作）
+             * @return true 序列仍在进行，false 已到达总时长
+             */
+            bool advance(uint32_t current_time);
+
+            /**
+             * @brief 推进到指定时间并输出值发生变化的通道
+             * @param current_time 序列内时间（毫秒，相对于第一个动作）
+             * @return true 序列仍在进行，false 已到达总时长
+             */
+            bool update(uint32_t current_time);
+
+            /**
+             * @brief 将所有通道设置到最终位置
+             */
+            void finish();
+
+            /**
+             * @brief 获取序列总时长（毫秒）
+             */
+            uint32_t getTotalDuration() const
+            {
+                return timeline_.getDuration();
+            }
+
+            /**
+             * @brief 各通道当前值（Q8，按 timeline::getSlot() 索引，长度 timeline::MAX_TRACKS）
+             *
+             * 序列未涉及或尚未开始的通道保持 begin() 时的起始值。
+             */
+            const int32_t* getValues() const
+            {
+                return values_;
+            }
+
+            /**
+             * @brief 序列涉及的通道位图（bit i 对应 getSlot() 下标 i）
+             */
+            uint32_t getTrackMask() const
+            {
+                return track_mask_;
+            }
+
+            /**
+             * @brief 输出通道值：舵机通道合成一帧写入，电机单独设置速度
+             * @param values 各通道值（Q8，按 timeline::getSlot() 索引）
+             * @param mask 需要输出的通道位图
+             */
+            static void output(const int32_t* values, uint32_t mask);
+
+        private:
+            timeline::Timeline timeline_;
+            timeline::Sample   samples_[timeline::MAX_TRACKS];
+            int32_t            values_[timeline::MAX_TRACKS] = {};
+            uint32_t           track_mask_                   = 0;
+            uint32_t           dirty_mask_                   = 0; // 最近一次 advance() 中变化的通道
         };
 
         /**
@@ -180,7 +320,8 @@ namespace app
         bool parseMovementJson(const std::string& json_str, std::vector<ServoMotion>& motions);
 
         /**
-         * @brief 执行运动序列（按照时间轴协调多个舵机运动）
+         * @brief 执行运动序列（按照时间轴协调多个舵机运动，阻塞到序列结束）
+         * @note 不希望阻塞调用任务时使用 engine::MotionEngine::submit()
          * @param motions 运动信息列表
          * @param update_interval_ms 更新间隔（毫秒），越小越平滑但CPU占用越高
          * @return true 执行成功，false 执行失败
@@ -216,17 +357,29 @@ namespace app
 // 【PCA9685 类 - 舵机角度控制】
 //   - setServoAngle()           : 按角度控制舵机（内部转换为 PWM 脉宽，0~180度）
 //   - setServoAngleWithEasing() : 舵机变速转动（支持10种缓动函数，实现平滑运动）
+//   - angleToCount()            : 角度查表转换为 off 计数
+//   - writeFrame()              : 一次 I2C 写入输出一帧多通道计数（跳过未变化的通道）
 //
 // 【PCA9685 类 - 内部寄存器操作（私有）】
 //   - read8()                   : 读取一个 8 位寄存器
 //   - write8()                  : 写入一个 8 位寄存器
+//   - buildServoTable()         : 设置频率时生成角度计数表
+//   - writeChannels()           : 自动递增写入连续的多个通道
 //
 // 【全局函数 - 运动数据解析与执行】
 //   - mapMovePartToChannel()    : 运动部位到通道号的映射（h1->0, h2->1, b1->2, h3->3, b2->254）
 //   - parseMovementJson()       : 从JSON字符串解析运动数据（支持任意数量的servo_XX配置）
 //   - executeMovements()        : 执行运动序列（按照时间轴协调多个舵机/电机运动）
 //
+// 【MotionPlayer 类 - 非阻塞播放】
+//   - begin()                   : 载入运动序列并编译成时间线，需要时初始化 b2 电机
+//   - advance()                 : 推进到指定时间，只更新各通道的值（供运动引擎混合）
+//   - update()                  : 推进到指定时间，只计算各通道当前所在的段，合成一帧输出（不阻塞）
+//   - output()                  : 输出通道值（舵机合成一帧，电机设置速度）
+//   - finish()                  : 将所有通道设置到最终位置
+//
 // 【数据结构】
+//   - ServoFrame                : 一帧多通道舵机计数（counts + 通道位图）
 //   - ServoMotion               : 单个舵机运动信息结构体（move_part, channel, start_time, angle, duration）
 //   - EasingType                : 缓动函数类型枚举（LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT等10种）
 //
@@ -235,7 +388,7 @@ namespace app
 // ============================================================================
 //
 // 【枚举类型 - EasingType】
-//   定义在 PCA9685 类内部，包含10种缓动函数类型：
+//   PCA9685::EasingType 是 timeline::Easing 的别名，包含10种缓动函数类型：
 //   - LINEAR              : 线性（匀速运动，t）
 //   - EASE_IN             : 缓入（开始慢，逐渐加速，t²）
 //   - EASE_OUT            : 缓出（开始快，逐渐减速，1-(1-t)²）
@@ -273,10 +426,14 @@ namespace app
 //     - type : 缓动类型（EasingType 枚举）
 //   返回值：缓动后的进度值 (0.0~1.0)
 //   说明：
-//     - 根据不同的 EasingType 应用不同的数学公式
+//     - 查 timeline::ease() 的 Q15 查找表（编译期由上面的公式生成）
 //     - 输入 t 会被限制在 0.0~1.0 范围内
 //     - 输出值也在 0.0~1.0 范围内
 //
+// 【JSON 中的 easing 字段】
+//   mov_info 的每一步可以带可选的 "easing" 字段，取值为上面枚举的小写形式
+//   （如 "ease_in_out_cubic"），缺省或无法识别时按 "linear" 处理
+//
 // 【使用示例】
 //   // 线性转动：45度 -> 135度，持续2秒
 //   PCA9685::setServoAngleWithEasing(0, 45.0f, 135.0f, 2000, 
@@ -0,0 +1,320 @@
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace app
+{
+    namespace move
+    {
+        namespace timeline
+        {
+            namespace
+            {
+                constexpr int32_t LUT_STEP = Q15_ONE / static_cast<int32_t>(LUT_SEGMENTS);
+
+                // 缓动曲线的浮点定义，只在编译期生成查找表时使用
+                constexpr double curve(Easing type, double t)
+                {
+                    switch (type)
+                    {
+                    case Easing::EASE_IN:
+                    case Easing::EASE_IN_QUAD:
+                        return t * t;
+                    case Easing::EASE_OUT:
+                    case Easing::EASE_OUT_QUAD:
+                        return 1.0 - ((1.0 - t) * (1.0 - t));
+                    case Easing::EASE_IN_OUT:
+                    case Easing::EASE_IN_OUT_QUAD:
+                        if (t < 0.5)
+                        {
+                            return 2.0 * t * t;
+                        }
+                        return 1.0 - (0.5 * (2.0 - (2.0 * t)) * (2.0 - (2.0 * t)));
+                    case Easing::EASE_IN_CUBIC:
+                        return t * t * t;
+                    case Easing::EASE_OUT_CUBIC:
+                        return 1.0 - ((1.0 - t) * (1.0 - t) * (1.0 - t));
+                    case Easing::EASE_IN_OUT_CUBIC:
+                        if (t < 0.5)
+                        {
+                            return 4.0 * t * t * t;
+                        }
+                        return 1.0 - (0.5 * (2.0 - (2.0 * t)) * (2.0 - (2.0 * t)) *
+                                      (2.0 - (2.0 * t)));
+                    default:
+                        return t;
+                    }
+                }
+
+                struct EasingLut
+                {
+                    uint16_t values[EASING_COUNT][LUT_SEGMENTS + 1]; // Q15
+                };
+
+                constexpr EasingLut buildLut()
+                {
+                    EasingLut lut{};
+                    for (size_t e = 0; e < EASING_COUNT; e++)
+                    {
+                        for (size_t i = 0; i <= LUT_SEGMENTS; i++)
+                        {
+                            double t = static_cast<double>(i) / LUT_SEGMENTS;
+                            double v = curve(static_cast<Easing>(e), t) * Q15_ONE + 0.5;
+                            lut.values[e][i] = static_cast<uint16_t>(v);
+                        }
+                    }
+                    return lut;
+                }
+
+                // 每种曲线 65 个点，共约 1.3KB，放在 Flash 中
+                constexpr EasingLut EASING_LUT = buildLut();
+
+                // 与 Easing 的顺序一致
+                const char* const EASING_NAMES[EASING_COUNT] = {
+                    "linear",
+                    "ease_in",
+                    "ease_out",
+                    "ease_in_out",
+                    "ease_in_quad",
+                    "ease_out_quad",
+                    "ease_in_out_quad",
+                    "ease_in_cubic",
+                    "ease_out_cubic",
+                    "ease_in_out_cubic",
+                };
+            } // namespace
+
+            int32_t ease(Easing type, int32_t progress)
+            {
+                size_t index = static_cast<size_t>(type);
+                if (index >= EASING_COUNT)
+                {
+                    index = 0; // 未知类型按线性处理
+                }
+                if (progress <= 0)
+                {
+                    return 0;
+                }
+                if (progress >= Q15_ONE)
+                {
+                    return Q15_ONE;
+                }
+
+                const uint16_t* lut  = EASING_LUT.values[index];
+                int32_t         i    = progress / LUT_STEP;
+                int32_t         frac = progress % LUT_STEP;
+                return lut[i] + ((lut[i + 1] - lut[i]) * frac) / LUT_STEP;
+            }
+
+            const char* getEasingName(Easing type)
+            {
+                size_t index = static_cast<size_t>(type);
+                return index < EASING_COUNT ? EASING_NAMES[index] : "unknown";
+            }
+
+            bool parseEasingName(const char* name, Easing& type)
+            {
+                if (name == nullptr)
+                {
+                    return false;
+                }
+                for (size_t i = 0; i < EASING_COUNT; i++)
+                {
+                    if (strcmp(name, EASING_NAMES[i]) == 0)
+                    {
+                        type = static_cast<Easing>(i);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool Timeline::compile(const std::vector<Keyframe>& keyframes,
+                                   const int32_t*               start_values)
+            {
+                clear();
+                if (keyframes.empty())
+                {
+                    return false;
+                }
+
+                // 按 (电机, 通道, 起始时间) 排序；稳定排序保证同一时刻的关键帧保持原有顺序
+                std::vector<const Keyframe*> order;
+                order.reserve(keyframes.size());
+                for (const auto& keyframe : keyframes)
+                {
+                    order.push_back(&keyframe);
+                }
+                std::stable_sort(order.begin(), order.end(),
+                                 [](const Keyframe* a, const Keyframe* b)
+                                 {
+                                     if (a->motor != b->motor)
+                                     {
+                                         return a->motor < b->motor;
+                                     }
+                                     if (a->channel != b->channel)
+                                     {
+                                         return a->channel < b->channel;
+                                     }
+                                     return a->start_time < b->start_time;
+                                 });
+
+                segments_.reserve(keyframes.size());
+                for (const Keyframe* keyframe : order)
+                {
+                    if (!keyframe->motor && keyframe->channel >= MOTOR_SLOT)
+                    {
+                        clear();
+                        return false;
+                    }
+
+                    size_t  slot      = getSlot(keyframe->channel, keyframe->motor);
+                    int32_t from      = start_values ? start_values[slot] : REST_VALUE * Q8_ONE;
+                    bool    new_track = tracks_.empty() ||
+                                     tracks_.back().channel != keyframe->channel ||
+                                     tracks_.back().motor != keyframe->motor;
+                    if (new_track)
+                    {
+                        if (tracks_.size() >= MAX_TRACKS)
+                        {
+                            clear();
+                            return false;
+                        }
+
+                        Track track   = {};
+                        track.channel = keyframe->channel;
+                        track.motor   = keyframe->motor;
+                        track.first   = static_cast<uint32_t>(segments_.size());
+                        tracks_.push_back(track);
+                    }
+                    else
+                    {
+                        // 上一段尚未结束时在此截止，从它此刻的值继续，避免跳变
+                        Segment& previous = segments_.back();
+                        if (previous.end > keyframe->start_time)
+                        {
+                            from         = valueAt(previous, keyframe->start_time);
+                            previous.end = keyframe->start_time;
+                        }
+                        else
+                        {
+                            from = previous.to;
+                        }
+                    }
+
+                    Segment segment;
+                    segment.start  = keyframe->start_time;
+                    segment.end    = keyframe->start_time + keyframe->duration;
+                    segment.span   = keyframe->duration;
+                    segment.from   = from;
+                    segment.to     = std::min<int32_t>(keyframe->value, 180) * Q8_ONE;
+                    segment.easing = keyframe->easing;
+                    segments_.push_back(segment);
+
+                    tracks_.back().last = static_cast<uint32_t>(segments_.size());
+                    duration_           = std::max(duration_, segment.end);
+                }
+
+                rewind();
+                return true;
+            }
+
+            void Timeline::clear()
+            {
+                tracks_.clear();
+                segments_.clear();
+                duration_ = 0;
+            }
+
+            void Timeline::rewind()
+            {
+                for (auto& track : tracks_)
+                {
+                    track.cursor     = track.first;
+                    track.output     = 0;
+                    track.has_output = false;
+                }
+            }
+
+            size_t Timeline::sample(uint32_t time_ms, Sample* out)
+            {
+                size_t count = 0;
+                for (auto& track : tracks_)
+                {
+                    // 跳过已经结束的段
+                    while (track.cursor < track.last && segments_[track.cursor].end <= time_ms)
+                    {
+                        track.cursor++;
+                    }
+
+                    int32_t value = 0;
+                    if (track.cursor < track.last && segments_[track.cursor].start <= time_ms)
+                    {
+                        value = valueAt(segments_[track.cursor], time_ms);
+                    }
+                    else if (track.cursor > track.first)
+                    {
+                        value = segments_[track.cursor - 1].to; // 段间空隙保持上一段的目标值
+                    }
+                    else
+                    {
+                        continue; // 第一段尚未开始
+                    }
+
+                    if (track.has_output && value == track.output)
+                    {
+                        continue;
+                    }
+                    track.output     = value;
+                    track.has_output = true;
+                    out[count++]     = {track.channel, track.motor, value};
+                }
+                return count;
+            }
+
+            size_t Timeline::getFinalValues(Sample* out) const
+            {
+                size_t count = 0;
+                for (const auto& track : tracks_)
+                {
+                    out[count++] = {track.channel, track.motor, segments_[track.last - 1].to};
+                }
+                return count;
+            }
+
+            bool Timeline::hasMotor() const
+            {
+                for (const auto& track : tracks_)
+                {
+                    if (track.motor)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            int32_t Timeline::valueAt(const Segment& segment, uint32_t time_ms)
+            {
+                if (time_ms <= segment.start)
+                {
+                    return segment.from;
+                }
+                uint32_t elapsed = time_ms - segment.start;
+                if (elapsed >= segment.span)
+                {
+                    return segment.to;
+                }
+
+                // 进度和插值结果都四舍五入，避免截断误差累积成单向偏差
+                int32_t progress = static_cast<int32_t>(
+                    (static_cast<uint64_t>(elapsed) * Q15_ONE + segment.span / 2) / segment.span);
+                int32_t delta = (segment.to - segment.from) * ease(segment.easing, progress);
+                delta         = (delta >= 0 ? delta + Q15_ONE / 2 : delta - Q15_ONE / 2) / Q15_ONE;
+                return segment.from + delta;
+            }
+
+        } // namespace timeline
+    } // namespace move
+} // namespace app
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace app
+{
+    namespace move
+    {
+        namespace timeline
+        {
+            // 定点数格式：角度值为 Q8（1 度 = 256），进度为 Q15（1.0 = 32768）
+            constexpr int32_t Q8_ONE  = 256;
+            constexpr int32_t Q15_ONE = 32768;
+
+            constexpr size_t  MAX_TRACKS   = 17; // 16 个舵机通道 + 1 个电机
+            constexpr size_t  MOTOR_SLOT   = 16; // 电机在按通道索引的数组中的下标
+            constexpr uint8_t REST_VALUE   = 90; // 未提供起始值时的假定值（舵机居中、电机停止）
+            constexpr size_t  LUT_SEGMENTS = 64; // 缓动查找表分段数
+
+            /**
+             * @brief 通道在按通道索引的数组（长度 MAX_TRACKS）中的下标
+             * @return 舵机为通道号，电机为 MOTOR_SLOT
+             */
+            inline size_t getSlot(uint8_t channel, bool motor)
+            {
+                return motor ? MOTOR_SLOT : channel;
+            }
+
+            /**
+             * @brief 缓动函数类型
+             */
+            enum class Easing : uint8_t
+            {
+                LINEAR,            // 线性（匀速）
+                EASE_IN,           // 缓入（开始慢，逐渐加速）
+                EASE_OUT,          // 缓出（开始快，逐渐减速）
+                EASE_IN_OUT,       // 缓入缓出（开始慢，中间快，结束慢）
+                EASE_IN_QUAD,      // 二次缓入
+                EASE_OUT_QUAD,     // 二次缓出
+                EASE_IN_OUT_QUAD,  // 二次缓入缓出
+                EASE_IN_CUBIC,     // 三次缓入
+                EASE_OUT_CUBIC,    // 三次缓出
+                EASE_IN_OUT_CUBIC, // 三次缓入缓出
+                COUNT
+            };
+
+            constexpr size_t EASING_COUNT = static_cast<size_t>(Easing::COUNT);
+
+            /**
+             * @brief 计算缓动后的进度（查表 + 线性插值）
+             * @param type 缓动类型
+             * @param progress 线性进度（Q15，0 ~ Q15_ONE，超出范围会被截断）
+             * @return 缓动后的进度（Q15）
+             */
+            int32_t ease(Easing type, int32_t progress);
+
+            /**
+             * @brief 获取缓动类型名称（与 JSON 中的 easing 字段一致，如 "ease_in_out"）
+             */
+            const char* getEasingName(Easing type);
+
+            /**
+             * @brief 按名称查找缓动类型
+             * @param name 缓动类型名称
+             * @param type 输出：缓动类型
+             * @return true 找到, false 未知名称
+             */
+            bool parseEasingName(const char* name, Easing& type);
+
+            /**
+             * @brief 一个关键帧（从 start_time 开始，经过 duration 到达 value）
+             */
+            struct Keyframe
+            {
+                uint8_t  channel;    // 通道号
+                bool     motor;      // 是否为电机（值表示速度而不是角度）
+                uint32_t start_time; // 起始时间（毫秒，相对于序列开始）
+                uint32_t duration;   // 持续时间（毫秒）
+                uint8_t  value;      // 目标值（0 ~ 180）
+                Easing   easing;     // 缓动类型
+            };
+
+            /**
+             * @brief 编译后的运动段
+             */
+            struct Segment
+            {
+                uint32_t start;  // 起始时间（毫秒）
+                uint32_t end;    // 结束时间（毫秒，被下一段打断时提前）
+                uint32_t span;   // 原始持续时间（毫秒），用于计算进度
+                int32_t  from;   // 起始值（Q8）
+                int32_t  to;     // 目标值（Q8）
+                Easing   easing; // 缓动类型
+            };
+
+            /**
+             * @brief 一个通道的轨道（segments 中 [first, last) 范围内的段，按时间排序）
+             */
+            struct Track
+            {
+                uint8_t  channel;
+                bool     motor;
+                uint32_t first;  // 第一个段的下标
+                uint32_t last;   // 最后一个段之后的下标
+                uint32_t cursor; // 当前段的下标
+                int32_t  output; // 最近一次输出的值（Q8）
+                bool     has_output;
+            };
+
+            /**
+             * @brief 一次采样中值发生变化的通道
+             */
+            struct Sample
+            {
+                uint8_t channel;
+                bool    motor;
+                int32_t value; // 当前值（Q8）
+            };
+
+            /**
+             * @brief 运动时间线
+             *
+             * compile() 把按时间顺序描述的关键帧整理成每个通道一条轨道：通道号和电机标志在
+             * 编译时解析，段按起始时间排序，起始值取上一段在该时刻的值（被打断的段在下一段
+             * 开始处截止，不会跳变）。每条轨道第一段的起始值由调用方给出（通常是该通道当前
+             * 的输出值），新序列从实际位置开始而不是假定的居中位置。
+             *
+             * sample() 每条轨道只看游标所在的段，时间单调递增时游标只前进，单次采样的开销
+             * 与关键帧总数无关；只输出值发生变化的通道，已经结束的轨道不再重复输出。
+             *
+             * @note 非线程安全；sample() 的时间应单调不减，需要回到开头时调用 rewind()
+             */
+            class Timeline
+            {
+            public:
+                Timeline() = default;
+
+                /**
+                 * @brief 编译关键帧
+                 * @param keyframes 关键帧列表（顺序不限，同一时刻的关键帧以靠后者为准）
+                 * @param start_values 各通道的起始值（Q8，按 getSlot() 索引，长度 MAX_TRACKS），
+                 *                     为空时使用 REST_VALUE
+                 * @return true 成功, false 关键帧为空、舵机通道号越界或轨道数超过 MAX_TRACKS
+                 */
+                bool compile(const std::vector<Keyframe>& keyframes,
+                             const int32_t*               start_values = nullptr);
+
+                /**
+                 * @brief 清空时间线
+                 */
+                void clear();
+
+                /**
+                 * @brief 回到序列开头（保留编译结果）
+                 */
+                void rewind();
+
+                /**
+                 * @brief 采样指定时间的各通道值
+                 * @param time_ms 序列内时间（毫秒）
+                 * @param out 输出：值发生变化的通道，容量至少为 MAX_TRACKS
+                 * @return 输出的通道数
+                 */
+                size_t sample(uint32_t time_ms, Sample* out);
+
+                /**
+                 * @brief 获取各通道的最终值
+                 * @param out 输出：每条轨道一个，容量至少为 MAX_TRACKS
+                 * @return 轨道数
+                 */
+                size_t getFinalValues(Sample* out) const;
+
+                /**
+                 * @brief 序列总时长（最后一个关键帧的 start_time + duration）
+                 */
+                uint32_t getDuration() const
+                {
+                    return duration_;
+                }
+
+                /**
+                 * @brief 是否包含电机轨道
+                 */
+                bool hasMotor() const;
+
+                /**
+                 * @brief 轨道数
+                 */
+                size_t getTrackCount() const
+                {
+                    return tracks_.size();
+                }
+
+                /**
+                 * @brief 运动段总数
+                 */
+                size_t getSegmentCount() const
+                {
+                    return segments_.size();
+                }
+
+            private:
+                // 计算段在指定时间的值（time_ms 需在 [start, start + span] 内）
+                static int32_t valueAt(const Segment& segment, uint32_t time_ms);
+
+                std::vector<Track>   tracks_;
+                std::vector<Segment> segments_;
+                uint32_t             duration_ = 0;
+            };
+
+        } // namespace timeline
+    } // namespace move
+} // namespace app
@@ -376,20 +376,16 @@ namespace app
 
                 updateState(State::CONNECTING);
 
-                if (timeout_ms > 0 && !timeout_task_)
-                {
-                    app::sys::task::Config config;
-                    config.name       = "wifi_timeout";
-                    config.stack_size = 2048;
-                    config.priority   = app::sys::task::Priority::NORMAL;
-                    config.core_id    = -1;
-
-                    timeout_task_ =
-                        std::make_unique<app::sys::task::Task>(timeoutTaskWrapper, config, this);
-                    if (!timeout_task_->start())
+                if (timeout_ms > 0)
+                {
+                    // 多等 1 个 tick，保证到期时按 tick 计算的已用时间不小于超时时间
+                    clearTimeoutJob();
+                    timeout_job_ = app::sys::task::Executor::getInstance().postDelayed(
+                        "wifi_timeout", timeout_ms + portTICK_PERIOD_MS,
+                        [this]() { this->checkTimeout(); });
+                    if (!timeout_job_.isValid())
                     {
-                        ESP_LOGE(TAG, "创建超时任务失败");
-                        timeout_task_.reset();
+                        ESP_LOGE(TAG, "提交连接超时作业失败");
                     }
                 }
 
@@ -397,7 +393,7 @@ namespace app
                 if (ret != ESP_OK)
                 {
                     updateState(State::FAILED, FailureReason::CONNECTION_FAILED);
-                    clearTimeoutTask();
+                    clearTimeoutJob();
                     return false;
                 }
 
@@ -415,7 +411,7 @@ namespace app
 
                 disconnecting_       = true;
                 connect_timeout_set_ = false;
-                clearTimeoutTask();
+                clearTimeoutJob();
 
                 esp_wifi_disconnect();
             }
@@ -664,7 +660,7 @@ namespace app
                         static_cast<wifi_event_sta_disconnected_t*>(event_data.data);
 
                     connect_timeout_set_ = false;
-                    clearTimeoutTask();
+                    clearTimeoutJob();
 
                     if (disconnecting_)
                     {
@@ -757,19 +753,16 @@ namespace app
                     ip_event_got_ip_t* event = static_cast<ip_event_got_ip_t*>(event_data.data);
                     memcpy(info_.ip, &event->ip_info.ip.addr, 4);
                     connect_timeout_set_ = false;
-                    clearTimeoutTask();
+                    clearTimeoutJob();
 
                     updateState(State::CONNECTED);
                 }
             }
 
-            void WiFiManager::clearTimeoutTask()
+            void WiFiManager::clearTimeoutJob()
             {
-                if (timeout_task_)
-                {
-                    timeout_task_->destroy();
-                    timeout_task_.reset();
-                }
+                // 可能持有 mutex_，不等待正在执行的作业：checkTimeout() 会重新检查连接状态
+                timeout_job_.cancel();
             }
 
             void WiFiManager::updateState(State state, FailureReason reason)
@@ -822,28 +815,6 @@ namespace app
                 }
             }
 
-            void WiFiManager::timeoutTaskWrapper(void* param)
-            {
-                WiFiManager* manager = static_cast<WiFiManager*>(param);
-                if (!manager)
-                {
-                    return;
-                }
-
-                while (true)
-                {
-                    app::sys::task::TaskManager::delayMs(1000);
-                    manager->checkTimeout();
-
-                    std::lock_guard<std::mutex> lock(manager->mutex_);
-                    if (!manager->connect_timeout_set_ || manager->info_.state != State::CONNECTING)
-                    {
-                        // 任务会自动结束，不需要手动删除
-                        break;
-                    }
-                }
-            }
-
         } // namespace wifi
     } // namespace network
 } // namespace app
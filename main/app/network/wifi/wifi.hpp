@@ -8,7 +8,7 @@
 #include <vector>
 
 #include "event.hpp"
-#include "system/task/task.hpp"
+#include "system/task/executor/executor.hpp"
 
 extern "C"
 {
@@ -172,23 +172,21 @@ namespace app
 
                 void updateState(State state, FailureReason reason = FailureReason::NONE);
 
-                void clearTimeoutTask();
+                void clearTimeoutJob();
 
                 void checkTimeout();
 
-                static void timeoutTaskWrapper(void* param);
-
-                mutable std::mutex                    mutex_;
-                bool                                  initialized_;
-                Info                                  info_;
-                StateCallback                         state_callback_;
-                ScanCallback                          scan_callback_;
-                uint32_t                              connect_timeout_ms_;
-                bool                                  connect_timeout_set_;
-                uint32_t                              connect_start_tick_;
-                bool                                  disconnecting_;
-                bool                                  scanning_;
-                std::unique_ptr<app::sys::task::Task> timeout_task_;
+                mutable std::mutex        mutex_;
+                bool                      initialized_;
+                Info                      info_;
+                StateCallback             state_callback_;
+                ScanCallback              scan_callback_;
+                uint32_t                  connect_timeout_ms_;
+                bool                      connect_timeout_set_;
+                uint32_t                  connect_start_tick_;
+                bool                      disconnecting_;
+                bool                      scanning_;
+                app::sys::task::JobHandle timeout_job_; // 连接超时检查作业
             };
 
         } // namespace wifi
@@ -5,6 +5,7 @@
 #include "esp_log.h"
 #include "esp_websocket_client.h"
 #include "esp_crt_bundle.h"
+#include "tool/trace/trace.hpp"
 
 static const char* const TAG = "WebSocket";
 
@@ -395,6 +396,8 @@ namespace app
 
             int WebSocketClient::sendBinary(const uint8_t* data, size_t len, int timeout_ms)
             {
+                TRACE_SCOPE("ws.send");
+
                 esp_websocket_client_handle_t handle = nullptr;
 
                 {
@@ -0,0 +1,432 @@
+#include "bus.hpp"
+
+#include <algorithm>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "tool/trace/trace.hpp"
+
+static const char* const TAG = "EventBus";
+
+namespace app
+{
+    namespace sys
+    {
+        namespace event
+        {
+            namespace bus
+            {
+                namespace
+                {
+                    constexpr uint16_t NO_BLOCK   = 0xFFFF;
+                    constexpr uint32_t INDEX_MASK = 0xFFFF;
+
+                    const char* const DISPATCHER_NAMES[DOMAIN_COUNT] = {"evt_audio", "evt_net",
+                                                                        "evt_sensor", "evt_sys"};
+
+                    const char* const DOMAIN_NAMES[DOMAIN_COUNT] = {"audio", "network", "sensor",
+                                                                    "system"};
+
+                    // 单写者更新最大值
+                    void updateMax(std::atomic<uint32_t>& target, uint32_t value)
+                    {
+                        if (value > target.load(std::memory_order_relaxed))
+                        {
+                            target.store(value, std::memory_order_relaxed);
+                        }
+                    }
+                } // namespace
+
+                EventBus& EventBus::getInstance()
+                {
+                    static EventBus instance;
+                    return instance;
+                }
+
+                bool EventBus::init(const DomainConfig& config)
+                {
+                    if (isInitialized())
+                    {
+                        return true;
+                    }
+
+                    // 负载池在内部 RAM，发布和分发都不经过堆分配
+                    auto* pool = static_cast<Envelope*>(heap_caps_malloc(
+                        POOL_BLOCKS * sizeof(Envelope), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+                    if (pool == nullptr)
+                    {
+                        ESP_LOGE(TAG, "分配负载池失败");
+                        return false;
+                    }
+                    for (size_t i = 0; i < POOL_BLOCKS; i++)
+                    {
+                        pool[i].index = static_cast<uint16_t>(i);
+                        next_free_[i].store(i + 1 < POOL_BLOCKS ? static_cast<uint16_t>(i + 1)
+                                                                : NO_BLOCK,
+                                            std::memory_order_relaxed);
+                    }
+                    free_head_.store(0, std::memory_order_relaxed);
+
+                    for (size_t i = 0; i < DOMAIN_COUNT; i++)
+                    {
+                        routes_[i].store(static_cast<uint8_t>(Domain::SYSTEM),
+                                         std::memory_order_relaxed);
+                    }
+                    pool_ = pool;
+
+                    if (!startDispatcher(Domain::SYSTEM, config))
+                    {
+                        pool_ = nullptr;
+                        heap_caps_free(pool);
+                        return false;
+                    }
+
+                    ESP_LOGI(TAG, "事件总线已启动: 负载池 %u 块 x %u 字节",
+                             (unsigned int)POOL_BLOCKS, (unsigned int)sizeof(Envelope));
+                    return true;
+                }
+
+                bool EventBus::startDomain(Domain domain, const DomainConfig& config)
+                {
+                    if (!isInitialized())
+                    {
+                        ESP_LOGE(TAG, "事件总线未初始化");
+                        return false;
+                    }
+
+                    size_t index = static_cast<size_t>(domain);
+                    if (index >= DOMAIN_COUNT)
+                    {
+                        return false;
+                    }
+                    if (dispatchers_[index].task != nullptr)
+                    {
+                        return true;
+                    }
+
+                    if (!startDispatcher(domain, config))
+                    {
+                        return false;
+                    }
+
+                    // 之后发布的事件进入新的分发任务，已在共用队列中的事件照常分发
+                    routes_[index].store(static_cast<uint8_t>(index), std::memory_order_release);
+                    return true;
+                }
+
+                bool EventBus::unsubscribe(SubscriptionId id)
+                {
+                    size_t topic = (id >> 24);
+                    if (topic == 0 || topic > TOPIC_COUNT)
+                    {
+                        return false;
+                    }
+                    topic -= 1;
+
+                    std::lock_guard<std::mutex> lock(write_mutex_);
+
+                    const SubscriberList* current = lists_[topic].load(std::memory_order_relaxed);
+                    if (current == nullptr)
+                    {
+                        return false;
+                    }
+
+                    auto it = std::find_if(current->begin(), current->end(),
+                                           [id](const Subscriber& s) { return s.id == id; });
+                    if (it == current->end())
+                    {
+                        return false;
+                    }
+
+                    SubscriberList* list = nullptr;
+                    if (current->size() > 1)
+                    {
+                        list = new SubscriberList(*current);
+                        list->erase(list->begin() + (it - current->begin()));
+                    }
+                    replace(static_cast<Topic>(topic), list);
+                    return true;
+                }
+
+                DomainStats EventBus::getStats(Domain domain) const
+                {
+                    DomainStats stats;
+                    size_t      index = static_cast<size_t>(domain);
+                    if (index >= DOMAIN_COUNT)
+                    {
+                        return stats;
+                    }
+
+                    const Counters& counters = counters_[index];
+                    stats.published          = counters.published.load(std::memory_order_relaxed);
+                    stats.delivered          = counters.delivered.load(std::memory_order_relaxed);
+                    stats.dropped            = counters.dropped.load(std::memory_order_relaxed);
+                    stats.max_latency_us = counters.max_latency_us.load(std::memory_order_relaxed);
+                    stats.max_handler_us = counters.max_handler_us.load(std::memory_order_relaxed);
+                    return stats;
+                }
+
+                void EventBus::logStats() const
+                {
+                    ESP_LOGI(TAG, "负载池: 使用 %lu/%u, 峰值 %lu",
+                             (unsigned long)pool_used_.load(std::memory_order_relaxed),
+                             (unsigned int)POOL_BLOCKS,
+                             (unsigned long)pool_peak_.load(std::memory_order_relaxed));
+
+                    for (size_t i = 0; i < DOMAIN_COUNT; i++)
+                    {
+                        DomainStats stats = getStats(static_cast<Domain>(i));
+                        if (stats.published == 0)
+                        {
+                            continue;
+                        }
+                        size_t route = routes_[i].load(std::memory_order_relaxed);
+                        ESP_LOGI(TAG,
+                                 "  %-8s (%s): 发布 %lu, 分发 %lu, 丢弃 %lu, 最大延迟 %lu us, "
+                                 "最大耗时 %lu us",
+                                 DOMAIN_NAMES[i], DISPATCHER_NAMES[route],
+                                 (unsigned long)stats.published, (unsigned long)stats.delivered,
+                                 (unsigned long)stats.dropped, (unsigned long)stats.max_latency_us,
+                                 (unsigned long)stats.max_handler_us);
+                    }
+                }
+
+                SubscriptionId EventBus::subscribeRaw(Topic topic, RawHandler handler)
+                {
+                    size_t index = static_cast<size_t>(topic);
+                    if (index >= TOPIC_COUNT)
+                    {
+                        return 0;
+                    }
+
+                    std::lock_guard<std::mutex> lock(write_mutex_);
+
+                    const SubscriberList* current = lists_[index].load(std::memory_order_relaxed);
+                    auto* list = current != nullptr ? new SubscriberList(*current)
+                                                    : new SubscriberList();
+
+                    SubscriptionId id = (static_cast<uint32_t>(index + 1) << 24) |
+                                        (next_id_++ & 0xFFFFFF);
+                    list->push_back(Subscriber{id, std::move(handler)});
+                    replace(topic, list);
+                    return id;
+                }
+
+                bool EventBus::acquire(Topic topic, Domain domain, Envelope*& envelope)
+                {
+                    envelope = nullptr;
+                    if (!isInitialized())
+                    {
+                        return false;
+                    }
+
+                    Counters& counters = counters_[static_cast<size_t>(domain)];
+                    counters.published.fetch_add(1, std::memory_order_relaxed);
+
+                    // 没有订阅者时不占用负载池
+                    const SubscriberList* list =
+                        lists_[static_cast<size_t>(topic)].load(std::memory_order_acquire);
+                    if (list == nullptr)
+                    {
+                        return true;
+                    }
+
+                    uint32_t head = free_head_.load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        uint16_t index = static_cast<uint16_t>(head & INDEX_MASK);
+                        if (index == NO_BLOCK)
+                        {
+                            counters.dropped.fetch_add(1, std::memory_order_relaxed);
+                            ESP_LOGW(TAG, "负载池已满，丢弃事件 %s", topicName(topic));
+                            return false;
+                        }
+
+                        uint16_t next = next_free_[index].load(std::memory_order_relaxed);
+                        uint32_t desired =
+                            ((head & ~INDEX_MASK) + (INDEX_MASK + 1)) | static_cast<uint32_t>(next);
+                        if (free_head_.compare_exchange_weak(head, desired,
+                                                             std::memory_order_acquire,
+                                                             std::memory_order_acquire))
+                        {
+                            envelope = &pool_[index];
+                            break;
+                        }
+                    }
+
+                    uint32_t used = pool_used_.fetch_add(1, std::memory_order_relaxed) + 1;
+                    if (used > pool_peak_.load(std::memory_order_relaxed))
+                    {
+                        pool_peak_.store(used, std::memory_order_relaxed);
+                    }
+
+                    envelope->topic      = topic;
+                    envelope->domain     = domain;
+                    envelope->publish_us = esp_timer_get_time();
+                    return true;
+                }
+
+                bool EventBus::post(Envelope* envelope)
+                {
+                    size_t      domain = static_cast<size_t>(envelope->domain);
+                    Dispatcher& dispatcher =
+                        dispatchers_[routes_[domain].load(std::memory_order_acquire)];
+
+                    if (xQueueSend(dispatcher.queue, &envelope, 0) != pdTRUE)
+                    {
+                        counters_[domain].dropped.fetch_add(1, std::memory_order_relaxed);
+                        ESP_LOGW(TAG, "分发队列已满，丢弃事件 %s", topicName(envelope->topic));
+                        release(envelope);
+                        return false;
+                    }
+                    return true;
+                }
+
+                void EventBus::release(Envelope* envelope)
+                {
+                    uint16_t index = envelope->index;
+                    uint32_t head  = free_head_.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        next_free_[index].store(static_cast<uint16_t>(head & INDEX_MASK),
+                                                std::memory_order_relaxed);
+                        uint32_t desired = ((head & ~INDEX_MASK) + (INDEX_MASK + 1)) | index;
+                        if (free_head_.compare_exchange_weak(head, desired,
+                                                             std::memory_order_release,
+                                                             std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    pool_used_.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                void EventBus::replace(Topic topic, const SubscriberList* list)
+                {
+                    size_t                index = static_cast<size_t>(topic);
+                    const SubscriberList* old   = lists_[index].exchange(list);
+                    if (old != nullptr)
+                    {
+                        // 替换之后开始读取的分发任务看到的纪元不小于 epoch，不会再拿到旧列表
+                        uint32_t epoch = epoch_.fetch_add(1) + 1;
+                        retired_.push_back(Retired{old, epoch});
+                    }
+                    reclaim();
+                }
+
+                void EventBus::reclaim()
+                {
+                    auto in_use = [this](uint32_t epoch)
+                    {
+                        for (const auto& dispatcher : dispatchers_)
+                        {
+                            uint32_t reading = dispatcher.reader_epoch.load();
+                            if (reading != 0 && reading < epoch)
+                            {
+                                return true;
+                            }
+                        }
+                        return false;
+                    };
+
+                    // 仍在使用的列表留到下一次订阅或取消订阅时再检查
+                    auto it = retired_.begin();
+                    while (it != retired_.end())
+                    {
+                        if (in_use(it->epoch))
+                        {
+                            ++it;
+                            continue;
+                        }
+                        delete it->list;
+                        it = retired_.erase(it);
+                    }
+                }
+
+                bool EventBus::startDispatcher(Domain domain, const DomainConfig& config)
+                {
+                    size_t      index      = static_cast<size_t>(domain);
+                    Dispatcher& dispatcher = dispatchers_[index];
+
+                    if (dispatcher.queue == nullptr)
+                    {
+                        dispatcher.queue = xQueueCreate(QUEUE_LENGTH, sizeof(Envelope*));
+                    }
+                    if (dispatcher.queue == nullptr)
+                    {
+                        ESP_LOGE(TAG, "创建分发队列失败");
+                        return false;
+                    }
+
+                    task::Config task_config;
+                    task_config.name       = DISPATCHER_NAMES[index];
+                    task_config.stack_size = config.stack_size;
+                    task_config.priority   = config.priority;
+                    task_config.core_id    = config.core_id;
+                    task_config.delay_ms   = 0;
+
+                    Dispatcher* self = &dispatcher;
+                    dispatcher.task  = std::unique_ptr<task::Task>(new task::Task(
+                        [this, self](void*) { this->dispatcherTaskFunction(self); }, task_config));
+                    if (!dispatcher.task->start())
+                    {
+                        ESP_LOGE(TAG, "启动分发任务 %s 失败", task_config.name);
+                        dispatcher.task.reset();
+                        return false;
+                    }
+
+                    ESP_LOGI(TAG, "分发任务 %s 已启动", task_config.name);
+                    return true;
+                }
+
+                void EventBus::dispatch(Dispatcher& dispatcher, Envelope* envelope)
+                {
+                    TRACE_SCOPE(topicName(envelope->topic));
+
+                    Counters& counters = counters_[static_cast<size_t>(envelope->domain)];
+                    int64_t   start_us = esp_timer_get_time();
+                    updateMax(counters.max_latency_us,
+                              static_cast<uint32_t>(start_us - envelope->publish_us));
+
+                    // 先登记纪元再读取列表，写者据此判断旧列表何时可以释放
+                    dispatcher.reader_epoch.store(epoch_.load());
+                    const SubscriberList* list =
+                        lists_[static_cast<size_t>(envelope->topic)].load();
+                    if (list != nullptr)
+                    {
+                        for (const auto& subscriber : *list)
+                        {
+                            subscriber.handler(envelope->payload);
+                        }
+                    }
+                    dispatcher.reader_epoch.store(0);
+
+                    uint32_t elapsed_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+                    updateMax(counters.max_handler_us, elapsed_us);
+                    if (elapsed_us > SLOW_HANDLER_US)
+                    {
+                        ESP_LOGW(TAG, "事件 %s 分发耗时 %lu us", topicName(envelope->topic),
+                                 (unsigned long)elapsed_us);
+                    }
+
+                    counters.delivered.fetch_add(1, std::memory_order_relaxed);
+                    release(envelope);
+                }
+
+                void EventBus::dispatcherTaskFunction(Dispatcher* dispatcher)
+                {
+                    // 分发任务常驻，不会退出
+                    while (true)
+                    {
+                        Envelope* envelope = nullptr;
+                        if (xQueueReceive(dispatcher->queue, &envelope, portMAX_DELAY) == pdTRUE)
+                        {
+                            dispatch(*dispatcher, envelope);
+                        }
+                    }
+                }
+            } // namespace bus
+        } // namespace event
+    } // namespace sys
+} // namespace app
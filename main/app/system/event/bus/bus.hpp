@@ -0,0 +1,298 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "system/task/task.hpp"
+#include "topics.hpp"
+
+namespace app
+{
+    namespace sys
+    {
+        namespace event
+        {
+            namespace bus
+            {
+                constexpr size_t   MAX_PAYLOAD     = 192;   // 单个事件负载的最大字节数
+                constexpr size_t   POOL_BLOCKS     = 32;    // 负载池的块数（同时在途的事件数上限）
+                constexpr size_t   QUEUE_LENGTH    = 16;    // 每个分发任务的队列长度
+                constexpr uint32_t SLOW_HANDLER_US = 10000; // 单个事件分发超过该时长时告警
+
+                /**
+                 * @brief 订阅 ID（高 8 位为主题编号 + 1），0 表示无效
+                 */
+                using SubscriptionId = uint32_t;
+
+                /**
+                 * @brief 单个事件域的统计
+                 */
+                struct DomainStats
+                {
+                    uint32_t published;      // 发布的事件数
+                    uint32_t delivered;      // 已分发的事件数
+                    uint32_t dropped;        // 负载池或队列已满而丢弃的事件数
+                    uint32_t max_latency_us; // 发布到开始分发的最大延迟（微秒）
+                    uint32_t max_handler_us; // 单个事件分发的最大耗时（微秒）
+
+                    DomainStats()
+                        : published(0), delivered(0), dropped(0), max_latency_us(0),
+                          max_handler_us(0)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 类型化事件总线（单例模式）
+                 *
+                 * 代替 EventManager 在模块之间传递应用事件（Wi-Fi/IP 等系统事件仍走 esp_event）：
+                 * - 主题是编译期常量，负载类型由 TopicTraits 确定，发布和订阅时检查类型
+                 * - 负载在发布时构造到预分配的负载池中，队列只传递指针，分发后归还
+                 * - 订阅者列表按主题以写时复制方式发布，分发时只读取当前列表，不加锁；
+                 *   旧列表在所有分发任务都不再使用后才释放
+                 * - 每个事件域可以有自己的分发任务，慢的订阅者只会延迟同一域的事件
+                 *
+                 * 订阅者在分发任务中执行，应尽快返回；负载引用只在回调期间有效。
+                 */
+                class EventBus
+                {
+                public:
+                    /**
+                     * @brief 分发任务配置
+                     */
+                    struct DomainConfig
+                    {
+                        task::Priority priority;   // 分发任务优先级
+                        BaseType_t     core_id;    // 绑定的核心，-1 表示不绑定
+                        size_t         stack_size; // 栈大小（字节），需容纳订阅者的调用
+
+                        DomainConfig()
+                            : priority(task::Priority::NORMAL), core_id(-1), stack_size(4096)
+                        {
+                        }
+                    };
+
+                    /**
+                     * @brief 获取事件总线实例
+                     * @return 事件总线引用
+                     */
+                    static EventBus& getInstance();
+
+                    /**
+                     * @brief 分配负载池并启动共用的分发任务（SYSTEM 域）
+                     * @param config 共用分发任务的配置
+                     * @return true 成功, false 失败
+                     */
+                    bool init(const DomainConfig& config = DomainConfig());
+
+                    /**
+                     * @brief 为事件域启动单独的分发任务（需先调用 init）
+                     * @param domain 事件域（SYSTEM 域的分发任务由 init 启动）
+                     * @param config 分发任务配置
+                     * @return true 成功或已启动, false 失败
+                     */
+                    bool startDomain(Domain domain, const DomainConfig& config = DomainConfig());
+
+                    /**
+                     * @brief 是否已初始化
+                     */
+                    bool isInitialized() const
+                    {
+                        return pool_ != nullptr;
+                    }
+
+                    /**
+                     * @brief 订阅主题（可以在初始化之前和订阅者回调中调用）
+                     * @param handler 处理函数，参数为负载引用
+                     * @return 订阅 ID，失败返回 0
+                     */
+                    template <Topic T>
+                    SubscriptionId subscribe(
+                        std::function<void(const typename TopicTraits<T>::Payload&)> handler)
+                    {
+                        using Payload = typename TopicTraits<T>::Payload;
+                        if (!handler)
+                        {
+                            return 0;
+                        }
+                        return subscribeRaw(T, [handler](const void* payload)
+                                            { handler(*static_cast<const Payload*>(payload)); });
+                    }
+
+                    /**
+                     * @brief 取消订阅
+                     * @param id 订阅 ID
+                     * @return true 成功, false 没有该订阅
+                     * @note 返回时分发任务可能仍在执行该订阅者，订阅者引用的对象不能立即释放
+                     */
+                    bool unsubscribe(SubscriptionId id);
+
+                    /**
+                     * @brief 发布事件（负载拷贝到负载池，不阻塞）
+                     * @param payload 负载
+                     * @return true 成功（没有订阅者时直接返回）, false 未初始化或负载池、队列已满
+                     */
+                    template <Topic T>
+                    bool publish(const typename TopicTraits<T>::Payload& payload)
+                    {
+                        using Payload = typename TopicTraits<T>::Payload;
+                        static_assert(sizeof(Payload) <= MAX_PAYLOAD, "负载超过 MAX_PAYLOAD");
+                        static_assert(alignof(Payload) <= alignof(std::max_align_t),
+                                      "负载对齐要求过高");
+                        static_assert(std::is_trivially_copyable<Payload>::value &&
+                                          std::is_trivially_destructible<Payload>::value,
+                                      "负载只能是可平凡拷贝的数据结构");
+
+                        Envelope* envelope = nullptr;
+                        if (!acquire(T, TopicTraits<T>::DOMAIN_ID, envelope))
+                        {
+                            return false;
+                        }
+                        if (envelope == nullptr)
+                        {
+                            return true;
+                        }
+                        new (envelope->payload) Payload(payload);
+                        return post(envelope);
+                    }
+
+                    /**
+                     * @brief 发布无负载事件
+                     */
+                    template <Topic T>
+                    bool publish()
+                    {
+                        return publish<T>(typename TopicTraits<T>::Payload());
+                    }
+
+                    /**
+                     * @brief 获取事件域的统计
+                     * @param domain 事件域
+                     * @return 统计信息
+                     */
+                    DomainStats getStats(Domain domain) const;
+
+                    /**
+                     * @brief 输出各事件域的统计和负载池用量
+                     */
+                    void logStats() const;
+
+                private:
+                    using RawHandler = std::function<void(const void* payload)>;
+
+                    struct Subscriber
+                    {
+                        SubscriptionId id;
+                        RawHandler     handler;
+                    };
+
+                    using SubscriberList = std::vector<Subscriber>;
+
+                    /**
+                     * @brief 负载池中的一块（队列中传递其指针）
+                     */
+                    struct Envelope
+                    {
+                        Topic    topic;      // 主题
+                        Domain   domain;     // 所属域
+                        uint16_t index;      // 在负载池中的下标
+                        int64_t  publish_us; // 发布时间
+                        alignas(std::max_align_t) uint8_t payload[MAX_PAYLOAD];
+                    };
+
+                    /**
+                     * @brief 分发任务
+                     */
+                    struct Dispatcher
+                    {
+                        std::unique_ptr<task::Task> task;
+                        QueueHandle_t               queue = nullptr;
+                        std::atomic<uint32_t>       reader_epoch{0}; // 正在读取的纪元，0 表示空闲
+                    };
+
+                    /**
+                     * @brief 单个事件域的计数
+                     */
+                    struct Counters
+                    {
+                        std::atomic<uint32_t> published{0};
+                        std::atomic<uint32_t> delivered{0};
+                        std::atomic<uint32_t> dropped{0};
+                        std::atomic<uint32_t> max_latency_us{0};
+                        std::atomic<uint32_t> max_handler_us{0};
+                    };
+
+                    /**
+                     * @brief 等待释放的旧订阅者列表
+                     */
+                    struct Retired
+                    {
+                        const SubscriberList* list;
+                        uint32_t              epoch; // 替换后的纪元
+                    };
+
+                    EventBus()                           = default;
+                    ~EventBus()                          = default;
+                    EventBus(const EventBus&)            = delete;
+                    EventBus& operator=(const EventBus&) = delete;
+
+                    // 添加订阅者
+                    SubscriptionId subscribeRaw(Topic topic, RawHandler handler);
+
+                    // 有订阅者时从负载池取一块（没有订阅者时 envelope 为空并返回 true）
+                    bool acquire(Topic topic, Domain domain, Envelope*& envelope);
+
+                    // 把已构造负载的块放入所属域的分发队列
+                    bool post(Envelope* envelope);
+
+                    // 把块归还负载池
+                    void release(Envelope* envelope);
+
+                    // 替换主题的订阅者列表并回收旧列表（需持有 write_mutex_）
+                    void replace(Topic topic, const SubscriberList* list);
+
+                    // 释放已没有分发任务在读取的旧列表（需持有 write_mutex_）
+                    void reclaim();
+
+                    // 创建分发任务
+                    bool startDispatcher(Domain domain, const DomainConfig& config);
+
+                    // 把事件分发给当前订阅者
+                    void dispatch(Dispatcher& dispatcher, Envelope* envelope);
+
+                    // 分发任务函数
+                    void dispatcherTaskFunction(Dispatcher* dispatcher);
+
+                    // 订阅者列表（写时复制，分发时只读）
+                    std::atomic<const SubscriberList*> lists_[TOPIC_COUNT] = {};
+
+                    std::mutex            write_mutex_; // 串行化订阅和取消订阅
+                    std::vector<Retired>  retired_;     // 等待释放的旧列表
+                    std::atomic<uint32_t> epoch_{1};    // 每次替换列表递增
+                    uint32_t              next_id_ = 1;
+
+                    // 负载池：空闲块组成的栈，栈顶为 (版本 << 16) | 下标，版本防止 ABA
+                    Envelope*             pool_ = nullptr;
+                    std::atomic<uint16_t> next_free_[POOL_BLOCKS];
+                    std::atomic<uint32_t> free_head_{0};
+                    std::atomic<uint32_t> pool_used_{0};
+                    std::atomic<uint32_t> pool_peak_{0};
+
+                    Dispatcher           dispatchers_[DOMAIN_COUNT];
+                    std::atomic<uint8_t> routes_[DOMAIN_COUNT]; // 各域使用的分发任务
+                    Counters             counters_[DOMAIN_COUNT];
+                };
+            } // namespace bus
+        } // namespace event
+    } // namespace sys
+} // namespace app
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 负载类型的前向声明（发布和订阅时需包含对应模块的头文件）
+namespace app
+{
+    namespace media
+    {
+        namespace audio
+        {
+            namespace wakeword
+            {
+                struct WakeWordEventData;
+            }
+        } // namespace audio
+    } // namespace media
+
+    namespace device
+    {
+        namespace apds9930
+        {
+            struct LightData;
+        }
+        namespace mpr121
+        {
+            struct TouchData;
+        }
+        namespace m0404
+        {
+            namespace gesture
+            {
+                struct GestureEvent;
+            }
+        } // namespace m0404
+    } // namespace device
+} // namespace app
+
+namespace app
+{
+    namespace sys
+    {
+        namespace event
+        {
+            namespace bus
+            {
+                /**
+                 * @brief 事件域，每个域的事件按发布顺序依次分发
+                 *
+                 * 未单独启动分发任务的域共用 SYSTEM 域的分发任务。
+                 */
+                enum class Domain : uint8_t
+                {
+                    AUDIO   = 0, // 音频（唤醒词等，对延迟敏感）
+                    NETWORK = 1, // 网络
+                    SENSOR  = 2, // 传感器
+                    SYSTEM  = 3  // 其他（共用分发任务）
+                };
+
+                constexpr size_t DOMAIN_COUNT = 4;
+
+                /**
+                 * @brief 事件主题（编译期 ID，负载类型和所属域见下方 TopicTraits）
+                 */
+                enum class Topic : uint8_t
+                {
+                    WAKEWORD_DETECTED = 0, // 检测到唤醒词
+                    WAKEWORD_STARTED,      // 唤醒词检测已启动
+                    WAKEWORD_STOPPED,      // 唤醒词检测已停止
+                    LIGHT_CHANGED,         // 光照超出阈值窗口
+                    PROXIMITY_CHANGED,     // 靠近/离开状态变化
+                    TOUCH_CHANGED,         // 触摸位掩码变化
+                    GESTURE,               // 压力阵列识别到手势
+                    COUNT
+                };
+
+                constexpr size_t TOPIC_COUNT = static_cast<size_t>(Topic::COUNT);
+
+                /**
+                 * @brief 无负载事件
+                 */
+                struct NoPayload
+                {
+                };
+
+                /**
+                 * @brief 主题的负载类型和所属域（未声明的主题不能发布或订阅）
+                 */
+                template <Topic T>
+                struct TopicTraits;
+
+                template <>
+                struct TopicTraits<Topic::WAKEWORD_DETECTED>
+                {
+                    using Payload                     = media::audio::wakeword::WakeWordEventData;
+                    static constexpr Domain DOMAIN_ID = Domain::AUDIO;
+                };
+
+                template <>
+                struct TopicTraits<Topic::WAKEWORD_STARTED>
+                {
+                    using Payload                     = NoPayload;
+                    static constexpr Domain DOMAIN_ID = Domain::AUDIO;
+                };
+
+                template <>
+                struct TopicTraits<Topic::WAKEWORD_STOPPED>
+                {
+                    using Payload                     = NoPayload;
+                    static constexpr Domain DOMAIN_ID = Domain::AUDIO;
+                };
+
+                template <>
+                struct TopicTraits<Topic::LIGHT_CHANGED>
+                {
+                    using Payload                     = device::apds9930::LightData;
+                    static constexpr Domain DOMAIN_ID = Domain::SENSOR;
+                };
+
+                template <>
+                struct TopicTraits<Topic::PROXIMITY_CHANGED>
+                {
+                    using Payload                     = device::apds9930::LightData;
+                    static constexpr Domain DOMAIN_ID = Domain::SENSOR;
+                };
+
+                template <>
+                struct TopicTraits<Topic::TOUCH_CHANGED>
+                {
+                    using Payload                     = device::mpr121::TouchData;
+                    static constexpr Domain DOMAIN_ID = Domain::SENSOR;
+                };
+
+                template <>
+                struct TopicTraits<Topic::GESTURE>
+                {
+                    using Payload                     = device::m0404::gesture::GestureEvent;
+                    static constexpr Domain DOMAIN_ID = Domain::SENSOR;
+                };
+
+                /**
+                 * @brief 主题名称（日志用）
+                 */
+                inline const char* topicName(Topic topic)
+                {
+                    switch (topic)
+                    {
+                    case Topic::WAKEWORD_DETECTED:
+                        return "WAKEWORD_DETECTED";
+                    case Topic::WAKEWORD_STARTED:
+                        return "WAKEWORD_STARTED";
+                    case Topic::WAKEWORD_STOPPED:
+                        return "WAKEWORD_STOPPED";
+                    case Topic::LIGHT_CHANGED:
+                        return "LIGHT_CHANGED";
+                    case Topic::PROXIMITY_CHANGED:
+                        return "PROXIMITY_CHANGED";
+                    case Topic::TOUCH_CHANGED:
+                        return "TOUCH_CHANGED";
+                    case Topic::GESTURE:
+                        return "GESTURE";
+                    default:
+                        return "UNKNOWN";
+                    }
+                }
+            } // namespace bus
+        } // namespace event
+    } // namespace sys
+} // namespace app
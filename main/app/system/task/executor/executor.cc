@@ -0,0 +1,390 @@
+#include "executor.hpp"
+
+#include <algorithm>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+
+static const char* const TAG = "Executor";
+
+// 工作任务名称，按 [核心][通道] 排列
+static const char* const WORKER_NAMES[app::sys::task::EXECUTOR_CORES]
+                                     [app::sys::task::EXECUTOR_LANES] = {
+                                         {"exec_high_0", "exec_normal_0", "exec_low_0"},
+                                         {"exec_high_1", "exec_normal_1", "exec_low_1"}};
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            namespace
+            {
+                // 堆顶为最早到期的作业
+                template <typename JobT> bool laterThan(const JobT& a, const JobT& b)
+                {
+                    if (a.due_us != b.due_us)
+                    {
+                        return a.due_us > b.due_us;
+                    }
+                    return static_cast<int32_t>(a.seq - b.seq) > 0;
+                }
+
+                Priority lanePriority(Lane lane)
+                {
+                    switch (lane)
+                    {
+                    case Lane::HIGH:
+                        return Priority::HIGH;
+                    case Lane::LOW:
+                        return Priority::LOW;
+                    default:
+                        return Priority::NORMAL;
+                    }
+                }
+            } // namespace
+
+            void JobHandle::cancel()
+            {
+                if (control_ != nullptr)
+                {
+                    control_->cancelled = true;
+                }
+            }
+
+            bool JobHandle::cancelAndWait(uint32_t timeout_ms)
+            {
+                if (control_ == nullptr)
+                {
+                    return true;
+                }
+                control_->cancelled = true;
+
+                // 在作业自身中等待会死锁
+                if (control_->runner.load() == xTaskGetCurrentTaskHandle())
+                {
+                    return false;
+                }
+
+                TickType_t start = xTaskGetTickCount();
+                while (control_->runner.load() != nullptr)
+                {
+                    if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeout_ms))
+                    {
+                        return false;
+                    }
+                    vTaskDelay(1);
+                }
+                return true;
+            }
+
+            bool JobHandle::isCancelled() const
+            {
+                return control_ != nullptr && control_->cancelled;
+            }
+
+            Executor& Executor::getInstance()
+            {
+                static Executor instance;
+                return instance;
+            }
+
+            void Executor::setConfig(const Config& config)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                config_ = config;
+            }
+
+            JobHandle Executor::post(const char* name, Function function, Lane lane,
+                                     BaseType_t core_id)
+            {
+                return schedule(name, std::move(function), 0, 0, lane, core_id);
+            }
+
+            JobHandle Executor::postDelayed(const char* name, uint32_t delay_ms, Function function,
+                                            Lane lane, BaseType_t core_id)
+            {
+                return schedule(name, std::move(function), static_cast<int64_t>(delay_ms) * 1000,
+                                0, lane, core_id);
+            }
+
+            JobHandle Executor::postPeriodic(const char* name, uint32_t period_ms,
+                                             Function function, Lane lane, BaseType_t core_id,
+                                             uint32_t delay_ms)
+            {
+                // 周期小于 1 个 tick 时工作任务无法按时唤醒
+                int64_t period_us = std::max<int64_t>(static_cast<int64_t>(period_ms) * 1000,
+                                                      portTICK_PERIOD_MS * 1000);
+                return schedule(name, std::move(function), static_cast<int64_t>(delay_ms) * 1000,
+                                period_us, lane, core_id);
+            }
+
+            JobHandle Executor::schedule(const char* name, Function function, int64_t delay_us,
+                                         int64_t period_us, Lane lane, BaseType_t core_id)
+            {
+                if (!function)
+                {
+                    ESP_LOGE(TAG, "作业函数为空");
+                    return JobHandle();
+                }
+                if (core_id >= static_cast<BaseType_t>(EXECUTOR_CORES))
+                {
+                    ESP_LOGE(TAG, "无效的核心 ID: %d", (int)core_id);
+                    return JobHandle();
+                }
+
+                auto              control = std::make_shared<JobHandle::Control>();
+                SemaphoreHandle_t wake_sem;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    Worker*                     worker = selectWorker(lane, core_id);
+                    if (worker == nullptr)
+                    {
+                        return JobHandle();
+                    }
+                    if (worker->jobs.size() >= MAX_PENDING_JOBS)
+                    {
+                        ESP_LOGW(TAG, "%s 待执行作业已满，丢弃作业 %s",
+                                 WORKER_NAMES[worker->core_id][static_cast<size_t>(lane)],
+                                 name ? name : "?");
+                        return JobHandle();
+                    }
+
+                    worker->jobs.push_back(Job{std::move(function), name ? name : "job",
+                                               esp_timer_get_time() + delay_us, period_us,
+                                               next_seq_++, control});
+                    std::push_heap(worker->jobs.begin(), worker->jobs.end(), laterThan<Job>);
+                    wake_sem = worker->wake_sem;
+                }
+
+                // 工作任务按最早到期的作业计算等待时间，新作业可能更早到期
+                xSemaphoreGive(wake_sem);
+                return JobHandle(control);
+            }
+
+            Executor::Worker* Executor::selectWorker(Lane lane, BaseType_t core_id)
+            {
+                size_t lane_index = static_cast<size_t>(lane);
+                if (core_id < 0)
+                {
+                    // 优先使用已有的工作任务，两个都有时选择待执行作业较少的；
+                    // 都没有时在核心 1 上创建（核心 0 运行 WiFi / 蓝牙协议栈）
+                    Worker& first  = workers_[0][lane_index];
+                    Worker& second = workers_[1][lane_index];
+                    if (first.task != nullptr && second.task != nullptr)
+                    {
+                        core_id = first.jobs.size() < second.jobs.size() ? 0 : 1;
+                    }
+                    else
+                    {
+                        core_id = first.task != nullptr ? 0 : 1;
+                    }
+                }
+
+                Worker& worker = workers_[core_id][lane_index];
+                if (worker.task == nullptr)
+                {
+                    worker.lane    = lane;
+                    worker.core_id = core_id;
+                    if (!startWorker(worker))
+                    {
+                        return nullptr;
+                    }
+                }
+                return &worker;
+            }
+
+            bool Executor::startWorker(Worker& worker)
+            {
+                if (worker.wake_sem == nullptr)
+                {
+                    worker.wake_sem = xSemaphoreCreateBinary();
+                }
+                if (worker.wake_sem == nullptr)
+                {
+                    ESP_LOGE(TAG, "创建工作任务信号量失败");
+                    return false;
+                }
+
+                const char* name =
+                    WORKER_NAMES[worker.core_id][static_cast<size_t>(worker.lane)];
+                sys::task::Config task_config;
+                task_config.name         = name;
+                task_config.stack_size   = config_.stack_size;
+                task_config.stack_region = config_.stack_region;
+                task_config.priority     = lanePriority(worker.lane);
+                task_config.core_id      = worker.core_id;
+                task_config.delay_ms     = 0;
+
+                Worker* self = &worker;
+                worker.task  = std::unique_ptr<Task>(new Task(
+                    [this, self](void*) { this->workerTaskFunction(self); }, task_config));
+                if (!worker.task->start())
+                {
+                    ESP_LOGE(TAG, "启动工作任务 %s 失败", name);
+                    worker.task.reset();
+                    return false;
+                }
+
+                ESP_LOGI(TAG, "工作任务 %s 已启动", name);
+                return true;
+            }
+
+            bool Executor::takeDue(Worker& worker, Job& job, TickType_t& wait)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (worker.jobs.empty())
+                {
+                    wait = portMAX_DELAY;
+                    return false;
+                }
+
+                int64_t remaining_us = worker.jobs.front().due_us - esp_timer_get_time();
+                if (remaining_us > 0)
+                {
+                    // 向上取整，避免提前醒来空转
+                    const int64_t tick_us = portTICK_PERIOD_MS * 1000;
+                    wait = static_cast<TickType_t>((remaining_us + tick_us - 1) / tick_us);
+                    return false;
+                }
+
+                std::pop_heap(worker.jobs.begin(), worker.jobs.end(), laterThan<Job>);
+                job = std::move(worker.jobs.back());
+                worker.jobs.pop_back();
+                return true;
+            }
+
+            void Executor::run(Worker& worker, Job& job)
+            {
+                // 先标记执行中再检查取消：cancelAndWait() 要么看到执行中，要么作业看到已取消
+                job.control->runner = xTaskGetCurrentTaskHandle();
+                if (job.control->cancelled)
+                {
+                    job.control->runner = nullptr;
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    stats_[job.name].cancelled++;
+                    return;
+                }
+
+                int64_t start_us    = esp_timer_get_time();
+                job.function();
+                int64_t end_us      = esp_timer_get_time();
+                job.control->runner = nullptr;
+
+                uint32_t duration_us = static_cast<uint32_t>(end_us - start_us);
+                uint32_t latency_us  = static_cast<uint32_t>(std::max<int64_t>(
+                    start_us - job.due_us, 0));
+
+                // 周期作业：按固定频率安排下一次，已经错过的周期跳过
+                uint32_t skipped = 0;
+                if (job.period_us > 0 && !job.control->cancelled)
+                {
+                    job.due_us += job.period_us;
+                    if (job.due_us <= end_us)
+                    {
+                        int64_t missed = (end_us - job.due_us) / job.period_us + 1;
+                        job.due_us += missed * job.period_us;
+                        skipped = static_cast<uint32_t>(missed);
+                    }
+                }
+
+                bool first_overrun = false;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    JobStats&                   stats = stats_[job.name];
+                    stats.runs++;
+                    stats.busy_us += duration_us;
+                    stats.max_us         = std::max(stats.max_us, duration_us);
+                    stats.max_latency_us = std::max(stats.max_latency_us, latency_us);
+                    stats.skipped += skipped;
+                    if (duration_us > LONG_JOB_US)
+                    {
+                        first_overrun = stats.overruns == 0;
+                        stats.overruns++;
+                    }
+                }
+                if (first_overrun)
+                {
+                    // 长作业会推迟同一工作任务上的其他作业，只在第一次出现时告警
+                    ESP_LOGW(TAG, "作业 %s 执行 %lu us，超过 %lu us", job.name,
+                             (unsigned long)duration_us, (unsigned long)LONG_JOB_US);
+                }
+
+                if (job.period_us > 0 && !job.control->cancelled)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    job.seq = next_seq_++;
+                    worker.jobs.push_back(std::move(job));
+                    std::push_heap(worker.jobs.begin(), worker.jobs.end(), laterThan<Job>);
+                }
+            }
+
+            bool Executor::getStats(const char* name, JobStats& stats) const
+            {
+                if (name == nullptr)
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                auto                        it = stats_.find(name);
+                if (it == stats_.end())
+                {
+                    return false;
+                }
+                stats = it->second;
+                return true;
+            }
+
+            void Executor::logStats() const
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (size_t core = 0; core < EXECUTOR_CORES; core++)
+                    {
+                        for (size_t lane = 0; lane < EXECUTOR_LANES; lane++)
+                        {
+                            const Worker& worker = workers_[core][lane];
+                            if (worker.task != nullptr)
+                            {
+                                ESP_LOGI(TAG, "%s: 待执行 %u", WORKER_NAMES[core][lane],
+                                         (unsigned)worker.jobs.size());
+                            }
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                for (const auto& entry : stats_)
+                {
+                    const JobStats& stats = entry.second;
+                    ESP_LOGI(TAG,
+                             "%s: 执行 %lu 次, 平均 %lu us, 最长 %lu us, 最大延迟 %lu us, "
+                             "超时 %lu, 跳过 %lu, 取消 %lu",
+                             entry.first.c_str(), (unsigned long)stats.runs,
+                             (unsigned long)(stats.runs ? stats.busy_us / stats.runs : 0),
+                             (unsigned long)stats.max_us, (unsigned long)stats.max_latency_us,
+                             (unsigned long)stats.overruns, (unsigned long)stats.skipped,
+                             (unsigned long)stats.cancelled);
+                }
+            }
+
+            void Executor::workerTaskFunction(Worker* worker)
+            {
+                // 工作任务常驻，不会退出
+                while (true)
+                {
+                    Job        job;
+                    TickType_t wait = portMAX_DELAY;
+                    if (takeDue(*worker, job, wait))
+                    {
+                        run(*worker, job);
+                        continue;
+                    }
+                    xSemaphoreTake(worker->wake_sem, wait);
+                }
+            }
+        } // namespace task
+    } // namespace sys
+} // namespace app
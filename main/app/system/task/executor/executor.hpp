@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "system/task/task.hpp"
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            constexpr size_t   EXECUTOR_CORES   = 2;     // 工作任务按核心分组（ESP32-S3 双核）
+            constexpr size_t   EXECUTOR_LANES   = 3;     // 优先级通道数
+            constexpr uint32_t LONG_JOB_US      = 10000; // 单次执行超过该时长记为超时（微秒）
+            constexpr size_t   MAX_PENDING_JOBS = 64;    // 每个工作任务的待执行作业上限
+
+            /**
+             * @brief 优先级通道，每个通道在每个核心上最多一个工作任务
+             */
+            enum class Lane : uint8_t
+            {
+                HIGH   = 0, // 对延迟敏感的作业（Priority::HIGH）
+                NORMAL = 1, // 普通作业（Priority::NORMAL）
+                LOW    = 2  // 后台作业（Priority::LOW）
+            };
+
+            /**
+             * @brief 作业执行统计（按作业名称汇总）
+             */
+            struct JobStats
+            {
+                uint32_t runs;           // 执行次数
+                uint32_t cancelled;      // 到期时已取消而跳过的次数
+                uint32_t overruns;       // 单次执行超过 LONG_JOB_US 的次数
+                uint32_t skipped;        // 周期作业因上次执行过晚而跳过的周期数
+                uint64_t busy_us;        // 累计执行时长（微秒）
+                uint32_t max_us;         // 单次执行最大时长（微秒）
+                uint32_t max_latency_us; // 到期到开始执行的最大延迟（微秒）
+
+                JobStats()
+                    : runs(0), cancelled(0), overruns(0), skipped(0), busy_us(0), max_us(0),
+                      max_latency_us(0)
+                {
+                }
+            };
+
+            /**
+             * @brief 作业句柄，用于取消作业（可拷贝，所有拷贝指向同一个作业）
+             */
+            class JobHandle
+            {
+            public:
+                JobHandle() = default;
+
+                /**
+                 * @brief 取消作业：未开始的不再执行，周期作业不再安排下一次
+                 * @note 不等待正在执行的那一次结束，可以在作业自身中调用
+                 */
+                void cancel();
+
+                /**
+                 * @brief 取消作业并等待正在执行的那一次结束
+                 * @param timeout_ms 等待超时（毫秒）
+                 * @return true 作业已不在执行, false 超时或在作业自身中调用
+                 * @note 作业引用的对象析构前应调用此函数；不能在持有作业需要的锁时调用
+                 */
+                bool cancelAndWait(uint32_t timeout_ms = 1000);
+
+                /**
+                 * @brief 作业是否已取消
+                 */
+                bool isCancelled() const;
+
+                /**
+                 * @brief 句柄是否指向作业（提交失败时返回空句柄）
+                 */
+                bool isValid() const
+                {
+                    return control_ != nullptr;
+                }
+
+            private:
+                friend class Executor;
+
+                struct Control
+                {
+                    std::atomic<bool>         cancelled{false};
+                    std::atomic<TaskHandle_t> runner{nullptr}; // 正在执行作业的工作任务
+                };
+
+                explicit JobHandle(std::shared_ptr<Control> control) : control_(std::move(control))
+                {
+                }
+
+                std::shared_ptr<Control> control_;
+            };
+
+            /**
+             * @brief 作业执行器
+             *
+             * 用少量常驻工作任务执行短小的异步、延时和周期作业，代替为每个功能单独创建任务。
+             * 每个核心的每个优先级通道最多一个工作任务，首次向该通道提交作业时创建；
+             * 同一工作任务上的作业按到期时间依次执行，作业应尽快返回，不能长时间阻塞。
+             *
+             * 周期作业按固定频率安排：执行过晚错过的周期直接跳过，不会连续补执行。
+             */
+            class Executor
+            {
+            public:
+                using Function = std::function<void()>;
+
+                /**
+                 * @brief 工作任务配置
+                 */
+                struct Config
+                {
+                    size_t      stack_size;   // 工作任务栈大小（字节），需容纳最大的作业
+                    StackRegion stack_region; // 工作任务栈所在内存区域
+
+                    Config() : stack_size(4096), stack_region(StackRegion::INTERNAL) {}
+                };
+
+                /**
+                 * @brief 获取执行器实例
+                 * @return 执行器引用
+                 */
+                static Executor& getInstance();
+
+                /**
+                 * @brief 设置工作任务配置，只影响之后创建的工作任务
+                 * @param config 工作任务配置
+                 */
+                void setConfig(const Config& config);
+
+                /**
+                 * @brief 提交作业，尽快执行一次
+                 * @param name 作业名称（用于统计，需在程序运行期间有效）
+                 * @param function 作业函数
+                 * @param lane 优先级通道
+                 * @param core_id 执行核心，-1 表示选择待执行作业较少的核心
+                 * @return 作业句柄，失败返回空句柄
+                 */
+                JobHandle post(const char* name, Function function, Lane lane = Lane::NORMAL,
+                               BaseType_t core_id = -1);
+
+                /**
+                 * @brief 提交延时作业，delay_ms 后执行一次
+                 * @param name 作业名称
+                 * @param delay_ms 延时（毫秒）
+                 * @param function 作业函数
+                 * @param lane 优先级通道
+                 * @param core_id 执行核心，-1 表示不指定
+                 * @return 作业句柄，失败返回空句柄
+                 */
+                JobHandle postDelayed(const char* name, uint32_t delay_ms, Function function,
+                                      Lane lane = Lane::NORMAL, BaseType_t core_id = -1);
+
+                /**
+                 * @brief 提交周期作业，每 period_ms 执行一次直到取消
+                 * @param name 作业名称
+                 * @param period_ms 周期（毫秒，不小于 1 个 tick）
+                 * @param function 作业函数
+                 * @param lane 优先级通道
+                 * @param core_id 执行核心，-1 表示不指定
+                 * @param delay_ms 第一次执行前的延时（毫秒）
+                 * @return 作业句柄，失败返回空句柄
+                 */
+                JobHandle postPeriodic(const char* name, uint32_t period_ms, Function function,
+                                       Lane lane = Lane::NORMAL, BaseType_t core_id = -1,
+                                       uint32_t delay_ms = 0);
+
+                /**
+                 * @brief 获取作业统计
+                 * @param name 作业名称
+                 * @param stats 输出统计
+                 * @return true 找到, false 没有该名称的作业
+                 */
+                bool getStats(const char* name, JobStats& stats) const;
+
+                /**
+                 * @brief 输出所有作业的统计和各工作任务的待执行作业数
+                 */
+                void logStats() const;
+
+            private:
+                Executor()                           = default;
+                ~Executor()                          = default;
+                Executor(const Executor&)            = delete;
+                Executor& operator=(const Executor&) = delete;
+
+                struct Job
+                {
+                    Function                            function;
+                    const char*                         name;
+                    int64_t                             due_us;    // 到期时间
+                    int64_t                             period_us; // 周期，0 表示只执行一次
+                    uint32_t                            seq;       // 同时到期时按提交顺序执行
+                    std::shared_ptr<JobHandle::Control> control;
+                };
+
+                struct Worker
+                {
+                    std::unique_ptr<Task> task;
+                    SemaphoreHandle_t     wake_sem = nullptr; // 有新作业时唤醒
+                    std::vector<Job>      jobs;               // 按到期时间排列的小顶堆
+                    Lane                  lane     = Lane::NORMAL;
+                    BaseType_t            core_id  = 0;
+                };
+
+                // 安排作业到对应的工作任务
+                JobHandle schedule(const char* name, Function function, int64_t delay_us,
+                                   int64_t period_us, Lane lane, BaseType_t core_id);
+
+                // 选择执行作业的工作任务，需要时创建（需持有 mutex_）
+                Worker* selectWorker(Lane lane, BaseType_t core_id);
+
+                // 创建工作任务（需持有 mutex_）
+                bool startWorker(Worker& worker);
+
+                // 取出到期的作业，没有时返回需要等待的 tick 数
+                bool takeDue(Worker& worker, Job& job, TickType_t& wait);
+
+                // 执行作业并更新统计，周期作业重新安排
+                void run(Worker& worker, Job& job);
+
+                // 工作任务函数
+                void workerTaskFunction(Worker* worker);
+
+                mutable std::mutex mutex_; // 保护 workers_ 和各工作任务的作业堆
+                Config             config_;
+                Worker             workers_[EXECUTOR_CORES][EXECUTOR_LANES];
+                uint32_t           next_seq_ = 0;
+
+                mutable std::mutex              stats_mutex_;
+                std::map<std::string, JobStats> stats_;
+            };
+        } // namespace task
+    } // namespace sys
+} // namespace app
@@ -0,0 +1,384 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+#include "esp_log.h"
+
+static const char* const TAG = "CpuProfiler";
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            namespace profiler
+            {
+                CpuProfiler& CpuProfiler::getInstance()
+                {
+                    static CpuProfiler instance;
+                    return instance;
+                }
+
+                bool CpuProfiler::start(uint32_t period_ms, uint32_t report_ms)
+                {
+                    if (running_)
+                    {
+                        return true;
+                    }
+
+                    // 首次启动时创建信号量，之后复用
+                    if (wake_sem_ == nullptr)
+                    {
+                        wake_sem_    = xSemaphoreCreateBinary();
+                        stopped_sem_ = xSemaphoreCreateBinary();
+                    }
+                    if (wake_sem_ == nullptr || stopped_sem_ == nullptr)
+                    {
+                        ESP_LOGE(TAG, "创建采样信号量失败");
+                        return false;
+                    }
+
+                    period_ms_ = period_ms > 0 ? period_ms : DEFAULT_PERIOD_MS;
+                    report_ms_ = report_ms;
+
+                    // 采样本身不紧急，使用低优先级；uxTaskGetSystemState 的结果数组在堆上分配
+                    Config task_config = Config::createLightweight("cpu_profiler", Priority::LOW);
+                    task_config.stack_size = 3 * 1024;
+
+                    sampler_task_ = std::unique_ptr<Task>(new Task(
+                        [this](void* param) { this->samplerTaskFunction(param); }, task_config,
+                        this));
+
+                    running_ = true;
+                    if (!sampler_task_->start())
+                    {
+                        ESP_LOGE(TAG, "启动 CPU 采样任务失败");
+                        running_ = false;
+                        sampler_task_.reset();
+                        return false;
+                    }
+
+                    ESP_LOGI(TAG, "CPU 占用采样已启动，周期: %lu ms, 报告周期: %lu ms",
+                             (unsigned long)period_ms_, (unsigned long)report_ms_);
+                    return true;
+                }
+
+                void CpuProfiler::stop()
+                {
+                    if (!running_)
+                    {
+                        return;
+                    }
+
+                    running_ = false;
+                    xSemaphoreGive(wake_sem_);
+                    if (xSemaphoreTake(stopped_sem_, pdMS_TO_TICKS(1000)) != pdTRUE)
+                    {
+                        ESP_LOGW(TAG, "等待 CPU 采样任务退出超时");
+                    }
+
+                    if (sampler_task_ != nullptr)
+                    {
+                        sampler_task_->destroy();
+                        sampler_task_.reset();
+                    }
+                }
+
+                void CpuProfiler::sample()
+                {
+                    // 预留几个位置，防止两次调用之间新建的任务导致数组不够
+                    UBaseType_t                 capacity = uxTaskGetNumberOfTasks() + 4;
+                    std::vector<TaskStatus_t>   tasks(capacity);
+                    configRUN_TIME_COUNTER_TYPE total = 0;
+                    UBaseType_t count = uxTaskGetSystemState(tasks.data(), capacity, &total);
+                    if (count == 0)
+                    {
+                        return;
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    // 运行时间计数是 32 位的，按无符号差值计算增量，回绕后仍然正确
+                    uint32_t now = static_cast<uint32_t>(total);
+                    if (!has_baseline_)
+                    {
+                        for (size_t core = 0; core < CORE_COUNT; core++)
+                        {
+                            idle_[core] = xTaskGetIdleTaskHandleForCore(static_cast<int>(core));
+                        }
+                        for (UBaseType_t i = 0; i < count; i++)
+                        {
+                            Track& track = tracks_[tasks[i].xHandle];
+                            track.name   = tasks[i].pcTaskName;
+                            track.last   = static_cast<uint32_t>(tasks[i].ulRunTimeCounter);
+                        }
+                        last_total_   = now;
+                        has_baseline_ = true;
+                        return;
+                    }
+
+                    uint32_t elapsed = now - last_total_;
+                    if (elapsed == 0)
+                    {
+                        return;
+                    }
+                    last_total_     = now;
+                    elapsed_[head_] = elapsed;
+
+                    for (auto& entry : tracks_)
+                    {
+                        entry.second.deltas[head_] = 0;
+                        entry.second.missing++;
+                    }
+
+                    for (UBaseType_t i = 0; i < count; i++)
+                    {
+                        const TaskStatus_t& status = tasks[i];
+
+                        Track&   track   = tracks_[status.xHandle];
+                        uint32_t counter = static_cast<uint32_t>(status.ulRunTimeCounter);
+                        uint32_t delta   = counter - track.last;
+                        if (track.name != status.pcTaskName)
+                        {
+                            // 新任务，或者已删除任务的句柄被复用：创建以来的运行时间都在本周期内
+                            track      = Track();
+                            track.name = status.pcTaskName;
+                            delta      = counter;
+                        }
+
+                        // 同名任务复用句柄时差值没有意义，按创建以来的运行时间计
+                        if (delta > elapsed)
+                        {
+                            delta = std::min(counter, elapsed);
+                        }
+
+                        track.deltas[head_] = delta;
+                        track.last          = counter;
+                        track.missing       = 0;
+                        track.priority      = status.uxCurrentPriority;
+#if configTASKLIST_INCLUDE_COREID
+                        track.core = status.xCoreID;
+#endif
+                    }
+
+                    // 已删除的任务在整个窗口内都没有运行时间后移除
+                    for (auto it = tracks_.begin(); it != tracks_.end();)
+                    {
+                        if (it->second.missing >= HISTORY_LEN)
+                        {
+                            it = tracks_.erase(it);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+
+                    head_  = (head_ + 1) % HISTORY_LEN;
+                    count_ = std::min(count_ + 1, HISTORY_LEN);
+                }
+
+                std::vector<TaskLoad> CpuProfiler::getTaskLoads(Window order,
+                                                                size_t max_count) const
+                {
+                    std::vector<TaskLoad> result;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        result.reserve(tracks_.size());
+                        for (const auto& entry : tracks_)
+                        {
+                            // 空闲任务体现在核心占用中
+                            if (std::find(std::begin(idle_), std::end(idle_), entry.first) !=
+                                std::end(idle_))
+                            {
+                                continue;
+                            }
+
+                            const Track& track = entry.second;
+                            TaskLoad     load;
+                            load.name     = track.name;
+                            load.handle   = entry.first;
+                            load.core     = track.core;
+                            load.priority = track.priority;
+                            for (size_t w = 0; w < WINDOW_COUNT; w++)
+                            {
+                                load.percent[w] = percent(track.deltas, WINDOW_SAMPLES[w]);
+                            }
+                            result.push_back(load);
+                        }
+                    }
+
+                    std::sort(result.begin(), result.end(),
+                              [order](const TaskLoad& a, const TaskLoad& b)
+                              { return a.load(order) > b.load(order); });
+                    if (max_count > 0 && result.size() > max_count)
+                    {
+                        result.resize(max_count);
+                    }
+                    return result;
+                }
+
+                std::vector<CoreLoad> CpuProfiler::getCoreLoads() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    std::vector<CoreLoad>       result(CORE_COUNT);
+                    for (size_t core = 0; core < CORE_COUNT; core++)
+                    {
+                        CoreLoad& load = result[core];
+                        load.core      = static_cast<int>(core);
+
+                        auto it = tracks_.find(idle_[core]);
+                        if (count_ == 0 || it == tracks_.end())
+                        {
+                            continue;
+                        }
+
+                        const uint32_t* idle = it->second.deltas;
+                        for (size_t w = 0; w < WINDOW_COUNT; w++)
+                        {
+                            load.percent[w] =
+                                std::max(100.0f - percent(idle, WINDOW_SAMPLES[w]), 0.0f);
+                        }
+
+                        for (size_t i = 0; i < count_; i++)
+                        {
+                            size_t index = (head_ + HISTORY_LEN - 1 - i) % HISTORY_LEN;
+                            float  busy  = 100.0f - 100.0f * idle[index] / elapsed_[index];
+                            load.peak    = std::max(load.peak, busy);
+                        }
+                    }
+                    return result;
+                }
+
+                uint32_t CpuProfiler::getRuntimePercent(TaskHandle_t handle, Window window) const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto                        it = tracks_.find(handle);
+                    if (it == tracks_.end())
+                    {
+                        return 0;
+                    }
+                    float value = percent(it->second.deltas,
+                                          WINDOW_SAMPLES[static_cast<size_t>(window)]);
+                    return static_cast<uint32_t>(value + 0.5f);
+                }
+
+                void CpuProfiler::report() const
+                {
+                    std::vector<CoreLoad> cores = getCoreLoads();
+                    std::vector<TaskLoad> tasks = getTaskLoads(Window::MEDIUM);
+
+                    ESP_LOGI(TAG, "CPU 占用（窗口 %lu / %lu / %lu ms，峰值为单次采样最高值）",
+                             (unsigned long)(WINDOW_SAMPLES[0] * period_ms_),
+                             (unsigned long)(WINDOW_SAMPLES[1] * period_ms_),
+                             (unsigned long)(WINDOW_SAMPLES[2] * period_ms_));
+                    for (const CoreLoad& core : cores)
+                    {
+                        ESP_LOGI(TAG, "核心 %d: %5.1f%% %5.1f%% %5.1f%%  峰值 %5.1f%%", core.core,
+                                 core.load(Window::SHORT), core.load(Window::MEDIUM),
+                                 core.load(Window::LONG), core.peak);
+                    }
+
+                    ESP_LOGI(TAG, "%-16s %4s %4s %6s %6s %6s", "任务", "核心", "优先", "短",
+                             "中", "长");
+                    for (size_t i = 0; i < tasks.size() && i < REPORT_TOP_TASKS; i++)
+                    {
+                        const TaskLoad& task = tasks[i];
+                        char            core[4];
+                        if (task.core == tskNO_AFFINITY)
+                        {
+                            snprintf(core, sizeof(core), "-");
+                        }
+                        else
+                        {
+                            snprintf(core, sizeof(core), "%d", (int)task.core);
+                        }
+                        ESP_LOGI(TAG, "%-16s %4s %4u %5.1f%% %5.1f%% %5.1f%%", task.name.c_str(),
+                                 core, (unsigned)task.priority, task.load(Window::SHORT),
+                                 task.load(Window::MEDIUM), task.load(Window::LONG));
+                    }
+
+                    // 核心接近饱和时列出绑定在该核心上占用最高的任务
+                    for (const CoreLoad& core : cores)
+                    {
+                        if (core.load(Window::MEDIUM) < SATURATION_PERCENT)
+                        {
+                            continue;
+                        }
+                        ESP_LOGW(TAG, "核心 %d 接近饱和: %.1f%%", core.core,
+                                 core.load(Window::MEDIUM));
+
+                        size_t listed = 0;
+                        for (const TaskLoad& task : tasks)
+                        {
+                            if (listed >= 3 || task.load(Window::MEDIUM) <= 0.0f)
+                            {
+                                break;
+                            }
+                            if (task.core != core.core)
+                            {
+                                continue;
+                            }
+                            ESP_LOGW(TAG, "  %s: %.1f%%", task.name.c_str(),
+                                     task.load(Window::MEDIUM));
+                            listed++;
+                        }
+                    }
+                }
+
+                uint64_t CpuProfiler::sum(const uint32_t* ring, size_t samples) const
+                {
+                    samples        = std::min(samples, count_);
+                    uint64_t total = 0;
+                    for (size_t i = 0; i < samples; i++)
+                    {
+                        total += ring[(head_ + HISTORY_LEN - 1 - i) % HISTORY_LEN];
+                    }
+                    return total;
+                }
+
+                float CpuProfiler::percent(const uint32_t* ring, size_t samples) const
+                {
+                    uint64_t elapsed = sum(elapsed_, samples);
+                    if (elapsed == 0)
+                    {
+                        return 0.0f;
+                    }
+                    return 100.0f * static_cast<float>(sum(ring, samples)) /
+                           static_cast<float>(elapsed);
+                }
+
+                void CpuProfiler::samplerTaskFunction(void* param)
+                {
+                    (void)param;
+
+                    const TickType_t period      = pdMS_TO_TICKS(period_ms_);
+                    TickType_t       last_report = xTaskGetTickCount();
+
+                    while (running_)
+                    {
+                        sample();
+
+                        if (report_ms_ > 0 &&
+                            xTaskGetTickCount() - last_report >= pdMS_TO_TICKS(report_ms_))
+                        {
+                            report();
+                            last_report = xTaskGetTickCount();
+                        }
+
+                        // 等待下一个采样周期，stop() 时提前唤醒
+                        xSemaphoreTake(wake_sem_, period);
+                    }
+
+                    xSemaphoreGive(stopped_sem_);
+
+                    // 等待 destroy() 删除任务
+                    vTaskDelay(portMAX_DELAY);
+                }
+            } // namespace profiler
+        } // namespace task
+    } // namespace sys
+} // namespace app
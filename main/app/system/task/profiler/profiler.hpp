@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "system/task/task.hpp"
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            namespace profiler
+            {
+                constexpr uint32_t DEFAULT_PERIOD_MS  = 1000;  // 默认采样周期
+                constexpr uint32_t DEFAULT_REPORT_MS  = 60000; // 默认输出报告周期（1 分钟）
+                constexpr size_t   HISTORY_LEN        = 60;    // 保留的采样数（最长窗口）
+                constexpr size_t   CORE_COUNT         = portNUM_PROCESSORS;
+                constexpr size_t   REPORT_TOP_TASKS   = 8;     // 报告中列出的任务数
+                constexpr uint32_t SATURATION_PERCENT = 90;    // 核心占用超过该值时告警
+
+                /**
+                 * @brief 统计窗口（按采样次数，默认周期下分别为 1 秒、10 秒、60 秒）
+                 */
+                enum class Window : uint8_t
+                {
+                    SHORT,  // 最近 1 次采样
+                    MEDIUM, // 最近 10 次采样
+                    LONG,   // 最近 HISTORY_LEN 次采样
+                };
+
+                constexpr size_t WINDOW_COUNT                 = 3;
+                constexpr size_t WINDOW_SAMPLES[WINDOW_COUNT] = {1, 10, HISTORY_LEN};
+
+                /**
+                 * @brief 单个任务的 CPU 占用（占单个核心时间的百分比）
+                 */
+                struct TaskLoad
+                {
+                    std::string  name;                  // 任务名称
+                    TaskHandle_t handle;                // 任务句柄（可能已删除，只用于比较）
+                    BaseType_t   core;                  // 绑定的核心，tskNO_AFFINITY 表示未绑定
+                    UBaseType_t  priority;              // 采样时的优先级
+                    float        percent[WINDOW_COUNT]; // 各窗口的占用
+
+                    TaskLoad() : handle(nullptr), core(tskNO_AFFINITY), priority(0), percent{} {}
+
+                    float load(Window window) const
+                    {
+                        return percent[static_cast<size_t>(window)];
+                    }
+                };
+
+                /**
+                 * @brief 单个核心的 CPU 占用（100% 减去空闲任务的占用）
+                 */
+                struct CoreLoad
+                {
+                    int   core;                  // 核心编号
+                    float percent[WINDOW_COUNT]; // 各窗口的占用
+                    float peak;                  // LONG 窗口内单次采样的最高占用
+
+                    CoreLoad() : core(0), percent{}, peak(0) {}
+
+                    float load(Window window) const
+                    {
+                        return percent[static_cast<size_t>(window)];
+                    }
+                };
+
+                /**
+                 * @brief 任务 CPU 占用统计
+                 *
+                 * 周期性地调用 uxTaskGetSystemState 读取各任务的运行时间计数，
+                 * 按两次采样之间的增量计算每个任务和每个核心在滑动窗口内的占用。
+                 * 核心占用由该核心空闲任务的运行时间得到。未绑定核心的任务不能确定在哪个核心运行，
+                 * 只计入任务占用，不参与按核心列出的排行。
+                 * 需要开启 CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS。
+                 */
+                class CpuProfiler
+                {
+                public:
+                    /**
+                     * @brief 获取统计实例
+                     * @return 统计实例引用
+                     */
+                    static CpuProfiler& getInstance();
+
+                    /**
+                     * @brief 启动周期采样任务
+                     * @param period_ms 采样周期（毫秒）
+                     * @param report_ms 输出报告的周期（毫秒），0 表示不定期输出
+                     * @return true 成功, false 失败
+                     */
+                    bool start(uint32_t period_ms = DEFAULT_PERIOD_MS,
+                               uint32_t report_ms = DEFAULT_REPORT_MS);
+
+                    /**
+                     * @brief 停止采样任务（保留已有统计）
+                     */
+                    void stop();
+
+                    /**
+                     * @brief 是否正在采样
+                     */
+                    bool isRunning() const
+                    {
+                        return running_;
+                    }
+
+                    /**
+                     * @brief 获取采样周期（毫秒）
+                     */
+                    uint32_t getPeriodMs() const
+                    {
+                        return period_ms_;
+                    }
+
+                    /**
+                     * @brief 立即采样一次（首次调用只记录基准）
+                     */
+                    void sample();
+
+                    /**
+                     * @brief 获取各任务的占用
+                     * @param order 排序依据的窗口
+                     * @param max_count 最多返回的任务数，0 表示全部
+                     * @return 按占用从高到低排序的任务列表
+                     */
+                    std::vector<TaskLoad> getTaskLoads(Window order     = Window::MEDIUM,
+                                                       size_t max_count = 0) const;
+
+                    /**
+                     * @brief 获取各核心的占用
+                     * @return 按核心编号排列的占用
+                     */
+                    std::vector<CoreLoad> getCoreLoads() const;
+
+                    /**
+                     * @brief 获取单个任务的占用（填充 Info::runtime_percent）
+                     * @param handle 任务句柄
+                     * @param window 统计窗口
+                     * @return 占用百分比（四舍五入），未采样到时返回 0
+                     */
+                    uint32_t getRuntimePercent(TaskHandle_t handle,
+                                               Window       window = Window::MEDIUM) const;
+
+                    /**
+                     * @brief 输出各核心占用和占用最高的任务
+                     */
+                    void report() const;
+
+                private:
+                    /**
+                     * @brief 单个任务的采样记录（与 elapsed_ 共用环形下标）
+                     */
+                    struct Track
+                    {
+                        std::string name;                // 任务名称
+                        BaseType_t  core;                // 绑定的核心
+                        UBaseType_t priority;            // 优先级
+                        uint32_t    last;                // 上次采样的运行时间计数
+                        uint32_t    missing;             // 连续未出现的采样次数
+                        uint32_t    deltas[HISTORY_LEN]; // 各次采样的运行时间增量
+
+                        Track()
+                            : core(tskNO_AFFINITY), priority(0), last(0), missing(0), deltas{}
+                        {
+                        }
+                    };
+
+                    CpuProfiler()                              = default;
+                    ~CpuProfiler()                             = default;
+                    CpuProfiler(const CpuProfiler&)            = delete;
+                    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+                    // 最近 samples 次采样的增量之和（需持有 mutex_）
+                    uint64_t sum(const uint32_t* ring, size_t samples) const;
+
+                    // 增量之和占经过时间的百分比（需持有 mutex_）
+                    float percent(const uint32_t* ring, size_t samples) const;
+
+                    // 采样任务函数
+                    void samplerTaskFunction(void* param);
+
+                    mutable std::mutex                      mutex_;
+                    std::unordered_map<TaskHandle_t, Track> tracks_;
+
+                    TaskHandle_t idle_[CORE_COUNT]     = {};    // 各核心的空闲任务
+                    uint32_t     elapsed_[HISTORY_LEN] = {};    // 各次采样经过的时间
+                    size_t       head_                 = 0;     // 下一次采样写入的位置
+                    size_t       count_                = 0;     // 有效采样数
+                    uint32_t     last_total_           = 0;     // 上次采样的总运行时间
+                    bool         has_baseline_         = false; // 是否已记录基准
+
+                    std::unique_ptr<Task> sampler_task_;
+                    std::atomic<bool>     running_{false};
+                    uint32_t              period_ms_   = DEFAULT_PERIOD_MS;
+                    uint32_t              report_ms_   = DEFAULT_REPORT_MS;
+                    SemaphoreHandle_t     wake_sem_    = nullptr; // 唤醒采样任务（停止时）
+                    SemaphoreHandle_t     stopped_sem_ = nullptr; // 采样任务退出信号
+                };
+            } // namespace profiler
+        } // namespace task
+    } // namespace sys
+} // namespace app
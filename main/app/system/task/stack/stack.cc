@@ -0,0 +1,253 @@
+#include "stack.hpp"
+
+#include <algorithm>
+
+#include "esp_log.h"
+#include "freertos/task.h"
+
+static const char* const TAG = "StackTuner";
+
+static const char* regionName(app::sys::task::StackRegion region)
+{
+    switch (region)
+    {
+    case app::sys::task::StackRegion::INTERNAL:
+        return "internal";
+    case app::sys::task::StackRegion::PSRAM:
+        return "psram";
+    default:
+        return "dynamic";
+    }
+}
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            namespace stack
+            {
+                StackTuner& StackTuner::getInstance()
+                {
+                    static StackTuner instance;
+                    return instance;
+                }
+
+                void StackTuner::track(const char* name, size_t stack_size, StackRegion region)
+                {
+                    if (name == nullptr)
+                    {
+                        return;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    Usage&                      usage = usage_[name];
+                    usage.name                        = name;
+                    usage.stack_size                  = stack_size;
+                    usage.region                      = region;
+                }
+
+                void StackTuner::record(const char* name, size_t free_bytes)
+                {
+                    if (name == nullptr)
+                    {
+                        return;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    update(name, free_bytes);
+                }
+
+                bool StackTuner::start(uint32_t period_ms, uint32_t report_ms)
+                {
+                    if (running_)
+                    {
+                        return true;
+                    }
+
+                    // 首次启动时创建信号量，之后复用
+                    if (wake_sem_ == nullptr)
+                    {
+                        wake_sem_    = xSemaphoreCreateBinary();
+                        stopped_sem_ = xSemaphoreCreateBinary();
+                    }
+                    if (wake_sem_ == nullptr || stopped_sem_ == nullptr)
+                    {
+                        ESP_LOGE(TAG, "创建采样信号量失败");
+                        return false;
+                    }
+
+                    period_ms_ = period_ms > 0 ? period_ms : DEFAULT_PERIOD_MS;
+                    report_ms_ = report_ms;
+
+                    // 采样本身不紧急，使用低优先级；uxTaskGetSystemState 的结果数组在堆上分配
+                    Config task_config = Config::createLightweight("stack_tuner", Priority::LOW);
+                    task_config.stack_size = 3 * 1024;
+
+                    sampler_task_ = std::unique_ptr<Task>(new Task(
+                        [this](void* param) { this->samplerTaskFunction(param); }, task_config,
+                        this));
+
+                    running_ = true;
+                    if (!sampler_task_->start())
+                    {
+                        ESP_LOGE(TAG, "启动栈采样任务失败");
+                        running_ = false;
+                        sampler_task_.reset();
+                        return false;
+                    }
+
+                    ESP_LOGI(TAG, "栈水位采样已启动，周期: %lu ms, 报告周期: %lu ms",
+                             (unsigned long)period_ms_, (unsigned long)report_ms_);
+                    return true;
+                }
+
+                void StackTuner::stop()
+                {
+                    if (!running_)
+                    {
+                        return;
+                    }
+
+                    running_ = false;
+                    xSemaphoreGive(wake_sem_);
+                    if (xSemaphoreTake(stopped_sem_, pdMS_TO_TICKS(1000)) != pdTRUE)
+                    {
+                        ESP_LOGW(TAG, "等待栈采样任务退出超时");
+                    }
+
+                    if (sampler_task_ != nullptr)
+                    {
+                        sampler_task_->destroy();
+                        sampler_task_.reset();
+                    }
+
+                    report();
+                }
+
+                void StackTuner::sample()
+                {
+                    // 预留几个位置，防止两次调用之间新建的任务导致数组不够
+                    UBaseType_t               capacity = uxTaskGetNumberOfTasks() + 4;
+                    std::vector<TaskStatus_t> tasks(capacity);
+                    UBaseType_t count = uxTaskGetSystemState(tasks.data(), capacity, nullptr);
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (UBaseType_t i = 0; i < count; i++)
+                    {
+                        update(tasks[i].pcTaskName,
+                               tasks[i].usStackHighWaterMark * sizeof(StackType_t));
+                    }
+                }
+
+                std::vector<Usage> StackTuner::getUsage() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    std::vector<Usage>          result;
+                    result.reserve(usage_.size());
+                    for (const auto& entry : usage_)
+                    {
+                        Usage usage = entry.second;
+                        if (usage.stack_size > 0 && usage.samples > 0)
+                        {
+                            usage.recommended =
+                                recommend(usage.stack_size - std::min(usage.min_free,
+                                                                      usage.stack_size));
+                        }
+                        result.push_back(usage);
+                    }
+                    return result;
+                }
+
+                void StackTuner::report() const
+                {
+                    std::vector<Usage> usage = getUsage();
+
+                    // 只统计内部 RAM 中的栈：PSRAM 不紧张
+                    long internal_saving = 0;
+
+                    ESP_LOGI(TAG, "%-16s %8s %8s %8s %8s  %s", "任务", "配置", "峰值", "剩余",
+                             "建议", "区域");
+                    for (const Usage& item : usage)
+                    {
+                        if (item.samples == 0)
+                        {
+                            continue;
+                        }
+
+                        if (item.stack_size == 0)
+                        {
+                            // 系统或第三方组件创建的任务，不知道配置大小，只输出剩余空间
+                            ESP_LOGI(TAG, "%-16s %8s %8s %8u %8s", item.name.c_str(), "-", "-",
+                                     (unsigned)item.min_free, "-");
+                            continue;
+                        }
+
+                        size_t used = item.stack_size - std::min(item.min_free, item.stack_size);
+                        ESP_LOGI(TAG, "%-16s %8u %8u %8u %8u  %s", item.name.c_str(),
+                                 (unsigned)item.stack_size, (unsigned)used,
+                                 (unsigned)item.min_free, (unsigned)item.recommended,
+                                 regionName(item.region));
+
+                        if (item.min_free < WARN_FREE_BYTES)
+                        {
+                            ESP_LOGW(TAG, "任务 %s 栈剩余仅 %u 字节", item.name.c_str(),
+                                     (unsigned)item.min_free);
+                        }
+                        if (item.region != StackRegion::PSRAM)
+                        {
+                            internal_saving += static_cast<long>(item.stack_size) -
+                                               static_cast<long>(item.recommended);
+                        }
+                    }
+                    ESP_LOGI(TAG, "按建议大小调整可节省内部 RAM: %ld 字节", internal_saving);
+                }
+
+                size_t StackTuner::recommend(size_t used)
+                {
+                    size_t margin = std::max(used * MARGIN_PERCENT / 100, MARGIN_MIN_BYTES);
+                    size_t size   = (used + margin + ALIGN_BYTES - 1) / ALIGN_BYTES * ALIGN_BYTES;
+                    return std::max(size, MIN_STACK_BYTES);
+                }
+
+                void StackTuner::update(const char* name, size_t free_bytes)
+                {
+                    Usage& usage = usage_[name];
+                    if (usage.samples == 0)
+                    {
+                        usage.name = name;
+                    }
+                    usage.min_free = std::min(usage.min_free, free_bytes);
+                    usage.samples++;
+                }
+
+                void StackTuner::samplerTaskFunction(void* param)
+                {
+                    (void)param;
+
+                    const TickType_t period      = pdMS_TO_TICKS(period_ms_);
+                    TickType_t       last_report = xTaskGetTickCount();
+
+                    while (running_)
+                    {
+                        sample();
+
+                        if (report_ms_ > 0 &&
+                            xTaskGetTickCount() - last_report >= pdMS_TO_TICKS(report_ms_))
+                        {
+                            report();
+                            last_report = xTaskGetTickCount();
+                        }
+
+                        // 等待下一个采样周期，stop() 时提前唤醒
+                        xSemaphoreTake(wake_sem_, period);
+                    }
+
+                    xSemaphoreGive(stopped_sem_);
+
+                    // 等待 destroy() 删除任务
+                    vTaskDelay(portMAX_DELAY);
+                }
+            } // namespace stack
+        } // namespace task
+    } // namespace sys
+} // namespace app
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "system/task/task.hpp"
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            namespace stack
+            {
+                constexpr uint32_t DEFAULT_PERIOD_MS = 1000;   // 默认采样周期
+                constexpr uint32_t DEFAULT_REPORT_MS = 600000; // 默认输出报告周期（10 分钟）
+                constexpr size_t   MARGIN_PERCENT    = 25;     // 建议大小在峰值用量上预留的比例
+                constexpr size_t   MARGIN_MIN_BYTES  = 512;    // 预留空间下限
+                constexpr size_t   ALIGN_BYTES       = 256;    // 建议大小向上对齐的粒度
+                constexpr size_t   MIN_STACK_BYTES   = 1024;   // 建议大小下限
+                constexpr size_t   WARN_FREE_BYTES   = 256;    // 剩余空间低于该值时告警
+
+                /**
+                 * @brief 单个任务的栈使用情况（按任务名称汇总，同名任务重建后继续累计）
+                 */
+                struct Usage
+                {
+                    std::string name;        // 任务名称
+                    size_t      stack_size;  // 配置的栈大小（字节），非 Task 创建的任务为 0
+                    size_t      min_free;    // 观察到的最小剩余空间（字节）
+                    size_t      recommended; // 建议栈大小（字节），stack_size 为 0 时为 0
+                    StackRegion region;      // 栈所在内存区域
+                    uint32_t    samples;     // 采样次数
+
+                    Usage()
+                        : stack_size(0), min_free(SIZE_MAX), recommended(0),
+                          region(StackRegion::DYNAMIC), samples(0)
+                    {
+                    }
+                };
+
+                /**
+                 * @brief 栈水位调优器
+                 *
+                 * 在长时间运行（浸泡测试）中周期性地对所有任务调用 uxTaskGetSystemState，
+                 * 记录每个任务栈剩余空间的最小值，并按峰值用量给出建议栈大小。
+                 * 通过 Task 创建的任务在启动时登记配置的栈大小，退出前登记最终水位，
+                 * 因此采样间隔之间创建又销毁的任务也能统计到。
+                 */
+                class StackTuner
+                {
+                public:
+                    /**
+                     * @brief 获取调优器实例
+                     * @return 调优器引用
+                     */
+                    static StackTuner& getInstance();
+
+                    /**
+                     * @brief 登记任务的栈配置（Task::start 调用）
+                     * @param name 任务名称
+                     * @param stack_size 栈大小（字节）
+                     * @param region 栈所在内存区域
+                     */
+                    void track(const char* name, size_t stack_size, StackRegion region);
+
+                    /**
+                     * @brief 登记任务的栈剩余空间（任务退出或删除前调用）
+                     * @param name 任务名称
+                     * @param free_bytes 剩余字节数
+                     */
+                    void record(const char* name, size_t free_bytes);
+
+                    /**
+                     * @brief 启动周期采样任务
+                     * @param period_ms 采样周期（毫秒）
+                     * @param report_ms 输出报告的周期（毫秒），0 表示只在 stop() 时输出
+                     * @return true 成功, false 失败
+                     */
+                    bool start(uint32_t period_ms = DEFAULT_PERIOD_MS,
+                               uint32_t report_ms = DEFAULT_REPORT_MS);
+
+                    /**
+                     * @brief 停止采样任务并输出报告
+                     */
+                    void stop();
+
+                    /**
+                     * @brief 立即对所有任务采样一次
+                     */
+                    void sample();
+
+                    /**
+                     * @brief 获取所有任务的栈使用情况
+                     * @return 按任务名称排序的使用情况
+                     */
+                    std::vector<Usage> getUsage() const;
+
+                    /**
+                     * @brief 输出栈使用报告和建议大小
+                     */
+                    void report() const;
+
+                    /**
+                     * @brief 按峰值用量计算建议栈大小
+                     * @param used 峰值用量（字节）
+                     * @return 建议栈大小（字节）
+                     */
+                    static size_t recommend(size_t used);
+
+                private:
+                    StackTuner()                             = default;
+                    ~StackTuner()                            = default;
+                    StackTuner(const StackTuner&)            = delete;
+                    StackTuner& operator=(const StackTuner&) = delete;
+
+                    // 更新任务的最小剩余空间（需持有 mutex_）
+                    void update(const char* name, size_t free_bytes);
+
+                    // 采样任务函数
+                    void samplerTaskFunction(void* param);
+
+                    mutable std::mutex           mutex_;
+                    std::map<std::string, Usage> usage_;
+
+                    std::unique_ptr<Task> sampler_task_;
+                    std::atomic<bool>     running_{false};
+                    uint32_t              period_ms_   = DEFAULT_PERIOD_MS;
+                    uint32_t              report_ms_   = DEFAULT_REPORT_MS;
+                    SemaphoreHandle_t     wake_sem_    = nullptr; // 唤醒采样任务（停止时）
+                    SemaphoreHandle_t     stopped_sem_ = nullptr; // 采样任务退出信号
+                };
+            } // namespace stack
+        } // namespace task
+    } // namespace sys
+} // namespace app
@@ -6,10 +6,13 @@
 #include <unordered_map>
 
 #include "esp_cpu.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "info.hpp"
+#include "profiler/profiler.hpp"
+#include "stack/stack.hpp"
 
 static const char* const TAG = "TASK";
 
@@ -24,6 +27,7 @@ namespace app
             {
                 Task::TaskFunction function;
                 void*              user_param;
+                bool               is_static; // 静态栈由 Task 对象释放，任务不能自行删除
             };
 
             static std::unordered_map<TaskHandle_t, std::unique_ptr<TaskStartParam>> s_task_params;
@@ -31,11 +35,19 @@ namespace app
 
             Task::Task(TaskFunction function, const Config& config, void* param)
                 : function_(function), config_(config), param_(param), handle_(nullptr),
-                  started_(false)
+                  started_(false), stack_(nullptr), tcb_(nullptr)
             {
             }
 
-            Task::~Task() = default;
+            Task::~Task()
+            {
+                // 静态栈随对象释放，任务不能继续运行
+                if (stack_ != nullptr)
+                {
+                    destroy();
+                    freeStatic();
+                }
+            }
 
             void Task::taskWrapper(void* param)
             {
@@ -45,14 +57,59 @@ namespace app
                     p->function(p->user_param);
                 }
 
-                TaskHandle_t self = xTaskGetCurrentTaskHandle();
+                TaskHandle_t self      = xTaskGetCurrentTaskHandle();
+                bool         is_static = p && p->is_static;
+                stack::StackTuner::getInstance().record(
+                    pcTaskGetName(self), uxTaskGetStackHighWaterMark(self) * sizeof(StackType_t));
                 {
                     std::lock_guard<std::mutex> lock(s_task_params_mutex);
                     s_task_params.erase(self);
                 }
+
+                if (is_static)
+                {
+                    // 自行删除的任务由空闲任务清理，清理前不能释放栈；挂起等待 destroy() 同步删除
+                    vTaskSuspend(nullptr);
+                }
                 vTaskDelete(nullptr);
             }
 
+            bool Task::allocateStatic()
+            {
+                uint32_t caps = config_.stack_region == StackRegion::PSRAM
+                                    ? MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT
+                                    : MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+                stack_ = static_cast<StackType_t*>(heap_caps_malloc(config_.stack_size, caps));
+                if (stack_ == nullptr && config_.stack_region == StackRegion::PSRAM)
+                {
+                    ESP_LOGW(TAG, "任务 %s 的栈无法分配在 PSRAM，改用内部 RAM", config_.name);
+                    stack_ = static_cast<StackType_t*>(heap_caps_malloc(
+                        config_.stack_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+                }
+
+                // 任务控制块会在关闭 Cache 时被调度器访问，必须在内部 RAM
+                tcb_ = static_cast<StaticTask_t*>(
+                    heap_caps_malloc(sizeof(StaticTask_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+
+                if (stack_ == nullptr || tcb_ == nullptr)
+                {
+                    ESP_LOGE(TAG, "分配任务 %s 的静态栈失败（%u 字节）", config_.name,
+                             (unsigned)config_.stack_size);
+                    freeStatic();
+                    return false;
+                }
+                return true;
+            }
+
+            void Task::freeStatic()
+            {
+                heap_caps_free(stack_);
+                heap_caps_free(tcb_);
+                stack_ = nullptr;
+                tcb_   = nullptr;
+            }
+
             bool Task::start()
             {
                 if (started_ || handle_ != nullptr)
@@ -67,8 +124,9 @@ namespace app
                     return false;
                 }
 
-                auto start_param =
-                    std::make_unique<TaskStartParam>(TaskStartParam{function_, param_});
+                bool is_static   = config_.stack_region != StackRegion::DYNAMIC;
+                auto start_param = std::make_unique<TaskStartParam>(
+                    TaskStartParam{function_, param_, is_static});
 
                 if (config_.delay_ms > 0)
                 {
@@ -77,7 +135,20 @@ namespace app
 
                 // 使用 .get() 获取原始指针，因为 FreeRTOS API 需要原始指针
                 BaseType_t result;
-                if (config_.core_id == -1)
+                if (is_static)
+                {
+                    // 上一次运行的任务已删除，栈可以复用
+                    if (stack_ == nullptr && !allocateStatic())
+                    {
+                        return false;
+                    }
+                    handle_ = xTaskCreateStaticPinnedToCore(
+                        taskWrapper, config_.name, config_.stack_size / sizeof(StackType_t),
+                        start_param.get(), static_cast<UBaseType_t>(config_.priority), stack_,
+                        tcb_, config_.core_id == -1 ? tskNO_AFFINITY : config_.core_id);
+                    result = handle_ != nullptr ? pdPASS : pdFAIL;
+                }
+                else if (config_.core_id == -1)
                 {
                     result = xTaskCreate(
                         taskWrapper, config_.name, config_.stack_size / sizeof(StackType_t),
@@ -105,6 +176,9 @@ namespace app
                     s_task_params[handle_] = std::move(start_param);
                 }
 
+                stack::StackTuner::getInstance().track(config_.name, config_.stack_size,
+                                                       config_.stack_region);
+
                 vTaskResume(handle_);
 
                 started_ = true;
@@ -115,6 +189,25 @@ namespace app
             {
                 if (handle_ != nullptr)
                 {
+                    if (stack_ != nullptr && handle_ == xTaskGetCurrentTaskHandle())
+                    {
+                        ESP_LOGE(TAG, "静态栈任务 %s 不能删除自身", config_.name);
+                        return;
+                    }
+
+                    stack::StackTuner::getInstance().record(config_.name,
+                                                            getStackHighWaterMark());
+
+                    if (stack_ != nullptr)
+                    {
+                        // 正在另一个核心上运行的任务会推迟到空闲任务中清理，之后才能复用或释放栈；
+                        // 先挂起并等它让出核心，再删除就是同步完成的
+                        vTaskSuspend(handle_);
+                        while (eTaskGetState(handle_) == eRunning)
+                        {
+                            vTaskDelay(1);
+                        }
+                    }
                     vTaskDelete(handle_);
 
                     {
@@ -166,8 +259,10 @@ namespace app
                 Info info;
                 if (handle_ != nullptr)
                 {
-                    info.name     = config_.name;
-                    info.priority = uxTaskPriorityGet(handle_);
+                    info.name            = config_.name;
+                    info.priority        = uxTaskPriorityGet(handle_);
+                    info.runtime_percent =
+                        profiler::CpuProfiler::getInstance().getRuntimePercent(handle_);
 
                     eTaskState state = eTaskGetState(handle_);
                     switch (state)
@@ -201,6 +296,15 @@ namespace app
                 return info;
             }
 
+            size_t Task::getStackHighWaterMark() const
+            {
+                if (handle_ == nullptr)
+                {
+                    return 0;
+                }
+                return uxTaskGetStackHighWaterMark(handle_) * sizeof(StackType_t);
+            }
+
             TaskManager& TaskManager::getInstance()
             {
                 static TaskManager instance;
@@ -220,8 +324,10 @@ namespace app
                     return info;
                 }
 
-                info.name     = pcTaskGetName(handle);
-                info.priority = uxTaskPriorityGet(handle);
+                info.name            = pcTaskGetName(handle);
+                info.priority        = uxTaskPriorityGet(handle);
+                info.runtime_percent =
+                    profiler::CpuProfiler::getInstance().getRuntimePercent(handle);
 
                 eTaskState state = eTaskGetState(handle);
                 switch (state)
@@ -39,16 +39,27 @@ namespace app
                 DELETED    // 已删除
             };
 
+            /**
+             * @brief 任务栈所在内存区域
+             */
+            enum class StackRegion
+            {
+                DYNAMIC,  // 由 xTaskCreate 从 FreeRTOS 堆分配（内部 RAM）
+                INTERNAL, // 静态分配在内部 RAM
+                PSRAM     // 静态分配在 PSRAM（任务中不能写 Flash，也不能在 ISR 上下文中访问栈）
+            };
+
             /**
              * @brief 任务配置结构体
              */
             struct Config
             {
-                const char* name;       // 任务名称
-                size_t      stack_size; // 栈大小（字节）
-                Priority    priority;   // 优先级
-                BaseType_t  core_id;    // 核心 ID（-1 表示不绑定核心，0 或 1 绑定到指定核心）
-                uint32_t    delay_ms;   // 启动延迟（毫秒）
+                const char* name;         // 任务名称
+                size_t      stack_size;   // 栈大小（字节）
+                Priority    priority;     // 优先级
+                BaseType_t  core_id;      // 核心 ID（-1 表示不绑定核心，0 或 1 绑定到指定核心）
+                uint32_t    delay_ms;     // 启动延迟（毫秒）
+                StackRegion stack_region; // 栈所在内存区域
 
                 /**
                  * @brief 默认构造函数
@@ -57,7 +68,7 @@ namespace app
                  */
                 Config()
                     : name("Task"), stack_size(4096), priority(Priority::NORMAL), core_id(-1),
-                      delay_ms(0)
+                      delay_ms(0), stack_region(StackRegion::DYNAMIC)
                 {
                 }
 
@@ -120,7 +131,7 @@ namespace app
                 const char* name;            // 任务名称
                 State       state;           // 任务状态
                 UBaseType_t priority;        // 优先级
-                uint32_t    runtime_percent; // CPU 运行时间百分比（如果启用统计）
+                uint32_t    runtime_percent; // CPU 占用百分比（CpuProfiler 运行时有效）
 
                 Info() : name(nullptr), state(State::DELETED), priority(0), runtime_percent(0) {}
             };
@@ -129,6 +140,10 @@ namespace app
              * @brief 任务类
              *
              * 封装 FreeRTOS 任务，提供任务生命周期管理
+             *
+             * stack_region 为 INTERNAL / PSRAM 时使用 xTaskCreateStaticPinnedToCore 创建任务，
+             * 栈和任务控制块由 Task 对象持有：任务函数返回后挂起等待 destroy()，
+             * 析构时如果任务仍存在会先删除任务再释放内存。
              */
             class Task
             {
@@ -145,7 +160,8 @@ namespace app
 
                 /**
                  * @brief 析构函数
-                 * @note 不会自动删除任务，如需删除任务请显式调用 destroy()
+                 * @note 动态分配栈的任务不会自动删除，如需删除任务请显式调用 destroy()；
+                 *       静态分配栈的任务会在析构时删除
                  */
                 ~Task();
 
@@ -164,7 +180,8 @@ namespace app
 
                 /**
                  * @brief 删除任务
-                 * @note 任务也可以在自己的函数中通过 return 或 vTaskDelete(nullptr) 自行结束
+                 * @note 任务也可以在自己的函数中通过 return 或 vTaskDelete(nullptr) 自行结束；
+                 *       静态分配栈的任务只能通过 return 结束，且不能在任务自身中调用 destroy()
                  */
                 void destroy();
 
@@ -214,6 +231,12 @@ namespace app
                  */
                 Info getInfo() const;
 
+                /**
+                 * @brief 获取任务运行以来栈剩余空间的最小值
+                 * @return 剩余字节数，任务未启动返回 0
+                 */
+                size_t getStackHighWaterMark() const;
+
                 /**
                  * @brief 检查任务是否有效
                  * @return 有效返回 true
@@ -226,11 +249,19 @@ namespace app
             private:
                 static void taskWrapper(void* param);
 
-                TaskFunction function_;
-                Config       config_;
-                void*        param_;
-                TaskHandle_t handle_;
-                bool         started_;
+                // 分配静态栈和任务控制块，失败返回 false
+                bool allocateStatic();
+
+                // 释放静态栈和任务控制块
+                void freeStatic();
+
+                TaskFunction  function_;
+                Config        config_;
+                void*         param_;
+                TaskHandle_t  handle_;
+                bool          started_;
+                StackType_t*  stack_; // 静态栈（动态分配栈的任务为空）
+                StaticTask_t* tcb_;   // 静态任务控制块（动态分配栈的任务为空）
             };
 
             /**
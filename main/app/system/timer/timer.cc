@@ -0,0 +1,383 @@
+#include "timer.hpp"
+
+#include <algorithm>
+
+#include "esp_log.h"
+
+static const char* const TAG = "TimerWheel";
+
+namespace app
+{
+    namespace sys
+    {
+        namespace timer
+        {
+            namespace
+            {
+                // 从 from 开始（含）循环查找第一个非空槽，返回相对 from 的偏移，没有时返回 -1
+                int findSlot(uint64_t bits, size_t from)
+                {
+                    if (bits == 0)
+                    {
+                        return -1;
+                    }
+                    from &= SLOTS - 1;
+                    uint64_t rotated = from == 0 ? bits : (bits >> from) | (bits << (SLOTS - from));
+                    return __builtin_ctzll(rotated);
+                }
+            } // namespace
+
+            Timer::~Timer()
+            {
+                if (wheel_ != nullptr)
+                {
+                    wheel_->stop(*this);
+                }
+            }
+
+            TimerWheel::~TimerWheel()
+            {
+                deinit();
+            }
+
+            bool TimerWheel::init(const char* name)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (handle_ != nullptr)
+                {
+                    return true;
+                }
+
+                esp_timer_create_args_t args = {};
+                args.callback                = onTimer;
+                args.arg                     = this;
+                args.dispatch_method         = ESP_TIMER_TASK;
+                args.name                    = name;
+                esp_err_t ret                = esp_timer_create(&args, &handle_);
+                if (ret != ESP_OK)
+                {
+                    ESP_LOGE(TAG, "创建 esp_timer 失败: %s", esp_err_to_name(ret));
+                    handle_ = nullptr;
+                    return false;
+                }
+
+                origin_us_ = esp_timer_get_time();
+                now_       = 0;
+                armed_     = UINT64_MAX;
+                return true;
+            }
+
+            void TimerWheel::deinit()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (handle_ == nullptr)
+                {
+                    return;
+                }
+
+                esp_timer_stop(handle_);
+                esp_timer_delete(handle_);
+                handle_ = nullptr;
+
+                for (size_t level = 0; level < LEVELS; level++)
+                {
+                    for (size_t slot = 0; slot < SLOTS; slot++)
+                    {
+                        while (slots_[level][slot] != nullptr)
+                        {
+                            unlink(*slots_[level][slot]);
+                        }
+                    }
+                }
+                while (expired_ != nullptr)
+                {
+                    unlink(*expired_);
+                }
+            }
+
+            bool TimerWheel::start(Timer& timer, uint32_t delay_ms, uint32_t period_ms)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (handle_ == nullptr)
+                {
+                    ESP_LOGE(TAG, "时间轮未初始化");
+                    return false;
+                }
+
+                if (timer.wheel_ == this)
+                {
+                    unlink(timer);
+                }
+                else if (timer.wheel_ != nullptr)
+                {
+                    ESP_LOGE(TAG, "定时器已加入其他时间轮");
+                    return false;
+                }
+
+                // 空的时间轮不需要逐层推进，直接对齐到当前时间
+                int64_t elapsed_us = esp_timer_get_time() - origin_us_;
+                if (stats_.active == 0 && expired_ == nullptr)
+                {
+                    now_ = std::max(now_, static_cast<uint64_t>(elapsed_us / TICK_US));
+                }
+
+                // 到期节拍向上取整，保证回调不早于 delay_ms
+                int64_t delay_us = static_cast<int64_t>(std::min(delay_ms, MAX_DELAY_MS)) * 1000;
+                int64_t due_us   = elapsed_us + delay_us + TICK_US - 1;
+
+                timer.expires_ = std::max(static_cast<uint64_t>(due_us / TICK_US), now_ + 1);
+                timer.period_  = static_cast<uint64_t>(period_ms) * 1000 / TICK_US;
+                if (period_ms > 0)
+                {
+                    timer.period_ = std::max<uint64_t>(timer.period_, 1);
+                }
+                timer.wheel_ = this;
+                insert(timer);
+                stats_.active++;
+
+                if (nextEventTick() < armed_)
+                {
+                    rearm();
+                }
+                return true;
+            }
+
+            void TimerWheel::stop(Timer& timer)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (timer.wheel_ != this)
+                {
+                    return;
+                }
+                // 不重新设置 esp_timer：提前醒来一次比每次停止都操作 esp_timer 代价小
+                unlink(timer);
+            }
+
+            Stats TimerWheel::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return stats_;
+            }
+
+            uint64_t TimerWheel::currentTick() const
+            {
+                return static_cast<uint64_t>((esp_timer_get_time() - origin_us_) / TICK_US);
+            }
+
+            void TimerWheel::insert(Timer& timer)
+            {
+                // 到期节拍早于当前节拍（迁移时恰好到期）时放入当前槽，随后立即处理
+                uint64_t delta = timer.expires_ > now_ ? timer.expires_ - now_ : 0;
+                if (delta == 0)
+                {
+                    timer.expires_ = now_;
+                }
+
+                size_t level = 0;
+                while (level + 1 < LEVELS && delta >= (1ull << (SLOT_BITS * (level + 1))))
+                {
+                    level++;
+                }
+                size_t slot = (timer.expires_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+                Timer*& head = slots_[level][slot];
+                timer.head_  = &head;
+                timer.prev_  = nullptr;
+                timer.next_  = head;
+                if (head != nullptr)
+                {
+                    head->prev_ = &timer;
+                }
+                head = &timer;
+                occupied_[level] |= 1ull << slot;
+            }
+
+            void TimerWheel::unlink(Timer& timer)
+            {
+                if (timer.prev_ != nullptr)
+                {
+                    timer.prev_->next_ = timer.next_;
+                }
+                else if (timer.head_ != nullptr)
+                {
+                    *timer.head_ = timer.next_;
+                }
+                if (timer.next_ != nullptr)
+                {
+                    timer.next_->prev_ = timer.prev_;
+                }
+
+                // 槽变空时清除位图（expired_ 不在槽数组中）
+                if (timer.head_ != nullptr && *timer.head_ == nullptr && timer.head_ != &expired_)
+                {
+                    size_t index = static_cast<size_t>(timer.head_ - &slots_[0][0]);
+                    occupied_[index / SLOTS] &= ~(1ull << (index % SLOTS));
+                }
+
+                timer.prev_  = nullptr;
+                timer.next_  = nullptr;
+                timer.head_  = nullptr;
+                timer.wheel_ = nullptr;
+                stats_.active--;
+            }
+
+            uint64_t TimerWheel::nextEventTick() const
+            {
+                uint64_t next = UINT64_MAX;
+
+                // 第 0 层：槽内定时器在 now_ 之后 64 个节拍内到期
+                int offset = findSlot(occupied_[0], now_ + 1);
+                if (offset >= 0)
+                {
+                    next = now_ + 1 + offset;
+                }
+
+                // 高层：槽在该层编号转到它时迁移（当前编号的槽已迁移过，要等下一圈）
+                for (size_t level = 1; level < LEVELS; level++)
+                {
+                    uint64_t current = now_ >> (SLOT_BITS * level);
+                    offset           = findSlot(occupied_[level], current + 1);
+                    if (offset >= 0)
+                    {
+                        next = std::min(next, (current + 1 + offset) << (SLOT_BITS * level));
+                    }
+                }
+                return next;
+            }
+
+            void TimerWheel::advance(uint64_t target)
+            {
+                while (now_ < target)
+                {
+                    uint64_t next = nextEventTick();
+                    if (next > target)
+                    {
+                        now_ = target;
+                        break;
+                    }
+                    now_ = next;
+
+                    // 低层转完一圈时，把高层当前槽中的定时器按剩余时间重新放入低层
+                    for (size_t level = 1; level < LEVELS; level++)
+                    {
+                        if ((now_ & ((1ull << (SLOT_BITS * level)) - 1)) != 0)
+                        {
+                            break;
+                        }
+                        size_t slot  = (now_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+                        Timer* timer = slots_[level][slot];
+                        slots_[level][slot] = nullptr;
+                        occupied_[level] &= ~(1ull << slot);
+                        while (timer != nullptr)
+                        {
+                            Timer* next_timer = timer->next_;
+                            insert(*timer);
+                            stats_.cascades++;
+                            timer = next_timer;
+                        }
+                    }
+
+                    // 第 0 层当前槽全部到期，整条链表移入 expired_
+                    size_t slot  = now_ & (SLOTS - 1);
+                    Timer* timer = slots_[0][slot];
+                    if (timer == nullptr)
+                    {
+                        continue;
+                    }
+                    slots_[0][slot] = nullptr;
+                    occupied_[0] &= ~(1ull << slot);
+
+                    Timer* tail = timer;
+                    for (Timer* t = timer; t != nullptr; t = t->next_)
+                    {
+                        t->head_ = &expired_;
+                        tail     = t;
+                    }
+                    tail->next_ = expired_;
+                    if (expired_ != nullptr)
+                    {
+                        expired_->prev_ = tail;
+                    }
+                    expired_ = timer;
+                }
+            }
+
+            void TimerWheel::rearm()
+            {
+                if (handle_ == nullptr)
+                {
+                    return;
+                }
+
+                // 还有未执行的到期回调时立即触发
+                uint64_t next = expired_ != nullptr ? now_ : nextEventTick();
+                esp_timer_stop(handle_);
+                armed_ = next;
+                if (next == UINT64_MAX)
+                {
+                    return;
+                }
+
+                int64_t deadline_us = origin_us_ + static_cast<int64_t>(next) * TICK_US;
+                esp_timer_start_once(handle_,
+                                     std::max<int64_t>(deadline_us - esp_timer_get_time(), 0));
+            }
+
+            void TimerWheel::fireExpired()
+            {
+                while (true)
+                {
+                    Timer::Callback callback;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        Timer*                      timer = expired_;
+                        if (timer == nullptr)
+                        {
+                            rearm();
+                            return;
+                        }
+
+                        uint64_t period = timer->period_;
+                        unlink(*timer);
+                        callback = timer->callback_;
+                        stats_.fired++;
+
+                        // 周期定时器按固定频率重新加入，回调过晚错过的周期跳过
+                        if (period > 0)
+                        {
+                            uint64_t expires = timer->expires_ + period;
+                            if (expires <= now_)
+                            {
+                                uint64_t missed = (now_ - expires) / period + 1;
+                                expires += missed * period;
+                                stats_.skipped += static_cast<uint32_t>(missed);
+                            }
+                            timer->expires_ = expires;
+                            timer->period_  = period;
+                            timer->wheel_   = this;
+                            insert(*timer);
+                            stats_.active++;
+                        }
+                    }
+
+                    if (callback)
+                    {
+                        callback();
+                    }
+                }
+            }
+
+            void TimerWheel::onTimer(void* arg)
+            {
+                auto* wheel = static_cast<TimerWheel*>(arg);
+                {
+                    std::lock_guard<std::mutex> lock(wheel->mutex_);
+                    wheel->stats_.wakeups++;
+                    wheel->armed_ = UINT64_MAX;
+                    wheel->advance(wheel->currentTick());
+                }
+                wheel->fireExpired();
+            }
+        } // namespace timer
+    } // namespace sys
+} // namespace app
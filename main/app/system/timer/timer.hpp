@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "esp_timer.h"
+
+namespace app
+{
+    namespace sys
+    {
+        namespace timer
+        {
+            constexpr int64_t  TICK_US      = 1000; // 时间轮节拍（微秒）
+            constexpr size_t   LEVELS       = 4;    // 时间轮层数
+            constexpr size_t   SLOT_BITS    = 6;    // 每层槽数的位数
+            constexpr size_t   SLOTS        = 1 << SLOT_BITS;
+            constexpr uint32_t MAX_DELAY_MS = (1u << (SLOT_BITS * LEVELS)) - 1; // 约 4.6 小时
+
+            class TimerWheel;
+
+            /**
+             * @brief 定时器（由使用者持有，加入时间轮不分配内存）
+             *
+             * 回调在 esp_timer 任务中执行，应尽快返回（例如只设置标志并唤醒处理任务）。
+             * 回调执行期间调用 stop() 不会等待回调结束；
+             * 已经到期的回调可能在 stop() 返回后执行一次。
+             */
+            class Timer
+            {
+            public:
+                using Callback = std::function<void()>;
+
+                Timer() = default;
+                explicit Timer(Callback callback) : callback_(std::move(callback)) {}
+                ~Timer();
+
+                // 链表节点不能拷贝或移动
+                Timer(const Timer&)            = delete;
+                Timer& operator=(const Timer&) = delete;
+
+                /**
+                 * @brief 设置回调（定时器未启动时调用）
+                 * @param callback 回调函数
+                 */
+                void setCallback(Callback callback)
+                {
+                    callback_ = std::move(callback);
+                }
+
+                /**
+                 * @brief 是否已加入时间轮（单次定时器到期后变为 false）
+                 */
+                bool isActive() const
+                {
+                    return wheel_ != nullptr;
+                }
+
+            private:
+                friend class TimerWheel;
+
+                Callback    callback_;
+                TimerWheel* wheel_   = nullptr; // 所在的时间轮，未启动时为空
+                Timer*      prev_    = nullptr;
+                Timer*      next_    = nullptr;
+                Timer**     head_    = nullptr; // 所在链表的表头
+                uint64_t    expires_ = 0;       // 到期节拍
+                uint64_t    period_  = 0;       // 周期（节拍），0 表示单次
+            };
+
+            /**
+             * @brief 时间轮统计
+             */
+            struct Stats
+            {
+                uint32_t active;   // 当前已启动的定时器数
+                uint32_t fired;    // 累计到期次数
+                uint32_t cascades; // 高层槽向下层迁移的次数
+                uint32_t wakeups;  // esp_timer 回调次数
+                uint32_t skipped;  // 周期定时器因回调过晚跳过的周期数
+
+                Stats() : active(0), fired(0), cascades(0), wakeups(0), skipped(0) {}
+            };
+
+            /**
+             * @brief 分层时间轮
+             *
+             * 4 层、每层 64 个槽，节拍 1ms，最长延时 MAX_DELAY_MS。定时器按到期时间放入对应层的槽，
+             * 高层的槽在低层转完一圈时迁移到低层，启动和停止都是 O(1)。
+             * 各层用位图记录非空槽，只用一个 esp_timer 定时到下一个非空槽，空闲时不唤醒。
+             */
+            class TimerWheel
+            {
+            public:
+                TimerWheel() = default;
+                ~TimerWheel();
+
+                TimerWheel(const TimerWheel&)            = delete;
+                TimerWheel& operator=(const TimerWheel&) = delete;
+
+                /**
+                 * @brief 初始化（创建 esp_timer）
+                 * @param name 名称（esp_timer 调试用）
+                 * @return true 成功, false 失败
+                 */
+                bool init(const char* name);
+
+                /**
+                 * @brief 释放 esp_timer，所有定时器停止
+                 */
+                void deinit();
+
+                /**
+                 * @brief 启动定时器，已启动的定时器重新计时
+                 * @param timer 定时器
+                 * @param delay_ms 首次到期的延时（毫秒，最大 MAX_DELAY_MS），最多晚 1 个节拍
+                 * @param period_ms 周期（毫秒），0 表示单次
+                 * @return true 成功, false 未初始化
+                 */
+                bool start(Timer& timer, uint32_t delay_ms, uint32_t period_ms = 0);
+
+                /**
+                 * @brief 停止定时器
+                 * @param timer 定时器
+                 */
+                void stop(Timer& timer);
+
+                /**
+                 * @brief 获取统计
+                 */
+                Stats getStats() const;
+
+            private:
+                // 当前时间对应的节拍
+                uint64_t currentTick() const;
+
+                // 按到期节拍放入对应层的槽（需持有 mutex_）
+                void insert(Timer& timer);
+
+                // 从所在链表中移除（需持有 mutex_）
+                void unlink(Timer& timer);
+
+                // 下一个需要处理的节拍（到期或迁移），没有时返回 UINT64_MAX（需持有 mutex_）
+                uint64_t nextEventTick() const;
+
+                // 推进到 target 节拍，到期的定时器移入 expired_（需持有 mutex_）
+                void advance(uint64_t target);
+
+                // 按下一个事件节拍重新设置 esp_timer（需持有 mutex_）
+                void rearm();
+
+                // 执行 expired_ 中的回调，周期定时器重新加入
+                void fireExpired();
+
+                static void onTimer(void* arg);
+
+                mutable std::mutex mutex_;
+                esp_timer_handle_t handle_               = nullptr;
+                int64_t            origin_us_            = 0;          // 节拍 0 对应的时间
+                uint64_t           now_                  = 0;          // 已处理到的节拍
+                uint64_t           armed_                = UINT64_MAX; // esp_timer 设置的节拍
+                Timer*             slots_[LEVELS][SLOTS] = {};         // 各层各槽的链表
+                uint64_t           occupied_[LEVELS]     = {};         // 各层非空槽位图
+                Timer*             expired_              = nullptr;    // 已到期、待执行回调
+                Stats              stats_;
+            };
+        } // namespace timer
+    } // namespace sys
+} // namespace app
@@ -0,0 +1,402 @@
+#include "recorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* const TAG = "Recorder";
+
+namespace app
+{
+    namespace tool
+    {
+        namespace recorder
+        {
+            namespace
+            {
+                constexpr size_t MAX_VARINT_LEN = 10; // 64 位变长整数的最大字节数
+                constexpr size_t RECORD_PREFIX  = 2;  // 类型 + 负载长度
+
+                // 变长整数编码（每字节 7 位，最高位表示后续还有字节）
+                size_t encodeVarint(uint64_t value, uint8_t* out)
+                {
+                    size_t len = 0;
+                    while (value >= 0x80)
+                    {
+                        out[len++] = static_cast<uint8_t>(value | 0x80);
+                        value >>= 7;
+                    }
+                    out[len++] = static_cast<uint8_t>(value);
+                    return len;
+                }
+
+                void putU16(uint8_t* out, uint16_t value)
+                {
+                    out[0] = static_cast<uint8_t>(value & 0xFF);
+                    out[1] = static_cast<uint8_t>(value >> 8);
+                }
+
+                void putU32(uint8_t* out, uint32_t value)
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        out[i] = static_cast<uint8_t>(value >> (8 * i));
+                    }
+                }
+
+                void putU64(uint8_t* out, uint64_t value)
+                {
+                    for (int i = 0; i < 8; i++)
+                    {
+                        out[i] = static_cast<uint8_t>(value >> (8 * i));
+                    }
+                }
+            } // namespace
+
+            Recorder::~Recorder()
+            {
+                deinit();
+            }
+
+            bool Recorder::init(size_t capacity)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (buffer_ != nullptr)
+                {
+                    ESP_LOGW(TAG, "记录器已初始化");
+                    return true;
+                }
+
+                if (capacity < DUMP_CHUNK_SIZE)
+                {
+                    ESP_LOGE(TAG, "缓冲容量过小: %u", (unsigned int)capacity);
+                    return false;
+                }
+
+                // 只使用 PSRAM，避免占用内部 RAM
+                buffer_ = static_cast<uint8_t*>(
+                    heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+                if (buffer_ == nullptr)
+                {
+                    ESP_LOGE(TAG, "PSRAM 分配失败: %u 字节", (unsigned int)capacity);
+                    return false;
+                }
+
+                capacity_       = capacity;
+                head_           = 0;
+                tail_           = 0;
+                used_           = 0;
+                records_        = 0;
+                overwritten_    = 0;
+                dropped_        = 0;
+                base_us_        = 0;
+                last_us_        = 0;
+                dumping_        = false;
+                busy_us_        = 0;
+                stats_start_us_ = esp_timer_get_time();
+
+                ESP_LOGI(TAG, "记录器已启动，缓冲 %u KB", (unsigned int)(capacity / 1024));
+                return true;
+            }
+
+            void Recorder::deinit()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (buffer_ != nullptr)
+                {
+                    heap_caps_free(buffer_);
+                    buffer_   = nullptr;
+                    capacity_ = 0;
+                    used_     = 0;
+                    records_  = 0;
+                }
+            }
+
+            void Recorder::record(RecordType type, const uint8_t* payload, size_t len)
+            {
+                if (buffer_ == nullptr || len > MAX_PAYLOAD || (len > 0 && payload == nullptr))
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (buffer_ == nullptr)
+                {
+                    return;
+                }
+                if (dumping_)
+                {
+                    dropped_++;
+                    return;
+                }
+
+                int64_t now = esp_timer_get_time();
+                if (records_ == 0)
+                {
+                    base_us_ = now;
+                    last_us_ = now;
+                }
+
+                uint64_t delta_us = now > last_us_ ? static_cast<uint64_t>(now - last_us_) : 0;
+
+                uint8_t prefix[RECORD_PREFIX + MAX_VARINT_LEN];
+                prefix[0]         = static_cast<uint8_t>(type);
+                prefix[1]         = static_cast<uint8_t>(len);
+                size_t prefix_len = RECORD_PREFIX + encodeVarint(delta_us, prefix + RECORD_PREFIX);
+
+                // 空间不足时覆盖最旧的记录
+                size_t total = prefix_len + len;
+                while (capacity_ - used_ < total && records_ > 0)
+                {
+                    dropOldest();
+                }
+
+                writeBytes(prefix, prefix_len);
+                writeBytes(payload, len);
+                records_++;
+                last_us_ = now;
+
+                busy_us_ += static_cast<uint64_t>(esp_timer_get_time() - now);
+            }
+
+            void Recorder::recordState(uint8_t from, uint8_t to)
+            {
+                uint8_t payload[2] = {from, to};
+                record(RecordType::STATE, payload, sizeof(payload));
+            }
+
+            void Recorder::recordVad(bool speaking)
+            {
+                uint8_t payload = speaking ? 1 : 0;
+                record(RecordType::VAD, &payload, 1);
+            }
+
+            void Recorder::recordWakeword(float probability)
+            {
+                float   clamped = std::min(std::max(probability, 0.0f), 1.0f);
+                uint8_t payload[2];
+                putU16(payload, static_cast<uint16_t>(clamped * 1000.0f + 0.5f));
+                record(RecordType::WAKEWORD, payload, sizeof(payload));
+            }
+
+            void Recorder::recordTouch(uint16_t touch_status)
+            {
+                uint8_t payload[2];
+                putU16(payload, touch_status);
+                record(RecordType::TOUCH, payload, sizeof(payload));
+            }
+
+            void Recorder::recordPressure(const uint16_t* pressures, size_t count)
+            {
+                if (pressures == nullptr)
+                {
+                    return;
+                }
+
+                uint8_t payload[MAX_PAYLOAD];
+                count = std::min(count, MAX_PAYLOAD / 2);
+                for (size_t i = 0; i < count; i++)
+                {
+                    putU16(payload + i * 2, pressures[i]);
+                }
+                record(RecordType::PRESSURE, payload, count * 2);
+            }
+
+            void Recorder::recordGesture(uint8_t type, uint8_t direction, uint8_t contacts,
+                                         uint32_t duration_ms)
+            {
+                uint8_t payload[5] = {type, direction, contacts};
+                putU16(payload + 3, static_cast<uint16_t>(std::min<uint32_t>(duration_ms, 0xFFFF)));
+                record(RecordType::GESTURE, payload, sizeof(payload));
+            }
+
+            void Recorder::recordLight(uint16_t ch0, uint16_t ch1, uint16_t proximity, bool near)
+            {
+                uint8_t payload[7];
+                putU16(payload, ch0);
+                putU16(payload + 2, ch1);
+                putU16(payload + 4, proximity);
+                payload[6] = near ? 1 : 0;
+                record(RecordType::LIGHT, payload, sizeof(payload));
+            }
+
+            void Recorder::recordImu(const int16_t raw[6])
+            {
+                uint8_t payload[12];
+                for (int i = 0; i < 6; i++)
+                {
+                    putU16(payload + i * 2, static_cast<uint16_t>(raw[i]));
+                }
+                record(RecordType::IMU, payload, sizeof(payload));
+            }
+
+            bool Recorder::dump(const Writer& writer, const BeginCallback& on_begin)
+            {
+                if (!writer)
+                {
+                    return false;
+                }
+
+                // 冻结缓冲：导出期间新记录只计数，不写入
+                size_t   start   = 0;
+                size_t   length  = 0;
+                uint32_t records = 0;
+                uint32_t dropped = 0;
+                int64_t  base_us = 0;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (buffer_ == nullptr)
+                    {
+                        ESP_LOGE(TAG, "记录器未初始化");
+                        return false;
+                    }
+                    if (dumping_)
+                    {
+                        ESP_LOGW(TAG, "正在导出中");
+                        return false;
+                    }
+                    dumping_ = true;
+                    start    = tail_;
+                    length   = used_;
+                    records  = records_;
+                    dropped  = dropped_;
+                    base_us  = base_us_;
+                }
+
+                uint8_t header[DUMP_HEADER_SIZE] = {};
+                putU32(header, DUMP_MAGIC);
+                header[4] = DUMP_VERSION;
+                putU32(header + 8, records);
+                putU32(header + 12, static_cast<uint32_t>(length));
+                putU32(header + 16, dropped);
+                putU64(header + 20, static_cast<uint64_t>(base_us));
+
+                bool success = true;
+                if (on_begin)
+                {
+                    success = on_begin(records, sizeof(header) + length);
+                }
+                if (success)
+                {
+                    success = writer(header, sizeof(header));
+                }
+
+                // 按块写出，环形缓冲回绕处拆成两段
+                size_t pos       = start;
+                size_t remaining = length;
+                while (success && remaining > 0)
+                {
+                    size_t chunk = std::min(std::min(remaining, DUMP_CHUNK_SIZE), capacity_ - pos);
+                    success      = writer(buffer_ + pos, chunk);
+                    pos          = (pos + chunk) % capacity_;
+                    remaining -= chunk;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    dumping_ = false;
+                }
+
+                if (success)
+                {
+                    ESP_LOGI(TAG, "导出完成: %lu 条记录, %u 字节", (unsigned long)records,
+                             (unsigned int)(length + sizeof(header)));
+                }
+                else
+                {
+                    ESP_LOGE(TAG, "导出失败");
+                }
+                return success;
+            }
+
+            Stats Recorder::getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                Stats stats;
+                stats.capacity    = capacity_;
+                stats.used        = used_;
+                stats.records     = records_;
+                stats.overwritten = overwritten_;
+                stats.dropped     = dropped_;
+                stats.span_us     = records_ > 0 ? last_us_ - base_us_ : 0;
+                stats.busy_us     = busy_us_;
+                stats.elapsed_us  = esp_timer_get_time() - stats_start_us_;
+                return stats;
+            }
+
+            void Recorder::logStats() const
+            {
+                if (!isInitialized())
+                {
+                    return;
+                }
+
+                Stats    stats   = getStats();
+                uint32_t cpu_ppm = 0;
+                if (stats.elapsed_us > 0)
+                {
+                    cpu_ppm = static_cast<uint32_t>(stats.busy_us * 1000000ULL /
+                                                    static_cast<uint64_t>(stats.elapsed_us));
+                }
+
+                ESP_LOGI(TAG, "记录器: %lu 条记录, %u/%u KB, 覆盖 %lu 秒",
+                         (unsigned long)stats.records, (unsigned int)(stats.used / 1024),
+                         (unsigned int)(stats.capacity / 1024),
+                         (unsigned long)(stats.span_us / 1000000));
+                ESP_LOGI(TAG, "  已覆盖: %lu, 已丢弃: %lu, CPU 占用: %lu.%04lu%%",
+                         (unsigned long)stats.overwritten, (unsigned long)stats.dropped,
+                         (unsigned long)(cpu_ppm / 10000), (unsigned long)(cpu_ppm % 10000));
+            }
+
+            void Recorder::writeBytes(const uint8_t* data, size_t len)
+            {
+                if (len == 0)
+                {
+                    return;
+                }
+
+                size_t first = std::min(len, capacity_ - head_);
+                memcpy(buffer_ + head_, data, first);
+                if (first < len)
+                {
+                    memcpy(buffer_, data + first, len - first);
+                }
+                head_ = (head_ + len) % capacity_;
+                used_ += len;
+            }
+
+            uint8_t Recorder::peekByte(size_t offset) const
+            {
+                return buffer_[(tail_ + offset) % capacity_];
+            }
+
+            void Recorder::dropOldest()
+            {
+                // 解析最旧记录的长度和时间增量，基准时间随之前移
+                size_t   payload_len = peekByte(1);
+                size_t   offset      = RECORD_PREFIX;
+                uint64_t delta_us    = 0;
+                int      shift       = 0;
+                uint8_t  byte        = 0;
+                do
+                {
+                    byte = peekByte(offset++);
+                    delta_us |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                } while ((byte & 0x80) != 0 && offset < RECORD_PREFIX + MAX_VARINT_LEN);
+
+                size_t size = offset + payload_len;
+                base_us_ += static_cast<int64_t>(delta_us);
+                tail_ = (tail_ + size) % capacity_;
+                used_ -= size;
+                records_--;
+                overwritten_++;
+            }
+
+        } // namespace recorder
+    } // namespace tool
+} // namespace app
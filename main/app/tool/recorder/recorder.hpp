@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace app
+{
+    namespace tool
+    {
+        namespace recorder
+        {
+            /**
+             * @brief 记录类型（写入每条记录的首字节，主机端解码器按此解析负载）
+             *
+             * 负载均为小端整数，各类型的布局：
+             * - STATE:    u8 旧状态, u8 新状态
+             * - VAD:      u8 是否说话
+             * - WAKEWORD: u16 概率（千分比）
+             * - TOUCH:    u16 触摸位掩码
+             * - PRESSURE: u16 x 16 压力值
+             * - GESTURE:  u8 手势, u8 方向, u8 激活点数, u16 持续时间（毫秒）
+             * - LIGHT:    u16 Ch0, u16 Ch1, u16 接近值, u8 是否靠近
+             * - IMU:      i16 x 6 加速度和角速度原始值
+             */
+            enum class RecordType : uint8_t
+            {
+                STATE    = 1, // 设备状态转换
+                VAD      = 2, // 人声检测状态变化
+                WAKEWORD = 3, // 唤醒词检测
+                TOUCH    = 4, // MPR121 触摸
+                PRESSURE = 5, // M0404 压力帧
+                GESTURE  = 6, // M0404 压力手势
+                LIGHT    = 7, // APDS9930 光照和接近
+                IMU      = 8  // QMI8658A 六轴原始数据
+            };
+
+            constexpr size_t   DEFAULT_CAPACITY = 512 * 1024; // 默认环形缓冲大小（PSRAM）
+            constexpr size_t   MAX_PAYLOAD      = 32;         // 单条记录负载上限
+            constexpr size_t   DUMP_CHUNK_SIZE  = 4096;       // 导出时单次写出的字节数上限
+            constexpr uint32_t DUMP_MAGIC       = 0x52465045; // 导出文件魔数 "EPFR"
+            constexpr uint8_t  DUMP_VERSION     = 1;          // 导出格式版本
+            constexpr size_t   DUMP_HEADER_SIZE = 28;         // 导出文件头长度
+
+            /**
+             * @brief 导出数据写出函数
+             * @param data 数据
+             * @param len 数据长度
+             * @return true 成功, false 失败（导出中止）
+             */
+            using Writer = std::function<bool(const uint8_t* data, size_t len)>;
+
+            /**
+             * @brief 导出开始回调（缓冲已冻结，写出文件头之前调用）
+             * @param records 导出的记录数
+             * @param length 导出数据总字节数（含文件头）
+             * @return true 继续导出, false 取消导出
+             */
+            using BeginCallback = std::function<bool(uint32_t records, size_t length)>;
+
+            /**
+             * @brief 记录器统计
+             */
+            struct Stats
+            {
+                size_t   capacity;    // 缓冲容量（字节）
+                size_t   used;        // 已用字节数
+                uint32_t records;     // 缓冲中的记录数
+                uint32_t overwritten; // 被新记录覆盖的旧记录数
+                uint32_t dropped;     // 导出期间丢弃的记录数
+                int64_t  span_us;     // 缓冲覆盖的时间跨度（微秒）
+                uint64_t busy_us;     // 写记录的累计耗时（微秒）
+                int64_t  elapsed_us;  // 统计时长（微秒）
+
+                Stats()
+                    : capacity(0), used(0), records(0), overwritten(0), dropped(0), span_us(0),
+                      busy_us(0), elapsed_us(0)
+                {
+                }
+            };
+
+            /**
+             * @brief 传感器飞行记录器（单例模式）
+             *
+             * 在 PSRAM 环形缓冲中持续保存最近一段时间的传感器数据、状态转换和语音事件，
+             * 缓冲写满后覆盖最旧的记录。每条记录格式为：
+             * u8 类型, u8 负载长度, 变长整数编码的时间增量（微秒，相对上一条记录）, 负载。
+             *
+             * 导出格式为 28 字节文件头加上按时间顺序排列的记录：
+             * u32 魔数, u8 版本, 3 字节保留, u32 记录数, u32 记录总字节数, u32 丢弃数,
+             * i64 基准时间（微秒，第一条记录的时间为基准时间加上其时间增量）。
+             * 主机端使用 scripts/decode_recorder.py 转换为 CSV。
+             */
+            class Recorder
+            {
+            public:
+                /**
+                 * @brief 获取单例实例
+                 * @return Recorder 实例的引用
+                 */
+                static Recorder& getInstance()
+                {
+                    static Recorder instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                Recorder(const Recorder&)            = delete;
+                Recorder& operator=(const Recorder&) = delete;
+
+                /**
+                 * @brief 在 PSRAM 中分配环形缓冲并开始记录
+                 * @param capacity 缓冲大小（字节）
+                 * @return true 成功, false 失败
+                 */
+                bool init(size_t capacity = DEFAULT_CAPACITY);
+
+                /**
+                 * @brief 停止记录并释放缓冲
+                 */
+                void deinit();
+
+                /**
+                 * @brief 是否已初始化
+                 */
+                bool isInitialized() const
+                {
+                    return buffer_ != nullptr;
+                }
+
+                /**
+                 * @brief 写入一条记录（未初始化时直接返回）
+                 * @param type 记录类型
+                 * @param payload 负载
+                 * @param len 负载长度，不超过 MAX_PAYLOAD
+                 */
+                void record(RecordType type, const uint8_t* payload, size_t len);
+
+                /**
+                 * @brief 记录设备状态转换
+                 */
+                void recordState(uint8_t from, uint8_t to);
+
+                /**
+                 * @brief 记录人声检测状态变化
+                 */
+                void recordVad(bool speaking);
+
+                /**
+                 * @brief 记录唤醒词检测
+                 * @param probability 检测概率（0.0 ~ 1.0）
+                 */
+                void recordWakeword(float probability);
+
+                /**
+                 * @brief 记录触摸位掩码
+                 */
+                void recordTouch(uint16_t touch_status);
+
+                /**
+                 * @brief 记录压力帧
+                 * @param pressures 压力值数组
+                 * @param count 压力值个数，超出负载上限的部分被截断
+                 */
+                void recordPressure(const uint16_t* pressures, size_t count);
+
+                /**
+                 * @brief 记录压力手势
+                 */
+                void recordGesture(uint8_t type, uint8_t direction, uint8_t contacts,
+                                   uint32_t duration_ms);
+
+                /**
+                 * @brief 记录光照和接近数据
+                 */
+                void recordLight(uint16_t ch0, uint16_t ch1, uint16_t proximity, bool near);
+
+                /**
+                 * @brief 记录六轴原始数据
+                 * @param raw 加速度 XYZ 和角速度 XYZ 的原始值
+                 */
+                void recordImu(const int16_t raw[6]);
+
+                /**
+                 * @brief 导出缓冲中的全部记录（文件头 + 记录）
+                 *
+                 * 导出期间暂停记录，新记录计入丢弃数；缓冲内容不会被清除。
+                 *
+                 * @param writer 写出函数，按块调用
+                 * @param on_begin 导出开始回调，可为空（用于先告知接收方数据长度）
+                 * @return true 成功, false 未初始化、正在导出、被取消或写出失败
+                 */
+                bool dump(const Writer& writer, const BeginCallback& on_begin = nullptr);
+
+                /**
+                 * @brief 获取统计信息
+                 */
+                Stats getStats() const;
+
+                /**
+                 * @brief 打印统计信息（含写记录的 CPU 占用）
+                 */
+                void logStats() const;
+
+            private:
+                Recorder() = default;
+                ~Recorder();
+
+                // 在写位置写入数据（调用方持有锁并已确保空间足够）
+                void writeBytes(const uint8_t* data, size_t len);
+
+                // 读取相对读位置偏移处的字节
+                uint8_t peekByte(size_t offset) const;
+
+                // 丢弃最旧的一条记录
+                void dropOldest();
+
+                uint8_t* buffer_   = nullptr; // 环形缓冲（PSRAM）
+                size_t   capacity_ = 0;       // 缓冲容量
+                size_t   head_     = 0;       // 写位置
+                size_t   tail_     = 0;       // 最旧记录的位置
+                size_t   used_     = 0;       // 已用字节数
+
+                uint32_t records_     = 0;     // 缓冲中的记录数
+                uint32_t overwritten_ = 0;     // 被覆盖的记录数
+                uint32_t dropped_     = 0;     // 导出期间丢弃的记录数
+                int64_t  base_us_     = 0;     // 最旧记录之前的基准时间
+                int64_t  last_us_     = 0;     // 最新记录的时间
+                bool     dumping_     = false; // 是否正在导出
+
+                uint64_t busy_us_        = 0; // 写记录的累计耗时
+                int64_t  stats_start_us_ = 0; // 统计起始时间
+
+                mutable std::mutex mutex_;
+            };
+
+        } // namespace recorder
+    } // namespace tool
+} // namespace app
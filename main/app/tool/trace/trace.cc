@@ -0,0 +1,391 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "mbedtls/base64.h"
+#include "system/info/info.hpp"
+
+static const char* const TAG = "Tracer";
+
+namespace app
+{
+    namespace tool
+    {
+        namespace trace
+        {
+            namespace
+            {
+                constexpr size_t MIN_RECORDS        = 64; // 每个核心的最小记录数
+                constexpr size_t CONSOLE_LINE_BYTES = 96; // 控制台每行编码的原始字节数
+
+                void putU16(uint8_t* out, uint16_t value)
+                {
+                    out[0] = static_cast<uint8_t>(value & 0xFF);
+                    out[1] = static_cast<uint8_t>(value >> 8);
+                }
+
+                void putU32(uint8_t* out, uint32_t value)
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        out[i] = static_cast<uint8_t>(value >> (8 * i));
+                    }
+                }
+
+                // 有序插入（去重）
+                void insertKey(std::vector<uint32_t>& keys, uint32_t key)
+                {
+                    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+                    if (it == keys.end() || *it != key)
+                    {
+                        keys.insert(it, key);
+                    }
+                }
+
+                // 追加名称表或任务表的一项：u32 地址, u8 长度, 字符串
+                void appendEntry(std::vector<uint8_t>& out, uint32_t key, const char* text)
+                {
+                    size_t  len = text != nullptr ? strnlen(text, MAX_NAME_LEN) : 0;
+                    uint8_t entry[5];
+                    putU32(entry, key);
+                    entry[4] = static_cast<uint8_t>(len);
+                    out.insert(out.end(), entry, entry + sizeof(entry));
+                    out.insert(out.end(), text, text + len);
+                }
+            } // namespace
+
+            Tracer::~Tracer()
+            {
+                deinit();
+            }
+
+            bool Tracer::init(size_t records)
+            {
+                if (isInitialized())
+                {
+                    ESP_LOGW(TAG, "跟踪已初始化");
+                    return true;
+                }
+
+                // 向下取整为 2 的幂，写入时用掩码代替取模
+                size_t capacity = MIN_RECORDS;
+                while (capacity * 2 <= records)
+                {
+                    capacity *= 2;
+                }
+
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    rings_[core] = Ring();
+                    rings_[core].records = static_cast<Record*>(
+                        heap_caps_calloc(capacity, sizeof(Record), MALLOC_CAP_SPIRAM));
+                    if (rings_[core].records == nullptr)
+                    {
+                        ESP_LOGE(TAG, "分配跟踪缓冲失败: %u 条记录", (unsigned int)capacity);
+                        for (int i = 0; i < core; i++)
+                        {
+                            heap_caps_free(rings_[i].records);
+                            rings_[i].records = nullptr;
+                        }
+                        return false;
+                    }
+                }
+
+                capacity_     = static_cast<uint32_t>(capacity);
+                mask_         = capacity_ - 1;
+                resync_ticks_ = std::max<TickType_t>(pdMS_TO_TICKS(RESYNC_MS), 1);
+                dropped_.store(0, std::memory_order_relaxed);
+                active_.store(true, std::memory_order_release);
+
+                ESP_LOGI(TAG, "跟踪已启动: 每个核心 %u 条记录（%u KB）", (unsigned int)capacity,
+                         (unsigned int)(capacity * sizeof(Record) / 1024));
+                return true;
+            }
+
+            void Tracer::deinit()
+            {
+                if (!isInitialized())
+                {
+                    return;
+                }
+
+                // 等待另一核心上正在进行的写入完成（写入期间屏蔽中断，不会跨越节拍）
+                active_.store(false, std::memory_order_release);
+                vTaskDelay(1);
+
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    heap_caps_free(rings_[core].records);
+                    rings_[core] = Ring();
+                }
+                capacity_ = 0;
+                mask_     = 0;
+            }
+
+            void Tracer::write(EventType type, const char* name, uint32_t value)
+            {
+                if (!active_.load(std::memory_order_acquire))
+                {
+                    if (dumping_.load(std::memory_order_relaxed))
+                    {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return;
+                }
+
+                bool    in_isr = xPortInIsrContext();
+                uint8_t flags  = in_isr ? FLAG_ISR : 0;
+
+                // 屏蔽本核心中断：不会被抢占，也不会迁移到另一核心
+                UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+                if (active_.load(std::memory_order_relaxed))
+                {
+                    Ring&      ring   = rings_[xPortGetCoreID()];
+                    uint32_t   cycles = esp_cpu_get_cycle_count();
+                    TickType_t tick   = xTaskGetTickCountFromISR();
+
+                    // 周期计数 32 位回绕，定期记录与 esp_timer 时间的对应关系
+                    if (!ring.synced || tick - ring.sync_tick >= resync_ticks_)
+                    {
+                        uint64_t now_us = static_cast<uint64_t>(esp_timer_get_time());
+                        push(ring, cycles, static_cast<uint32_t>(now_us),
+                             static_cast<uint32_t>(now_us >> 32),
+                             static_cast<uint8_t>(EventType::SYNC), 0);
+                        ring.sync_tick = tick;
+                        ring.synced    = true;
+                    }
+
+                    uint32_t arg = value;
+                    if (type != EventType::COUNTER)
+                    {
+                        arg = static_cast<uint32_t>(
+                            reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle()));
+                    }
+                    push(ring, cycles, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name)),
+                         arg, static_cast<uint8_t>(type), flags);
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+            }
+
+            void Tracer::push(Ring& ring, uint32_t cycles, uint32_t name, uint32_t arg,
+                              uint8_t type, uint8_t flags)
+            {
+                Record& record  = ring.records[ring.head];
+                record.cycles   = cycles;
+                record.name     = name;
+                record.arg      = arg;
+                record.type     = type;
+                record.flags    = flags;
+                record.reserved = 0;
+
+                ring.head = (ring.head + 1) & mask_;
+                if (ring.count < capacity_)
+                {
+                    ring.count++;
+                }
+                else
+                {
+                    ring.overwritten++;
+                }
+            }
+
+            bool Tracer::dump(const Writer& writer, const BeginCallback& on_begin)
+            {
+                if (!writer)
+                {
+                    return false;
+                }
+                if (!isInitialized())
+                {
+                    ESP_LOGE(TAG, "跟踪未初始化");
+                    return false;
+                }
+
+                bool expected = false;
+                if (!dumping_.compare_exchange_strong(expected, true))
+                {
+                    ESP_LOGW(TAG, "正在导出中");
+                    return false;
+                }
+
+                // 暂停记录并等待另一核心上正在进行的写入完成
+                active_.store(false, std::memory_order_release);
+                vTaskDelay(1);
+
+                uint32_t counts[portNUM_PROCESSORS];
+                uint32_t starts[portNUM_PROCESSORS];
+                uint32_t total       = 0;
+                uint32_t overwritten = 0;
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    const Ring& ring = rings_[core];
+                    counts[core]     = ring.count;
+                    starts[core]     = (ring.head - ring.count) & mask_;
+                    total += ring.count;
+                    overwritten += ring.overwritten;
+                }
+
+                // 收集记录中出现的名称和任务
+                std::vector<uint32_t> names;
+                std::vector<uint32_t> tasks;
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    for (uint32_t i = 0; i < counts[core]; i++)
+                    {
+                        const Record& record = rings_[core].records[(starts[core] + i) & mask_];
+                        auto          type   = static_cast<EventType>(record.type);
+                        if (type == EventType::SYNC)
+                        {
+                            continue;
+                        }
+                        insertKey(names, record.name);
+                        if (type != EventType::COUNTER && record.arg != 0)
+                        {
+                            insertKey(tasks, record.arg);
+                        }
+                    }
+                }
+
+                std::vector<uint8_t> tables;
+                for (uint32_t key : names)
+                {
+                    appendEntry(tables, key, reinterpret_cast<const char*>(key));
+                }
+
+                // 任务名称只能从现存任务中取得，已删除的任务在主机端显示为句柄
+                uint32_t                  task_count = 0;
+                std::vector<TaskStatus_t> status(uxTaskGetNumberOfTasks() + 4);
+                UBaseType_t               found =
+                    uxTaskGetSystemState(status.data(), status.size(), nullptr);
+                for (UBaseType_t i = 0; i < found; i++)
+                {
+                    uintptr_t handle = reinterpret_cast<uintptr_t>(status[i].xHandle);
+                    auto      key    = static_cast<uint32_t>(handle);
+                    if (std::binary_search(tasks.begin(), tasks.end(), key))
+                    {
+                        appendEntry(tables, key, status[i].pcTaskName);
+                        task_count++;
+                    }
+                }
+
+                uint8_t header[DUMP_HEADER_SIZE] = {};
+                putU32(header, DUMP_MAGIC);
+                header[4] = DUMP_VERSION;
+                header[5] = portNUM_PROCESSORS;
+                putU16(header + 6, sizeof(Record));
+                putU32(header + 8, sys::info::CpuInfo::getCpuInfo().getCpuFrequency());
+                putU32(header + 12, overwritten);
+                putU32(header + 16, dropped_.load(std::memory_order_relaxed));
+                putU32(header + 20, static_cast<uint32_t>(names.size()));
+                putU32(header + 24, task_count);
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    putU32(header + 28 + 4 * core, counts[core]);
+                }
+
+                size_t length  = sizeof(header) + total * sizeof(Record) + tables.size();
+                bool   success = true;
+                if (on_begin)
+                {
+                    success = on_begin(total, length);
+                }
+                if (success)
+                {
+                    success = writer(header, sizeof(header));
+                }
+
+                // 按块写出，环形缓冲回绕处拆成两段
+                constexpr uint32_t CHUNK_RECORDS = DUMP_CHUNK_SIZE / sizeof(Record);
+                for (int core = 0; success && core < portNUM_PROCESSORS; core++)
+                {
+                    uint32_t pos       = starts[core];
+                    uint32_t remaining = counts[core];
+                    while (success && remaining > 0)
+                    {
+                        uint32_t chunk =
+                            std::min(std::min(remaining, CHUNK_RECORDS), capacity_ - pos);
+                        auto data = reinterpret_cast<const uint8_t*>(rings_[core].records + pos);
+                        success   = writer(data, chunk * sizeof(Record));
+                        pos       = (pos + chunk) & mask_;
+                        remaining -= chunk;
+                    }
+                }
+                if (success && !tables.empty())
+                {
+                    success = writer(tables.data(), tables.size());
+                }
+
+                active_.store(true, std::memory_order_release);
+                dumping_.store(false, std::memory_order_release);
+
+                if (success)
+                {
+                    ESP_LOGI(TAG, "导出完成: %lu 条记录, %u 字节", (unsigned long)total,
+                             (unsigned int)length);
+                }
+                else
+                {
+                    ESP_LOGE(TAG, "导出失败");
+                }
+                return success;
+            }
+
+            bool Tracer::dumpToConsole()
+            {
+                bool started = false;
+                auto on_begin = [&started](uint32_t, size_t length) {
+                    printf("TRACE_DUMP_BEGIN %u\n", (unsigned int)length);
+                    started = true;
+                    return true;
+                };
+
+                auto writer = [](const uint8_t* data, size_t len) {
+                    unsigned char line[(CONSOLE_LINE_BYTES / 3) * 4 + 1];
+                    for (size_t offset = 0; offset < len; offset += CONSOLE_LINE_BYTES)
+                    {
+                        size_t piece   = std::min(len - offset, CONSOLE_LINE_BYTES);
+                        size_t written = 0;
+                        if (mbedtls_base64_encode(line, sizeof(line), &written, data + offset,
+                                                  piece) != 0)
+                        {
+                            return false;
+                        }
+                        line[written] = '\0';
+                        printf("TRACE:%s\n", reinterpret_cast<const char*>(line));
+                    }
+                    return true;
+                };
+
+                bool success = dump(writer, on_begin);
+                if (started)
+                {
+                    printf("TRACE_DUMP_END\n");
+                }
+                return success;
+            }
+
+            Stats Tracer::getStats() const
+            {
+                // 只读计数，不暂停记录，结果可能与正在写入的记录相差几条
+                Stats stats;
+                stats.capacity = capacity_;
+                for (int core = 0; core < portNUM_PROCESSORS; core++)
+                {
+                    stats.records += rings_[core].count;
+                    stats.overwritten += rings_[core].overwritten;
+                }
+                stats.dropped = dropped_.load(std::memory_order_relaxed);
+                return stats;
+            }
+
+        } // namespace trace
+    } // namespace tool
+} // namespace app
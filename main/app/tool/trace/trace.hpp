@@ -0,0 +1,251 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+/**
+ * 跟踪打点宏（CONFIG_TRACE_ENABLE 关闭时展开为空，参数不求值）
+ *
+ * name 必须是字符串字面量或其他静态存储的字符串：记录中只保存地址，导出时才读取内容。
+ * TRACE_BEGIN/TRACE_END 需在同一任务中成对使用，TRACE_SCOPE 在离开作用域时自动结束。
+ */
+#ifdef CONFIG_TRACE_ENABLE
+#define TRACE_WRITE_(type, name, value)                                                      \
+    ::app::tool::trace::Tracer::getInstance().write(::app::tool::trace::EventType::type, (name), \
+                                                    static_cast<uint32_t>(value))
+#define TRACE_CONCAT_(a, b)        a##b
+#define TRACE_CONCAT(a, b)         TRACE_CONCAT_(a, b)
+#define TRACE_BEGIN(name)          TRACE_WRITE_(BEGIN, name, 0)
+#define TRACE_END(name)            TRACE_WRITE_(END, name, 0)
+#define TRACE_INSTANT(name)        TRACE_WRITE_(INSTANT, name, 0)
+#define TRACE_COUNTER(name, value) TRACE_WRITE_(COUNTER, name, value)
+#define TRACE_SCOPE(name) \
+    ::app::tool::trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_BEGIN(name)          ((void)0)
+#define TRACE_END(name)            ((void)0)
+#define TRACE_INSTANT(name)        ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_SCOPE(name)          ((void)0)
+#endif
+
+namespace app
+{
+    namespace tool
+    {
+        namespace trace
+        {
+            /**
+             * @brief 事件类型（写入每条记录的 type 字段）
+             */
+            enum class EventType : uint8_t
+            {
+                BEGIN   = 1, // 区间开始
+                END     = 2, // 区间结束（名称与对应的 BEGIN 相同）
+                INSTANT = 3, // 瞬时事件
+                COUNTER = 4, // 计数值
+                SYNC    = 5  // 时间同步点（周期计数与 esp_timer 时间的对应关系）
+            };
+
+            constexpr uint8_t FLAG_ISR = 0x01; // 在中断中记录（arg 为被中断的任务）
+
+            /**
+             * @brief 跟踪记录（16 字节，小端）
+             *
+             * 时间戳是写入核心的 CPU 周期计数（32 位，240MHz 下约 17.9 秒回绕一次），
+             * 每个核心至少每 RESYNC_MS 插入一条 SYNC 记录，主机端据此换算为微秒。
+             */
+            struct Record
+            {
+                uint32_t cycles; // 写入核心的周期计数（CCOUNT）
+                uint32_t name;   // 事件名称地址；SYNC 为时间（微秒）的低 32 位
+                uint32_t arg;    // 任务句柄，COUNTER 为计数值；SYNC 为时间的高 32 位
+                uint8_t  type;   // 事件类型
+                uint8_t  flags;  // FLAG_*
+                uint16_t reserved;
+            };
+            static_assert(sizeof(Record) == 16, "跟踪记录应为 16 字节");
+
+            constexpr size_t   DEFAULT_RECORDS  = 4096;       // 每个核心的默认记录数（64 KB）
+            constexpr uint32_t RESYNC_MS        = 1000;       // 同一核心两次时间同步的最大间隔
+            constexpr size_t   MAX_NAME_LEN     = 63;         // 导出时名称的最大长度
+            constexpr size_t   DUMP_CHUNK_SIZE  = 4096;       // 导出时单次写出的字节数上限
+            constexpr uint32_t DUMP_MAGIC       = 0x52545045; // 导出文件魔数 "EPTR"
+            constexpr uint8_t  DUMP_VERSION     = 1;          // 导出格式版本
+            constexpr size_t   DUMP_HEADER_SIZE = 28 + 4 * portNUM_PROCESSORS; // 导出文件头长度
+
+            /**
+             * @brief 导出数据写出函数
+             * @param data 数据
+             * @param len 数据长度
+             * @return true 成功, false 失败（导出中止）
+             */
+            using Writer = std::function<bool(const uint8_t* data, size_t len)>;
+
+            /**
+             * @brief 导出开始回调（记录已暂停，写出文件头之前调用）
+             * @param records 导出的记录数
+             * @param length 导出数据总字节数（含文件头）
+             * @return true 继续导出, false 取消导出
+             */
+            using BeginCallback = std::function<bool(uint32_t records, size_t length)>;
+
+            /**
+             * @brief 跟踪统计
+             */
+            struct Stats
+            {
+                size_t   capacity;    // 每个核心的记录数上限
+                uint32_t records;     // 缓冲中的记录数（所有核心）
+                uint32_t overwritten; // 被新记录覆盖的记录数
+                uint32_t dropped;     // 导出期间丢弃的记录数
+
+                Stats() : capacity(0), records(0), overwritten(0), dropped(0) {}
+            };
+
+            /**
+             * @brief 跨任务时延跟踪（单例模式）
+             *
+             * 每个核心一个环形缓冲（PSRAM），只由该核心写入：写记录时屏蔽本核心中断，
+             * 期间不会被抢占或迁移到另一核心，不需要锁，开销为几十个周期。
+             * 缓冲写满后覆盖最旧的记录。
+             * 可以在任务和普通中断中调用，不能在 IRAM 中断（cache 关闭期间）中调用。
+             *
+             * 导出格式为文件头、各核心按时间顺序排列的记录、名称表和任务表：
+             * - 文件头：u32 魔数, u8 版本, u8 核心数, u16 记录长度, u32 CPU 频率（Hz）,
+             *   u32 覆盖数, u32 丢弃数, u32 名称数, u32 任务数, 每个核心 u32 记录数
+             * - 名称表和任务表的每一项：u32 地址, u8 长度, 字符串（不含结束符）
+             * 主机端使用 scripts/trace_to_chrome.py 转换为 Chrome 跟踪 JSON，在 Perfetto 中查看。
+             */
+            class Tracer
+            {
+            public:
+                /**
+                 * @brief 获取单例实例
+                 * @return Tracer 实例的引用
+                 */
+                static Tracer& getInstance()
+                {
+                    static Tracer instance;
+                    return instance;
+                }
+
+                // 禁止拷贝和赋值
+                Tracer(const Tracer&)            = delete;
+                Tracer& operator=(const Tracer&) = delete;
+
+                /**
+                 * @brief 为每个核心分配环形缓冲并开始记录
+                 * @param records 每个核心的记录数，向下取整为 2 的幂
+                 * @return true 成功, false 失败
+                 */
+                bool init(size_t records = DEFAULT_RECORDS);
+
+                /**
+                 * @brief 停止记录并释放缓冲
+                 */
+                void deinit();
+
+                /**
+                 * @brief 是否已初始化
+                 */
+                bool isInitialized() const
+                {
+                    return rings_[0].records != nullptr;
+                }
+
+                /**
+                 * @brief 写入一条记录（未初始化或导出期间直接返回）
+                 * @param type 事件类型（不能是 SYNC）
+                 * @param name 事件名称（静态字符串）
+                 * @param value COUNTER 的计数值，其他类型忽略
+                 */
+                void write(EventType type, const char* name, uint32_t value);
+
+                /**
+                 * @brief 导出全部记录（格式见类说明）
+                 *
+                 * 导出期间暂停记录，新记录计入丢弃数；缓冲内容不会被清除。
+                 *
+                 * @param writer 写出函数，按块调用
+                 * @param on_begin 导出开始回调，可为空（用于先告知接收方数据长度）
+                 * @return true 成功, false 未初始化、正在导出、被取消或写出失败
+                 */
+                bool dump(const Writer& writer, const BeginCallback& on_begin = nullptr);
+
+                /**
+                 * @brief 以 base64 文本行导出到控制台（串口）
+                 *
+                 * 输出 "TRACE_DUMP_BEGIN <字节数>"、若干 "TRACE:<base64>" 行和 "TRACE_DUMP_END"，
+                 * 主机端脚本可以直接读取串口日志。
+                 *
+                 * @return true 成功, false 失败
+                 */
+                bool dumpToConsole();
+
+                /**
+                 * @brief 获取统计信息
+                 */
+                Stats getStats() const;
+
+            private:
+                /**
+                 * @brief 单个核心的环形缓冲
+                 */
+                struct Ring
+                {
+                    Record*    records     = nullptr; // 记录数组（PSRAM）
+                    uint32_t   head        = 0;       // 下一条记录的位置
+                    uint32_t   count       = 0;       // 缓冲中的记录数
+                    uint32_t   overwritten = 0;       // 被覆盖的记录数
+                    TickType_t sync_tick   = 0;       // 上次同步时的系统节拍
+                    bool       synced      = false;   // 是否已写入过 SYNC 记录
+                };
+
+                Tracer() = default;
+                ~Tracer();
+
+                // 在环形缓冲中追加一条记录（调用方已屏蔽本核心中断）
+                void push(Ring& ring, uint32_t cycles, uint32_t name, uint32_t arg, uint8_t type,
+                          uint8_t flags);
+
+                Ring                  rings_[portNUM_PROCESSORS];
+                uint32_t              capacity_     = 0; // 每个核心的记录数
+                uint32_t              mask_         = 0; // capacity_ - 1
+                TickType_t            resync_ticks_ = 0; // SYNC 间隔（节拍）
+                std::atomic<bool>     active_{false};    // 是否接受新记录
+                std::atomic<bool>     dumping_{false};   // 是否正在导出
+                std::atomic<uint32_t> dropped_{0};       // 导出期间丢弃的记录数
+            };
+
+            /**
+             * @brief 作用域跟踪（构造时 BEGIN，析构时 END）
+             */
+            class Scope
+            {
+            public:
+                explicit Scope(const char* name) : name_(name)
+                {
+                    Tracer::getInstance().write(EventType::BEGIN, name_, 0);
+                }
+
+                ~Scope()
+                {
+                    Tracer::getInstance().write(EventType::END, name_, 0);
+                }
+
+                Scope(const Scope&)            = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                const char* name_;
+            };
+
+        } // namespace trace
+    } // namespace tool
+} // namespace app
@@ -0,0 +1,118 @@
+#include "system/event/bus/bus.hpp"
+#include "device/apds9930/apds9930.hpp"
+#include "media/audio/wakeword/wakeword.hpp"
+#include "system/task/task.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* const TAG = "EventBusTest";
+
+using app::device::apds9930::LightData;
+using app::media::audio::wakeword::WakeWordEventData;
+using app::sys::task::TaskManager;
+using namespace app::sys::event::bus;
+
+static std::atomic<int>     s_light_count{0};
+static std::atomic<int>     s_wake_count{0};
+static std::atomic<int>     s_started_count{0};
+static std::atomic<int64_t> s_wake_publish_us{0};
+static std::atomic<int64_t> s_wake_latency_us{0};
+static SubscriptionId       s_started_id = 0;
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "=== 事件总线测试 ===");
+
+    auto& event_bus = EventBus::getInstance();
+    if (!event_bus.init())
+    {
+        ESP_LOGE(TAG, "事件总线初始化失败");
+        return;
+    }
+
+    EventBus::DomainConfig audio_config;
+    audio_config.priority = app::sys::task::Priority::HIGH;
+    if (!event_bus.startDomain(Domain::AUDIO, audio_config))
+    {
+        ESP_LOGE(TAG, "音频分发任务启动失败");
+        return;
+    }
+
+    // 慢的传感器订阅者：每个事件阻塞 50ms
+    event_bus.subscribe<Topic::LIGHT_CHANGED>(
+        [](const LightData& data)
+        {
+            (void)data;
+            TaskManager::delayMs(50);
+            s_light_count++;
+        });
+
+    event_bus.subscribe<Topic::WAKEWORD_DETECTED>(
+        [](const WakeWordEventData& data)
+        {
+            if (s_wake_count++ == 0)
+            {
+                s_wake_latency_us.store(esp_timer_get_time() - s_wake_publish_us.load());
+                ESP_LOGI(TAG, "唤醒词: %s (%.2f)", data.text, data.probability);
+            }
+        });
+
+    // 在回调中取消自己的订阅，之后的事件不再送达
+    s_started_id = event_bus.subscribe<Topic::WAKEWORD_STARTED>(
+        [](const NoPayload&)
+        {
+            s_started_count++;
+            EventBus::getInstance().unsubscribe(s_started_id);
+        });
+
+    // 1. 传感器域积压时，唤醒词事件不受影响
+    LightData light;
+    for (int i = 0; i < 8; i++)
+    {
+        light.ch0 = static_cast<uint16_t>(i);
+        event_bus.publish<Topic::LIGHT_CHANGED>(light);
+    }
+
+    WakeWordEventData wake{};
+    strncpy(wake.text, "ni hao", sizeof(wake.text) - 1);
+    wake.probability = 0.9f;
+    s_wake_publish_us.store(esp_timer_get_time());
+    event_bus.publish<Topic::WAKEWORD_DETECTED>(wake);
+
+    TaskManager::delayMs(50);
+    ESP_LOGI(TAG, "唤醒词延迟 %lld us，此时光照事件已处理 %d/8",
+             (long long)s_wake_latency_us.load(), s_light_count.load());
+    if (s_wake_count.load() != 1 || s_light_count.load() >= 8)
+    {
+        ESP_LOGE(TAG, "唤醒词事件被传感器事件阻塞");
+    }
+
+    // 2. 回调中取消订阅
+    event_bus.publish<Topic::WAKEWORD_STARTED>();
+    event_bus.publish<Topic::WAKEWORD_STARTED>();
+
+    // 3. 压力测试：连续发布直到负载池或队列满
+    int published = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        if (event_bus.publish<Topic::WAKEWORD_DETECTED>(wake))
+        {
+            published++;
+        }
+        if (i % 16 == 0)
+        {
+            TaskManager::delayMs(1);
+        }
+    }
+
+    TaskManager::delayMs(1000);
+    ESP_LOGI(TAG, "启动事件 %d 次（期望 1 次），唤醒词 %d/%d，光照 %d/8",
+             s_started_count.load(), s_wake_count.load(), published + 1, s_light_count.load());
+
+    event_bus.logStats();
+    ESP_LOGI(TAG, "测试完成");
+}
@@ -0,0 +1,69 @@
+#include "system/task/executor/executor.hpp"
+#include "system/task/task.hpp"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* const TAG = "ExecutorTest";
+
+using app::sys::task::Executor;
+using app::sys::task::JobHandle;
+using app::sys::task::JobStats;
+using app::sys::task::Lane;
+using app::sys::task::TaskManager;
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "=== 作业执行器测试 ===");
+
+    auto&   executor = Executor::getInstance();
+    int64_t start_us = esp_timer_get_time();
+
+    // ==========================================
+    // 立即执行和延时执行
+    // ==========================================
+    ESP_LOGI(TAG, "--- 立即 / 延时作业 ---");
+    executor.post("hello", []() { ESP_LOGI(TAG, "立即作业在核心 %d 上执行", xPortGetCoreID()); });
+    executor.postDelayed("delayed", 500, [start_us]() {
+        ESP_LOGI(TAG, "延时作业执行，距提交 %lld ms",
+                 (long long)((esp_timer_get_time() - start_us) / 1000));
+    });
+    TaskManager::delayMs(1000);
+
+    // ==========================================
+    // 周期作业和取消
+    // ==========================================
+    ESP_LOGI(TAG, "--- 周期作业 ---");
+    std::atomic<int> ticks{0};
+    JobHandle        periodic =
+        executor.postPeriodic("blink", 100, [&ticks]() { ticks++; }, Lane::HIGH, 0);
+    JobHandle cancelled = executor.postDelayed("cancelled", 200, []() {
+        ESP_LOGE(TAG, "已取消的作业不应执行");
+    });
+    cancelled.cancel();
+
+    TaskManager::delayMs(1050);
+    periodic.cancelAndWait();
+    ESP_LOGI(TAG, "周期作业 1 秒内执行 %d 次（期望 10-11 次）", ticks.load());
+
+    // ==========================================
+    // 长作业：记为超时，周期作业跳过错过的周期
+    // ==========================================
+    ESP_LOGI(TAG, "--- 长作业 ---");
+    JobHandle slow = executor.postPeriodic(
+        "slow", 20, []() { TaskManager::delayUs(30000); }, Lane::LOW);
+    TaskManager::delayMs(500);
+    slow.cancelAndWait();
+
+    JobStats stats;
+    if (executor.getStats("slow", stats))
+    {
+        ESP_LOGI(TAG, "slow: 执行 %lu 次, 超时 %lu 次, 跳过 %lu 个周期", (unsigned long)stats.runs,
+                 (unsigned long)stats.overruns, (unsigned long)stats.skipped);
+    }
+
+    executor.logStats();
+    ESP_LOGI(TAG, "测试完成");
+}
@@ -0,0 +1,122 @@
+#include "i2c/i2c.hpp"
+#include "i2c/scheduler/scheduler.hpp"
+#include "system/task/task.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include <atomic>
+
+static const char* const TAG = "Main";
+
+using namespace app::i2c;
+
+namespace
+{
+    constexpr uint8_t PCA9685_ADDR  = 0x44; // 舵机驱动（高优先级）
+    constexpr uint8_t APDS9930_ADDR = 0x39; // 环境光（低优先级）
+
+    std::atomic<uint32_t> async_done{0};
+    std::atomic<uint32_t> async_failed{0};
+
+    i2c_master_dev_handle_t addDevice(i2c_master_bus_handle_t bus, uint8_t addr)
+    {
+        i2c_device_config_t dev_cfg = {};
+        dev_cfg.dev_addr_length     = I2C_ADDR_BIT_LEN_7;
+        dev_cfg.device_address      = addr;
+        dev_cfg.scl_speed_hz        = 400000;
+
+        i2c_master_dev_handle_t handle = nullptr;
+        if (i2c_master_bus_add_device(bus, &dev_cfg, &handle) != ESP_OK)
+        {
+            return nullptr;
+        }
+        return handle;
+    }
+} // namespace
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "=== I2C Scheduler Test Start ===");
+
+    I2c i2c;
+    if (!i2c.init())
+    {
+        ESP_LOGE(TAG, "Failed to initialize I2C");
+        return;
+    }
+
+    auto& scheduler = scheduler::Scheduler::getInstance();
+    if (!scheduler.start())
+    {
+        ESP_LOGE(TAG, "Failed to start I2C scheduler");
+        return;
+    }
+
+    i2c_master_dev_handle_t servo_handle = addDevice(i2c.getBusHandle(), PCA9685_ADDR);
+    i2c_master_dev_handle_t light_handle = addDevice(i2c.getBusHandle(), APDS9930_ADDR);
+    if (servo_handle == nullptr || light_handle == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to add I2C devices");
+        return;
+    }
+
+    scheduler::DeviceId servo =
+        scheduler.registerDevice("PCA9685", servo_handle, scheduler::Priority::HIGH);
+    scheduler::DeviceId light =
+        scheduler.registerDevice("APDS9930", light_handle, scheduler::Priority::LOW);
+
+    // 后台任务持续提交低优先级异步读（模拟遥测），读取 APDS9930 的 ID 寄存器
+    app::sys::task::Config task_config = app::sys::task::Config::createLightweight(
+        "light_flood", app::sys::task::Priority::LOW);
+    app::sys::task::Task flood_task(
+        [light, &scheduler](void*)
+        {
+            static uint8_t reg = 0x80 | 0x12;
+            static uint8_t id  = 0;
+            while (true)
+            {
+                scheduler.submit(light, &reg, 1, &id, 1,
+                                 [](esp_err_t result)
+                                 {
+                                     async_done++;
+                                     if (result != ESP_OK)
+                                     {
+                                         async_failed++;
+                                     }
+                                 });
+                app::sys::task::TaskManager::delayMs(2);
+            }
+        },
+        task_config);
+    flood_task.start();
+
+    // 主任务以 20ms 周期写舵机通道 0 的 LED0 寄存器，统计同步写的最长耗时
+    uint32_t max_latency_us = 0;
+    for (int i = 0; i < 250; i++)
+    {
+        uint8_t buffer[5] = {0x06, 0x00, 0x00, static_cast<uint8_t>(i & 0xFF), 0x01};
+
+        int64_t   start  = esp_timer_get_time();
+        esp_err_t result = scheduler.transmit(servo, buffer, sizeof(buffer));
+        uint32_t  cost   = static_cast<uint32_t>(esp_timer_get_time() - start);
+        if (cost > max_latency_us)
+        {
+            max_latency_us = cost;
+        }
+        if (result != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Servo write failed: %s", esp_err_to_name(result));
+        }
+
+        app::sys::task::TaskManager::delayMs(20);
+    }
+
+    flood_task.destroy();
+
+    ESP_LOGI(TAG, "Servo write max latency: %lu us", (unsigned long)max_latency_us);
+    ESP_LOGI(TAG, "Async light reads: %lu done, %lu failed", (unsigned long)async_done.load(),
+             (unsigned long)async_failed.load());
+    scheduler.logStats();
+
+    ESP_LOGI(TAG, "=== I2C Scheduler Test End ===");
+}
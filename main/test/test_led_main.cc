@@ -158,6 +158,24 @@ extern "C" void app_main(void)
     ESP_LOGI(TAG, "  LED已恢复最亮");
     TaskManager::delayMs(2000);
 
+    // ========== 示例13: 效果叠加 ==========
+    ESP_LOGI(TAG, "\n[示例8] 白色底色上淡入情绪颜色，再叠加音频电平");
+    led.setColor(gpio, Color(60, 60, 60));
+    led.setEmotionColor(gpio, Color(255, 160, 0)); // 开心：暖黄色
+    TaskManager::delayMs(2000);
+
+    led.enableAudioLevel(gpio, Color(0, 0, 255));
+    for (int i = 0; i < 100; i++)
+    {
+        // 模拟说话时的电平起伏
+        led.setAudioLevel(static_cast<uint8_t>((i * 37) % 256));
+        TaskManager::delayMs(20);
+    }
+    led.disableAudioLevel();
+
+    led.clearEmotionColor(); // 淡出，恢复白色底色
+    TaskManager::delayMs(1000);
+
     // 关闭LED
     led.setColor(gpio, Color(0, 0, 0));
 }
@@ -1,5 +1,6 @@
 #include "system/info/info.hpp"
 #include "system/task/task.hpp"
+#include "system/task/stack/stack.hpp"
 
 #include "esp_log.h"
 
@@ -28,6 +29,19 @@ void testTask2(void* param)
     ESP_LOGI(TAG, "Task2 完成");
 }
 
+// 使用一段栈空间，便于观察栈水位
+void stackUserTask(void* param)
+{
+    volatile uint8_t buffer[1500];
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(i);
+    }
+    ESP_LOGI(TAG, "%s 运行中，栈剩余: %u 字节", pcTaskGetName(nullptr),
+             (unsigned)(uxTaskGetStackHighWaterMark(nullptr) * sizeof(StackType_t)));
+    app::sys::task::TaskManager::delayMs(500);
+}
+
 extern "C" void app_main(void)
 {
     ESP_LOGI(TAG, "=== Task Module Test ===");
@@ -110,6 +124,37 @@ extern "C" void app_main(void)
         ESP_LOGI(TAG, "找到的任务信息: 名称=%s, 优先级=%u", found_info.name, found_info.priority);
     }
 
+    // 测试静态栈任务（内部 RAM / PSRAM）和栈水位采样
+    auto& tuner = app::sys::task::stack::StackTuner::getInstance();
+    tuner.start(100, 0);
+    {
+        app::sys::task::Config config3 = app::sys::task::Config::createLightweight("StaticInt");
+        config3.stack_size             = 4096;
+        config3.stack_region           = app::sys::task::StackRegion::INTERNAL;
+        app::sys::task::Task task3(stackUserTask, config3);
+
+        app::sys::task::Config config4 = app::sys::task::Config::createLightweight("StaticPsram");
+        config4.stack_size             = 4096;
+        config4.stack_region           = app::sys::task::StackRegion::PSRAM;
+        app::sys::task::Task task4(stackUserTask, config4);
+
+        if (task3.start() && task4.start())
+        {
+            ESP_LOGI(TAG, "静态栈任务启动成功");
+        }
+        app::sys::task::TaskManager::delayMs(1000);
+
+        // 任务函数已返回，任务挂起等待删除；重新启动复用同一块栈
+        task3.destroy();
+        if (task3.start())
+        {
+            ESP_LOGI(TAG, "静态栈任务重新启动成功");
+        }
+        app::sys::task::TaskManager::delayMs(1000);
+        ESP_LOGI(TAG, "StaticPsram 栈剩余: %u 字节", (unsigned)task4.getStackHighWaterMark());
+    } // 析构时删除任务并释放静态栈
+    tuner.stop(); // 输出报告和建议栈大小
+
     ESP_LOGI(TAG, "最终系统任务数量: %lu", task_mgr.getTaskCount());
     ESP_LOGI(TAG, "测试完成");
 }
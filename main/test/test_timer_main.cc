@@ -0,0 +1,72 @@
+#include "system/timer/timer.hpp"
+#include "system/task/task.hpp"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* const TAG = "TimerTest";
+
+using app::sys::task::TaskManager;
+using app::sys::timer::Stats;
+using app::sys::timer::Timer;
+using app::sys::timer::TimerWheel;
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "=== 时间轮测试 ===");
+
+    TimerWheel wheel;
+    if (!wheel.init("timer_test"))
+    {
+        ESP_LOGE(TAG, "时间轮初始化失败");
+        return;
+    }
+
+    // ==========================================
+    // 单次定时器：到期误差
+    // ==========================================
+    ESP_LOGI(TAG, "--- 单次定时器 ---");
+    int64_t start_us = esp_timer_get_time();
+    Timer   once([start_us]() {
+        ESP_LOGI(TAG, "单次定时器到期，距启动 %lld us（期望 250000-251000）",
+                 (long long)(esp_timer_get_time() - start_us));
+    });
+    wheel.start(once, 250);
+
+    // 跨越多层的定时器（5 秒，需要从第 2 层迁移下来）
+    Timer far([start_us]() {
+        ESP_LOGI(TAG, "5 秒定时器到期，距启动 %lld ms",
+                 (long long)((esp_timer_get_time() - start_us) / 1000));
+    });
+    wheel.start(far, 5000);
+
+    // 停止后不应到期
+    Timer stopped([]() { ESP_LOGE(TAG, "已停止的定时器不应到期"); });
+    wheel.start(stopped, 300);
+    wheel.stop(stopped);
+
+    // ==========================================
+    // 周期定时器
+    // ==========================================
+    ESP_LOGI(TAG, "--- 周期定时器 ---");
+    std::atomic<int> ticks{0};
+    Timer            periodic([&ticks]() { ticks++; });
+    wheel.start(periodic, 100, 100);
+
+    TaskManager::delayMs(1050);
+    wheel.stop(periodic);
+    ESP_LOGI(TAG, "周期定时器 1 秒内到期 %d 次（期望 10 次）", ticks.load());
+
+    TaskManager::delayMs(4500);
+
+    Stats stats = wheel.getStats();
+    ESP_LOGI(TAG, "统计: 活动 %lu, 到期 %lu, 迁移 %lu, 唤醒 %lu, 跳过 %lu",
+             (unsigned long)stats.active, (unsigned long)stats.fired,
+             (unsigned long)stats.cascades, (unsigned long)stats.wakeups,
+             (unsigned long)stats.skipped);
+
+    wheel.deinit();
+    ESP_LOGI(TAG, "测试完成");
+}
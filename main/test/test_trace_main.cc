@@ -0,0 +1,88 @@
+#include "tool/trace/trace.hpp"
+#include "system/task/task.hpp"
+
+#include <atomic>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char* const TAG = "TraceTest";
+
+using app::sys::task::TaskManager;
+using app::tool::trace::Stats;
+using app::tool::trace::Tracer;
+
+static std::atomic<int> s_finished{0};
+
+// 生产者：周期性地打点并计数，与消费者分别绑定在两个核心上
+static void producerTask(void* param)
+{
+    (void)param;
+    for (int i = 0; i < 200; i++)
+    {
+        TRACE_BEGIN("producer.work");
+        TaskManager::delayUs(200);
+        TRACE_COUNTER("producer.count", i);
+        TRACE_END("producer.work");
+        TaskManager::delayMs(5);
+    }
+    s_finished++;
+    vTaskDelete(nullptr);
+}
+
+static void consumerTask(void* param)
+{
+    (void)param;
+    for (int i = 0; i < 200; i++)
+    {
+        TRACE_SCOPE("consumer.work");
+        TaskManager::delayUs(100);
+        if (i % 50 == 0)
+        {
+            TRACE_INSTANT("consumer.mark");
+        }
+        TaskManager::delayMs(5);
+    }
+    s_finished++;
+    vTaskDelete(nullptr);
+}
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "=== 跟踪记录测试 ===");
+
+#ifndef CONFIG_TRACE_ENABLE
+    ESP_LOGE(TAG, "需要在 menuconfig 中开启 CONFIG_TRACE_ENABLE");
+    return;
+#endif
+
+    auto& tracer = Tracer::getInstance();
+    if (!tracer.init(1024))
+    {
+        ESP_LOGE(TAG, "跟踪初始化失败");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(producerTask, "trace_prod", 3072, nullptr, 5, nullptr, 0);
+    xTaskCreatePinnedToCore(consumerTask, "trace_cons", 3072, nullptr, 5, nullptr, 1);
+
+    while (s_finished.load() < 2)
+    {
+        TaskManager::delayMs(100);
+    }
+
+    Stats stats = tracer.getStats();
+    ESP_LOGI(TAG, "统计: 容量 %u, 记录 %lu, 覆盖 %lu, 丢弃 %lu", (unsigned int)stats.capacity,
+             (unsigned long)stats.records, (unsigned long)stats.overwritten,
+             (unsigned long)stats.dropped);
+
+    // 串口日志保存后用 scripts/trace_to_chrome.py 转换
+    if (!tracer.dumpToConsole())
+    {
+        ESP_LOGE(TAG, "导出失败");
+    }
+
+    tracer.deinit();
+    ESP_LOGI(TAG, "测试完成");
+}
@@ -2,7 +2,7 @@
 #include "i2c/i2c.hpp"
 #include "media/audio/audio.hpp"
 #include "media/audio/wakeword/wakeword.hpp"
-#include "system/event/event.hpp"
+#include "system/event/bus/bus.hpp"
 #include "system/task/task.hpp"
 #include "esp_log.h"
 #include "nvs_flash.h"
@@ -13,7 +13,7 @@ using namespace app::assets;
 using namespace app::i2c;
 using namespace app::media::audio;
 using namespace app::media::audio::wakeword;
-using namespace app::sys::event;
+using namespace app::sys::event::bus;
 
 extern WakeWord* createCustomWakeWord();
 
@@ -76,34 +76,30 @@ extern "C" void app_main(void)
 
     // ========== 1. 事件系统测试 ==========
     ESP_LOGI(TAG, "\n[测试 1] 事件系统");
-    auto& event_mgr = EventManager::getInstance();
-    if (!event_mgr.init())
+    auto& event_bus = EventBus::getInstance();
+    if (!event_bus.init() || !event_bus.startDomain(Domain::AUDIO))
     {
-        ESP_LOGE(TAG, "  事件系统初始化失败");
+        ESP_LOGE(TAG, "  事件总线初始化失败");
         return;
     }
-    ESP_LOGI(TAG, "  事件系统初始化成功");
+    ESP_LOGI(TAG, "  事件总线初始化成功");
 
-    // 注册唤醒词事件
-    event_mgr.registerHandler(
-        WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_DETECTED,
-        [](esp_event_base_t, EventId, const EventData& data)
+    // 订阅唤醒词事件
+    event_bus.subscribe<Topic::WAKEWORD_DETECTED>(
+        [](const WakeWordEventData& event)
         {
-            const auto* event = static_cast<const WakeWordEventData*>(data.data);
             g_detection_count++;
             ESP_LOGI(TAG, "");
-            ESP_LOGI(TAG, "  ★ 检测到唤醒词: %s", event->text);
-            ESP_LOGI(TAG, "    置信度: %.2f, 累计次数: %d", event->probability, g_detection_count);
+            ESP_LOGI(TAG, "  ★ 检测到唤醒词: %s", event.text);
+            ESP_LOGI(TAG, "    置信度: %.2f, 累计次数: %d", event.probability, g_detection_count);
         });
 
-    event_mgr.registerHandler(WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_STARTED,
-                              [](esp_event_base_t, EventId, const EventData&)
-                              { ESP_LOGI(TAG, "  [事件] 唤醒词检测已启动"); });
+    event_bus.subscribe<Topic::WAKEWORD_STARTED>([](const NoPayload&)
+                                                 { ESP_LOGI(TAG, "  [事件] 唤醒词检测已启动"); });
 
-    event_mgr.registerHandler(WAKEWORD_EVENT_BASE, WAKEWORD_EVENT_STOPPED,
-                              [](esp_event_base_t, EventId, const EventData&)
-                              { ESP_LOGI(TAG, "  [事件] 唤醒词检测已停止"); });
-    ESP_LOGI(TAG, "  事件处理器注册成功");
+    event_bus.subscribe<Topic::WAKEWORD_STOPPED>([](const NoPayload&)
+                                                 { ESP_LOGI(TAG, "  [事件] 唤醒词检测已停止"); });
+    ESP_LOGI(TAG, "  事件订阅成功");
 
     // ========== 2. Assets 测试 ==========
     ESP_LOGI(TAG, "\n[测试 2] Assets 系统");
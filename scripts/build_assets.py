@@ -7,6 +7,8 @@
 - VADNet: 语音活动检测模型 (vadnet*)
 - NSNet: 噪声抑制模型 (nsnet*)
 - MultiNet: 语音命令识别模型 (mn*_cn, mn*_en 等)
+
+另外可以把预置动作片段（JSON）编译为 motions.bin 一起打包
 """
 
 import argparse
@@ -360,6 +362,125 @@ def generate_index_json(assets_dir, srmodels, multinet_model_info):
     return True
 
 
+# 动作片段库格式（与 main/app/move/clip/clip.hpp 保持一致）
+MOTION_CLIP_MAGIC = 0x434D5045  # "EPMC"
+MOTION_CLIP_VERSION = 1
+MOTION_CLIP_HEADER_FORMAT = '<IHH'
+MOTION_CLIP_ENTRY_FORMAT = '<HHII16s'
+MOTION_CLIP_KEYFRAME_FORMAT = '<IIBBBx'
+MOTION_CLIP_NAME_LEN = 15  # 不含结尾的 '\0'
+
+# 运动部位到通道号的映射（与 mapMovePartToChannel 一致，254 为电机）
+MOTION_PARTS = {'h1': 0, 'h2': 1, 'b1': 2, 'h3': 3, 'b2': 254}
+
+# 缓动类型（与 timeline::Easing 的顺序一致）
+MOTION_EASINGS = [
+    'linear', 'ease_in', 'ease_out', 'ease_in_out', 'ease_in_quad', 'ease_out_quad',
+    'ease_in_out_quad', 'ease_in_cubic', 'ease_out_cubic', 'ease_in_out_cubic'
+]
+
+
+def compile_motion_clip(clip):
+    """
+    把一个片段的步骤编译为关键帧列表
+    返回: (关键帧列表, 时长)，关键帧为 (start_time, duration, channel, angle, easing)
+    """
+    keyframes = []
+    for step in clip.get('steps', []):
+        move_part = step.get('move_part')
+        if move_part not in MOTION_PARTS:
+            raise ValueError(f"未知的运动部位: {move_part}")
+        easing = step.get('easing', 'linear')
+        if easing not in MOTION_EASINGS:
+            raise ValueError(f"未知的缓动类型: {easing}")
+        start_time = int(step.get('start_time', 0))
+        duration = int(step.get('duration', 0))
+        angle = int(step['angle'])
+        if start_time < 0 or duration < 0 or not 0 <= angle <= 180:
+            raise ValueError(f"步骤参数超出范围: {step}")
+        keyframes.append((start_time, duration, MOTION_PARTS[move_part], angle,
+                          MOTION_EASINGS.index(easing)))
+
+    if not keyframes:
+        raise ValueError("片段没有任何步骤")
+
+    # 稳定排序，同一时刻的步骤保持原有顺序（设备端以靠后者为准）
+    keyframes.sort(key=lambda keyframe: keyframe[0])
+    duration = max(start + length for start, length, _, _, _ in keyframes)
+    return keyframes, duration
+
+
+def pack_motion_clips(clips_file, out_file):
+    """
+    把动作片段描述文件（JSON）编译为 motions.bin
+
+    JSON 格式:
+    {
+        "clips": [
+            {
+                "id": 1,
+                "name": "nod",
+                "steps": [
+                    {"move_part": "h2", "start_time": 0, "angle": 60, "duration": 250,
+                     "easing": "ease_in_out"},
+                    ...
+                ]
+            },
+            ...
+        ]
+    }
+
+    二进制格式（小端）:
+    {
+        magic: uint32, version: uint16, clip_count: uint16
+        clip_entry * clip_count（按 id 升序）:
+            id: uint16, keyframe_count: uint16, offset: uint32, duration: uint32, name: char[16]
+        keyframe * N:
+            start_time: uint32, duration: uint32, channel: uint8, angle: uint8, easing: uint8,
+            reserved: uint8
+    }
+    """
+    with open(clips_file, 'r', encoding='utf-8') as f:
+        clips = json.load(f).get('clips', [])
+
+    compiled = {}
+    for clip in clips:
+        clip_id = int(clip['id'])
+        name = clip.get('name', '')
+        if not 0 <= clip_id <= 0xFFFF:
+            raise ValueError(f"片段 id 超出范围: {clip_id}")
+        if clip_id in compiled:
+            raise ValueError(f"片段 id 重复: {clip_id}")
+        if len(name.encode('utf-8')) > MOTION_CLIP_NAME_LEN:
+            raise ValueError(f'片段名称超过 {MOTION_CLIP_NAME_LEN} 字节: "{name}"')
+        try:
+            keyframes, duration = compile_motion_clip(clip)
+        except (KeyError, ValueError) as e:
+            raise ValueError(f"片段 {clip_id} ({name}) 无效: {e}")
+        compiled[clip_id] = (name, keyframes, duration)
+
+    header_len = (struct.calcsize(MOTION_CLIP_HEADER_FORMAT) +
+                  len(compiled) * struct.calcsize(MOTION_CLIP_ENTRY_FORMAT))
+    out_bin = struct.pack(MOTION_CLIP_HEADER_FORMAT, MOTION_CLIP_MAGIC, MOTION_CLIP_VERSION,
+                          len(compiled))
+    data_bin = b''
+    for clip_id in sorted(compiled):
+        name, keyframes, duration = compiled[clip_id]
+        out_bin += struct.pack(MOTION_CLIP_ENTRY_FORMAT, clip_id, len(keyframes),
+                               header_len + len(data_bin), duration, name.encode('utf-8'))
+        for keyframe in keyframes:
+            data_bin += struct.pack(MOTION_CLIP_KEYFRAME_FORMAT, *keyframe)
+
+    assert len(out_bin) == header_len, f"头部长度不匹配: {len(out_bin)} != {header_len}"
+    out_bin += data_bin
+
+    with open(out_file, 'wb') as f:
+        f.write(out_bin)
+
+    print(f"已生成: {out_file} ({len(compiled)} 个片段, {len(out_bin)} 字节)")
+    return True
+
+
 def compute_checksum(data):
     """计算校验和"""
     return sum(data) & 0xFFFF
@@ -437,7 +558,7 @@ def pack_assets_simple(target_path, include_path, out_file, assets_path, max_nam
 
 
 def build_assets(model_names, esp_sr_model_path, output_path, 
-                 cn_wake_word=None, en_wake_word=None, threshold=0.2):
+                 cn_wake_word=None, en_wake_word=None, threshold=0.2, motion_clips=None):
     """
     构建 assets.bin，支持多种模型类型
     
@@ -450,6 +571,7 @@ def build_assets(model_names, esp_sr_model_path, output_path,
         cn_wake_word: 中文唤醒词（可选，仅用于 multinet）
         en_wake_word: 英文唤醒词（可选，仅用于 multinet）
         threshold: 检测阈值（0.0-1.0，仅用于 multinet）
+        motion_clips: 动作片段描述文件路径（可选，编译为 motions.bin）
     """
     # 创建临时构建目录
     temp_build_dir = os.path.join(os.path.dirname(output_path), "temp_build")
@@ -528,6 +650,13 @@ def build_assets(model_names, esp_sr_model_path, output_path,
             if not multinet_model_info["commands"]:
                 print("提示: 未指定唤醒词，可在运行时通过 esp_mn_commands_add() 动态添加")
         
+        # 编译动作片段
+        if motion_clips:
+            if not os.path.exists(motion_clips):
+                print(f"错误: 动作片段文件不存在: {motion_clips}")
+                return False
+            pack_motion_clips(motion_clips, os.path.join(assets_dir, "motions.bin"))
+
         # 生成 index.json
         generate_index_json(assets_dir, srmodels, multinet_model_info)
         
@@ -586,6 +715,12 @@ def main():
                          --cn_wake_word "你好小智" \\
                          --output assets.bin
 
+  # 同时打包预置动作片段
+  python build_assets.py --esp_sr_model_path ./managed_components/espressif__esp-sr/model \\
+                         --models vadnet1_medium nsnet1 \\
+                         --motion_clips scripts/motion_clips.json \\
+                         --output assets.bin
+
   # 使用完整路径指定自定义模型
   python build_assets.py --esp_sr_model_path ./managed_components/espressif__esp-sr/model \\
                          --models /path/to/custom/model \\
@@ -610,6 +745,8 @@ def main():
                        help='英文唤醒词（可选，仅用于 multinet 模型）')
     parser.add_argument('--threshold', type=float, default=0.2,
                        help='Multinet 检测阈值 (0.0-1.0，默认 0.2)')
+    parser.add_argument('--motion_clips', default=None,
+                       help='动作片段描述文件（JSON，可选），编译为 motions.bin 一起打包')
     
     args = parser.parse_args()
     
@@ -623,6 +760,8 @@ def main():
         print(f"唤醒词: CN={args.cn_wake_word}, EN={args.en_wake_word}")
     if any('mn' in m.lower() or 'multinet' in m.lower() for m in args.models):
         print(f"Multinet 阈值: {args.threshold}")
+    if args.motion_clips:
+        print(f"动作片段: {args.motion_clips}")
     print("=" * 60)
     print()
     
@@ -632,7 +771,8 @@ def main():
         output_path=args.output,
         cn_wake_word=args.cn_wake_word,
         en_wake_word=args.en_wake_word,
-        threshold=args.threshold
+        threshold=args.threshold,
+        motion_clips=args.motion_clips
     )
     
     if not success:
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+飞行记录器导出文件解码脚本
+将设备导出的二进制记录（格式见 main/app/tool/recorder/recorder.hpp）转换为 CSV
+
+用法:
+    python decode_recorder.py dump.bin -o dump.csv
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+DUMP_MAGIC = 0x52465045  # "EPFR"
+DUMP_VERSION = 1
+HEADER_FORMAT = '<IB3xIIIq'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+# 设备状态（与 App::DeviceState 保持一致）
+STATE_NAMES = [
+    'INIT', 'PROVISIONING', 'NTP_SYNC', 'CONNECTING', 'WAKEWORD_WAIT', 'RUNNING', 'ERROR',
+    'RECOVERY'
+]
+
+
+def state_name(value):
+    """状态编号转名称"""
+    return STATE_NAMES[value] if value < len(STATE_NAMES) else str(value)
+
+
+def decode_state(payload):
+    old, new = struct.unpack('<BB', payload)
+    return [state_name(old), state_name(new)]
+
+
+def decode_vad(payload):
+    return [payload[0]]
+
+
+def decode_wakeword(payload):
+    (probability,) = struct.unpack('<H', payload)
+    return ['%.3f' % (probability / 1000.0)]
+
+
+def decode_touch(payload):
+    (mask,) = struct.unpack('<H', payload)
+    return ['0x%03X' % mask]
+
+
+def decode_pressure(payload):
+    return list(struct.unpack('<%dH' % (len(payload) // 2), payload))
+
+
+def decode_gesture(payload):
+    return list(struct.unpack('<BBBH', payload))
+
+
+def decode_light(payload):
+    return list(struct.unpack('<HHHB', payload))
+
+
+def decode_imu(payload):
+    return list(struct.unpack('<6h', payload))
+
+
+# 记录类型: (名称, 负载解码函数)
+RECORD_TYPES = {
+    1: ('state', decode_state),
+    2: ('vad', decode_vad),
+    3: ('wakeword', decode_wakeword),
+    4: ('touch', decode_touch),
+    5: ('pressure', decode_pressure),
+    6: ('gesture', decode_gesture),
+    7: ('light', decode_light),
+    8: ('imu', decode_imu),
+}
+
+
+def read_varint(data, offset):
+    """读取变长整数，返回 (值, 新偏移)"""
+    value = 0
+    shift = 0
+    while True:
+        if offset >= len(data):
+            raise ValueError('变长整数被截断')
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def decode(data):
+    """解码导出数据，逐条返回 (时间微秒, 类型名, 字段列表)"""
+    if len(data) < HEADER_SIZE:
+        raise ValueError('文件过短')
+
+    magic, version, records, length, dropped, base_us = struct.unpack_from(HEADER_FORMAT, data)
+    if magic != DUMP_MAGIC:
+        raise ValueError('魔数错误: 0x%08X' % magic)
+    if version != DUMP_VERSION:
+        raise ValueError('不支持的版本: %d' % version)
+
+    body = data[HEADER_SIZE:HEADER_SIZE + length]
+    if len(body) < length:
+        print('警告: 数据不完整 (%d/%d 字节)' % (len(body), length), file=sys.stderr)
+    if dropped:
+        print('提示: 导出期间丢弃 %d 条记录' % dropped, file=sys.stderr)
+
+    offset = 0
+    timestamp = base_us
+    count = 0
+    while offset < len(body) and count < records:
+        if offset + 2 > len(body):
+            break
+        record_type = body[offset]
+        payload_len = body[offset + 1]
+        delta, offset = read_varint(body, offset + 2)
+        payload = body[offset:offset + payload_len]
+        offset += payload_len
+        if len(payload) < payload_len:
+            break
+
+        timestamp += delta
+        count += 1
+        name, decoder = RECORD_TYPES.get(record_type, ('type_%d' % record_type, None))
+        try:
+            fields = decoder(payload) if decoder else [payload.hex()]
+        except struct.error:
+            fields = [payload.hex()]
+        yield timestamp, name, fields
+
+
+def main():
+    parser = argparse.ArgumentParser(description='飞行记录器导出文件转 CSV')
+    parser.add_argument('input', help='设备导出的二进制文件')
+    parser.add_argument('-o', '--output', help='输出 CSV 文件（默认输出到标准输出）')
+    parser.add_argument('--type', action='append', help='只输出指定类型（可多次指定）')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    out = open(args.output, 'w', newline='') if args.output else sys.stdout
+    try:
+        writer = csv.writer(out)
+        writer.writerow(['time_s', 'type', 'values'])
+        rows = 0
+        for timestamp, name, fields in decode(data):
+            if args.type and name not in args.type:
+                continue
+            writer.writerow(['%.6f' % (timestamp / 1e6), name] + fields)
+            rows += 1
+    except ValueError as e:
+        print('解码失败: %s' % e, file=sys.stderr)
+        return 1
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+    print('解码完成: %d 条记录' % rows, file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
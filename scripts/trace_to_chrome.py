@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+跟踪导出文件转换脚本
+将设备导出的跟踪记录（格式见 main/app/tool/trace/trace.hpp）转换为 Chrome 跟踪 JSON，
+可在 https://ui.perfetto.dev 或 chrome://tracing 中打开
+
+输入可以是二进制导出文件，也可以是包含 TRACE_DUMP_BEGIN/TRACE_DUMP_END 的串口日志。
+
+用法:
+    python trace_to_chrome.py trace.bin -o trace.json
+    python trace_to_chrome.py monitor.log -o trace.json
+"""
+
+import argparse
+import base64
+import json
+import struct
+import sys
+
+DUMP_MAGIC = 0x52545045  # "EPTR"
+DUMP_VERSION = 1
+HEADER_FORMAT = '<IBBHIIIII'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+RECORD_FORMAT = '<IIIBBH'
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+# 事件类型（与 trace::EventType 保持一致）
+TYPE_BEGIN = 1
+TYPE_END = 2
+TYPE_INSTANT = 3
+TYPE_COUNTER = 4
+TYPE_SYNC = 5
+
+FLAG_ISR = 0x01
+CYCLES_MASK = 0xFFFFFFFF
+PID = 1
+
+
+def extract_console(text):
+    """从串口日志中取出最后一次完整导出的二进制数据"""
+    dumps = []
+    lines = None
+    expected = 0
+    for line in text.splitlines():
+        if 'TRACE_DUMP_BEGIN' in line:
+            lines = []
+            expected = int(line.split('TRACE_DUMP_BEGIN')[1].split()[0])
+        elif 'TRACE_DUMP_END' in line:
+            if lines is not None:
+                dumps.append((b''.join(lines), expected))
+            lines = None
+        elif lines is not None and 'TRACE:' in line:
+            lines.append(base64.b64decode(line.split('TRACE:', 1)[1].strip()))
+
+    if not dumps:
+        raise ValueError('日志中没有完整的跟踪导出')
+    data, expected = dumps[-1]
+    if len(data) != expected:
+        print('警告: 数据长度不符 (%d/%d 字节)' % (len(data), expected), file=sys.stderr)
+    return data
+
+
+def read_table(data, offset, count):
+    """读取名称表或任务表，返回 ({地址: 字符串}, 新偏移)"""
+    table = {}
+    for _ in range(count):
+        if offset + 5 > len(data):
+            raise ValueError('表被截断')
+        key, length = struct.unpack_from('<IB', data, offset)
+        offset += 5
+        table[key] = data[offset:offset + length].decode('utf-8', errors='replace')
+        offset += length
+    return table, offset
+
+
+def decode(data):
+    """解码导出数据，返回 (文件头字典, 各核心记录列表, 名称表, 任务表)"""
+    if len(data) < HEADER_SIZE:
+        raise ValueError('文件过短')
+
+    (magic, version, cores, record_size, cpu_hz, overwritten, dropped, name_count,
+     task_count) = struct.unpack_from(HEADER_FORMAT, data)
+    if magic != DUMP_MAGIC:
+        raise ValueError('魔数错误: 0x%08X' % magic)
+    if version != DUMP_VERSION:
+        raise ValueError('不支持的版本: %d' % version)
+    if record_size != RECORD_SIZE:
+        raise ValueError('记录长度错误: %d' % record_size)
+
+    counts = struct.unpack_from('<%dI' % cores, data, HEADER_SIZE)
+    offset = HEADER_SIZE + 4 * cores
+
+    per_core = []
+    for count in counts:
+        end = offset + count * RECORD_SIZE
+        if end > len(data):
+            raise ValueError('记录被截断')
+        per_core.append([struct.unpack_from(RECORD_FORMAT, data, pos)
+                         for pos in range(offset, end, RECORD_SIZE)])
+        offset = end
+
+    names, offset = read_table(data, offset, name_count)
+    tasks, offset = read_table(data, offset, task_count)
+
+    header = {
+        'cores': cores,
+        'cpu_hz': cpu_hz,
+        'overwritten': overwritten,
+        'dropped': dropped,
+    }
+    return header, per_core, names, tasks
+
+
+def to_events(header, per_core, names, tasks):
+    """转换为按时间排序的 Chrome 跟踪事件列表"""
+    cpu_mhz = header['cpu_hz'] / 1e6
+    if cpu_mhz <= 0:
+        raise ValueError('CPU 频率无效')
+
+    raw = []
+    skipped = 0
+    for core, records in enumerate(per_core):
+        # 周期计数按核心独立，以最近一次 SYNC 为基准换算为微秒
+        anchor = None
+        for cycles, name, arg, record_type, flags, _ in records:
+            if record_type == TYPE_SYNC:
+                anchor = (cycles, name | (arg << 32))
+                continue
+            if anchor is None:
+                # 缓冲覆盖了之前的 SYNC，无法确定时间
+                skipped += 1
+                continue
+            ts = anchor[1] + ((cycles - anchor[0]) & CYCLES_MASK) / cpu_mhz
+            raw.append((ts, core, name, arg, record_type, flags))
+
+    if skipped:
+        print('提示: %d 条记录缺少时间基准，已跳过' % skipped, file=sys.stderr)
+    raw.sort(key=lambda item: item[0])
+
+    events = [{'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'EmotiPet'}}]
+    threads = {}
+    depth = {}
+    unmatched = 0
+    for ts, core, name, arg, record_type, flags in raw:
+        label = names.get(name, '0x%08X' % name)
+        event = {'name': label, 'pid': PID, 'ts': round(ts, 3)}
+
+        if record_type == TYPE_COUNTER:
+            event.update({'ph': 'C', 'args': {label: arg}})
+            events.append(event)
+            continue
+
+        # 中断中的记录放到每个核心单独的线程上，任务按句柄区分
+        if flags & FLAG_ISR:
+            tid = core
+            threads.setdefault(tid, 'ISR (core %d)' % core)
+        else:
+            tid = arg
+            threads.setdefault(tid, tasks.get(arg, 'task 0x%08X' % arg))
+        event.update({'tid': tid, 'args': {'core': core}})
+
+        if record_type == TYPE_BEGIN:
+            depth[tid] = depth.get(tid, 0) + 1
+            event['ph'] = 'B'
+        elif record_type == TYPE_END:
+            # 对应的 BEGIN 已被覆盖
+            if depth.get(tid, 0) == 0:
+                unmatched += 1
+                continue
+            depth[tid] -= 1
+            event['ph'] = 'E'
+        elif record_type == TYPE_INSTANT:
+            event.update({'ph': 'i', 's': 't'})
+        else:
+            continue
+        events.append(event)
+
+    if unmatched:
+        print('提示: %d 个区间缺少开始记录，已跳过' % unmatched, file=sys.stderr)
+
+    for tid, name in threads.items():
+        events.append({'ph': 'M', 'pid': PID, 'tid': tid, 'name': 'thread_name',
+                       'args': {'name': name}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description='跟踪导出文件转 Chrome 跟踪 JSON')
+    parser.add_argument('input', help='设备导出的二进制文件或串口日志')
+    parser.add_argument('-o', '--output', help='输出 JSON 文件（默认输出到标准输出）')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    try:
+        if len(data) < 4 or struct.unpack_from('<I', data)[0] != DUMP_MAGIC:
+            data = extract_console(data.decode('utf-8', errors='replace'))
+        header, per_core, names, tasks = decode(data)
+        events = to_events(header, per_core, names, tasks)
+    except ValueError as e:
+        print('转换失败: %s' % e, file=sys.stderr)
+        return 1
+
+    if header['overwritten']:
+        print('提示: %d 条较早的记录已被覆盖' % header['overwritten'], file=sys.stderr)
+    if header['dropped']:
+        print('提示: 导出期间丢弃 %d 条记录' % header['dropped'], file=sys.stderr)
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    try:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ms'}, out)
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+    print('转换完成: %d 个事件' % len(events), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
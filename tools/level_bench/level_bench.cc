@@ -0,0 +1,167 @@
+// 音频电平表主机基准：检查 LevelMeter 的读数和包络回落时间，并测量每帧的处理时间。
+//
+// 用法：
+//   level_bench [--frame N] [--frames N] [--max-ns NS]
+//
+//   --frame N    每帧采样数（默认 160，即 16kHz 下 10ms）
+//   --frames N   计时的帧数（默认 200000）
+//   --max-ns NS  每帧处理时间上限（纳秒），超过时返回非 0
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "media/audio/level/level.hpp"
+
+using app::media::audio::level::FLOOR_DB;
+using app::media::audio::level::LevelMeter;
+using app::media::audio::level::RELEASE_MS;
+
+namespace
+{
+    constexpr uint32_t SAMPLE_RATE = 16000;
+
+    // dBFS 对应的理论电平
+    int expectedLevel(double db)
+    {
+        double level = (db - FLOOR_DB) * 255.0 / -FLOOR_DB;
+        return static_cast<int>(std::lround(std::max(0.0, std::min(255.0, level))));
+    }
+
+    // 指定 RMS（dBFS）的正弦波
+    std::vector<int16_t> sine(double db, size_t samples)
+    {
+        double               amplitude = 32767.0 * std::sqrt(2.0) * std::pow(10.0, db / 20.0);
+        std::vector<int16_t> data(samples);
+        for (size_t i = 0; i < samples; i++)
+        {
+            double value = amplitude * std::sin(2.0 * M_PI * 440.0 * i / SAMPLE_RATE);
+            data[i]      = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, value)));
+        }
+        return data;
+    }
+
+    // 把一段信号按帧送入电平表，返回最后的读数
+    app::media::audio::level::Reading feed(LevelMeter& meter, const std::vector<int16_t>& data,
+                                           size_t frame)
+    {
+        for (size_t offset = 0; offset + frame <= data.size(); offset += frame)
+        {
+            meter.process(data.data() + offset, frame);
+        }
+        return meter.read();
+    }
+
+    bool checkLevels(size_t frame)
+    {
+        LevelMeter& meter = LevelMeter::input();
+        meter.setSampleRate(SAMPLE_RATE);
+        bool ok = true;
+
+        printf("电平（稳态正弦波，允许误差 ±3）：\n");
+        const double levels_db[] = {-70.0, -50.0, -30.0, -20.0, -10.0, -3.0};
+        for (double db : levels_db)
+        {
+            auto reading  = feed(meter, sine(db, SAMPLE_RATE), frame);
+            int  expected = expectedLevel(db);
+            bool pass     = std::abs(reading.level - expected) <= 3;
+            printf("  %6.1f dBFS: 电平 %3u, 峰值 %3u, 理论 %3d %s\n", db, reading.level,
+                   reading.peak, expected, pass ? "" : "  <-- 超出");
+            ok = ok && pass;
+        }
+
+        // 满量程后静音：RELEASE_MS 后（加一帧余量）回落到 0
+        feed(meter, sine(-3.0, SAMPLE_RATE), frame);
+        std::vector<int16_t> silence(frame, 0);
+        size_t               frames_to_zero = 0;
+        while (meter.read().level > 0 && frames_to_zero < 1000)
+        {
+            meter.process(silence.data(), frame);
+            frames_to_zero++;
+        }
+        double release_ms = frames_to_zero * frame * 1000.0 / SAMPLE_RATE;
+        bool   pass       = release_ms <= RELEASE_MS + frame * 1000.0 / SAMPLE_RATE;
+        printf("回落到 0: %.0f ms（上限 %lu ms）%s\n", release_ms, (unsigned long)RELEASE_MS,
+               pass ? "" : "  <-- 超出");
+        return ok && pass;
+    }
+
+    double benchmark(size_t frame, size_t frames)
+    {
+        // 随机噪声，避免分支预测对峰值比较过于有利
+        std::mt19937                           rng(1);
+        std::uniform_int_distribution<int32_t> dist(-32768, 32767);
+        std::vector<int16_t>                   data(frame * 64);
+        for (auto& sample : data)
+        {
+            sample = static_cast<int16_t>(dist(rng));
+        }
+
+        LevelMeter& meter = LevelMeter::output();
+        meter.setSampleRate(SAMPLE_RATE);
+
+        auto     start    = std::chrono::steady_clock::now();
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < frames; i++)
+        {
+            meter.process(data.data() + (i % 64) * frame, frame);
+            checksum += meter.getLevel();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+        printf("处理时间: %.0f ns / 帧（%lu 采样，%lu 帧，校验和 %lu）\n", ns,
+               (unsigned long)frame, (unsigned long)frames, (unsigned long)checksum);
+        return ns;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t frame  = 160;
+    size_t frames = 200000;
+    double max_ns = -1.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frame") == 0 && i + 1 < argc)
+        {
+            frame = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--max-ns") == 0 && i + 1 < argc)
+        {
+            max_ns = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "用法: %s [--frame N] [--frames N] [--max-ns NS]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frame == 0 || frames == 0)
+    {
+        fprintf(stderr, "帧大小和帧数必须大于 0\n");
+        return 2;
+    }
+
+    bool ok = checkLevels(frame);
+
+    double ns = benchmark(frame, frames);
+    if (max_ns > 0 && ns > max_ns)
+    {
+        printf("处理时间超过上限 %.0f ns\n", max_ns);
+        ok = false;
+    }
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
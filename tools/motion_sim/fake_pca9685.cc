@@ -0,0 +1,352 @@
+#include "fake_pca9685.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "driver/gpio.h"
+#include "driver/i2c_master.h"
+#include "driver/ledc.h"
+#include "esp_timer.h"
+#include "i2c/scheduler/scheduler.hpp"
+
+// PCA9685 寄存器
+static constexpr uint8_t MODE1      = 0x00;
+static constexpr uint8_t MODE1_AI   = 0x20; // 自动递增
+static constexpr uint8_t LED0_ON_L  = 0x06;
+static constexpr uint8_t FULL_BIT   = 0x10; // LEDn_ON_H / LEDn_OFF_H 中的全开 / 全关位
+static constexpr uint8_t MOTOR_DIR  = 46;   // 与 move.cc 中的 MOTOR_B2_DIR_GPIO 一致
+static constexpr int32_t OUTPUT_OFF = -1;   // 通道未输出舵机脉冲（全开、全关或 on 不为 0）
+
+// 仿真的设备句柄只保存地址
+struct i2c_master_dev_t
+{
+    uint16_t address;
+};
+
+namespace sim
+{
+    FakePca9685::FakePca9685()
+    {
+        // 上电默认值：MODE1 = 0x11（sleep + ALLCALL），各通道全关
+        memset(registers_, 0, sizeof(registers_));
+        registers_[MODE1] = 0x11;
+        for (uint8_t ch = 0; ch < SERVO_COUNT; ch++)
+        {
+            registers_[LED0_ON_L + 4 * ch + 3] = FULL_BIT;
+            outputs_[ch]                       = OUTPUT_OFF;
+        }
+        outputs_[MOTOR_SLOT] = 0;
+    }
+
+    esp_err_t FakePca9685::transmit(const uint8_t* data, size_t len)
+    {
+        if (data == nullptr || len == 0)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // AI 位为 0 时所有数据写入同一个寄存器
+            uint8_t reg = data[0];
+            for (size_t i = 1; i < len; i++)
+            {
+                registers_[reg] = data[i];
+                if ((registers_[MODE1] & MODE1_AI) != 0)
+                {
+                    reg = static_cast<uint8_t>(reg + 1);
+                }
+            }
+
+            int64_t now = esp_timer_get_time();
+            for (uint8_t ch = 0; ch < SERVO_COUNT; ch++)
+            {
+                int32_t value = channelValue(ch);
+                if (value != outputs_[ch])
+                {
+                    outputs_[ch] = value;
+                    writes_.push_back({now, ch, value});
+                }
+            }
+        }
+
+        recordTransaction(len + 1);
+        return ESP_OK;
+    }
+
+    esp_err_t FakePca9685::transmitReceive(const uint8_t* write_data, size_t write_len,
+                                           uint8_t* read_data, size_t read_len)
+    {
+        if (write_data == nullptr || write_len == 0 || read_data == nullptr)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint8_t                     reg = write_data[write_len - 1];
+            for (size_t i = 0; i < read_len; i++)
+            {
+                read_data[i] = registers_[reg];
+                if ((registers_[MODE1] & MODE1_AI) != 0)
+                {
+                    reg = static_cast<uint8_t>(reg + 1);
+                }
+            }
+        }
+
+        // 写地址 + 数据，重复起始后再发一次地址
+        recordTransaction(write_len + 1 + read_len + 1);
+        return ESP_OK;
+    }
+
+    void FakePca9685::setMotorDirection(uint32_t level)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        direction_ = level;
+    }
+
+    int FakePca9685::getMotorDirection() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<int>(direction_);
+    }
+
+    void FakePca9685::setMotorDuty(uint32_t duty)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_duty_ = duty;
+    }
+
+    void FakePca9685::updateMotorDuty()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int32_t duty  = static_cast<int32_t>(pending_duty_);
+        int32_t value = direction_ != 0 ? duty : -duty;
+        if (value != outputs_[MOTOR_SLOT])
+        {
+            outputs_[MOTOR_SLOT] = value;
+            writes_.push_back({esp_timer_get_time(), MOTOR_SLOT, value});
+        }
+    }
+
+    std::vector<Write> FakePca9685::takeWrites()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Write>          writes;
+        writes.swap(writes_);
+        return writes;
+    }
+
+    BusStats FakePca9685::getBusStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void FakePca9685::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = BusStats();
+        writes_.clear();
+    }
+
+    uint8_t FakePca9685::getRegister(uint8_t reg) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return registers_[reg];
+    }
+
+    int32_t FakePca9685::channelValue(uint8_t channel) const
+    {
+        const uint8_t* led = registers_ + LED0_ON_L + 4 * channel;
+        uint16_t       on  = static_cast<uint16_t>(led[0] | (led[1] << 8));
+        uint16_t       off = static_cast<uint16_t>(led[2] | (led[3] << 8));
+        if (on != 0 || (off & (FULL_BIT << 8)) != 0)
+        {
+            return OUTPUT_OFF;
+        }
+        return off & 0x0FFF;
+    }
+
+    void FakePca9685::recordTransaction(size_t bytes)
+    {
+        // 每字节 8 位数据 + 1 位应答，忽略起始 / 停止条件
+        uint64_t busy_us = static_cast<uint64_t>(bytes) * 9 * 1000000 / BUS_SPEED_HZ;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.bytes += bytes;
+            stats_.transactions++;
+            stats_.busy_us += busy_us;
+        }
+
+        if (!bus_delay_)
+        {
+            return;
+        }
+        if (sim_clock_is_virtual())
+        {
+            sim_clock_advance(static_cast<int64_t>(busy_us));
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(busy_us));
+        }
+    }
+
+} // namespace sim
+
+// ==================== 驱动接口 ====================
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t    bus_handle,
+                                    const i2c_device_config_t* dev_config,
+                                    i2c_master_dev_handle_t*   ret_handle)
+{
+    if (bus_handle == nullptr || dev_config == nullptr || ret_handle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *ret_handle = new i2c_master_dev_t{dev_config->device_address};
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle)
+{
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t gpio_config(const gpio_config_t* config)
+{
+    return config != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num == MOTOR_DIR)
+    {
+        sim::FakePca9685::getInstance().setMotorDirection(level);
+    }
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (gpio_num == MOTOR_DIR)
+    {
+        return sim::FakePca9685::getInstance().getMotorDirection();
+    }
+    return 0;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t* config)
+{
+    return config != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t* config)
+{
+    return config != nullptr ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty)
+{
+    (void)speed_mode;
+    (void)channel;
+    sim::FakePca9685::getInstance().setMotorDuty(duty);
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t speed_mode, ledc_channel_t channel)
+{
+    (void)speed_mode;
+    (void)channel;
+    sim::FakePca9685::getInstance().updateMotorDuty();
+    return ESP_OK;
+}
+
+// ==================== I2C 调度器 ====================
+//
+// 仿真中调度器不启动任务，事务在调用任务中直接交给 FakePca9685，
+// 与设备上调度器未启动时的退化行为一致
+
+namespace app
+{
+    namespace i2c
+    {
+        namespace scheduler
+        {
+            Scheduler::~Scheduler() = default;
+
+            DeviceId Scheduler::registerDevice(const char* name, i2c_master_dev_handle_t handle,
+                                               Priority priority)
+            {
+                for (size_t i = 0; i < MAX_DEVICES; i++)
+                {
+                    if (!devices_[i].used)
+                    {
+                        devices_[i].used           = true;
+                        devices_[i].handle         = handle;
+                        devices_[i].stats          = DeviceStats();
+                        devices_[i].stats.name     = name;
+                        devices_[i].stats.priority = priority;
+                        return static_cast<DeviceId>(i);
+                    }
+                }
+                return INVALID_DEVICE;
+            }
+
+            bool Scheduler::unregisterDevice(DeviceId id)
+            {
+                // 事务都在调用任务中同步完成，没有需要等待的排队事务
+                if (isValidDevice(id))
+                {
+                    devices_[id].used = false;
+                }
+                return true;
+            }
+
+            bool Scheduler::isValidDevice(DeviceId id) const
+            {
+                return id >= 0 && static_cast<size_t>(id) < MAX_DEVICES && devices_[id].used;
+            }
+
+            esp_err_t Scheduler::transmit(DeviceId id, const uint8_t* data, size_t len,
+                                          int timeout_ms)
+            {
+                (void)timeout_ms;
+                if (!isValidDevice(id))
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (devices_[id].handle->address != sim::PCA9685_ADDR)
+                {
+                    return ESP_FAIL; // 地址上没有设备，相当于 NACK
+                }
+                devices_[id].stats.transactions++;
+                return sim::FakePca9685::getInstance().transmit(data, len);
+            }
+
+            esp_err_t Scheduler::transmitReceive(DeviceId id, const uint8_t* write_data,
+                                                 size_t write_len, uint8_t* read_data,
+                                                 size_t read_len, int timeout_ms)
+            {
+                (void)timeout_ms;
+                if (!isValidDevice(id))
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+                if (devices_[id].handle->address != sim::PCA9685_ADDR)
+                {
+                    return ESP_FAIL;
+                }
+                devices_[id].stats.transactions++;
+                return sim::FakePca9685::getInstance().transmitReceive(write_data, write_len,
+                                                                       read_data, read_len);
+            }
+        } // namespace scheduler
+    } // namespace i2c
+} // namespace app
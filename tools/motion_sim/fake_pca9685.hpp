@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "esp_err.h"
+
+namespace sim
+{
+    constexpr uint8_t  PCA9685_ADDR  = 0x44;   // 与 PCA9685::DEFAULT_I2C_ADDR 一致
+    constexpr uint32_t BUS_SPEED_HZ  = 400000; // 与 PCA9685::init() 中的 scl_speed_hz 一致
+    constexpr uint8_t  SERVO_COUNT   = 16;
+    constexpr uint8_t  MOTOR_SLOT    = 16; // 与 timeline::MOTOR_SLOT 一致
+    constexpr size_t   REGISTER_SIZE = 256;
+
+    /**
+     * @brief 一次输出变化（带时间戳）
+     *
+     * 舵机通道记录写入后的 off 计数（on 不为 0 时记为 -1），
+     * 电机记录带方向的占空比（DIR 为低时取负，0 ~ ±1023）
+     */
+    struct Write
+    {
+        int64_t time_us; // 写入时间（esp_timer_get_time()）
+        uint8_t slot;    // 0 ~ 15 舵机通道，16 电机
+        int32_t value;
+    };
+
+    /**
+     * @brief 总线统计
+     */
+    struct BusStats
+    {
+        uint64_t bytes;        // 总线上传输的字节数（含地址字节）
+        uint32_t transactions; // 事务数
+        uint64_t busy_us;      // 按总线速率估算的占用时间（微秒）
+
+        BusStats() : bytes(0), transactions(0), busy_us(0) {}
+    };
+
+    /**
+     * @brief 仿真的 PCA9685（单例模式）
+     *
+     * 维护一份 256 字节的寄存器表，按芯片的规则处理写入（MODE1 的 AI 位决定是否自动递增），
+     * 每次写入后比较各通道的 LEDn 寄存器，把变化的通道记录为带时间戳的 Write。
+     * b2 电机的 LEDC 占空比和 DIR 电平也记录到同一条轨迹中。
+     * 开启总线延时后，每个事务按 400kHz 下的传输时间阻塞调用方（仿真时间下推进时钟），
+     * 使节拍耗时接近真实设备。
+     */
+    class FakePca9685
+    {
+    public:
+        /**
+         * @brief 获取单例实例
+         */
+        static FakePca9685& getInstance()
+        {
+            static FakePca9685 instance;
+            return instance;
+        }
+
+        FakePca9685(const FakePca9685&)            = delete;
+        FakePca9685& operator=(const FakePca9685&) = delete;
+
+        /**
+         * @brief 是否按总线速率模拟事务耗时（默认开启）
+         */
+        void setBusDelay(bool enabled)
+        {
+            bus_delay_ = enabled;
+        }
+
+        /**
+         * @brief 写事务（第一个字节为起始寄存器地址）
+         */
+        esp_err_t transmit(const uint8_t* data, size_t len);
+
+        /**
+         * @brief 写后读事务（写入寄存器地址后读取）
+         */
+        esp_err_t transmitReceive(const uint8_t* write_data, size_t write_len, uint8_t* read_data,
+                                  size_t read_len);
+
+        /**
+         * @brief 记录 DIR 引脚电平
+         */
+        void setMotorDirection(uint32_t level);
+
+        /**
+         * @brief 读取 DIR 引脚电平
+         */
+        int getMotorDirection() const;
+
+        /**
+         * @brief 设置 LEDC 占空比（对应 ledc_set_duty，尚未生效）
+         */
+        void setMotorDuty(uint32_t duty);
+
+        /**
+         * @brief 使占空比生效并记录电机输出（对应 ledc_update_duty）
+         */
+        void updateMotorDuty();
+
+        /**
+         * @brief 取出并清空记录的写入
+         */
+        std::vector<Write> takeWrites();
+
+        /**
+         * @brief 获取总线统计
+         */
+        BusStats getBusStats() const;
+
+        /**
+         * @brief 清零总线统计和写入记录（不影响寄存器）
+         */
+        void resetStats();
+
+        /**
+         * @brief 读取寄存器当前值
+         */
+        uint8_t getRegister(uint8_t reg) const;
+
+    private:
+        FakePca9685();
+
+        // 一个通道当前的输出（off 计数，on 不为 0 时为 -1）
+        int32_t channelValue(uint8_t channel) const;
+
+        // 记录一个事务的总线统计，需要时按总线速率阻塞
+        void recordTransaction(size_t bytes);
+
+        mutable std::mutex mutex_;
+        uint8_t            registers_[REGISTER_SIZE];
+        int32_t            outputs_[SERVO_COUNT + 1];
+        uint32_t           direction_    = 0;
+        uint32_t           pending_duty_ = 0;
+        bool               bus_delay_    = true;
+        std::vector<Write> writes_;
+        BusStats           stats_;
+    };
+
+} // namespace sim
@@ -0,0 +1,551 @@
+// 运动模块主机仿真：把 mov_info 夹具依次提交给真实的运动引擎，PCA9685 和电机由
+// FakePca9685 记录带时间戳的输出，再与独立的浮点参考轨迹比较。
+//
+// 报告内容：
+//   - 各通道轨迹误差（写入时刻的实际输出与参考轨迹之差：最大值、均方根、结束误差，单位为度）
+//   - 节拍抖动（引擎统计的唤醒偏差，以及相邻两次写入间隔相对节拍周期的偏差，只作参考）
+//   - I2C 字节数 / 秒、事务数 / 秒、总线占用率
+//
+// 用法见 README.md
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "fake_pca9685.hpp"
+#include "move/engine/engine.hpp"
+#include "move/move.hpp"
+
+using app::move::ServoMotion;
+using app::move::timeline::Easing;
+using app::move::timeline::MAX_TRACKS;
+using app::move::timeline::MOTOR_SLOT;
+using app::move::timeline::REST_VALUE;
+
+namespace
+{
+    // 与 move.cc 一致的舵机脉宽范围和频率
+    constexpr double SERVO_MIN_PULSE_US = 500.0;
+    constexpr double SERVO_MAX_PULSE_US = 2500.0;
+    constexpr double SERVO_FREQ_HZ      = 50.0;
+    constexpr double MOTOR_MAX_DUTY     = 1023.0;
+
+    constexpr int64_t SETTLE_TIMEOUT_US = 2000000;  // 序列结束后等待引擎空闲的上限
+    constexpr int64_t WALL_TIMEOUT_US   = 30000000; // 按主机时间等待单个夹具的上限
+    constexpr int64_t TICK_GROUP_US     = 2000;    // 间隔小于此值的写入属于同一个节拍
+
+    struct Options
+    {
+        uint32_t                 tick_ms       = app::move::engine::DEFAULT_TICK_MS;
+        bool                     bus_delay   = true;
+        bool                     realtime    = false; // 按主机时间运行（默认使用仿真时间）
+        double                   max_error   = -1.0;  // 小于 0 表示不检查
+        int64_t                  max_i2c_bps = -1;
+        const char*              trace_path  = nullptr;
+        bool                     verbose     = false;
+        std::vector<std::string> fixtures;
+    };
+
+    // ==================== 参考轨迹 ====================
+
+    // 缓动曲线的浮点定义（独立于 timeline 的定点查找表）
+    double curve(Easing type, double t)
+    {
+        switch (type)
+        {
+        case Easing::EASE_IN:
+        case Easing::EASE_IN_QUAD:
+            return t * t;
+        case Easing::EASE_OUT:
+        case Easing::EASE_OUT_QUAD:
+            return 1.0 - (1.0 - t) * (1.0 - t);
+        case Easing::EASE_IN_OUT:
+        case Easing::EASE_IN_OUT_QUAD:
+            return t < 0.5 ? 2.0 * t * t : 1.0 - 2.0 * (1.0 - t) * (1.0 - t);
+        case Easing::EASE_IN_CUBIC:
+            return t * t * t;
+        case Easing::EASE_OUT_CUBIC:
+            return 1.0 - std::pow(1.0 - t, 3.0);
+        case Easing::EASE_IN_OUT_CUBIC:
+            return t < 0.5 ? 4.0 * t * t * t : 1.0 - 4.0 * std::pow(1.0 - t, 3.0);
+        default:
+            return t;
+        }
+    }
+
+    struct RefSegment
+    {
+        double start;
+        double end; // 被同一通道的下一段打断时提前
+        double span;
+        double from;
+        double to;
+        Easing easing;
+
+        double valueAt(double t) const
+        {
+            if (t <= start)
+            {
+                return from;
+            }
+            if (t - start >= span)
+            {
+                return to;
+            }
+            return from + (to - from) * curve(easing, (t - start) / span);
+        }
+    };
+
+    /**
+     * @brief 一个序列的参考轨迹（角度，电机为 0~180 的速度刻度）
+     *
+     * 语义与 mov_info 的约定一致：同一通道上后一步开始时打断前一步并从当前值继续，
+     * 步与步之间保持上一步的目标值，第一步开始前保持起始值。
+     */
+    class Reference
+    {
+    public:
+        Reference(const std::vector<ServoMotion>& motions, const double* start_values)
+        {
+            std::copy(start_values, start_values + MAX_TRACKS, start_);
+
+            std::vector<const ServoMotion*> order;
+            for (const auto& motion : motions)
+            {
+                order.push_back(&motion);
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [](const ServoMotion* a, const ServoMotion* b)
+                             { return a->start_time < b->start_time; });
+
+            for (const ServoMotion* motion : order)
+            {
+                int slot = slotOf(motion->channel);
+                if (slot < 0)
+                {
+                    continue;
+                }
+
+                std::vector<RefSegment>& track = tracks_[slot];
+                double                   from  = start_[slot];
+                if (!track.empty())
+                {
+                    RefSegment& previous = track.back();
+                    if (previous.end > motion->start_time)
+                    {
+                        from         = previous.valueAt(motion->start_time);
+                        previous.end = motion->start_time;
+                    }
+                    else
+                    {
+                        from = previous.to;
+                    }
+                }
+
+                RefSegment segment;
+                segment.start  = motion->start_time;
+                segment.end    = static_cast<double>(motion->start_time) + motion->duration;
+                segment.span   = motion->duration;
+                segment.from   = from;
+                segment.to     = motion->angle;
+                segment.easing = motion->easing;
+                track.push_back(segment);
+
+                mask_ |= 1u << slot;
+                duration_ = std::max(duration_, segment.end);
+            }
+        }
+
+        static int slotOf(uint8_t channel)
+        {
+            if (channel == 254)
+            {
+                return static_cast<int>(MOTOR_SLOT);
+            }
+            return channel < app::move::PCA9685::CHANNEL_COUNT ? channel : -1;
+        }
+
+        double valueAt(size_t slot, double t) const
+        {
+            const std::vector<RefSegment>& track = tracks_[slot];
+            for (size_t i = 0; i < track.size(); i++)
+            {
+                if (track[i].end > t || i + 1 == track.size())
+                {
+                    if (track[i].start <= t)
+                    {
+                        return track[i].valueAt(t);
+                    }
+                    return i > 0 ? track[i - 1].to : start_[slot];
+                }
+            }
+            return start_[slot];
+        }
+
+        double finalValue(size_t slot) const
+        {
+            return tracks_[slot].empty() ? start_[slot] : tracks_[slot].back().to;
+        }
+
+        uint32_t getMask() const
+        {
+            return mask_;
+        }
+
+        double getDuration() const
+        {
+            return duration_;
+        }
+
+    private:
+        std::vector<RefSegment> tracks_[MAX_TRACKS];
+        double                  start_[MAX_TRACKS];
+        uint32_t                mask_     = 0;
+        double                  duration_ = 0.0;
+    };
+
+    // ==================== 输出换算 ====================
+
+    // 舵机 off 计数换算为角度（按 50Hz 的标称周期，与 PCA9685::buildServoTable 一致）
+    double countToDegrees(int32_t count)
+    {
+        double pulse_us = count * (1000000.0 / SERVO_FREQ_HZ) / 4096.0;
+        return (pulse_us - SERVO_MIN_PULSE_US) / (SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) * 180.0;
+    }
+
+    // 电机带方向的占空比换算为 0~180 刻度（90 为停止）
+    double dutyToDegrees(int32_t duty)
+    {
+        return 90.0 + 90.0 * duty / MOTOR_MAX_DUTY;
+    }
+
+    const char* slotName(size_t slot)
+    {
+        static const char* const NAMES[] = {"h1", "h2", "b1", "h3"};
+        static char              buffer[MAX_TRACKS][8];
+        if (slot < 4)
+        {
+            return NAMES[slot];
+        }
+        if (slot == MOTOR_SLOT)
+        {
+            return "b2";
+        }
+        snprintf(buffer[slot], sizeof(buffer[slot]), "ch%u", static_cast<unsigned>(slot));
+        return buffer[slot];
+    }
+
+    // ==================== 单个夹具 ====================
+
+    struct ChannelError
+    {
+        uint32_t samples = 0;
+        double   max     = 0.0;
+        double   sum_sq  = 0.0;
+        double   last    = 0.0; // 最后一次写入的实际值
+        bool     written = false;
+    };
+
+    struct Result
+    {
+        bool   ok        = false;
+        double max_error = 0.0;
+        double i2c_bps   = 0.0;
+    };
+
+    bool readFile(const std::string& path, std::string& content)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        content = buffer.str();
+        return true;
+    }
+
+    std::string baseName(const std::string& path)
+    {
+        size_t pos = path.find_last_of('/');
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+
+    Result runFixture(const std::string& path, const Options& options, double* start_values,
+                      FILE* trace)
+    {
+        Result      result;
+        std::string json;
+        if (!readFile(path, json))
+        {
+            printf("%s: 无法读取\n", path.c_str());
+            return result;
+        }
+
+        std::vector<ServoMotion> motions;
+        if (!app::move::parseMovementJson(json, motions))
+        {
+            printf("%s: 不是有效的 mov_info\n", path.c_str());
+            return result;
+        }
+
+        Reference reference(motions, start_values);
+        auto&     engine = app::move::engine::MotionEngine::getInstance();
+        auto&     fake   = sim::FakePca9685::getInstance();
+        engine.resetStats();
+        fake.resetStats();
+
+        int64_t t0 = esp_timer_get_time();
+        if (!engine.submit(motions))
+        {
+            printf("%s: 提交失败\n", path.c_str());
+            return result;
+        }
+
+        // 等待序列完成且引擎回到空闲；仿真时间下引擎卡住时时钟不再前进，另按主机时间限制
+        int64_t deadline = t0 + static_cast<int64_t>(reference.getDuration() * 1000) +
+                           SETTLE_TIMEOUT_US;
+        auto wall_deadline =
+            std::chrono::steady_clock::now() + std::chrono::microseconds(WALL_TIMEOUT_US);
+        while (engine.getStats().sequences == 0 || engine.isBusy())
+        {
+            if (esp_timer_get_time() > deadline || std::chrono::steady_clock::now() > wall_deadline)
+            {
+                printf("%s: 等待序列完成超时\n", path.c_str());
+                return result;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        int64_t elapsed_us = esp_timer_get_time() - t0;
+
+        // 写入时刻的实际值与参考轨迹比较
+        std::vector<sim::Write> writes = fake.takeWrites();
+        ChannelError            errors[MAX_TRACKS];
+        int64_t                 interval_jitter_us = 0;
+        int64_t                 group_start_us     = -1;
+        const int64_t           period_us          = options.tick_ms * 1000;
+        for (const auto& write : writes)
+        {
+            // 写入间隔相对节拍周期整数倍的偏差（同一个节拍内的多次写入只取第一次）
+            if (group_start_us < 0 || write.time_us - group_start_us >= TICK_GROUP_US)
+            {
+                if (group_start_us >= 0)
+                {
+                    int64_t interval = write.time_us - group_start_us;
+                    int64_t ticks    = std::max<int64_t>((interval + period_us / 2) / period_us, 1);
+                    int64_t deviation  = std::llabs(interval - ticks * period_us);
+                    interval_jitter_us = std::max(interval_jitter_us, deviation);
+                }
+                group_start_us = write.time_us;
+            }
+
+            if (write.slot != sim::MOTOR_SLOT && write.value < 0)
+            {
+                continue; // 通道未输出脉冲
+            }
+
+            double actual   = write.slot == sim::MOTOR_SLOT ? dutyToDegrees(write.value)
+                                                            : countToDegrees(write.value);
+            double t_ms     = (write.time_us - t0) / 1000.0;
+            double expected = reference.valueAt(write.slot, t_ms);
+            double error    = actual - expected;
+
+            ChannelError& channel = errors[write.slot];
+            channel.samples++;
+            channel.max = std::max(channel.max, std::fabs(error));
+            channel.sum_sq += error * error;
+            channel.last    = actual;
+            channel.written = true;
+
+            if (trace != nullptr)
+            {
+                fprintf(trace, "%s,%.3f,%s,%.3f,%.3f\n", baseName(path).c_str(), t_ms,
+                        slotName(write.slot), actual, expected);
+            }
+        }
+
+        auto     stats    = engine.getStats();
+        auto     bus      = fake.getBusStats();
+        uint32_t avg_us   = stats.ticks > 0 ? stats.jitter_sum_us / stats.ticks : 0;
+        double   seconds  = elapsed_us / 1000000.0;
+        result.i2c_bps = bus.bytes / seconds;
+
+        printf("== %s: %zu 步, 计划 %.0f ms, 实际 %.1f ms, 结束偏差 %ld ms\n",
+               baseName(path).c_str(), motions.size(), reference.getDuration(),
+               elapsed_us / 1000.0, (long)stats.end_error_ms);
+        printf("   通道     写入   最大误差     均方根   结束误差\n");
+        for (size_t slot = 0; slot < MAX_TRACKS; slot++)
+        {
+            if ((reference.getMask() & (1u << slot)) == 0)
+            {
+                continue;
+            }
+
+            const ChannelError& channel   = errors[slot];
+            double              final_ref = reference.finalValue(slot);
+            double              end_error =
+                channel.written ? channel.last - final_ref : start_values[slot] - final_ref;
+            double rms = channel.samples > 0 ? std::sqrt(channel.sum_sq / channel.samples) : 0.0;
+            printf("   %-6s %6u %10.2f %10.2f %10.2f\n", slotName(slot), channel.samples,
+                   channel.max, rms, end_error);
+
+            result.max_error = std::max({result.max_error, channel.max, std::fabs(end_error)});
+            start_values[slot] = final_ref; // 下一个夹具从这里开始
+        }
+        // 仿真时间下偏差只来自模拟的总线耗时；主机时间下取决于主机调度，都不作为测试条件
+        printf("   节拍%s: %lu, 超时: %lu, 唤醒偏差 平均 %lu us / 最大 %lu us, 写入间隔偏差 最大 "
+               "%lld us, 最长处理 %lu us\n",
+               options.realtime ? "（主机时间）" : "", (unsigned long)stats.ticks,
+               (unsigned long)stats.overruns, (unsigned long)avg_us,
+               (unsigned long)stats.jitter_max_us, (long long)interval_jitter_us,
+               (unsigned long)stats.busy_max_us);
+        printf("   I2C: %llu 字节, %.0f B/s, %.1f 事务/s, 总线占用 %.2f%%\n",
+               (unsigned long long)bus.bytes, result.i2c_bps, bus.transactions / seconds,
+               bus.busy_us / 10000.0 / seconds);
+
+        result.ok = true;
+        return result;
+    }
+
+    void printUsage(const char* program)
+    {
+        printf("用法: %s [选项] 夹具.json...\n"
+               "  --tick MS         引擎节拍周期（默认 %lu）\n"
+               "  --no-bus-delay    不按 400kHz 模拟事务耗时\n"
+               "  --realtime        按主机时间运行（默认使用仿真时间，结果与主机负载无关）\n"
+               "  --max-error DEG   轨迹误差上限，超过时返回非 0\n"
+               "  --max-i2c-bps N   I2C 字节数 / 秒上限，超过时返回非 0\n"
+               "  --trace FILE      把每次写入输出为 CSV（夹具, 时间 ms, 通道, 实际, 参考）\n"
+               "  -v                输出运动模块的 INFO 日志\n",
+               program, (unsigned long)app::move::engine::DEFAULT_TICK_MS);
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg      = argv[i];
+            bool        has_next = i + 1 < argc;
+            if (arg == "--tick" && has_next)
+            {
+                options.tick_ms = static_cast<uint32_t>(atoi(argv[++i]));
+            }
+            else if (arg == "--no-bus-delay")
+            {
+                options.bus_delay = false;
+            }
+            else if (arg == "--realtime")
+            {
+                options.realtime = true;
+            }
+            else if (arg == "--max-error" && has_next)
+            {
+                options.max_error = atof(argv[++i]);
+            }
+            else if (arg == "--max-i2c-bps" && has_next)
+            {
+                options.max_i2c_bps = atoll(argv[++i]);
+            }
+            else if (arg == "--trace" && has_next)
+            {
+                options.trace_path = argv[++i];
+            }
+            else if (arg == "-v")
+            {
+                options.verbose = true;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                return false;
+            }
+            else
+            {
+                options.fixtures.push_back(arg);
+            }
+        }
+        return !options.fixtures.empty();
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    esp_log_level_set("*", options.verbose ? ESP_LOG_INFO : ESP_LOG_WARN);
+    sim_clock_use_virtual(!options.realtime);
+    sim::FakePca9685::getInstance().setBusDelay(options.bus_delay);
+
+    // 总线句柄只需非空，仿真的 i2c_master_bus_add_device 不使用它
+    static int bus_token = 0;
+    auto       bus       = reinterpret_cast<i2c_master_bus_handle_t>(&bus_token);
+    if (!app::move::PCA9685::init(bus) ||
+        !app::move::engine::MotionEngine::getInstance().start(options.tick_ms))
+    {
+        printf("初始化失败\n");
+        return 1;
+    }
+
+    FILE* trace = nullptr;
+    if (options.trace_path != nullptr)
+    {
+        trace = fopen(options.trace_path, "w");
+        if (trace == nullptr)
+        {
+            printf("无法写入 %s\n", options.trace_path);
+            return 1;
+        }
+        fprintf(trace, "fixture,time_ms,channel,actual,reference\n");
+    }
+
+    // 上电后引擎假定舵机居中、电机停止
+    double start_values[MAX_TRACKS];
+    std::fill(std::begin(start_values), std::end(start_values), static_cast<double>(REST_VALUE));
+
+    bool passed = true;
+    for (const auto& path : options.fixtures)
+    {
+        Result result = runFixture(path, options, start_values, trace);
+        if (!result.ok)
+        {
+            passed = false;
+            continue;
+        }
+
+        if (options.max_error >= 0 && result.max_error > options.max_error)
+        {
+            printf("   FAIL: 轨迹误差 %.2f 度 > %.2f 度\n", result.max_error, options.max_error);
+            passed = false;
+        }
+        if (options.max_i2c_bps >= 0 && result.i2c_bps > options.max_i2c_bps)
+        {
+            printf("   FAIL: I2C %.0f B/s > %lld B/s\n", result.i2c_bps,
+                   (long long)options.max_i2c_bps);
+            passed = false;
+        }
+    }
+
+    if (trace != nullptr)
+    {
+        fclose(trace);
+    }
+
+    app::move::engine::MotionEngine::getInstance().stop();
+    printf("%s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}
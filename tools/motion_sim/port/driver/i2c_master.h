@@ -0,0 +1,28 @@
+#pragma once
+
+// 主机仿真用的 I2C 主机接口（只有类型和设备登记，读写由仿真的 I2C 调度器完成）
+
+#include <cstdint>
+
+#include "esp_err.h"
+
+typedef struct i2c_master_bus_t* i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t* i2c_master_dev_handle_t;
+
+typedef enum
+{
+    I2C_ADDR_BIT_LEN_7  = 0,
+    I2C_ADDR_BIT_LEN_10 = 1
+} i2c_addr_bit_len_t;
+
+typedef struct
+{
+    i2c_addr_bit_len_t dev_addr_length;
+    uint16_t           device_address;
+    uint32_t           scl_speed_hz;
+} i2c_device_config_t;
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t    bus_handle,
+                                    const i2c_device_config_t* dev_config,
+                                    i2c_master_dev_handle_t*   ret_handle);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle);
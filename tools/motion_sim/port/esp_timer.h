@@ -0,0 +1,15 @@
+#pragma once
+
+// 主机仿真用的时钟：进程启动后的单调时间（微秒）
+//
+// 开启仿真时间后，时钟只由任务延时和 sim_clock_advance() 推进：vTaskDelay / xTaskDelayUntil
+// 不再睡眠，而是把时钟直接推进到唤醒时刻。运动引擎是唯一推进时钟的任务，
+// 因此写入时刻和轨迹误差只取决于代码本身，与主机负载无关。
+
+#include <cstdint>
+
+int64_t esp_timer_get_time();
+
+void sim_clock_use_virtual(bool enabled); // 在创建任务之前调用
+bool sim_clock_is_virtual();
+void sim_clock_advance(int64_t us); // 仿真时间下推进时钟（模拟耗时操作）
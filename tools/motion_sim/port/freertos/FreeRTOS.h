@@ -0,0 +1,31 @@
+#pragma once
+
+// 主机仿真用的 FreeRTOS 类型和常量，节拍频率默认与设备的 CONFIG_FREERTOS_HZ 一致
+
+#include <cstdint>
+
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ 100
+#endif
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t  StackType_t;
+
+typedef struct HostStaticTask
+{
+    uint8_t unused;
+} StaticTask_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY      ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+typedef struct HostQueue* QueueHandle_t;
+typedef void*             TaskHandle_t;
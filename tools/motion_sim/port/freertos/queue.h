@@ -0,0 +1,13 @@
+#pragma once
+
+// 主机仿真用的队列（std::mutex + std::condition_variable）
+
+#include "freertos/FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void          vQueueDelete(QueueHandle_t queue);
+BaseType_t    xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+BaseType_t    xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+BaseType_t    xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait);
+BaseType_t    xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks_to_wait);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t queue);
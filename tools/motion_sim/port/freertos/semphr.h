@@ -0,0 +1,12 @@
+#pragma once
+
+// 主机仿真用的信号量（与 FreeRTOS 一样用长度为 1、元素大小为 0 的队列实现）
+
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#define xSemaphoreCreateBinary()           xQueueCreate(1, 0)
+#define vSemaphoreDelete(sem)              vQueueDelete(sem)
+#define xSemaphoreGive(sem)                xQueueSend(sem, nullptr, 0)
+#define xSemaphoreTake(sem, ticks_to_wait) xQueueReceive(sem, nullptr, ticks_to_wait)
@@ -0,0 +1,9 @@
+#pragma once
+
+// 主机仿真用的任务延时接口（基于 std::chrono::steady_clock）
+
+#include "freertos/FreeRTOS.h"
+
+TickType_t xTaskGetTickCount();
+void       vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t* previous_wake_time, TickType_t time_increment);
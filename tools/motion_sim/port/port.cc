@@ -0,0 +1,280 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point EPOCH = Clock::now();
+
+    esp_log_level_t log_level = ESP_LOG_WARN;
+
+    std::atomic<bool>    virtual_clock{false};
+    std::atomic<int64_t> virtual_now_us{0};
+
+    int64_t ticksToUs(TickType_t ticks)
+    {
+        return (int64_t)ticks * 1000000 / configTICK_RATE_HZ;
+    }
+
+    // 等到时钟到达 target_us：仿真时间下直接推进时钟（不回退），否则睡眠
+    void sleepUntilUs(int64_t target_us)
+    {
+        if (!virtual_clock)
+        {
+            std::this_thread::sleep_until(EPOCH + std::chrono::microseconds(target_us));
+            return;
+        }
+
+        int64_t now = virtual_now_us.load();
+        while (now < target_us && !virtual_now_us.compare_exchange_weak(now, target_us))
+        {
+        }
+    }
+
+    // 节拍数转换为超时时间点（portMAX_DELAY 表示一直等待）
+    // 队列和信号量的超时只用于异常保护，仿真时间下也按主机时间计算
+    bool toDeadline(TickType_t ticks, Clock::time_point& deadline)
+    {
+        if (ticks == portMAX_DELAY)
+        {
+            return false;
+        }
+        deadline = Clock::now() + std::chrono::microseconds(ticksToUs(ticks));
+        return true;
+    }
+} // namespace
+
+// ==================== esp_err / esp_log / esp_timer ====================
+
+const char* esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    default:
+        return "UNKNOWN_ERROR";
+    }
+}
+
+void esp_log_level_set(const char* tag, esp_log_level_t level)
+{
+    (void)tag; // 仿真中所有 TAG 使用同一级别
+    log_level = level;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...)
+{
+    if (level > log_level)
+    {
+        return;
+    }
+
+    static const char LETTERS[] = "NEWIDV";
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    printf("%c (%lld) %s: ", LETTERS[level], (long long)(esp_timer_get_time() / 1000), tag);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+}
+
+int64_t esp_timer_get_time()
+{
+    if (virtual_clock)
+    {
+        return virtual_now_us.load();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - EPOCH).count();
+}
+
+void sim_clock_use_virtual(bool enabled)
+{
+    // 仿真时间从 0 开始，节拍边界的相位每次相同
+    virtual_now_us = 0;
+    virtual_clock  = enabled;
+}
+
+bool sim_clock_is_virtual()
+{
+    return virtual_clock;
+}
+
+void sim_clock_advance(int64_t us)
+{
+    if (virtual_clock && us > 0)
+    {
+        virtual_now_us += us;
+    }
+}
+
+// ==================== 任务延时 ====================
+
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(esp_timer_get_time() * configTICK_RATE_HZ / 1000000);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        // 对应任务在这里等待被删除，主机上让线程一直睡眠
+        while (true)
+        {
+            std::this_thread::sleep_for(std::chrono::hours(1));
+        }
+    }
+    sleepUntilUs(esp_timer_get_time() + ticksToUs(ticks));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* previous_wake_time, TickType_t time_increment)
+{
+    // 与 FreeRTOS 一致：唤醒时间总是前进 time_increment，已经错过时不延时并返回 pdFALSE
+    TickType_t wake_time = *previous_wake_time + time_increment;
+    *previous_wake_time  = wake_time;
+    if ((int32_t)(wake_time - xTaskGetTickCount()) <= 0)
+    {
+        return pdFALSE;
+    }
+    sleepUntilUs(ticksToUs(wake_time));
+    return pdTRUE;
+}
+
+// ==================== 队列 ====================
+
+struct HostQueue
+{
+    std::mutex                        mutex;
+    std::condition_variable           changed;
+    std::deque<std::vector<uint8_t>> items;
+    size_t                            length;
+    size_t                            item_size;
+};
+
+namespace
+{
+    BaseType_t queueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait,
+                         bool to_front)
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        Clock::time_point            deadline;
+        bool                         timed = toDeadline(ticks_to_wait, deadline);
+        auto has_space = [queue]() { return queue->items.size() < queue->length; };
+        if (timed ? !queue->changed.wait_until(lock, deadline, has_space)
+                  : (queue->changed.wait(lock, has_space), false))
+        {
+            return pdFALSE;
+        }
+
+        std::vector<uint8_t> data(queue->item_size);
+        if (queue->item_size > 0)
+        {
+            memcpy(data.data(), item, queue->item_size);
+        }
+        if (to_front)
+        {
+            queue->items.push_front(std::move(data));
+        }
+        else
+        {
+            queue->items.push_back(std::move(data));
+        }
+        queue->changed.notify_all();
+        return pdTRUE;
+    }
+
+    BaseType_t queueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait, bool peek)
+    {
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        Clock::time_point            deadline;
+        bool                         timed     = toDeadline(ticks_to_wait, deadline);
+        auto                         not_empty = [queue]() { return !queue->items.empty(); };
+        if (timed ? !queue->changed.wait_until(lock, deadline, not_empty)
+                  : (queue->changed.wait(lock, not_empty), false))
+        {
+            return pdFALSE;
+        }
+
+        if (queue->item_size > 0)
+        {
+            memcpy(item, queue->items.front().data(), queue->item_size);
+        }
+        if (!peek)
+        {
+            queue->items.pop_front();
+            queue->changed.notify_all();
+        }
+        return pdTRUE;
+    }
+} // namespace
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    HostQueue* queue = new HostQueue;
+    queue->length    = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait)
+{
+    return queueSend(queue, item, ticks_to_wait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait)
+{
+    return queueSend(queue, item, ticks_to_wait, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait)
+{
+    return queueReceive(queue, item, ticks_to_wait, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks_to_wait)
+{
+    return queueReceive(queue, item, ticks_to_wait, true);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->items.size());
+}
@@ -0,0 +1,70 @@
+// 主机仿真用的 app::sys::task::Task（只实现运动引擎用到的接口）
+//
+// 任务用分离的 std::thread 运行。FreeRTOS 中 destroy() 会删除任务，主机上线程无法从外部结束，
+// 因此 destroy() 只释放句柄：运动引擎在 stop() 之前已经让任务停在 vTaskDelay(portMAX_DELAY)。
+
+#include "system/task/task.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+#include "esp_log.h"
+
+static const char* const TAG = "TASK";
+
+namespace app
+{
+    namespace sys
+    {
+        namespace task
+        {
+            Task::Task(TaskFunction function, const Config& config, void* param)
+                : function_(function), config_(config), param_(param), handle_(nullptr),
+                  started_(false), stack_(nullptr), tcb_(nullptr)
+            {
+            }
+
+            Task::~Task() = default;
+
+            bool Task::start()
+            {
+                if (started_ || handle_ != nullptr)
+                {
+                    ESP_LOGW(TAG, "任务 %s 已启动", config_.name);
+                    return false;
+                }
+
+                if (!function_)
+                {
+                    ESP_LOGE(TAG, "任务函数为空");
+                    return false;
+                }
+
+                if (config_.delay_ms > 0)
+                {
+                    vTaskDelay(pdMS_TO_TICKS(config_.delay_ms));
+                }
+
+                std::thread thread(function_, param_);
+
+                // 尽量使用实时调度减小唤醒抖动，没有权限时保持普通调度
+                sched_param param = {};
+                param.sched_priority =
+                    sched_get_priority_min(SCHED_FIFO) + static_cast<int>(config_.priority);
+                pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+
+                thread.detach();
+                handle_  = this;
+                started_ = true;
+                return true;
+            }
+
+            void Task::destroy()
+            {
+                handle_  = nullptr;
+                started_ = false;
+            }
+        } // namespace task
+    } // namespace sys
+} // namespace app
@@ -0,0 +1,262 @@
+// 运动时间线的主机测试与基准：先检查插值、打断和起始值的正确性，再比较编译后的时间线
+// 与原先逐节拍扫描全部动作的写法在不同关键帧数量下每个节拍的耗时。
+//
+// 用法：timeline_bench [关键帧数量...]（默认 100 1000 10000）
+// 任一检查失败时返回值非 0；基准耗时只作参考，不作为测试条件。
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "move/timeline/timeline.hpp"
+
+using namespace app::move::timeline;
+
+namespace
+{
+    constexpr uint32_t TICK_MS = 20;
+
+    using Clock = std::chrono::steady_clock;
+
+    int64_t elapsedUs(Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start)
+            .count();
+    }
+
+    // 原先逐节拍扫描全部动作的写法（只做插值，不写 I2C），作为对比基准
+    struct LegacyMotion
+    {
+        std::string move_part;
+        uint8_t     channel;
+        uint32_t    start_time;
+        uint8_t     angle;
+        uint32_t    duration;
+    };
+
+    uint32_t rng_state = 12345;
+
+    uint32_t nextRandom()
+    {
+        rng_state = rng_state * 1664525u + 1013904223u;
+        return rng_state >> 8;
+    }
+
+    // 生成一段编舞：4 个舵机通道 + b2 电机依次接力，每个通道的关键帧首尾相接
+    void buildChoreography(size_t count, std::vector<Keyframe>& keyframes,
+                           std::vector<LegacyMotion>& legacy)
+    {
+        static const char* const PARTS[]    = {"h1", "h2", "b1", "h3", "b2"};
+        static const uint8_t     CHANNELS[] = {0, 1, 2, 3, 254};
+
+        uint32_t channel_time[5] = {};
+        keyframes.clear();
+        legacy.clear();
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t   part     = i % 5;
+            uint32_t duration = 100 + nextRandom() % 900;
+            uint8_t  angle    = static_cast<uint8_t>(nextRandom() % 181);
+
+            Keyframe keyframe;
+            keyframe.channel    = CHANNELS[part];
+            keyframe.motor      = part == 4;
+            keyframe.start_time = channel_time[part];
+            keyframe.duration   = duration;
+            keyframe.value      = angle;
+            keyframe.easing     = static_cast<Easing>(nextRandom() % EASING_COUNT);
+            keyframes.push_back(keyframe);
+
+            legacy.push_back({PARTS[part], CHANNELS[part], channel_time[part], angle, duration});
+            channel_time[part] += duration;
+        }
+    }
+
+    // 原先的每节拍处理：遍历全部动作，比较 move_part 字符串，插值活跃的动作
+    float legacyTick(const std::vector<LegacyMotion>& motions, uint32_t now)
+    {
+        float sum = 0.0f;
+        for (const auto& motion : motions)
+        {
+            bool motor = motion.move_part == "b2";
+            if (motion.start_time <= now && now < motion.start_time + motion.duration)
+            {
+                float progress = static_cast<float>(now - motion.start_time) / motion.duration;
+                sum += (motor ? 0.5f : 1.0f) * motion.angle * progress;
+            }
+        }
+        return sum;
+    }
+
+    bool runBenchmark(size_t count)
+    {
+        std::vector<Keyframe>     keyframes;
+        std::vector<LegacyMotion> legacy;
+        buildChoreography(count, keyframes, legacy);
+
+        Timeline timeline;
+        auto     start = Clock::now();
+        if (!timeline.compile(keyframes))
+        {
+            printf("编译失败 (%zu 个关键帧)\n", count);
+            return false;
+        }
+        int64_t compile_us = elapsedUs(start);
+
+        // 新写法：每节拍只看各轨道当前所在的段
+        Sample   samples[MAX_TRACKS];
+        uint32_t ticks   = 0;
+        uint32_t outputs = 0;
+        start            = Clock::now();
+        for (uint32_t now = 0; now <= timeline.getDuration(); now += TICK_MS)
+        {
+            outputs += timeline.sample(now, samples);
+            ticks++;
+        }
+        int64_t timeline_us = elapsedUs(start);
+
+        // 基准：每节拍扫描全部动作
+        volatile float sink = 0.0f;
+        start               = Clock::now();
+        for (uint32_t now = 0; now <= timeline.getDuration(); now += TICK_MS)
+        {
+            sink = sink + legacyTick(legacy, now);
+        }
+        int64_t legacy_us = elapsedUs(start);
+
+        printf("%6zu 个关键帧, %6u 个节拍: 编译 %lld us, 时间线 %lld ns/节拍, "
+               "逐个扫描 %lld ns/节拍, 输出 %u\n",
+               count, ticks, (long long)compile_us, (long long)(timeline_us * 1000 / ticks),
+               (long long)(legacy_us * 1000 / ticks), outputs);
+        return true;
+    }
+
+    // 线性缓动、首尾相接的关键帧应与直接插值的结果一致（定点误差不超过 1/256 度）
+    bool checkLinear()
+    {
+        std::vector<Keyframe> keyframes;
+        keyframes.push_back({0, false, 0, 1000, 180, Easing::LINEAR});
+        keyframes.push_back({0, false, 1000, 500, 0, Easing::LINEAR});
+        keyframes.push_back({254, true, 200, 0, 180, Easing::LINEAR});
+
+        Timeline timeline;
+        if (!timeline.compile(keyframes) || timeline.getDuration() != 1500 ||
+            timeline.getTrackCount() != 2)
+        {
+            return false;
+        }
+
+        Sample samples[MAX_TRACKS];
+        for (uint32_t now = 0; now <= 1500; now += 10)
+        {
+            float expected = now < 1000 ? 90.0f + 90.0f * now / 1000.0f
+                                        : 180.0f - 180.0f * (now - 1000) / 500.0f;
+            size_t count = timeline.sample(now, samples);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (samples[i].motor)
+                {
+                    if (now < 200 || samples[i].value != 180 * Q8_ONE)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                float actual = static_cast<float>(samples[i].value) / Q8_ONE;
+                if (std::fabs(actual - expected) > 1.0f / Q8_ONE)
+                {
+                    printf("t=%u 期望 %.3f 实际 %.3f\n", now, static_cast<double>(expected),
+                           static_cast<double>(actual));
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // 被打断的段从当前值继续，不应跳变
+    bool checkPreempt()
+    {
+        std::vector<Keyframe> keyframes;
+        keyframes.push_back({0, false, 0, 1000, 180, Easing::LINEAR});
+        keyframes.push_back({0, false, 500, 1000, 0, Easing::EASE_IN_OUT});
+
+        Timeline timeline;
+        if (!timeline.compile(keyframes))
+        {
+            return false;
+        }
+
+        Sample  samples[MAX_TRACKS];
+        int32_t last = 90 * Q8_ONE;
+        for (uint32_t now = 0; now <= 1500; now += 5)
+        {
+            if (timeline.sample(now, samples) == 1)
+            {
+                // 5ms 内的最大变化：180 度 / 1000ms 的线性段或缓入缓出段峰值速度的两倍
+                if (std::abs(samples[0].value - last) > 2 * Q8_ONE)
+                {
+                    printf("t=%u 处跳变\n", now);
+                    return false;
+                }
+                last = samples[0].value;
+            }
+        }
+        return last == 0;
+    }
+
+    // 给出起始值时第一段从起始值开始，未涉及的通道不输出
+    bool checkStartValues()
+    {
+        int32_t start_values[MAX_TRACKS];
+        for (size_t slot = 0; slot < MAX_TRACKS; slot++)
+        {
+            start_values[slot] = 30 * Q8_ONE;
+        }
+        start_values[getSlot(2, false)] = 150 * Q8_ONE;
+
+        std::vector<Keyframe> keyframes;
+        keyframes.push_back({2, false, 0, 1000, 50, Easing::LINEAR});
+
+        Timeline timeline;
+        Sample   samples[MAX_TRACKS];
+        if (!timeline.compile(keyframes, start_values) || timeline.sample(0, samples) != 1)
+        {
+            return false;
+        }
+        return samples[0].channel == 2 && samples[0].value == 150 * Q8_ONE;
+    }
+
+    bool report(const char* name, bool passed)
+    {
+        printf("%s: %s\n", name, passed ? "通过" : "失败");
+        return passed;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool passed = true;
+    passed &= report("线性插值", checkLinear());
+    passed &= report("打断连续性", checkPreempt());
+    passed &= report("起始值", checkStartValues());
+
+    std::vector<size_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        counts.push_back(static_cast<size_t>(std::strtoul(argv[i], nullptr, 10)));
+    }
+    if (counts.empty())
+    {
+        counts = {100, 1000, 10000};
+    }
+    for (size_t count : counts)
+    {
+        passed &= runBenchmark(count);
+    }
+
+    return passed ? 0 : 1;
+}